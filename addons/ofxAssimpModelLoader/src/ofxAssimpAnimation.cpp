@@ -5,6 +5,26 @@
 
 #include "ofxAssimpAnimation.h"
 
+namespace{
+    // returns the index of the last key with mTime <= time, or 0 if time is
+    // before the second key. the cursor is checked first together with the
+    // key after it, falling back to a binary search when seeking.
+    template<typename Key>
+    unsigned int findKey(const Key * keys, unsigned int numKeys, double time, unsigned int & cursor) {
+        for(unsigned int frame = cursor; frame < numKeys && frame <= cursor + 1; frame++) {
+            if((frame == 0 || keys[frame].mTime <= time) && (frame + 1 == numKeys || time < keys[frame + 1].mTime)) {
+                cursor = frame;
+                return frame;
+            }
+        }
+        const Key * next = std::upper_bound(keys + 1, keys + numKeys, time, [](double t, const Key & key) {
+            return t < key.mTime;
+        });
+        cursor = next - keys - 1;
+        return cursor;
+    }
+}
+
 ofxAssimpAnimation::ofxAssimpAnimation(shared_ptr<const aiScene> scene, aiAnimation * animation) {
     this->scene = scene;
     this->animation = animation;
@@ -19,10 +39,21 @@ ofxAssimpAnimation::ofxAssimpAnimation(shared_ptr<const aiScene> scene, aiAnimat
     durationInSeconds = 0;
     durationInMilliSeconds = 0;
     speed = 1;
+    sampleStep = 0;
     
     if(animation != NULL) {
         durationInSeconds = animation->mDuration;
         durationInMilliSeconds = durationInSeconds * 1000;
+
+        channels.resize(animation->mNumChannels);
+        for(unsigned int i=0; i<animation->mNumChannels; i++) {
+            Channel & channel = channels[i];
+            channel.nodeAnim = animation->mChannels[i];
+            channel.node = scene->mRootNode->FindNode(channel.nodeAnim->mNodeName);
+            channel.positionKey = 0;
+            channel.rotationKey = 0;
+            channel.scalingKey = 0;
+        }
     }
 }
 
@@ -64,72 +95,13 @@ void ofxAssimpAnimation::update() {
 }
 
 void ofxAssimpAnimation::updateAnimationNodes() {
-	for(unsigned int i=0; i<animation->mNumChannels; i++) {
-        const aiNodeAnim * channel = animation->mChannels[i];
-        aiNode * targetNode = scene->mRootNode->FindNode(channel->mNodeName);
-        
-        aiVector3D presentPosition(0, 0, 0);
-        if(channel->mNumPositionKeys > 0) {
-            unsigned int frame = 0;
-            while(frame < channel->mNumPositionKeys - 1) {
-                if(progressInSeconds < channel->mPositionKeys[frame+1].mTime) {
-                    break;
-                }
-                frame++;
-            }
-            
-            unsigned int nextFrame = (frame + 1) % channel->mNumPositionKeys;
-            const aiVectorKey & key = channel->mPositionKeys[frame];
-            const aiVectorKey & nextKey = channel->mPositionKeys[nextFrame];
-            double diffTime = nextKey.mTime - key.mTime;
-            if(diffTime < 0.0) {
-                diffTime += getDurationInSeconds();
-            }
-            if(diffTime > 0) {
-                float factor = float((progressInSeconds - key.mTime) / diffTime);
-                presentPosition = key.mValue + (nextKey.mValue - key.mValue) * factor;
-            } else {
-                presentPosition = key.mValue;
-            }
-        }
-        
-        aiQuaternion presentRotation(1, 0, 0, 0);
-        if(channel->mNumRotationKeys > 0) {
-            unsigned int frame = 0;
-            while(frame < channel->mNumRotationKeys - 1) {
-                if(progressInSeconds < channel->mRotationKeys[frame+1].mTime) {
-                    break;
-                }
-                frame++;
-            }
-            
-            unsigned int nextFrame = (frame + 1) % channel->mNumRotationKeys;
-            const aiQuatKey& key = channel->mRotationKeys[frame];
-            const aiQuatKey& nextKey = channel->mRotationKeys[nextFrame];
-            double diffTime = nextKey.mTime - key.mTime;
-            if(diffTime < 0.0) {
-                diffTime += getDurationInSeconds();
-            }
-            if(diffTime > 0) {
-                float factor = float((progressInSeconds - key.mTime) / diffTime);
-                aiQuaternion::Interpolate(presentRotation, key.mValue, nextKey.mValue, factor);
-            } else {
-                presentRotation = key.mValue;
-            }
-        }
-        
-        aiVector3D presentScaling(1, 1, 1);
-        if(channel->mNumScalingKeys > 0) {
-            unsigned int frame = 0;
-            while(frame < channel->mNumScalingKeys - 1){
-                if(progressInSeconds < channel->mScalingKeys[frame+1].mTime) {
-                    break;
-                }
-                frame++;
-            }
-            
-            presentScaling = channel->mScalingKeys[frame].mValue;
+    for(auto & channel : channels) {
+        if(channel.node == NULL) {
+            continue;
         }
+        aiVector3D presentPosition = getPositionAtTime(channel, progressInSeconds);
+        aiQuaternion presentRotation = getRotationAtTime(channel, progressInSeconds);
+        aiVector3D presentScaling = getScalingAtTime(channel, progressInSeconds);
         
         aiMatrix4x4 mat = aiMatrix4x4(presentRotation.GetMatrix());
         mat.a1 *= presentScaling.x; mat.b1 *= presentScaling.x; mat.c1 *= presentScaling.x;
@@ -137,8 +109,131 @@ void ofxAssimpAnimation::updateAnimationNodes() {
         mat.a3 *= presentScaling.z; mat.b3 *= presentScaling.z; mat.c3 *= presentScaling.z;
         mat.a4 = presentPosition.x; mat.b4 = presentPosition.y; mat.c4 = presentPosition.z;
         
-        targetNode->mTransformation = mat;
+        channel.node->mTransformation = mat;
+    }
+}
+
+aiVector3D ofxAssimpAnimation::getPositionAtTime(Channel & channel, double time) {
+    if(!channel.positions.empty()) {
+        double sample = ofClamp(time / sampleStep, 0, channel.positions.size() - 1);
+        size_t frame = sample;
+        size_t nextFrame = std::min(frame + 1, channel.positions.size() - 1);
+        float factor = float(sample - frame);
+        return channel.positions[frame] + (channel.positions[nextFrame] - channel.positions[frame]) * factor;
+    }
+
+    const aiNodeAnim * nodeAnim = channel.nodeAnim;
+    if(nodeAnim->mNumPositionKeys == 0) {
+        return aiVector3D(0, 0, 0);
+    }
+    unsigned int frame = findKey(nodeAnim->mPositionKeys, nodeAnim->mNumPositionKeys, time, channel.positionKey);
+    unsigned int nextFrame = (frame + 1) % nodeAnim->mNumPositionKeys;
+    const aiVectorKey & key = nodeAnim->mPositionKeys[frame];
+    const aiVectorKey & nextKey = nodeAnim->mPositionKeys[nextFrame];
+    double diffTime = nextKey.mTime - key.mTime;
+    if(diffTime < 0.0) {
+        diffTime += getDurationInSeconds();
     }
+    if(diffTime > 0) {
+        float factor = float((time - key.mTime) / diffTime);
+        return key.mValue + (nextKey.mValue - key.mValue) * factor;
+    } else {
+        return key.mValue;
+    }
+}
+
+aiQuaternion ofxAssimpAnimation::getRotationAtTime(Channel & channel, double time) {
+    aiQuaternion rotation(1, 0, 0, 0);
+    if(!channel.rotations.empty()) {
+        double sample = ofClamp(time / sampleStep, 0, channel.rotations.size() - 1);
+        size_t frame = sample;
+        size_t nextFrame = std::min(frame + 1, channel.rotations.size() - 1);
+        aiQuaternion::Interpolate(rotation, channel.rotations[frame], channel.rotations[nextFrame], float(sample - frame));
+        return rotation;
+    }
+
+    const aiNodeAnim * nodeAnim = channel.nodeAnim;
+    if(nodeAnim->mNumRotationKeys == 0) {
+        return rotation;
+    }
+    unsigned int frame = findKey(nodeAnim->mRotationKeys, nodeAnim->mNumRotationKeys, time, channel.rotationKey);
+    unsigned int nextFrame = (frame + 1) % nodeAnim->mNumRotationKeys;
+    const aiQuatKey& key = nodeAnim->mRotationKeys[frame];
+    const aiQuatKey& nextKey = nodeAnim->mRotationKeys[nextFrame];
+    double diffTime = nextKey.mTime - key.mTime;
+    if(diffTime < 0.0) {
+        diffTime += getDurationInSeconds();
+    }
+    if(diffTime > 0) {
+        float factor = float((time - key.mTime) / diffTime);
+        aiQuaternion::Interpolate(rotation, key.mValue, nextKey.mValue, factor);
+    } else {
+        rotation = key.mValue;
+    }
+    return rotation;
+}
+
+aiVector3D ofxAssimpAnimation::getScalingAtTime(Channel & channel, double time) {
+    if(!channel.scalings.empty()) {
+        size_t frame = ofClamp(time / sampleStep, 0, channel.scalings.size() - 1);
+        return channel.scalings[frame];
+    }
+
+    const aiNodeAnim * nodeAnim = channel.nodeAnim;
+    if(nodeAnim->mNumScalingKeys == 0) {
+        return aiVector3D(1, 1, 1);
+    }
+    unsigned int frame = findKey(nodeAnim->mScalingKeys, nodeAnim->mNumScalingKeys, time, channel.scalingKey);
+    return nodeAnim->mScalingKeys[frame].mValue;
+}
+
+void ofxAssimpAnimation::resample(float framesPerSecond) {
+    if(animation == NULL || framesPerSecond <= 0) {
+        return;
+    }
+    clearResampling();
+
+    // key times are in ticks, same as the duration.
+    double tps = animation->mTicksPerSecond ? animation->mTicksPerSecond : 25.f;
+    double step = tps / framesPerSecond;
+    size_t numSamples = size_t(ceil(getDurationInSeconds() / step)) + 1;
+
+    for(auto & channel : channels) {
+        vector<aiVector3D> positions(numSamples);
+        vector<aiQuaternion> rotations(numSamples);
+        vector<aiVector3D> scalings(numSamples);
+        for(size_t i=0; i<numSamples; i++) {
+            double time = std::min(i * step, double(getDurationInSeconds()));
+            positions[i] = getPositionAtTime(channel, time);
+            rotations[i] = getRotationAtTime(channel, time);
+            scalings[i] = getScalingAtTime(channel, time);
+        }
+        channel.positions.swap(positions);
+        channel.rotations.swap(rotations);
+        channel.scalings.swap(scalings);
+    }
+    sampleStep = step;
+}
+
+void ofxAssimpAnimation::clearResampling() {
+    for(auto & channel : channels) {
+        channel.positions.clear();
+        channel.rotations.clear();
+        channel.scalings.clear();
+    }
+    sampleStep = 0;
+}
+
+bool ofxAssimpAnimation::isResampled() {
+    return sampleStep > 0;
+}
+
+void ofxAssimpAnimation::updateAll(const vector<ofxAssimpAnimation*> & animations) {
+    ofParallelFor(0, animations.size(), [&animations](size_t begin, size_t end) {
+        for(size_t i=begin; i<end; i++) {
+            animations[i]->update();
+        }
+    });
 }
 
 void ofxAssimpAnimation::play() {
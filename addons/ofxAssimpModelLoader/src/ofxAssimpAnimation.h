@@ -42,10 +42,40 @@ public:
     void setPosition(float position);
     void setLoopState(ofLoopType state);
     void setSpeed(float speed);
+
+    // bakes every channel into keys sampled at a fixed rate so looking up
+    // a frame is a direct index instead of a search, at the cost of memory.
+    // useful for long clips with lots of keys, eg. mocap.
+    // positions and rotations are interpolated between samples.
+    void resample(float framesPerSecond);
+    void clearResampling();
+    bool isResampled();
+
+    // updates several animations concurrently on the shared ofThreadPool.
+    // animations that drive the same scene (eg. the animations of a single
+    // model) write to the same nodes and can't be updated together, pass
+    // one animation per model instead.
+    static void updateAll(const vector<ofxAssimpAnimation*> & animations);
     
 protected:
     
+    struct Channel {
+        const aiNodeAnim * nodeAnim;
+        aiNode * node;
+        // last key found for each kind of key, updates usually land on the same or the next one.
+        unsigned int positionKey;
+        unsigned int rotationKey;
+        unsigned int scalingKey;
+        // fixed rate samples, empty unless the animation is resampled.
+        vector<aiVector3D> positions;
+        vector<aiQuaternion> rotations;
+        vector<aiVector3D> scalings;
+    };
+
     void updateAnimationNodes();
+    aiVector3D getPositionAtTime(Channel & channel, double time);
+    aiQuaternion getRotationAtTime(Channel & channel, double time);
+    aiVector3D getScalingAtTime(Channel & channel, double time);
     
     shared_ptr<const aiScene> scene;
     aiAnimation * animation;
@@ -60,4 +90,6 @@ protected:
     float durationInSeconds;
     int durationInMilliSeconds;
     float speed;
+    vector<Channel> channels;
+    double sampleStep;
 };
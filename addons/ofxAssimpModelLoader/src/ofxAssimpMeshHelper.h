@@ -13,6 +13,14 @@
 
 struct aiMesh;
 
+// bone influences for one vertex, gathered from the per bone aiVertexWeight
+// lists so skinning can be computed vertex by vertex. vertices with more
+// than 4 influences keep the 4 strongest ones, renormalized.
+struct ofxAssimpVertexWeights {
+    float weights[4];
+    unsigned int bones[4];
+};
+
 class ofxAssimpMeshHelper {
 
 public:
@@ -39,6 +47,10 @@ public:
     vector<aiVector3D> animatedPos;
     vector<aiVector3D> animatedNorm;
 
+    vector<ofxAssimpVertexWeights> vertexWeights;
+    vector<const aiNode*> boneNodes;
+    vector<aiMatrix4x4> boneMatrices;
+
     ofMesh cachedMesh;
     bool validCache;
     
@@ -1,12 +1,100 @@
 #include "ofxAssimpModelLoader.h"
 #include "ofxAssimpUtils.h"
+#include "ofxAssimpSceneCache.h"
 
 #include <assimp/cimport.h>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <assimp/config.h>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define OFX_ASSIMP_SKINNING_SSE
+#endif
+
+namespace{
+    // number of vertices skinned by each job, small meshes are skinned
+    // in one go while big ones get split across the thread pool.
+    const size_t skinningGrainSize = 2048;
+
+    struct SkinningJob{
+        ofxAssimpMeshHelper * meshHelper;
+        size_t begin;
+        size_t end;
+    };
+
+#ifdef OFX_ASSIMP_SKINNING_SSE
+    inline aiVector3D transformSSE(__m128 row0, __m128 row1, __m128 row2, __m128 v){
+        __m128 x = _mm_mul_ps(row0, v);
+        __m128 y = _mm_mul_ps(row1, v);
+        __m128 z = _mm_mul_ps(row2, v);
+        __m128 w = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        float result[4];
+        _mm_storeu_ps(result, _mm_add_ps(_mm_add_ps(x, y), _mm_add_ps(z, w)));
+        return aiVector3D(result[0], result[1], result[2]);
+    }
+#endif
+
+    // blends the (up to) 4 bone matrices of each vertex and transforms
+    // its position and normal, writing only to the range [begin, end)
+    // so several jobs can run on the same mesh concurrently.
+    void skinVertices(ofxAssimpMeshHelper & meshHelper, size_t begin, size_t end){
+        const aiMesh * mesh = meshHelper.mesh;
+        const aiMatrix4x4 * bones = meshHelper.boneMatrices.data();
+        const ofxAssimpVertexWeights * vertexWeights = meshHelper.vertexWeights.data();
+        const aiVector3D * srcPos = mesh->mVertices;
+        const aiVector3D * srcNorm = mesh->HasNormals() ? mesh->mNormals : nullptr;
+        aiVector3D * dstPos = meshHelper.animatedPos.data();
+        aiVector3D * dstNorm = srcNorm ? meshHelper.animatedNorm.data() : nullptr;
+
+        for(size_t v = begin; v < end; ++v){
+            const ofxAssimpVertexWeights & influences = vertexWeights[v];
+#ifdef OFX_ASSIMP_SKINNING_SSE
+            __m128 row0 = _mm_setzero_ps();
+            __m128 row1 = _mm_setzero_ps();
+            __m128 row2 = _mm_setzero_ps();
+            for(int i = 0; i < 4; ++i){
+                const aiMatrix4x4 & m = bones[influences.bones[i]];
+                __m128 weight = _mm_set1_ps(influences.weights[i]);
+                row0 = _mm_add_ps(row0, _mm_mul_ps(weight, _mm_loadu_ps(&m.a1)));
+                row1 = _mm_add_ps(row1, _mm_mul_ps(weight, _mm_loadu_ps(&m.b1)));
+                row2 = _mm_add_ps(row2, _mm_mul_ps(weight, _mm_loadu_ps(&m.c1)));
+            }
+            const aiVector3D & p = srcPos[v];
+            dstPos[v] = transformSSE(row0, row1, row2, _mm_setr_ps(p.x, p.y, p.z, 1.f));
+            if(srcNorm){
+                // w = 0 leaves out the translation, same as using the 3x3 part of the matrix
+                const aiVector3D & n = srcNorm[v];
+                dstNorm[v] = transformSSE(row0, row1, row2, _mm_setr_ps(n.x, n.y, n.z, 0.f));
+            }
+#else
+            float m[12] = {0};
+            for(int i = 0; i < 4; ++i){
+                const float * bone = &bones[influences.bones[i]].a1;
+                float weight = influences.weights[i];
+                for(int j = 0; j < 12; ++j){
+                    m[j] += weight * bone[j];
+                }
+            }
+            const aiVector3D & p = srcPos[v];
+            dstPos[v].Set(m[0] * p.x + m[1] * p.y + m[2]  * p.z + m[3],
+                          m[4] * p.x + m[5] * p.y + m[6]  * p.z + m[7],
+                          m[8] * p.x + m[9] * p.y + m[10] * p.z + m[11]);
+            if(srcNorm){
+                const aiVector3D & n = srcNorm[v];
+                dstNorm[v].Set(m[0] * n.x + m[1] * n.y + m[2]  * n.z,
+                               m[4] * n.x + m[5] * n.y + m[6]  * n.z,
+                               m[8] * n.x + m[9] * n.y + m[10] * n.z);
+            }
+#endif
+        }
+    }
+}
+
 ofxAssimpModelLoader::ofxAssimpModelLoader(){
+	bUsingSceneCache = false;
+	bSceneFromCache = false;
 	clear();
 }
 
@@ -36,8 +124,23 @@ bool ofxAssimpModelLoader::loadModel(string modelName, bool optimize){
     // sets various properties & flags to a default preference
     unsigned int flags = initImportProperties(optimize);
     
-    // loads scene from file
-    scene = shared_ptr<const aiScene>(aiImportFileExWithProperties(file.getAbsolutePath().c_str(), flags, NULL, store.get()), aiReleaseImport);
+    string cachePath;
+    uint64_t sourceHash = 0;
+    if(bUsingSceneCache){
+        sourceHash = ofxAssimpSceneCache::hash(ofBufferFromFile(file.getAbsolutePath(), true));
+        cachePath = ofxAssimpSceneCache::getCachePath(sceneCacheFolder, file.getFileName(), sourceHash, flags);
+        scene = ofxAssimpSceneCache::load(cachePath, sourceHash, flags);
+    }
+    bSceneFromCache = bool(scene);
+    
+    if(!scene){
+        // loads scene from file
+        scene = shared_ptr<const aiScene>(aiImportFileExWithProperties(file.getAbsolutePath().c_str(), flags, NULL, store.get()), aiReleaseImport);
+        // the cache has to be written before processScene, updating the animations modifies the nodes.
+        if(scene && bUsingSceneCache){
+            ofxAssimpSceneCache::save(scene.get(), cachePath, sourceHash, flags);
+        }
+    }
     
     bool bOk = processScene();
     return bOk;
@@ -59,6 +162,7 @@ bool ofxAssimpModelLoader::loadModel(ofBuffer & buffer, bool optimize, const cha
     unsigned int flags = initImportProperties(optimize);
     
     // loads scene from memory buffer - note this will not work for multipart files (obj, md3, etc)
+    bSceneFromCache = false;
     scene = shared_ptr<const aiScene>(aiImportFileFromMemoryWithProperties(buffer.getData(), buffer.size(), flags, extension, store.get()), aiReleaseImport);
     
     bool bOk = processScene();
@@ -167,6 +271,10 @@ void ofxAssimpModelLoader::createLightsFromAiModel(){
 }
 
 void ofxAssimpModelLoader::optimizeScene(){
+	if(bSceneFromCache){
+		ofLogWarning("ofxAssimpModelLoader") << "optimizeScene(): can't optimize a scene loaded from the scene cache, load the model with optimize = true instead";
+		return;
+	}
 	aiApplyPostProcessing(scene.get(),aiProcess_ImproveCacheLocality | aiProcess_OptimizeGraph |
 			aiProcess_OptimizeMeshes | aiProcess_JoinIdenticalVertices |
 			aiProcess_RemoveRedundantMaterials);
@@ -297,6 +405,7 @@ void ofxAssimpModelLoader::loadGLResources(){
 			if(mesh->HasNormals()){
 				meshHelper.animatedNorm.resize(mesh->mNumVertices);
 			}
+			setupVertexWeights(meshHelper);
         }
 
 
@@ -365,6 +474,7 @@ void ofxAssimpModelLoader::clear(){
     bUsingNormals = true;
     bUsingTextures = true;
     bUsingColors = true;
+    bUsingThreadedSkinning = true;
 
     currentAnimation = -1;
 
@@ -412,66 +522,106 @@ void ofxAssimpModelLoader::updateMeshes(aiNode * node, ofMatrix4x4 parentMatrix)
     }
 }
 
+void ofxAssimpModelLoader::setupVertexWeights(ofxAssimpMeshHelper & meshHelper){
+	const aiMesh * mesh = meshHelper.mesh;
+
+	// look up the bone nodes once instead of searching the hierarchy every frame
+	meshHelper.boneNodes.resize(mesh->mNumBones);
+	meshHelper.boneMatrices.resize(mesh->mNumBones);
+	for(unsigned int a=0; a<mesh->mNumBones; ++a) {
+		meshHelper.boneNodes[a] = scene->mRootNode->FindNode(mesh->mBones[a]->mName);
+	}
+
+	// turn the per bone weight lists into up to 4 influences per vertex
+	ofxAssimpVertexWeights noWeights = {{0, 0, 0, 0}, {0, 0, 0, 0}};
+	meshHelper.vertexWeights.assign(mesh->mNumVertices, noWeights);
+	vector<float> totalWeights(mesh->mNumVertices, 0.f);
+	vector<unsigned int> numInfluences(mesh->mNumVertices, 0);
+	for(unsigned int a=0; a<mesh->mNumBones; ++a) {
+		const aiBone* bone = mesh->mBones[a];
+		for(unsigned int b=0; b<bone->mNumWeights; ++b) {
+			const aiVertexWeight& weight = bone->mWeights[b];
+			ofxAssimpVertexWeights & influences = meshHelper.vertexWeights[weight.mVertexId];
+			int weakest = 0;
+			for(int i=1; i<4; ++i) {
+				if(influences.weights[i] < influences.weights[weakest]) {
+					weakest = i;
+				}
+			}
+			if(weight.mWeight > influences.weights[weakest]) {
+				influences.weights[weakest] = weight.mWeight;
+				influences.bones[weakest] = a;
+			}
+			totalWeights[weight.mVertexId] += weight.mWeight;
+			numInfluences[weight.mVertexId]++;
+		}
+	}
+
+	size_t numTruncated = 0;
+	for(size_t v=0; v<meshHelper.vertexWeights.size(); ++v) {
+		if(numInfluences[v] <= 4) {
+			continue;
+		}
+		ofxAssimpVertexWeights & influences = meshHelper.vertexWeights[v];
+		float keptWeight = influences.weights[0] + influences.weights[1] + influences.weights[2] + influences.weights[3];
+		if(keptWeight > 0) {
+			float normalize = totalWeights[v] / keptWeight;
+			for(int i=0; i<4; ++i) {
+				influences.weights[i] *= normalize;
+			}
+		}
+		numTruncated++;
+	}
+	if(numTruncated > 0) {
+		ofLogVerbose("ofxAssimpModelLoader") << "setupVertexWeights(): " << numTruncated
+			<< " vertices in mesh \"" << mesh->mName.data << "\" have more than 4 bone influences, keeping the 4 strongest";
+	}
+}
+
 void ofxAssimpModelLoader::updateBones() {
     if (!hasAnimations()){
         return;
     }
-    // update mesh position for the animation
+	vector<SkinningJob> jobs;
 	for(unsigned int i=0; i<modelMeshes.size(); ++i) {
 		// current mesh we are introspecting
-		const aiMesh* mesh = modelMeshes[i].mesh;
-        
+		ofxAssimpMeshHelper & meshHelper = modelMeshes[i];
+		const aiMesh* mesh = meshHelper.mesh;
+		if(mesh->mNumBones == 0) {
+			continue;
+		}
+
 		// calculate bone matrices
-		vector<aiMatrix4x4> boneMatrices(mesh->mNumBones);
 		for(unsigned int a=0; a<mesh->mNumBones; ++a) {
-			const aiBone* bone = mesh->mBones[a];
-            
-			// find the corresponding node by again looking recursively through the node hierarchy for the same name
-			aiNode* node = scene->mRootNode->FindNode(bone->mName);
-            
 			// start with the mesh-to-bone matrix
-			boneMatrices[a] = bone->mOffsetMatrix;
+			aiMatrix4x4 & boneMatrix = meshHelper.boneMatrices[a];
+			boneMatrix = mesh->mBones[a]->mOffsetMatrix;
 			// and now append all node transformations down the parent chain until we're back at mesh coordinates again
-			const aiNode* tempNode = node;
+			const aiNode* tempNode = meshHelper.boneNodes[a];
 			while(tempNode) {
-				// check your matrix multiplication order here!!!
-				boneMatrices[a] = tempNode->mTransformation * boneMatrices[a];
-				// boneMatrices[a] = boneMatrices[a] * tempNode->mTransformation;
+				boneMatrix = tempNode->mTransformation * boneMatrix;
 				tempNode = tempNode->mParent;
 			}
-			modelMeshes[i].hasChanged = true;
-			modelMeshes[i].validCache = false;
 		}
-        
-		modelMeshes[i].animatedPos.assign(modelMeshes[i].animatedPos.size(), aiVector3D(0.0f));
-		if(mesh->HasNormals()){
-			modelMeshes[i].animatedNorm.assign(modelMeshes[i].animatedNorm.size(), aiVector3D(0.0f));
+		meshHelper.hasChanged = true;
+		meshHelper.validCache = false;
+
+		for(size_t begin=0; begin<mesh->mNumVertices; begin+=skinningGrainSize) {
+			SkinningJob job = {&meshHelper, begin, std::min<size_t>(begin + skinningGrainSize, mesh->mNumVertices)};
+			jobs.push_back(job);
 		}
-		// loop through all vertex weights of all bones
-		for(unsigned int a=0; a<mesh->mNumBones; ++a) {
-			const aiBone* bone = mesh->mBones[a];
-			const aiMatrix4x4& posTrafo = boneMatrices[a];
-            
-			for(unsigned int b=0; b<bone->mNumWeights; ++b) {
-				const aiVertexWeight& weight = bone->mWeights[b];
-                
-				size_t vertexId = weight.mVertexId;
-				const aiVector3D& srcPos = mesh->mVertices[vertexId];
-                
-				modelMeshes[i].animatedPos[vertexId] += weight.mWeight * (posTrafo * srcPos);
-			}
-			if(mesh->HasNormals()){
-				// 3x3 matrix, contains the bone matrix without the translation, only with rotation and possibly scaling
-				aiMatrix3x3 normTrafo = aiMatrix3x3( posTrafo);
-				for(unsigned int b=0; b<bone->mNumWeights; ++b) {
-					const aiVertexWeight& weight = bone->mWeights[b];
-					size_t vertexId = weight.mVertexId;
-                    
-					const aiVector3D& srcNorm = mesh->mNormals[vertexId];
-					modelMeshes[i].animatedNorm[vertexId] += weight.mWeight * (normTrafo * srcNorm);
-				}
-			}
+	}
+
+	// every job writes a disjoint range of vertices so they can run in any order
+	auto skinJobs = [&jobs](size_t begin, size_t end) {
+		for(size_t j=begin; j<end; ++j) {
+			skinVertices(*jobs[j].meshHelper, jobs[j].begin, jobs[j].end);
 		}
+	};
+	if(bUsingThreadedSkinning) {
+		ofParallelFor(0, jobs.size(), skinJobs);
+	} else {
+		skinJobs(0, jobs.size());
 	}
 }
 
@@ -554,6 +704,12 @@ void ofxAssimpModelLoader::setPositionForAllAnimations(float position) {
     }
 }
 
+void ofxAssimpModelLoader::resampleAllAnimations(float framesPerSecond) {
+    for(unsigned int i=0; i<animations.size(); i++) {
+        animations[i].resample(framesPerSecond);
+    }
+}
+
 // DEPRECATED.
 void ofxAssimpModelLoader::setAnimation(int animationIndex) {
     if(!hasAnimations()) {
@@ -1039,3 +1195,24 @@ void ofxAssimpModelLoader::disableColors(){
 void ofxAssimpModelLoader::disableMaterials(){
 	bUsingMaterials = false;
 }
+
+//--------------------------------------------------------------
+void ofxAssimpModelLoader::enableThreadedSkinning(){
+	bUsingThreadedSkinning = true;
+}
+
+//--------------------------------------------------------------
+void ofxAssimpModelLoader::disableThreadedSkinning(){
+	bUsingThreadedSkinning = false;
+}
+
+//--------------------------------------------------------------
+void ofxAssimpModelLoader::enableSceneCache(string cacheFolder){
+	bUsingSceneCache = true;
+	sceneCacheFolder = cacheFolder;
+}
+
+//--------------------------------------------------------------
+void ofxAssimpModelLoader::disableSceneCache(){
+	bUsingSceneCache = false;
+}
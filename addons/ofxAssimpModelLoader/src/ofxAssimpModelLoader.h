@@ -31,7 +31,17 @@ class ofxAssimpModelLoader{
         bool loadModel(string modelName, bool optimize=false);
         bool loadModel(ofBuffer & buffer, bool optimize=false, const char * extension="");
         void createEmptyModel();
+
+        // keeps a binary copy of every model loaded from a file in cacheFolder,
+        // so loading the same file with the same settings again skips the
+        // assimp import and post-processing. see ofxAssimpSceneCache.
+        void enableSceneCache(string cacheFolder = "assimp_cache");
+        void disableSceneCache();
         void createLightsFromAiModel();
+
+        // runs assimp's optimization steps on the loaded scene. scenes loaded
+        // from the scene cache weren't created by assimp's importer and can't
+        // be post-processed, load them with optimize = true instead.
         void optimizeScene();
 
         void update();
@@ -45,6 +55,7 @@ class ofxAssimpModelLoader{
         void setPausedForAllAnimations(bool pause);
         void setLoopStateForAllAnimations(ofLoopType state);
         void setPositionForAllAnimations(float position);
+        void resampleAllAnimations(float framesPerSecond);
         OF_DEPRECATED_MSG("Use ofxAssimpAnimation instead", void setAnimation(int animationIndex));
         OF_DEPRECATED_MSG("Use ofxAssimpAnimation instead", void setNormalizedTime(float time));
         OF_DEPRECATED_MSG("Use ofxAssimpAnimation instead", void setTime(float time));
@@ -93,6 +104,11 @@ class ofxAssimpModelLoader{
     	void disableColors();
     	void disableMaterials();
 
+    	// skinning of animated meshes is split across the shared ofThreadPool
+    	// by default, disable it to skin every mesh in the calling thread.
+    	void enableThreadedSkinning();
+    	void disableThreadedSkinning();
+
         void draw(ofPolyRenderMode renderType);
 		
 		ofPoint getPosition();
@@ -116,6 +132,7 @@ class ofxAssimpModelLoader{
         void updateAnimations();
         void updateMeshes(aiNode * node, ofMatrix4x4 parentMatrix);
         void updateBones();
+        void setupVertexWeights(ofxAssimpMeshHelper & meshHelper);
         void updateModelMatrix();
     
         // ai scene setup
@@ -154,6 +171,10 @@ class ofxAssimpModelLoader{
         bool bUsingNormals;
         bool bUsingColors;
         bool bUsingMaterials;
+        bool bUsingThreadedSkinning;
+        bool bUsingSceneCache;
+        bool bSceneFromCache;
+        string sceneCacheFolder;
         float normalizeFactor;
 
         // the main Asset Import scene that does the magic.
@@ -0,0 +1,693 @@
+//
+//  ofxAssimpSceneCache.cpp
+//
+
+#include "ofxAssimpSceneCache.h"
+
+#include <assimp/scene.h>
+
+namespace{
+    const char magic[8] = {'O','F','X','A','S','S','C','N'};
+    const uint32_t version = 2;
+
+    // cache files are written and read on the same machine, this only
+    // protects against reading files written by a build with a different
+    // layout for the assimp types that are copied as raw memory.
+    const uint32_t layout = sizeof(aiVector3D) | (sizeof(aiVectorKey) << 8) | (sizeof(aiQuatKey) << 16) | (sizeof(aiMatrix4x4) << 24);
+
+    const size_t alignment = 16;
+    const int maxNodeDepth = 1024;
+
+    class Writer {
+    public:
+        template<typename T>
+        void write(const T & value) {
+            buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void write(const aiString & str) {
+            write(uint32_t(str.length));
+            buffer.append(str.data, str.length);
+        }
+
+        template<typename T>
+        void writeArray(const T * data, size_t count) {
+            align();
+            if(count > 0) {
+                buffer.append(reinterpret_cast<const char*>(data), count * sizeof(T));
+            }
+        }
+
+        void align() {
+            static const char zeros[alignment] = {0};
+            buffer.append(zeros, (alignment - buffer.size() % alignment) % alignment);
+        }
+
+        ofBuffer buffer;
+    };
+
+    class Reader {
+    public:
+        Reader(const ofBuffer & buffer)
+        :data(buffer.getData())
+        ,size(buffer.size())
+        ,pos(0){}
+
+        template<typename T>
+        bool read(T & value) {
+            if(size - pos < sizeof(T)) {
+                return false;
+            }
+            memcpy(&value, data + pos, sizeof(T));
+            pos += sizeof(T);
+            return true;
+        }
+
+        bool read(aiString & str) {
+            uint32_t length;
+            if(!read(length) || length >= MAXLEN || size - pos < length) {
+                return false;
+            }
+            str.length = length;
+            memcpy(str.data, data + pos, length);
+            str.data[length] = '\0';
+            pos += length;
+            return true;
+        }
+
+        // reads count bytes into an array of T big enough to hold them,
+        // for arrays that can store data of a different type
+        template<typename T>
+        bool readArrayBytes(T * & array, size_t count) {
+            array = nullptr;
+            pos = std::min(size, (pos + alignment - 1) / alignment * alignment);
+            if(count == 0) {
+                return true;
+            }
+            if(size - pos < count) {
+                return false;
+            }
+            array = new T[(count + sizeof(T) - 1) / sizeof(T)]();
+            memcpy(array, data + pos, count);
+            pos += count;
+            return true;
+        }
+
+        bool readBytes(vector<char> & bytes, size_t count) {
+            if(size - pos < count) {
+                return false;
+            }
+            bytes.assign(data + pos, data + pos + count);
+            pos += count;
+            return true;
+        }
+
+        // allocates with new[] since the assimp destructors delete[] the arrays
+        template<typename T>
+        bool readArray(T * & array, size_t count) {
+            array = nullptr;
+            pos = std::min(size, (pos + alignment - 1) / alignment * alignment);
+            if(count == 0) {
+                return true;
+            }
+            if((size - pos) / sizeof(T) < count) {
+                return false;
+            }
+            array = new T[count];
+            memcpy(array, data + pos, count * sizeof(T));
+            pos += count * sizeof(T);
+            return true;
+        }
+
+        // every element takes at least a few bytes in the file, used to
+        // reject corrupt counts before allocating.
+        bool canHold(size_t count, size_t minBytes = 4) {
+            return count <= (size - pos) / minBytes;
+        }
+
+        bool atEnd() const {
+            return pos == size;
+        }
+
+    private:
+        const char * data;
+        size_t size;
+        size_t pos;
+    };
+
+    //--------------------------------------------------------------
+    void writeNode(Writer & writer, const aiNode * node) {
+        writer.write(node->mName);
+        writer.write(node->mTransformation);
+        writer.write(uint32_t(node->mNumMeshes));
+        writer.writeArray(node->mMeshes, node->mNumMeshes);
+        writer.write(uint32_t(node->mNumChildren));
+        for(unsigned int i=0; i<node->mNumChildren; i++) {
+            writeNode(writer, node->mChildren[i]);
+        }
+    }
+
+    void writeMesh(Writer & writer, const aiMesh * mesh) {
+        writer.write(mesh->mName);
+        writer.write(uint32_t(mesh->mPrimitiveTypes));
+        writer.write(uint32_t(mesh->mMaterialIndex));
+        writer.write(uint32_t(mesh->mNumVertices));
+        writer.writeArray(mesh->mVertices, mesh->mNumVertices);
+
+        writer.write(uint8_t(mesh->HasNormals()));
+        if(mesh->HasNormals()) {
+            writer.writeArray(mesh->mNormals, mesh->mNumVertices);
+        }
+        writer.write(uint8_t(mesh->HasTangentsAndBitangents()));
+        if(mesh->HasTangentsAndBitangents()) {
+            writer.writeArray(mesh->mTangents, mesh->mNumVertices);
+            writer.writeArray(mesh->mBitangents, mesh->mNumVertices);
+        }
+        writer.write(uint32_t(AI_MAX_NUMBER_OF_TEXTURECOORDS));
+        for(unsigned int i=0; i<AI_MAX_NUMBER_OF_TEXTURECOORDS; i++) {
+            writer.write(uint8_t(mesh->HasTextureCoords(i)));
+            if(mesh->HasTextureCoords(i)) {
+                writer.write(uint32_t(mesh->mNumUVComponents[i]));
+                writer.writeArray(mesh->mTextureCoords[i], mesh->mNumVertices);
+            }
+        }
+        writer.write(uint32_t(AI_MAX_NUMBER_OF_COLOR_SETS));
+        for(unsigned int i=0; i<AI_MAX_NUMBER_OF_COLOR_SETS; i++) {
+            writer.write(uint8_t(mesh->HasVertexColors(i)));
+            if(mesh->HasVertexColors(i)) {
+                writer.writeArray(mesh->mColors[i], mesh->mNumVertices);
+            }
+        }
+
+        // faces as a list of index counts followed by all the indices
+        vector<uint32_t> faceSizes(mesh->mNumFaces);
+        vector<uint32_t> indices;
+        indices.reserve(mesh->mNumFaces * 3);
+        for(unsigned int i=0; i<mesh->mNumFaces; i++) {
+            const aiFace & face = mesh->mFaces[i];
+            faceSizes[i] = face.mNumIndices;
+            indices.insert(indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+        }
+        writer.write(uint32_t(mesh->mNumFaces));
+        writer.writeArray(faceSizes.data(), faceSizes.size());
+        writer.write(uint32_t(indices.size()));
+        writer.writeArray(indices.data(), indices.size());
+
+        writer.write(uint32_t(mesh->mNumBones));
+        for(unsigned int i=0; i<mesh->mNumBones; i++) {
+            const aiBone * bone = mesh->mBones[i];
+            writer.write(bone->mName);
+            writer.write(bone->mOffsetMatrix);
+            writer.write(uint32_t(bone->mNumWeights));
+            writer.writeArray(bone->mWeights, bone->mNumWeights);
+        }
+    }
+
+    void writeMaterial(Writer & writer, const aiMaterial * material) {
+        writer.write(uint32_t(material->mNumProperties));
+        for(unsigned int i=0; i<material->mNumProperties; i++) {
+            const aiMaterialProperty * property = material->mProperties[i];
+            writer.write(property->mKey);
+            writer.write(uint32_t(property->mSemantic));
+            writer.write(uint32_t(property->mIndex));
+            writer.write(uint32_t(property->mType));
+            writer.write(uint32_t(property->mDataLength));
+            writer.buffer.append(property->mData, property->mDataLength);
+        }
+    }
+
+    void writeLight(Writer & writer, const aiLight * light) {
+        writer.write(light->mName);
+        writer.write(uint32_t(light->mType));
+        writer.write(light->mPosition);
+        writer.write(light->mDirection);
+        writer.write(light->mAttenuationConstant);
+        writer.write(light->mAttenuationLinear);
+        writer.write(light->mAttenuationQuadratic);
+        writer.write(light->mColorDiffuse);
+        writer.write(light->mColorSpecular);
+        writer.write(light->mColorAmbient);
+        writer.write(light->mAngleInnerCone);
+        writer.write(light->mAngleOuterCone);
+    }
+
+    void writeCamera(Writer & writer, const aiCamera * camera) {
+        writer.write(camera->mName);
+        writer.write(camera->mPosition);
+        writer.write(camera->mUp);
+        writer.write(camera->mLookAt);
+        writer.write(camera->mHorizontalFOV);
+        writer.write(camera->mClipPlaneNear);
+        writer.write(camera->mClipPlaneFar);
+        writer.write(camera->mAspect);
+    }
+
+    // embedded textures are either mWidth * mHeight texels or, when
+    // mHeight is 0, a compressed image file of mWidth bytes
+    size_t getTextureBytes(const aiTexture * texture) {
+        if(texture->mHeight == 0) {
+            return texture->mWidth;
+        }
+        return size_t(texture->mWidth) * texture->mHeight * sizeof(aiTexel);
+    }
+
+    void writeTexture(Writer & writer, const aiTexture * texture) {
+        writer.write(uint32_t(texture->mWidth));
+        writer.write(uint32_t(texture->mHeight));
+        writer.write(texture->achFormatHint);
+        writer.writeArray(reinterpret_cast<const char*>(texture->pcData), getTextureBytes(texture));
+    }
+
+    void writeAnimation(Writer & writer, const aiAnimation * animation) {
+        writer.write(animation->mName);
+        writer.write(animation->mDuration);
+        writer.write(animation->mTicksPerSecond);
+        writer.write(uint32_t(animation->mNumChannels));
+        for(unsigned int i=0; i<animation->mNumChannels; i++) {
+            const aiNodeAnim * channel = animation->mChannels[i];
+            writer.write(channel->mNodeName);
+            writer.write(uint32_t(channel->mPreState));
+            writer.write(uint32_t(channel->mPostState));
+            writer.write(uint32_t(channel->mNumPositionKeys));
+            writer.writeArray(channel->mPositionKeys, channel->mNumPositionKeys);
+            writer.write(uint32_t(channel->mNumRotationKeys));
+            writer.writeArray(channel->mRotationKeys, channel->mNumRotationKeys);
+            writer.write(uint32_t(channel->mNumScalingKeys));
+            writer.writeArray(channel->mScalingKeys, channel->mNumScalingKeys);
+        }
+    }
+
+    //--------------------------------------------------------------
+    // the read functions attach every object to its parent as soon as it's
+    // allocated, so if reading fails half way deleting the scene frees everything.
+    bool readNode(Reader & reader, aiNode * node, int depth) {
+        uint32_t numMeshes, numChildren;
+        if(depth > maxNodeDepth
+           || !reader.read(node->mName)
+           || !reader.read(node->mTransformation)
+           || !reader.read(numMeshes)
+           || !reader.readArray(node->mMeshes, numMeshes)) {
+            return false;
+        }
+        node->mNumMeshes = numMeshes;
+        if(!reader.read(numChildren) || !reader.canHold(numChildren)) {
+            return false;
+        }
+        if(numChildren > 0) {
+            node->mChildren = new aiNode*[numChildren]();
+            node->mNumChildren = numChildren;
+            for(unsigned int i=0; i<numChildren; i++) {
+                node->mChildren[i] = new aiNode();
+                node->mChildren[i]->mParent = node;
+                if(!readNode(reader, node->mChildren[i], depth + 1)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool readMesh(Reader & reader, aiMesh * mesh) {
+        uint32_t primitiveTypes, materialIndex, numVertices;
+        uint8_t hasNormals, hasTangents;
+        if(!reader.read(mesh->mName)
+           || !reader.read(primitiveTypes)
+           || !reader.read(materialIndex)
+           || !reader.read(numVertices)
+           || !reader.readArray(mesh->mVertices, numVertices)) {
+            return false;
+        }
+        mesh->mPrimitiveTypes = primitiveTypes;
+        mesh->mMaterialIndex = materialIndex;
+        mesh->mNumVertices = numVertices;
+
+        if(!reader.read(hasNormals) || (hasNormals && !reader.readArray(mesh->mNormals, numVertices))) {
+            return false;
+        }
+        if(!reader.read(hasTangents)) {
+            return false;
+        }
+        if(hasTangents && (!reader.readArray(mesh->mTangents, numVertices) || !reader.readArray(mesh->mBitangents, numVertices))) {
+            return false;
+        }
+        uint32_t numTexCoordChannels;
+        if(!reader.read(numTexCoordChannels) || numTexCoordChannels > AI_MAX_NUMBER_OF_TEXTURECOORDS) {
+            return false;
+        }
+        for(unsigned int i=0; i<numTexCoordChannels; i++) {
+            uint8_t hasTexCoords;
+            if(!reader.read(hasTexCoords)) {
+                return false;
+            }
+            if(hasTexCoords) {
+                uint32_t numComponents;
+                if(!reader.read(numComponents) || numComponents > 3 || !reader.readArray(mesh->mTextureCoords[i], numVertices)) {
+                    return false;
+                }
+                mesh->mNumUVComponents[i] = numComponents;
+            }
+        }
+        uint32_t numColorChannels;
+        if(!reader.read(numColorChannels) || numColorChannels > AI_MAX_NUMBER_OF_COLOR_SETS) {
+            return false;
+        }
+        for(unsigned int i=0; i<numColorChannels; i++) {
+            uint8_t hasColors;
+            if(!reader.read(hasColors) || (hasColors && !reader.readArray(mesh->mColors[i], numVertices))) {
+                return false;
+            }
+        }
+
+        uint32_t numFaces, numIndices;
+        uint32_t * faceSizes = nullptr;
+        uint32_t * indices = nullptr;
+        if(!reader.read(numFaces) || !reader.readArray(faceSizes, numFaces)) {
+            return false;
+        }
+        unique_ptr<uint32_t[]> faceSizesOwner(faceSizes);
+        if(!reader.read(numIndices) || !reader.readArray(indices, numIndices)) {
+            return false;
+        }
+        unique_ptr<uint32_t[]> indicesOwner(indices);
+        if(numFaces > 0) {
+            mesh->mFaces = new aiFace[numFaces];
+            mesh->mNumFaces = numFaces;
+            uint32_t offset = 0;
+            for(unsigned int i=0; i<numFaces; i++) {
+                if(faceSizes[i] > numIndices - offset) {
+                    return false;
+                }
+                aiFace & face = mesh->mFaces[i];
+                face.mNumIndices = faceSizes[i];
+                face.mIndices = new unsigned int[face.mNumIndices];
+                memcpy(face.mIndices, indices + offset, face.mNumIndices * sizeof(unsigned int));
+                offset += face.mNumIndices;
+            }
+        }
+
+        uint32_t numBones;
+        if(!reader.read(numBones) || !reader.canHold(numBones)) {
+            return false;
+        }
+        if(numBones > 0) {
+            mesh->mBones = new aiBone*[numBones]();
+            mesh->mNumBones = numBones;
+            for(unsigned int i=0; i<numBones; i++) {
+                aiBone * bone = mesh->mBones[i] = new aiBone();
+                uint32_t numWeights;
+                if(!reader.read(bone->mName)
+                   || !reader.read(bone->mOffsetMatrix)
+                   || !reader.read(numWeights)
+                   || !reader.readArray(bone->mWeights, numWeights)) {
+                    return false;
+                }
+                bone->mNumWeights = numWeights;
+            }
+        }
+        return true;
+    }
+
+    bool readMaterial(Reader & reader, aiMaterial * material) {
+        uint32_t numProperties;
+        if(!reader.read(numProperties) || !reader.canHold(numProperties)) {
+            return false;
+        }
+        vector<char> data;
+        for(unsigned int i=0; i<numProperties; i++) {
+            aiString key;
+            uint32_t semantic, index, type, length;
+            if(!reader.read(key)
+               || !reader.read(semantic)
+               || !reader.read(index)
+               || !reader.read(type)
+               || !reader.read(length)
+               || !reader.readBytes(data, length)) {
+                return false;
+            }
+            material->AddBinaryProperty(data.data(), length, key.C_Str(), semantic, index, aiPropertyTypeInfo(type));
+        }
+        return true;
+    }
+
+    bool readLight(Reader & reader, aiLight * light) {
+        uint32_t type;
+        if(!reader.read(light->mName) || !reader.read(type)) {
+            return false;
+        }
+        light->mType = aiLightSourceType(type);
+        return reader.read(light->mPosition)
+            && reader.read(light->mDirection)
+            && reader.read(light->mAttenuationConstant)
+            && reader.read(light->mAttenuationLinear)
+            && reader.read(light->mAttenuationQuadratic)
+            && reader.read(light->mColorDiffuse)
+            && reader.read(light->mColorSpecular)
+            && reader.read(light->mColorAmbient)
+            && reader.read(light->mAngleInnerCone)
+            && reader.read(light->mAngleOuterCone);
+    }
+
+    bool readCamera(Reader & reader, aiCamera * camera) {
+        return reader.read(camera->mName)
+            && reader.read(camera->mPosition)
+            && reader.read(camera->mUp)
+            && reader.read(camera->mLookAt)
+            && reader.read(camera->mHorizontalFOV)
+            && reader.read(camera->mClipPlaneNear)
+            && reader.read(camera->mClipPlaneFar)
+            && reader.read(camera->mAspect);
+    }
+
+    bool readTexture(Reader & reader, aiTexture * texture) {
+        uint32_t width, height;
+        if(!reader.read(width)
+           || !reader.read(height)
+           || !reader.read(texture->achFormatHint)) {
+            return false;
+        }
+        texture->mWidth = width;
+        texture->mHeight = height;
+        size_t bytes = getTextureBytes(texture);
+        if(height != 0 && bytes / sizeof(aiTexel) / height != width) {
+            return false;
+        }
+        return reader.readArrayBytes(texture->pcData, bytes);
+    }
+
+    bool readAnimation(Reader & reader, aiAnimation * animation) {
+        uint32_t numChannels;
+        if(!reader.read(animation->mName)
+           || !reader.read(animation->mDuration)
+           || !reader.read(animation->mTicksPerSecond)
+           || !reader.read(numChannels)
+           || !reader.canHold(numChannels)) {
+            return false;
+        }
+        if(numChannels > 0) {
+            animation->mChannels = new aiNodeAnim*[numChannels]();
+            animation->mNumChannels = numChannels;
+            for(unsigned int i=0; i<numChannels; i++) {
+                aiNodeAnim * channel = animation->mChannels[i] = new aiNodeAnim();
+                uint32_t preState, postState, numPositionKeys, numRotationKeys, numScalingKeys;
+                if(!reader.read(channel->mNodeName)
+                   || !reader.read(preState)
+                   || !reader.read(postState)
+                   || !reader.read(numPositionKeys)
+                   || !reader.readArray(channel->mPositionKeys, numPositionKeys)) {
+                    return false;
+                }
+                channel->mNumPositionKeys = numPositionKeys;
+                if(!reader.read(numRotationKeys) || !reader.readArray(channel->mRotationKeys, numRotationKeys)) {
+                    return false;
+                }
+                channel->mNumRotationKeys = numRotationKeys;
+                if(!reader.read(numScalingKeys) || !reader.readArray(channel->mScalingKeys, numScalingKeys)) {
+                    return false;
+                }
+                channel->mNumScalingKeys = numScalingKeys;
+                channel->mPreState = aiAnimBehaviour(preState);
+                channel->mPostState = aiAnimBehaviour(postState);
+            }
+        }
+        return true;
+    }
+
+    // indices that the loader uses without checking, a corrupt file
+    // could otherwise make it read out of bounds.
+    bool validateNode(const aiNode * node, unsigned int numMeshes) {
+        for(unsigned int i=0; i<node->mNumMeshes; i++) {
+            if(node->mMeshes[i] >= numMeshes) {
+                return false;
+            }
+        }
+        for(unsigned int i=0; i<node->mNumChildren; i++) {
+            if(!validateNode(node->mChildren[i], numMeshes)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool validate(const aiScene * scene) {
+        for(unsigned int i=0; i<scene->mNumMeshes; i++) {
+            const aiMesh * mesh = scene->mMeshes[i];
+            if(mesh->mMaterialIndex >= scene->mNumMaterials) {
+                return false;
+            }
+            for(unsigned int j=0; j<mesh->mNumFaces; j++) {
+                for(unsigned int k=0; k<mesh->mFaces[j].mNumIndices; k++) {
+                    if(mesh->mFaces[j].mIndices[k] >= mesh->mNumVertices) {
+                        return false;
+                    }
+                }
+            }
+            for(unsigned int j=0; j<mesh->mNumBones; j++) {
+                const aiBone * bone = mesh->mBones[j];
+                for(unsigned int k=0; k<bone->mNumWeights; k++) {
+                    if(bone->mWeights[k].mVertexId >= mesh->mNumVertices) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return validateNode(scene->mRootNode, scene->mNumMeshes);
+    }
+
+    template<typename T>
+    bool readObjects(Reader & reader, T ** & objects, unsigned int & numObjects, bool (*readObject)(Reader &, T *)) {
+        uint32_t count;
+        if(!reader.read(count) || !reader.canHold(count)) {
+            return false;
+        }
+        if(count > 0) {
+            objects = new T*[count]();
+            numObjects = count;
+            for(unsigned int i=0; i<count; i++) {
+                objects[i] = new T();
+                if(!readObject(reader, objects[i])) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+//--------------------------------------------------------------
+uint64_t ofxAssimpSceneCache::hash(const ofBuffer & buffer) {
+    uint64_t hash = 14695981039346656037ULL;
+    const unsigned char * data = reinterpret_cast<const unsigned char*>(buffer.getData());
+    for(size_t i=0; i<buffer.size(); i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+//--------------------------------------------------------------
+string ofxAssimpSceneCache::getCachePath(const string & cacheFolder, const string & sourceName, uint64_t sourceHash, unsigned int flags) {
+    string fileName = ofFilePath::getFileName(sourceName) + "_" + ofToHex(sourceHash) + "_" + ofToHex(uint32_t(flags)) + ".ofxassimp";
+    return ofFilePath::join(cacheFolder, fileName);
+}
+
+//--------------------------------------------------------------
+bool ofxAssimpSceneCache::save(const aiScene * scene, const string & path, uint64_t sourceHash, unsigned int flags) {
+    if(scene == NULL || scene->mRootNode == NULL) {
+        return false;
+    }
+    // morph targets aren't stored, caching the scene would lose them
+    for(unsigned int i=0; i<scene->mNumMeshes; i++) {
+        if(scene->mMeshes[i]->mNumAnimMeshes > 0) {
+            ofLogNotice("ofxAssimpSceneCache") << "save(): not caching \"" << path << "\", its meshes have animation meshes";
+            return false;
+        }
+    }
+
+    Writer writer;
+    writer.buffer.append(magic, sizeof(magic));
+    writer.write(version);
+    writer.write(layout);
+    writer.write(sourceHash);
+    writer.write(uint32_t(flags));
+    writer.write(uint32_t(scene->mFlags));
+
+    writeNode(writer, scene->mRootNode);
+    writer.write(uint32_t(scene->mNumMeshes));
+    for(unsigned int i=0; i<scene->mNumMeshes; i++) {
+        writeMesh(writer, scene->mMeshes[i]);
+    }
+    writer.write(uint32_t(scene->mNumMaterials));
+    for(unsigned int i=0; i<scene->mNumMaterials; i++) {
+        writeMaterial(writer, scene->mMaterials[i]);
+    }
+    writer.write(uint32_t(scene->mNumLights));
+    for(unsigned int i=0; i<scene->mNumLights; i++) {
+        writeLight(writer, scene->mLights[i]);
+    }
+    writer.write(uint32_t(scene->mNumAnimations));
+    for(unsigned int i=0; i<scene->mNumAnimations; i++) {
+        writeAnimation(writer, scene->mAnimations[i]);
+    }
+    writer.write(uint32_t(scene->mNumCameras));
+    for(unsigned int i=0; i<scene->mNumCameras; i++) {
+        writeCamera(writer, scene->mCameras[i]);
+    }
+    writer.write(uint32_t(scene->mNumTextures));
+    for(unsigned int i=0; i<scene->mNumTextures; i++) {
+        writeTexture(writer, scene->mTextures[i]);
+    }
+
+    ofFilePath::createEnclosingDirectory(path);
+    if(!ofBufferToFile(path, writer.buffer, true)) {
+        ofLogError("ofxAssimpSceneCache") << "save(): couldn't write scene cache \"" << path << "\"";
+        return false;
+    }
+    ofLogVerbose("ofxAssimpSceneCache") << "save(): wrote " << writer.buffer.size() << " bytes to \"" << path << "\"";
+    return true;
+}
+
+//--------------------------------------------------------------
+shared_ptr<const aiScene> ofxAssimpSceneCache::load(const string & path, uint64_t sourceHash, unsigned int flags) {
+    if(!ofFile::doesFileExist(path)) {
+        return shared_ptr<const aiScene>();
+    }
+    ofBuffer buffer = ofBufferFromFile(path, true);
+    Reader reader(buffer);
+
+    char fileMagic[sizeof(magic)];
+    uint32_t fileVersion, fileLayout, fileFlags, sceneFlags;
+    uint64_t fileHash;
+    bool headerOk = reader.read(fileMagic)
+        && memcmp(fileMagic, magic, sizeof(magic)) == 0
+        && reader.read(fileVersion) && fileVersion == version
+        && reader.read(fileLayout) && fileLayout == layout
+        && reader.read(fileHash) && fileHash == sourceHash
+        && reader.read(fileFlags) && fileFlags == flags
+        && reader.read(sceneFlags);
+    if(!headerOk) {
+        ofLogVerbose("ofxAssimpSceneCache") << "load(): \"" << path << "\" is out of date";
+        return shared_ptr<const aiScene>();
+    }
+
+    unique_ptr<aiScene> scene(new aiScene());
+    scene->mFlags = sceneFlags;
+    scene->mRootNode = new aiNode();
+    bool ok = readNode(reader, scene->mRootNode, 0)
+        && readObjects(reader, scene->mMeshes, scene->mNumMeshes, &readMesh)
+        && readObjects(reader, scene->mMaterials, scene->mNumMaterials, &readMaterial)
+        && readObjects(reader, scene->mLights, scene->mNumLights, &readLight)
+        && readObjects(reader, scene->mAnimations, scene->mNumAnimations, &readAnimation)
+        && readObjects(reader, scene->mCameras, scene->mNumCameras, &readCamera)
+        && readObjects(reader, scene->mTextures, scene->mNumTextures, &readTexture)
+        && reader.atEnd()
+        && validate(scene.get());
+    if(!ok) {
+        ofLogWarning("ofxAssimpSceneCache") << "load(): scene cache \"" << path << "\" is corrupt, ignoring it";
+        return shared_ptr<const aiScene>();
+    }
+
+    ofLogVerbose("ofxAssimpSceneCache") << "load(): loaded scene from \"" << path << "\"";
+    return shared_ptr<const aiScene>(scene.release(), [](const aiScene * scene){
+        delete scene;
+    });
+}
@@ -0,0 +1,38 @@
+//
+//  ofxAssimpSceneCache.h
+//
+//  Binary cache of imported scenes, so models that take long to import
+//  and post-process through assimp only pay that cost once.
+//
+//  Cache files hold the node hierarchy, meshes (positions, normals,
+//  tangents, every uv and color channel, faces and bones), materials,
+//  lights, cameras, embedded textures and node animations of an already
+//  post-processed aiScene, scenes with animation meshes aren't cached.
+//  Each file is keyed by the contents of the source model and the import
+//  flags, so changing either of them misses the cache and the model is
+//  imported again.
+//  Bulk arrays are 16 byte aligned in the file.
+//
+
+#pragma once
+
+#include "ofMain.h"
+
+struct aiScene;
+
+class ofxAssimpSceneCache {
+
+public:
+
+    // 64 bit FNV-1a hash of the buffer contents
+    static uint64_t hash(const ofBuffer & buffer);
+
+    // path of the cache file for a source with that hash imported with those flags
+    static string getCachePath(const string & cacheFolder, const string & sourceName, uint64_t sourceHash, unsigned int flags);
+
+    static bool save(const aiScene * scene, const string & path, uint64_t sourceHash, unsigned int flags);
+
+    // returns an empty pointer if the file doesn't exist, is corrupt or was
+    // created from a different source or flags.
+    static shared_ptr<const aiScene> load(const string & path, uint64_t sourceHash, unsigned int flags);
+};
@@ -1,98 +1,365 @@
 #include "ofxThreadedImageLoader.h"
-#include <sstream>
+#include "ofUtils.h"
+#include <algorithm>
+
 ofxThreadedImageLoader::ofxThreadedImageLoader(){
-	nextID = 0;
+	numThreads = std::max(2u, std::thread::hardware_concurrency()) - 1;
+	maxDecodedBytes = 256 * 1024 * 1024;
+	updateBudgetMicros = 5000;
     ofAddListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
 	ofAddListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
-    
-    startThread();
-    lastUpdate = 0;
 }
 
 ofxThreadedImageLoader::~ofxThreadedImageLoader(){
-	images_to_load_from_disk.close();
-	images_to_update.close();
-	waitForThread(true);
+	cancelAll();
+	stopThreads();
     ofRemoveListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
 	ofRemoveListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
 }
 
 // Load an image from disk.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::loadFromDisk(ofImage& image, string filename) {
-	nextID++;
-	ofImageLoaderEntry entry(image);
-	entry.filename = filename;
-	entry.image->setUseTexture(false);
-	entry.name = filename;
-    
-	images_to_load_from_disk.send(entry);
+int ofxThreadedImageLoader::loadFromDisk(ofImage& image, string filename, int priority) {
+	auto entry = make_shared<ofImageLoaderEntry>();
+	entry->image = &image;
+	entry->filename = filename;
+	entry->priority = priority;
+
+	std::unique_lock<std::mutex> lock(mutex);
+	entry->id = nextID++;
+	entry->order = nextOrder++;
+	entries[entry->id] = entry;
+	images_to_decode[queueKey(*entry)] = entry;
+	if(threads.empty()){
+		startThreads();
+	}
+	condition.notify_one();
+	return entry->id;
 }
 
 
 // Load an url asynchronously from an url.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::loadFromURL(ofImage& image, string url) {
-	nextID++;
-	ofImageLoaderEntry entry(image);
-	entry.url = url;
-	entry.image->setUseTexture(false);	
-	entry.name = "image" + ofToString(nextID);
-	images_async_loading[entry.name] = entry;
-	ofLoadURLAsync(entry.url, entry.name);
+int ofxThreadedImageLoader::loadFromURL(ofImage& image, string url, int priority) {
+	auto entry = make_shared<ofImageLoaderEntry>();
+	entry->image = &image;
+	entry->url = url;
+	entry->priority = priority;
+	entry->state = ofImageLoaderEntry::Downloading;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		entry->id = nextID++;
+		entry->order = nextOrder++;
+		entries[entry->id] = entry;
+	}
+	int requestID = ofLoadURLAsync(entry->url, "ofxThreadedImageLoader " + ofToString(entry->id));
+	images_async_loading[requestID] = entry->id;
+	return entry->id;
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::cancel(int id){
+	std::unique_lock<std::mutex> lock(mutex);
+	auto it = entries.find(id);
+	if(it != entries.end()){
+		remove(it);
+	}
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::cancelAll(){
+	std::unique_lock<std::mutex> lock(mutex);
+	while(!entries.empty()){
+		remove(entries.begin());
+	}
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::remove(std::unordered_map<int, shared_ptr<ofImageLoaderEntry>>::iterator it){
+	auto entry = it->second;
+	entries.erase(it);
+	switch(entry->state){
+	case ofImageLoaderEntry::Downloading:
+		for(auto download = images_async_loading.begin(); download != images_async_loading.end(); ++download){
+			if(download->second == entry->id){
+				ofRemoveURLRequest(download->first);
+				images_async_loading.erase(download);
+				break;
+			}
+		}
+		break;
+	case ofImageLoaderEntry::Queued:
+		images_to_decode.erase(queueKey(*entry));
+		break;
+	case ofImageLoaderEntry::Decoding:
+		// the worker drops it when it's done
+		break;
+	case ofImageLoaderEntry::Decoded:
+		images_to_update.erase(std::find(images_to_update.begin(), images_to_update.end(), entry));
+		decodedBytes -= entry->pixels.getTotalBytes();
+		condition.notify_all();
+		break;
+	}
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::setPriority(int id, int priority){
+	std::unique_lock<std::mutex> lock(mutex);
+	auto it = entries.find(id);
+	if(it == entries.end()){
+		return;
+	}
+	auto entry = it->second;
+	if(entry->state == ofImageLoaderEntry::Queued){
+		images_to_decode.erase(queueKey(*entry));
+		entry->priority = priority;
+		images_to_decode[queueKey(*entry)] = entry;
+	}else{
+		// still used to order downloaded and decoded images
+		entry->priority = priority;
+	}
+}
+
+
+//--------------------------------------------------------------
+bool ofxThreadedImageLoader::isLoading(int id) const{
+	std::unique_lock<std::mutex> lock(mutex);
+	return entries.find(id) != entries.end();
+}
+
+
+//--------------------------------------------------------------
+size_t ofxThreadedImageLoader::getNumLoading() const{
+	std::unique_lock<std::mutex> lock(mutex);
+	return entries.size();
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::setNumThreads(size_t threads){
+	stopThreads();
+	std::unique_lock<std::mutex> lock(mutex);
+	numThreads = std::max<size_t>(threads, 1);
+	if(!images_to_decode.empty()){
+		startThreads();
+	}
+}
+
+
+//--------------------------------------------------------------
+size_t ofxThreadedImageLoader::getNumDecoded() const{
+	std::unique_lock<std::mutex> lock(mutex);
+	return images_to_update.size();
+}
+
+
+//--------------------------------------------------------------
+size_t ofxThreadedImageLoader::getNumThreads() const{
+	std::unique_lock<std::mutex> lock(mutex);
+	return numThreads;
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::setMaxDecodedBytes(uint64_t bytes){
+	std::unique_lock<std::mutex> lock(mutex);
+	maxDecodedBytes = bytes;
+	condition.notify_all();
 }
 
 
-// Reads from the queue and loads new images.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::threadedFunction() {
-	setThreadName("ofxThreadedImageLoader " + ofToString(thread.get_id()));
-	ofImageLoaderEntry entry;
-	while( images_to_load_from_disk.receive(entry) ) {
-		if(entry.image->load(entry.filename) )  {
-			images_to_update.send(entry);
+void ofxThreadedImageLoader::setUpdateBudget(float milliseconds){
+	updateBudgetMicros = std::max(0.f, milliseconds) * 1000;
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::stopThread(){
+	cancelAll();
+}
+
+
+// has to be called with the mutex locked
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::startThreads(){
+	for(size_t i = 0; i < numThreads; i++){
+		threads.emplace_back(&ofxThreadedImageLoader::threadedFunction, this, generation);
+	}
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::stopThreads(){
+	vector<std::thread> stopped;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		// threads started after this don't see the old generation so
+		// they aren't stopped by mistake
+		generation++;
+		stopped.swap(threads);
+		condition.notify_all();
+	}
+	for(auto & thread: stopped){
+		thread.join();
+	}
+}
+
+
+//--------------------------------------------------------------
+ofxThreadedImageLoader::queue_key ofxThreadedImageLoader::queueKey(const ofImageLoaderEntry & entry) const{
+	return std::make_pair(-entry.priority, entry.order);
+}
+
+
+// has to be called with the mutex locked
+//--------------------------------------------------------------
+uint64_t ofxThreadedImageLoader::decodingEstimate() const{
+	if(numDecodedTotal == 0){
+		return maxDecodedBytes;
+	}
+	return decodedBytesTotal / numDecodedTotal;
+}
+
+
+// has to be called with the mutex locked
+//--------------------------------------------------------------
+bool ofxThreadedImageLoader::canDecode() const{
+	if(images_to_decode.empty()){
+		return false;
+	}
+	if(decodedBytes == 0){
+		return true;
+	}
+	return decodedBytes < maxDecodedBytes && decodingEstimate() <= maxDecodedBytes - decodedBytes;
+}
+
+
+// Decodes the queued images with the highest priority, waiting while
+// the images being decoded and the ones not uploaded yet would take
+// more than the budget.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::threadedFunction(uint64_t threadsGeneration) {
+	std::unique_lock<std::mutex> lock(mutex);
+	while(true){
+		condition.wait(lock, [&]{
+			return generation != threadsGeneration || canDecode();
+		});
+		if(generation != threadsGeneration){
+			break;
+		}
+		auto entry = images_to_decode.begin()->second;
+		images_to_decode.erase(images_to_decode.begin());
+		entry->state = ofImageLoaderEntry::Decoding;
+		entry->reservedBytes = decodingEstimate();
+		decodedBytes += entry->reservedBytes;
+		lock.unlock();
+
+		ofPixels pixels;
+		bool loaded;
+		if(entry->url.empty()){
+			loaded = ofLoadImage(pixels, entry->filename);
 		}else{
-			ofLogError("ofxThreadedImageLoader") << "couldn't load file: \"" << entry.filename << "\"";
+			loaded = ofLoadImage(pixels, entry->data);
+			entry->data.clear();
+		}
+
+		lock.lock();
+		decodedBytes -= entry->reservedBytes;
+		entry->reservedBytes = 0;
+		if(loaded){
+			numDecodedTotal++;
+			decodedBytesTotal += pixels.getTotalBytes();
+		}
+		// the estimate and the bytes available changed
+		condition.notify_all();
+		if(entries.find(entry->id) == entries.end()){
+			// cancelled while decoding
+			continue;
 		}
+		entry->state = ofImageLoaderEntry::Decoded;
+		entry->loaded = loaded;
+		entry->pixels = std::move(pixels);
+		decodedBytes += entry->pixels.getTotalBytes();
+		images_to_update.push_back(entry);
 	}
-	ofLogVerbose("ofxThreadedImageLoader") << "finishing thread on closed queue";
+	ofLogVerbose("ofxThreadedImageLoader") << "finishing thread";
 }
 
 
-// When we receive an url response this method is called; 
-// The loaded image is removed from the async_queue and added to the
-// update queue. The update queue is used to update the texture.
+// When we receive an url response this method is called;
+// The downloaded image is queued to be decoded by the threads
 //--------------------------------------------------------------
 void ofxThreadedImageLoader::urlResponse(ofHttpResponse & response) {
 	// this happens in the update thread so no need to lock to access
 	// images_async_loading
-	entry_iterator it = images_async_loading.find(response.request.name);
+	auto it = images_async_loading.find(response.request.getID());
+	if(it == images_async_loading.end()){
+		return;
+	}
+	int id = it->second;
+	images_async_loading.erase(it);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	auto entry = entries.find(id);
+	if(entry == entries.end()){
+		return;
+	}
 	if(response.status == 200) {
-		if(it != images_async_loading.end()) {
-			it->second.image->load(response.data);
-			images_to_update.send(it->second);
+		entry->second->data = response.data;
+		entry->second->state = ofImageLoaderEntry::Queued;
+		images_to_decode[queueKey(*entry->second)] = entry->second;
+		if(threads.empty()){
+			startThreads();
 		}
+		condition.notify_one();
 	}else{
 		// log error.
 		ofLogError("ofxThreadedImageLoader") << "couldn't load url, response status: " << response.status;
 		ofRemoveURLRequest(response.request.getID());
-	}
-
-	// remove the entry from the queue
-	if(it != images_async_loading.end()) {
-		images_async_loading.erase(it);
+		entries.erase(entry);
 	}
 }
 
 
-// Check the update queue and update the texture
+// Uploads the decoded images with the highest priority until the
+// update budget is used
 //--------------------------------------------------------------
 void ofxThreadedImageLoader::update(ofEventArgs & a){
-    // Load 1 image per update so we don't block the gl thread for too long
-	ofImageLoaderEntry entry;
-	if (images_to_update.tryReceive(entry)) {
-		entry.image->setUseTexture(true);
-		entry.image->update();
+	auto start = ofGetElapsedTimeMicros();
+	while(true){
+		shared_ptr<ofImageLoaderEntry> entry;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			if(images_to_update.empty()){
+				break;
+			}
+			auto next = std::min_element(images_to_update.begin(), images_to_update.end(),
+				[this](const shared_ptr<ofImageLoaderEntry> & e1, const shared_ptr<ofImageLoaderEntry> & e2){
+					return queueKey(*e1) < queueKey(*e2);
+				});
+			entry = *next;
+			images_to_update.erase(next);
+			entries.erase(entry->id);
+			decodedBytes -= entry->pixels.getTotalBytes();
+			condition.notify_all();
+		}
+
+		if(entry->loaded){
+			entry->image->getPixels() = std::move(entry->pixels);
+			entry->image->update();
+		}else if(entry->url.empty()){
+			ofLogError("ofxThreadedImageLoader") << "couldn't load file: \"" << entry->filename << "\"";
+		}else{
+			ofLogError("ofxThreadedImageLoader") << "couldn't load image from url: \"" << entry->url << "\"";
+		}
+
+		if(ofGetElapsedTimeMicros() - start >= updateBudgetMicros){
+			break;
+		}
 	}
 }
-
@@ -1,53 +1,153 @@
 #pragma once
 
-#include "ofThread.h"
 #include "ofImage.h"
 #include "ofURLFileLoader.h"
-#include "ofTypes.h" 
-#include "ofThreadChannel.h"
+#include "ofTypes.h"
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 
 using namespace std;
 
-class ofxThreadedImageLoader : public ofThread {
+/// \class ofxThreadedImageLoader
+///
+/// Loads images from disk or urls without blocking the main thread.
+///
+/// Images are decoded by a pool of worker threads, higher priorities
+/// first, and uploaded to their textures from the main thread during
+/// ofEvents().update. The image passed to a load function isn't modified
+/// until it's uploaded and has to exist until then or until its request
+/// is cancelled.
+///
+/// To keep the frame rate while loading lots of images, uploads stop once
+/// an update has taken setUpdateBudget() milliseconds and continue in the
+/// next one, and workers wait to decode more images while the decoded
+/// ones waiting to be uploaded take more than setMaxDecodedBytes().
+///
+/// Requests are made and cancelled from the main thread, like the url
+/// responses they depend on.
+///
+/// ~~~~{.cpp}
+/// // thumbnails that are visible first
+/// for(size_t i = 0; i < thumbnails.size(); i++){
+///     ids[i] = loader.loadFromDisk(thumbnails[i], paths[i], isVisible(i) ? 1 : 0);
+/// }
+/// // and when scrolling
+/// loader.setPriority(ids[i], isVisible(i) ? 1 : 0);
+/// ~~~~
+class ofxThreadedImageLoader {
 public:
     ofxThreadedImageLoader();
     ~ofxThreadedImageLoader();
 
-	void loadFromDisk(ofImage& image, string file);
-	void loadFromURL(ofImage& image, string url);
+	/// \brief Load an image file.
+	/// \param image Image to load into.
+	/// \param file Path of the image, relative to the data folder.
+	/// \param priority Images with higher priorities are loaded first.
+	/// \returns The id of the request, to cancel it or change its priority.
+	int loadFromDisk(ofImage& image, string file, int priority = 0);
 
+	/// \brief Download and load an image.
+	///
+	/// The download starts immediately and is decoded with the priority
+	/// of the request once it arrives.
+	int loadFromURL(ofImage& image, string url, int priority = 0);
 
+	/// \brief Cancel a request, the image is left as it was.
+	void cancel(int id);
+
+	/// \brief Cancel all the requests.
+	void cancelAll();
+
+	/// \brief Change the priority of a request that hasn't been decoded.
+	void setPriority(int id, int priority);
+
+	/// \returns true until the image of the request is uploaded, fails or
+	/// the request is cancelled.
+	bool isLoading(int id) const;
+
+	/// \returns the number of requests not finished yet.
+	size_t getNumLoading() const;
+
+	/// \returns the number of images decoded and waiting to be uploaded.
+	size_t getNumDecoded() const;
+
+	/// \brief Number of images decoded at the same time, by default one
+	/// less than the number of cores. Waits for the images being decoded.
+	void setNumThreads(size_t numThreads);
+	size_t getNumThreads() const;
+
+	/// \brief Limit the memory held by images being decoded or waiting to
+	/// be uploaded, 256MB by default. One image is always allowed.
+	///
+	/// The size of an image is only known once it's decoded so images
+	/// being decoded count as the average size of the previous ones, or
+	/// as the whole budget before any image has been decoded.
+	void setMaxDecodedBytes(uint64_t bytes);
+
+	/// \brief Stop uploading images during an update once it has taken
+	/// this long, 5ms by default. At least one image is uploaded per
+	/// update so loading always progresses.
+	void setUpdateBudget(float milliseconds);
+
+	OF_DEPRECATED_MSG("The threads stop when the loader is destroyed, use cancelAll() to stop loading", void stopThread());
 
 private:
 	void update(ofEventArgs & a);
-    virtual void threadedFunction();
 	void urlResponse(ofHttpResponse & response);
-    
+	void threadedFunction(uint64_t threadsGeneration);
+	void startThreads();
+	void stopThreads();
+
     // Entry to load.
-    struct ofImageLoaderEntry {
-        ofImageLoaderEntry() {
-            image = NULL;
-        }
-        
-        ofImageLoaderEntry(ofImage & pImage) {
-            image = &pImage;
-        }
-        ofImage* image;
-        string filename;
-        string url;
-        string name;
-    };
-
-
-    typedef map<string, ofImageLoaderEntry>::iterator entry_iterator;
-
-	int                 nextID;
-    int                 lastUpdate;
-
-	map<string,ofImageLoaderEntry> images_async_loading; // keeps track of images which are loading async
-	ofThreadChannel<ofImageLoaderEntry> images_to_load_from_disk;
-	ofThreadChannel<ofImageLoaderEntry> images_to_update;
-};
+	struct ofImageLoaderEntry {
+		enum State{
+			Downloading,
+			Queued,
+			Decoding,
+			Decoded,
+		};
+
+		int id = 0;
+		ofImage* image = nullptr;
+		string filename;
+		string url;
+		ofBuffer data;
+		int priority = 0;
+		uint64_t order = 0;
+		State state = Queued;
+		bool loaded = false;
+		uint64_t reservedBytes = 0; // counted in decodedBytes while decoding
+		ofPixels pixels;
+	};
 
+	typedef std::pair<int, uint64_t> queue_key;
+	queue_key queueKey(const ofImageLoaderEntry & entry) const;
+	// both have to be called with the mutex locked
+	uint64_t decodingEstimate() const;
+	bool canDecode() const;
+	// has to be called with the mutex locked
+	void remove(std::unordered_map<int, shared_ptr<ofImageLoaderEntry>>::iterator it);
 
+	mutable std::mutex mutex;
+	std::condition_variable condition;
+	vector<std::thread> threads;
+	size_t numThreads;
+	uint64_t generation = 0; // incremented to stop the threads
+
+	int nextID = 1;
+	uint64_t nextOrder = 0;
+	uint64_t maxDecodedBytes;
+	uint64_t decodedBytes = 0; // decoded images and the ones being decoded
+	uint64_t numDecodedTotal = 0; // to estimate the size of the images being decoded
+	uint64_t decodedBytesTotal = 0;
+	uint64_t updateBudgetMicros;
+
+	unordered_map<int, shared_ptr<ofImageLoaderEntry>> entries; // every request not finished
+	map<queue_key, shared_ptr<ofImageLoaderEntry>> images_to_decode; // by priority and then order
+	vector<shared_ptr<ofImageLoaderEntry>> images_to_update; // decoded, waiting to be uploaded
+	unordered_map<int, int> images_async_loading; // url request id to entry id, only used from the main thread
+};
@@ -0,0 +1,111 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+
+// Reads every file under a directory with ofBufferFromFile() as an app
+// would on startup, from the loose files and after mounting an
+// uncompressed and an LZ4 compressed pack of them, reporting the time of
+// each including mounting. Without a path a tree of small text files is
+// created in the data folder. The first run reads from disk, run it again
+// to compare with the files in the system's cache.
+//
+// usage: assetPackBenchmark [path | numFiles]
+class ofApp: public ofBaseApp{
+public:
+	ofApp(const string & path, size_t numFiles)
+	:path(path)
+	,numFiles(numFiles){}
+
+	void setup(){
+		bool generated = path.empty();
+		if(generated){
+			path = "pack_benchmark";
+			ofLogNotice() << "creating " << numFiles << " files in " << path;
+			for(size_t i = 0; i < numFiles; i++){
+				auto dir = path + "/" + ofToString(i / 100);
+				if(i % 100 == 0){
+					ofDirectory::createDirectory(dir, true, true);
+				}
+				string contents;
+				for(size_t j = 0; j < 50 + i % 100; j++){
+					contents += "{\"id\": " + ofToString(i * j) + ", \"name\": \"asset " + ofToString(j) + "\"}\n";
+				}
+				ofBufferToFile(dir + "/" + ofToString(i) + ".json", ofBuffer(contents.c_str(), contents.size()));
+			}
+		}
+
+		auto listing = ofDirectory(path).scan();
+		vector<string> files;
+		for(size_t i = 0; i < listing.size(); i++){
+			if(listing.isFile(i)){
+				files.push_back(listing.getRelativePath(i).toString());
+			}
+		}
+
+		ofAssetPack::create(path, "raw.pack", ofAssetPackCompression::None);
+		ofAssetPack::create(path, "lz4.pack", ofAssetPackCompression::LZ4);
+		ofLogNotice() << files.size() << " files, " << ofFile("raw.pack").getSize() << " bytes, "
+			<< ofFile("lz4.pack").getSize() << " bytes compressed";
+
+		run("loose files", [&]{
+			return read(path + "/", files);
+		});
+
+		run("pack", [&]{
+			ofMountAssetPack("raw.pack", path);
+			auto bytes = read(path + "/", files);
+			ofUnmountAllAssetPacks();
+			return bytes;
+		});
+
+		run("lz4 pack", [&]{
+			ofMountAssetPack("lz4.pack", path);
+			auto bytes = read(path + "/", files);
+			ofUnmountAllAssetPacks();
+			return bytes;
+		});
+
+		if(generated){
+			ofDirectory::removeDirectory(path, true);
+		}
+		ofFile::removeFile("raw.pack");
+		ofFile::removeFile("lz4.pack");
+		ofExit();
+	}
+
+	uint64_t read(const string & root, const vector<string> & files){
+		uint64_t bytes = 0;
+		for(auto & file: files){
+			bytes += ofBufferFromFile(root + file).size();
+		}
+		return bytes;
+	}
+
+	void run(const string & name, std::function<uint64_t()> read){
+		auto start = ofGetElapsedTimeMicros();
+		auto bytes = read();
+		auto seconds = (ofGetElapsedTimeMicros() - start) / 1000000.;
+		ofLogNotice() << name << ": " << bytes << " bytes in " << seconds << "s";
+	}
+
+	string path;
+	size_t numFiles;
+};
+
+//========================================================================
+int main(int argc, char ** argv){
+	string path;
+	size_t numFiles = 20000;
+	if(argc > 1){
+		if(ofToString(ofToInt(argv[1])) == argv[1]){
+			numFiles = ofToInt(argv[1]);
+		}else{
+			path = argv[1];
+		}
+	}
+
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>(path, numFiles);
+	ofRunApp(window, app);
+	ofRunMainLoop();
+}
@@ -0,0 +1,59 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+
+// Packs every file under a directory into an asset pack that can be
+// mounted with ofMountAssetPack(). Relative paths are relative to the
+// current directory. Files are compressed with LZ4 unless --raw is passed.
+//
+// usage: assetPacker directory output.pack [--raw]
+class ofApp: public ofBaseApp{
+public:
+	ofApp(const string & directory, const string & output, ofAssetPackCompression compression)
+	:directory(directory)
+	,output(output)
+	,compression(compression){}
+
+	void setup(){
+		auto start = ofGetElapsedTimeMicros();
+		if(ofAssetPack::create(directory, output, compression)){
+			ofAssetPack pack;
+			pack.open(output);
+			uint64_t bytes = 0;
+			size_t compressed = 0;
+			for(size_t i = 0; i < pack.size(); i++){
+				bytes += pack.getSize(i);
+				compressed += pack.getCompression(i) == ofAssetPackCompression::LZ4;
+			}
+			auto seconds = (ofGetElapsedTimeMicros() - start) / 1000000.;
+			ofLogNotice() << "packed " << pack.size() << " files, " << compressed << " compressed, "
+				<< bytes << " bytes into " << ofFile(output).getSize() << " bytes in " << seconds << "s";
+		}else{
+			exitCode = 1;
+		}
+		ofExit(exitCode);
+	}
+
+	string directory;
+	string output;
+	ofAssetPackCompression compression;
+	int exitCode = 0;
+};
+
+//========================================================================
+int main(int argc, char ** argv){
+	if(argc < 3){
+		ofLogError() << "usage: assetPacker directory output.pack [--raw]";
+		return 1;
+	}
+	auto compression = ofAssetPackCompression::LZ4;
+	if(argc > 3 && string(argv[3]) == "--raw"){
+		compression = ofAssetPackCompression::None;
+	}
+
+	ofInit();
+	ofDisableDataPath();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>(argv[1], argv[2], compression);
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
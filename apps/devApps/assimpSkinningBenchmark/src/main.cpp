@@ -0,0 +1,80 @@
+#include "ofMain.h"
+#include "ofAppGLFWWindow.h"
+#include "ofxAssimpModelLoader.h"
+
+// Animates a skinned model without drawing it and reports the time spent
+// in ofxAssimpModelLoader::update() with and without threaded skinning.
+// The window is hidden, it's only needed for the GL context the model
+// uploads its vbos to.
+//
+// usage: assimpSkinningBenchmark [model] [numFrames] [numInstances]
+class ofApp: public ofBaseApp{
+public:
+	ofApp(const string & modelPath, int numFrames, int numInstances)
+	:modelPath(modelPath)
+	,numFrames(numFrames)
+	,numInstances(numInstances){}
+
+	void setup(){
+		models.resize(numInstances);
+		for(auto & model: models){
+			if(!model.loadModel(modelPath)){
+				ofLogError() << "couldn't load " << modelPath;
+				ofExit(1);
+				return;
+			}
+			model.playAllAnimations();
+		}
+
+		size_t numVertices = 0;
+		for(unsigned int i=0; i<models[0].getMeshCount(); i++){
+			numVertices += models[0].getMeshHelper(i).mesh->mNumVertices;
+		}
+		ofLogNotice() << modelPath << ": " << models[0].getMeshCount() << " meshes, "
+			<< numVertices << " vertices, " << models[0].getAnimationCount() << " animations";
+		ofLogNotice() << "thread pool workers: " << ofGetThreadPool().getNumThreads();
+
+		for(auto & model: models) model.disableThreadedSkinning();
+		auto serial = run();
+		for(auto & model: models) model.enableThreadedSkinning();
+		auto threaded = run();
+
+		ofLogNotice() << "serial:   " << serial << "us per frame";
+		ofLogNotice() << "threaded: " << threaded << "us per frame";
+		ofLogNotice() << "speedup:  " << serial / threaded << "x";
+		ofExit();
+	}
+
+	double run(){
+		auto start = ofGetElapsedTimeMicros();
+		for(int frame=0; frame<numFrames; frame++){
+			for(auto & model: models){
+				model.setPositionForAllAnimations(float(frame) / numFrames);
+				model.update();
+			}
+		}
+		return double(ofGetElapsedTimeMicros() - start) / numFrames;
+	}
+
+	string modelPath;
+	int numFrames;
+	int numInstances;
+	vector<ofxAssimpModelLoader> models;
+};
+
+//========================================================================
+int main(int argc, char ** argv){
+	string modelPath = "../../../../../examples/3d/assimpExample/bin/data/astroBoy_walk.dae";
+	int numFrames = 500;
+	int numInstances = 16;
+	if(argc > 1) modelPath = argv[1];
+	if(argc > 2) numFrames = ofToInt(argv[2]);
+	if(argc > 3) numInstances = ofToInt(argv[3]);
+
+	ofGLFWWindowSettings settings;
+	settings.width = 320;
+	settings.height = 240;
+	settings.visible = false;
+	ofCreateWindow(settings);
+	ofRunApp(new ofApp(modelPath, numFrames, numInstances));
+}
@@ -0,0 +1,92 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+
+// Writes a csv file of the requested size with an id, a name and three
+// float columns and parses it with getLines() and ofSplitString(), with
+// getLineViews() and ofSplitStringView() and with the same on a mapped
+// buffer, reporting the time and throughput of each.
+//
+// usage: csvParsingBenchmark [sizeMB] [file]
+class ofApp: public ofBaseApp{
+public:
+	ofApp(size_t sizeMB, const string & path)
+	:sizeMB(sizeMB)
+	,path(path){}
+
+	void setup(){
+		ofLogNotice() << "writing " << sizeMB << "MB to " << path;
+		{
+			ofBuffer csv;
+			csv.reserve(sizeMB * 1024 * 1024 + 128);
+			ofSeedRandom(0);
+			for(size_t id = 0; csv.size() < sizeMB * 1024 * 1024; id++){
+				csv.append(ofToString(id) + ",point" + ofToString(id % 1000) + "," + ofToString(ofRandom(-100, 100)) + ","
+					+ ofToString(ofRandom(-100, 100)) + "," + ofToString(ofRandom(-100, 100)) + "\n");
+			}
+			ofBufferToFile(path, csv);
+		}
+
+		run("getLines + ofSplitString", [&]{
+			ofBuffer buffer = ofBufferFromFile(path);
+			double sum = 0;
+			for(auto line: buffer.getLines()){
+				auto columns = ofSplitString(line, ",");
+				if(columns.size() == 5){
+					sum += ofToInt(columns[0]) + ofToFloat(columns[2]) + ofToFloat(columns[3]) + ofToFloat(columns[4]);
+				}
+			}
+			return sum;
+		});
+
+		auto parseViews = [](const ofBuffer & buffer){
+			double sum = 0;
+			for(auto line: buffer.getLineViews()){
+				size_t column = 0;
+				for(auto token: ofSplitStringView(line, ",")){
+					if(column == 0){
+						sum += ofToInt(token);
+					}else if(column >= 2){
+						sum += ofToFloat(token);
+					}
+					column++;
+				}
+			}
+			return sum;
+		};
+
+		run("getLineViews + ofSplitStringView", [&]{
+			return parseViews(ofBufferFromFile(path));
+		});
+
+		run("mapped + views", [&]{
+			return parseViews(ofBufferFromFile(path, ofBufferLoadMode::Mapped));
+		});
+
+		ofFile::removeFile(path);
+		ofExit();
+	}
+
+	void run(const string & name, std::function<double()> parse){
+		auto start = ofGetElapsedTimeMicros();
+		auto sum = parse();
+		auto seconds = (ofGetElapsedTimeMicros() - start) / 1000000.;
+		ofLogNotice() << name << ": " << seconds << "s, " << sizeMB / seconds << "MB/s (checksum " << sum << ")";
+	}
+
+	size_t sizeMB;
+	string path;
+};
+
+//========================================================================
+int main(int argc, char ** argv){
+	size_t sizeMB = 256;
+	string path = "benchmark.csv";
+	if(argc > 1) sizeMB = ofToInt(argv[1]);
+	if(argc > 2) path = argv[2];
+
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>(sizeMB, path);
+	ofRunApp(window, app);
+	ofRunMainLoop();
+}
@@ -0,0 +1,98 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+
+// Lists every file under a directory with recursive listDir() calls,
+// querying the size and type of each ofFile and sorting, and with
+// ofDirectory::scan() and sorting the listing, reporting the time of each.
+// Without a path a tree of empty files is created in the data folder.
+//
+// usage: directoryScanBenchmark [path | numFiles]
+class ofApp: public ofBaseApp{
+public:
+	ofApp(const string & path, size_t numFiles)
+	:path(path)
+	,numFiles(numFiles){}
+
+	void setup(){
+		bool generated = path.empty();
+		if(generated){
+			path = "scan_benchmark";
+			ofLogNotice() << "creating " << numFiles << " files in " << path;
+			for(size_t i = 0; i < numFiles; i++){
+				auto dir = path + "/" + ofToString(i / 10000) + "/" + ofToString(i / 100 % 100);
+				if(i % 100 == 0){
+					ofDirectory::createDirectory(dir, true, true);
+				}
+				ofFile(dir + "/" + ofToString(i) + ".jpg", ofFile::WriteOnly);
+			}
+		}
+
+		run("listDir + ofFile", [&]{
+			vector<ofFile> files;
+			uint64_t bytes = 0;
+			std::function<void(const string &)> list = [&](const string & dirPath){
+				ofDirectory dir(dirPath);
+				dir.listDir();
+				dir.sort();
+				for(auto & file: dir){
+					if(file.isDirectory()){
+						list(file.path());
+					}else{
+						bytes += file.getSize();
+						files.push_back(file);
+					}
+				}
+			};
+			list(path);
+			return files.size();
+		});
+
+		run("scan", [&]{
+			auto listing = ofDirectory(path).scan();
+			listing.sort();
+			size_t count = 0;
+			uint64_t bytes = 0;
+			for(size_t i = 0; i < listing.size(); i++){
+				if(listing.isFile(i)){
+					bytes += listing.getSize(i);
+					count++;
+				}
+			}
+			return count;
+		});
+
+		if(generated){
+			ofDirectory::removeDirectory(path, true);
+		}
+		ofExit();
+	}
+
+	void run(const string & name, std::function<size_t()> list){
+		auto start = ofGetElapsedTimeMicros();
+		auto count = list();
+		auto seconds = (ofGetElapsedTimeMicros() - start) / 1000000.;
+		ofLogNotice() << name << ": " << count << " files in " << seconds << "s";
+	}
+
+	string path;
+	size_t numFiles;
+};
+
+//========================================================================
+int main(int argc, char ** argv){
+	string path;
+	size_t numFiles = 200000;
+	if(argc > 1){
+		if(ofToString(ofToInt(argv[1])) == argv[1]){
+			numFiles = ofToInt(argv[1]);
+		}else{
+			path = argv[1];
+		}
+	}
+
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>(path, numFiles);
+	ofRunApp(window, app);
+	ofRunMainLoop();
+}
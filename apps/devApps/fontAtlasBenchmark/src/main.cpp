@@ -0,0 +1,69 @@
+#include "ofMain.h"
+#include "ofAppGLFWWindow.h"
+
+// Loads a font with the japanese alphabet rasterizing every glyph when
+// loading and with a dynamic atlas, and reports the time to load it, the
+// size of the atlas texture and the time to create the first mesh of a
+// string. The window is hidden, it's only needed for the GL context.
+//
+// usage: fontAtlasBenchmark [font] [fontSize]
+class ofApp: public ofBaseApp{
+public:
+	ofApp(const string & fontPath, int fontSize)
+	:fontPath(fontPath)
+	,fontSize(fontSize){}
+
+	void setup(){
+		string text = "openFrameworksはC++のオープンソースツールキットです。\n"
+			"日本語の文字を描くときに必要なグリフだけを読み込みます。";
+		run(false, text);
+		run(true, text);
+		ofExit();
+	}
+
+	void run(bool dynamicAtlas, const string & text){
+		ofTtfSettings settings(fontPath, fontSize);
+		settings.antialiased = true;
+		settings.ranges = ofAlphabet::Japanese;
+		settings.dynamicAtlas = dynamicAtlas;
+
+		ofTrueTypeFont font;
+		auto start = ofGetElapsedTimeMicros();
+		if(!font.load(settings)){
+			ofLogError() << "couldn't load " << fontPath;
+			ofExit(1);
+			return;
+		}
+		auto loaded = ofGetElapsedTimeMicros();
+		auto & mesh = font.getStringMesh(text, 0, 0);
+		auto firstMesh = ofGetElapsedTimeMicros();
+		font.getStringMesh(text, 0, 0);
+		auto secondMesh = ofGetElapsedTimeMicros();
+
+		auto & texture = font.getFontTexture();
+		ofLogNotice() << (dynamicAtlas ? "dynamic atlas:" : "static atlas:");
+		ofLogNotice() << "  load:        " << (loaded - start) / 1000. << "ms";
+		ofLogNotice() << "  texture:     " << texture.getWidth() << "x" << texture.getHeight() << ", "
+			<< texture.getWidth() * texture.getHeight() * 2 / 1024 << "KB";
+		ofLogNotice() << "  first mesh:  " << (firstMesh - loaded) << "us, " << mesh.getNumVertices() / 4 << " glyphs";
+		ofLogNotice() << "  second mesh: " << (secondMesh - firstMesh) << "us";
+	}
+
+	string fontPath;
+	int fontSize;
+};
+
+//========================================================================
+int main(int argc, char ** argv){
+	string fontPath = OF_TTF_SANS;
+	int fontSize = 24;
+	if(argc > 1) fontPath = argv[1];
+	if(argc > 2) fontSize = ofToInt(argv[2]);
+
+	ofGLFWWindowSettings settings;
+	settings.width = 320;
+	settings.height = 240;
+	settings.visible = false;
+	ofCreateWindow(settings);
+	ofRunApp(new ofApp(fontPath, fontSize));
+}
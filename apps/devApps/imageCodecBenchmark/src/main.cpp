@@ -0,0 +1,88 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+
+// Encodes and decodes a generated photo like image to and from memory
+// with ofSaveImage() and ofLoadImage(), as PNG, JPEG and EXR, and reports
+// the throughput of each including the conversion between ofPixels and
+// FreeImage bitmaps. Loading also reports the time with
+// ofImageLoadSettings::maxWidth set to make a thumbnail.
+//
+// usage: imageCodecBenchmark [size] [iterations]
+class ofApp: public ofBaseApp{
+public:
+	ofApp(size_t size, size_t iterations)
+	:size(size)
+	,iterations(iterations){}
+
+	void setup(){
+		ofPixels pixels;
+		pixels.allocate(size, size, OF_PIXELS_RGB);
+		for(size_t y = 0; y < size; y++){
+			for(size_t x = 0; x < size; x++){
+				auto noise = ofNoise(x * 0.01f, y * 0.01f) * 200;
+				pixels.setColor(x, y, ofColor(noise + x % 7, 255 - noise, (x ^ y) & 0x3F));
+			}
+		}
+		ofFloatPixels floatPixels = pixels;
+
+		ofLogNotice() << size << "x" << size << " pixels, " << iterations << " iterations";
+		run("png", pixels, OF_IMAGE_FORMAT_PNG);
+		run("jpeg", pixels, OF_IMAGE_FORMAT_JPEG);
+		run("exr", floatPixels, OF_IMAGE_FORMAT_EXR);
+		ofExit();
+	}
+
+	template<typename PixelType>
+	void run(const string & name, const ofPixels_<PixelType> & pixels, ofImageFormat format){
+		ofBuffer buffer;
+		auto start = ofGetElapsedTimeMicros();
+		for(size_t i = 0; i < iterations; i++){
+			ofSaveImage(pixels, buffer, format);
+		}
+		report(name + " save", start, pixels.getTotalBytes());
+
+		ofPixels_<PixelType> loaded;
+		start = ofGetElapsedTimeMicros();
+		for(size_t i = 0; i < iterations; i++){
+			ofLoadImage(loaded, buffer);
+		}
+		report(name + " load", start, pixels.getTotalBytes());
+
+		ofImageLoadSettings settings;
+		settings.maxWidth = 256;
+		start = ofGetElapsedTimeMicros();
+		for(size_t i = 0; i < iterations; i++){
+			ofLoadImage(loaded, buffer, settings);
+		}
+		report(name + " load thumbnail", start, pixels.getTotalBytes());
+		ofLogNotice() << "    " << buffer.size() << " bytes encoded";
+	}
+
+	void report(const string & name, uint64_t start, size_t bytes){
+		auto seconds = (ofGetElapsedTimeMicros() - start) / 1000000.;
+		auto megapixels = size * size * iterations / 1000000.;
+		ofLogNotice() << name << ": " << seconds / iterations * 1000 << "ms, "
+			<< megapixels / seconds << " MPixels/s, " << bytes * iterations / seconds / 1024 / 1024 << " MB/s";
+	}
+
+	size_t size;
+	size_t iterations;
+};
+
+//========================================================================
+int main(int argc, char ** argv){
+	size_t size = 4096;
+	size_t iterations = 5;
+	if(argc > 1){
+		size = ofToInt(argv[1]);
+	}
+	if(argc > 2){
+		iterations = ofToInt(argv[2]);
+	}
+
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>(size, iterations);
+	ofRunApp(window, app);
+	ofRunMainLoop();
+}
@@ -0,0 +1,81 @@
+#include "ofMain.h"
+#include "ofAppGLFWWindow.h"
+
+// Reports the time to get the meshes of a few labels every frame with the
+// string mesh cache disabled and enabled and with ofTextLayout. Nothing is
+// drawn, the window is hidden, it's only needed for the GL context.
+//
+// usage: textLayoutBenchmark [font] [numFrames]
+class ofApp: public ofBaseApp{
+public:
+	ofApp(const string & fontPath, int numFrames)
+	:fontPath(fontPath)
+	,numFrames(numFrames){}
+
+	void setup(){
+		if(!font.load(fontPath, 16)){
+			ofLogError() << "couldn't load " << fontPath;
+			ofExit(1);
+			return;
+		}
+		for(int i = 0; i < 50; i++){
+			labels.push_back("label " + ofToString(i) + ": the quick brown fox jumps over the lazy dog");
+		}
+
+		font.setStringMeshCacheSize(0);
+		auto uncached = run([&](const string & label, float x, float y){
+			font.getStringMesh(label, x, y);
+		});
+		font.setStringMeshCacheSize(256);
+		auto cached = run([&](const string & label, float x, float y){
+			glm::vec2 translation;
+			font.getCachedStringMesh(label, x, y, true, translation);
+		});
+		vector<ofTextLayout> layouts;
+		for(auto & label: labels){
+			layouts.emplace_back(font, label);
+		}
+		size_t i = 0;
+		auto layout = run([&](const string &, float, float){
+			layouts[i++ % layouts.size()].getMesh();
+		});
+
+		ofLogNotice() << labels.size() << " labels per frame";
+		ofLogNotice() << "no cache:     " << uncached << "us per frame";
+		ofLogNotice() << "mesh cache:   " << cached << "us per frame";
+		ofLogNotice() << "ofTextLayout: " << layout << "us per frame";
+		ofExit();
+	}
+
+	double run(std::function<void(const string &, float, float)> f){
+		auto start = ofGetElapsedTimeMicros();
+		for(int frame = 0; frame < numFrames; frame++){
+			float y = 20;
+			for(auto & label: labels){
+				f(label, 10, y);
+				y += 20;
+			}
+		}
+		return double(ofGetElapsedTimeMicros() - start) / numFrames;
+	}
+
+	string fontPath;
+	int numFrames;
+	ofTrueTypeFont font;
+	vector<string> labels;
+};
+
+//========================================================================
+int main(int argc, char ** argv){
+	string fontPath = OF_TTF_SANS;
+	int numFrames = 1000;
+	if(argc > 1) fontPath = argv[1];
+	if(argc > 2) numFrames = ofToInt(argv[2]);
+
+	ofGLFWWindowSettings settings;
+	settings.width = 320;
+	settings.height = 240;
+	settings.visible = false;
+	ofCreateWindow(settings);
+	ofRunApp(new ofApp(fontPath, numFrames));
+}
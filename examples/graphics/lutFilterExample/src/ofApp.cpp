@@ -60,56 +60,14 @@ void ofApp::draw(){
 
 //--------------------------------------------------------------
 void ofApp::loadLUT(string path){
-	LUTloaded=false;
-	
-	ofFile file(path);
-	string line;
-	for(int i = 0; i < 5; i++) {
-		getline(file, line);
-		ofLog() << "Skipped line: " << line;	
-	}
-	for(int z=0; z<32; z++){
-		for(int y=0; y<32; y++){
-			for(int x=0; x<32; x++){
-				ofVec3f cur;
-				file >> cur.x >> cur.y >> cur.z;
-				lut[x][y][z] = cur;
-			}
-		}
-	}
-	
-	LUTloaded = true;
+	lut.load(path);
 }
+
 //--------------------------------------------------------------
 void ofApp::applyLUT(ofPixelsRef pix){
-	if (LUTloaded) {
-		
-		for(int y = 0; y < pix.getHeight(); y++){
-			for(int x = 0; x < pix.getWidth(); x++){
-				
-				ofColor color = pix.getColor(x, y);
-				
-				int lutPos [3];
-				for (int m=0; m<3; m++) {
-					lutPos[m] = color[m] / 8;
-					if (lutPos[m]==31) {
-						lutPos[m]=30;
-					}
-				}
-				
-				ofVec3f start = lut[lutPos[0]][lutPos[1]][lutPos[2]];
-				ofVec3f end = lut[lutPos[0]+1][lutPos[1]+1][lutPos[2]+1]; 
-				
-				for (int k=0; k<3; k++) {
-					float amount = (color[k] % 8) / 8.0f;
-					color[k]= (start[k] + amount * (end[k] - start[k])) * 255;
-				}
-				
-				lutImg.setColor(x, y, color);
-				
-			}			
-		}
-		
+	// maps every pixel through the table, interpolating between its
+	// entries, on all the cores of the computer
+	if(ofApplyLut(pix, lutImg.getPixels(), lut)){
 		lutImg.update();
 	}
 }
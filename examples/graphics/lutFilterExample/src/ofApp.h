@@ -31,9 +31,7 @@ public:
 	ofPoint lutPos;
 	ofPoint thumbPos;
 	
-	bool LUTloaded;
-	ofVec3f lut[32][32][32];
-	
+	ofLut3D lut;
 	ofImage lutImg;
 	
 	
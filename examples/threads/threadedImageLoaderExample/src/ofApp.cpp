@@ -7,7 +7,8 @@ void ofApp::setup(){
 	total = 24;
 	images.resize(total*2);
 	for(int i = 0; i < total; ++i) {
-		loader.loadFromDisk(images[i*2], "of" + ofToString(i) + ".png");
+		// the first row is loaded first
+		loader.loadFromDisk(images[i*2], "of" + ofToString(i) + ".png", i < 4 ? 1 : 0);
 		loader.loadFromURL(images[i*2+1], "http://www.openframeworks.cc/images/of_inverted.png");
 	}
 }
@@ -37,7 +38,7 @@ void ofApp::draw(){
 
 //--------------------------------------------------------------
 void ofApp::exit(){
-	loader.stopThread();
+	loader.cancelAll();
 }
 
 //--------------------------------------------------------------
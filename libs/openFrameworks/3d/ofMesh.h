@@ -6,6 +6,8 @@
 
 #include "ofGLUtils.h"
 #include "ofConstants.h"
+#include "ofAsyncFileLoader.h"
+#include "ofAssetPack.h"
 
 template<class V, class N, class C, class T>
 class ofMeshFace_;
@@ -740,3 +742,24 @@ private:
 
 using ofMesh = ofMesh_<ofDefaultVertexType, ofDefaultNormalType, ofDefaultColorType, ofDefaultTexCoordType>;
 using ofMeshFace = ofMeshFace_<ofDefaultVertexType, ofDefaultNormalType, ofDefaultColorType, ofDefaultTexCoordType>;
+
+/// \brief Load a PLY mesh without blocking the calling thread.
+///
+/// The file is parsed in one of the file loader threads, see
+/// ofLoadFileAsync(), and \p done is called with the mesh from the main
+/// thread during a later update.
+///
+/// \returns The id of the request, see ofCancelFileRequest() and
+/// ofSetFileRequestPriority().
+inline int ofLoadMeshAsync(const std::filesystem::path & path, std::function<void(ofMesh & mesh, const ofFileLoadResult & result)> done, int priority = 0){
+	auto mesh = std::make_shared<ofMesh>();
+	return ofLoadFileAsync(path, [mesh](const std::filesystem::path & path){
+		if(!ofFile::doesFileExist(path) && !ofIsInMountedAssetPack(path)){
+			return false;
+		}
+		mesh->load(path);
+		return mesh->getNumVertices() > 0;
+	}, [mesh, done](const ofFileLoadResult & result){
+		done(*mesh, result);
+	}, priority);
+}
@@ -1025,12 +1025,11 @@ void ofMesh_<V,N,C,T>::append(const ofMesh_<V,N,C,T> & mesh){
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
 void ofMesh_<V,N,C,T>::load(std::filesystem::path path){
-	ofFile is(path, ofFile::ReadOnly);
 	auto & data = *this;
 
 
 	string error;
-	ofBuffer buffer(is);
+	ofBuffer buffer = ofBufferFromFile(path);
 	auto backup = data;
 
 	int orderVertices=-1;
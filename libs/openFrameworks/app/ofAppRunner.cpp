@@ -102,6 +102,7 @@ namespace{
 
 void ofExitCallback();
 void ofURLFileLoaderShutdown();
+void ofAsyncFileLoaderShutdown();
 
 void ofInit(){
 	if(initialized()) return;
@@ -234,6 +235,7 @@ void ofExitCallback(){
 
 	// finish every library and subsystem
 	ofURLFileLoaderShutdown();
+	ofAsyncFileLoaderShutdown();
 
 	#ifndef TARGET_NO_SOUND
 		//------------------------
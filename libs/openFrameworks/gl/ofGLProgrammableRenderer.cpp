@@ -1841,9 +1841,16 @@ void ofGLProgrammableRenderer::drawString(const ofTrueTypeFont & font, string te
 
 	mutThis->setBlendMode(OF_BLENDMODE_ALPHA);
 
+	// get the mesh before binding the texture, fonts with a dynamic atlas
+	// might need to update it
+	glm::vec2 translation;
+	const ofMesh & mesh = font.getCachedStringMesh(text,x,y,isVFlipped(),translation);
+	mutThis->pushMatrix();
+	mutThis->translate(translation.x,translation.y);
 	mutThis->bind(font.getFontTexture(),0);
-	draw(font.getStringMesh(text,x,y,isVFlipped()),OF_MESH_FILL);
+	draw(mesh,OF_MESH_FILL);
 	mutThis->unbind(font.getFontTexture(),0);
+	mutThis->popMatrix();
 
 	mutThis->setBlendMode(blendMode);
 }
@@ -1688,9 +1688,16 @@ void ofGLRenderer::drawString(const ofTrueTypeFont & font, string text, float x,
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+	// get the mesh before binding the texture, fonts with a dynamic atlas
+	// might need to update it
+	glm::vec2 translation;
+	const ofMesh & mesh = font.getCachedStringMesh(text,x,y,isVFlipped(),translation);
+	mutThis->pushMatrix();
+	mutThis->translate(translation.x,translation.y);
 	mutThis->bind(font.getFontTexture(),0);
-	draw(font.getStringMesh(text,x,y,isVFlipped()),OF_MESH_FILL);
+	draw(mesh,OF_MESH_FILL);
 	mutThis->unbind(font.getFontTexture(),0);
+	mutThis->popMatrix();
 
 	if(!blendEnabled){
 		glDisable(GL_BLEND);
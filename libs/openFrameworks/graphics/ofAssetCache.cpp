@@ -0,0 +1,470 @@
+#include "ofAssetCache.h"
+#include "ofLog.h"
+#include "ofThreadPool.h"
+#include "ofUtils.h"
+#include <atomic>
+#include <ctime>
+#include <fstream>
+#include <limits>
+
+
+namespace{
+	// XXH64, see https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+	const uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+	const uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+	const uint64_t prime3 = 0x165667B19E3779F9ULL;
+	const uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+	const uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+	uint64_t rotl(uint64_t x, int r){
+		return (x << r) | (x >> (64 - r));
+	}
+
+	uint64_t read64(const uint8_t * p){
+		uint64_t v;
+		memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	uint32_t read32(const uint8_t * p){
+		uint32_t v;
+		memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	uint64_t hashRound(uint64_t acc, uint64_t input){
+		return rotl(acc + input * prime2, 31) * prime1;
+	}
+
+	uint64_t hashMerge(uint64_t acc, uint64_t value){
+		return (acc ^ hashRound(0, value)) * prime1 + prime4;
+	}
+
+	uint64_t hash64(const void * data, std::size_t size, uint64_t seed){
+		auto p = static_cast<const uint8_t*>(data);
+		auto end = p + size;
+		uint64_t h;
+		if(size >= 32){
+			uint64_t v1 = seed + prime1 + prime2;
+			uint64_t v2 = seed + prime2;
+			uint64_t v3 = seed;
+			uint64_t v4 = seed - prime1;
+			for(; end - p >= 32; p += 32){
+				v1 = hashRound(v1, read64(p));
+				v2 = hashRound(v2, read64(p + 8));
+				v3 = hashRound(v3, read64(p + 16));
+				v4 = hashRound(v4, read64(p + 24));
+			}
+			h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+			h = hashMerge(h, v1);
+			h = hashMerge(h, v2);
+			h = hashMerge(h, v3);
+			h = hashMerge(h, v4);
+		}else{
+			h = seed + prime5;
+		}
+		h += size;
+		for(; end - p >= 8; p += 8){
+			h = rotl(h ^ hashRound(0, read64(p)), 27) * prime1 + prime4;
+		}
+		if(end - p >= 4){
+			h = rotl(h ^ (read32(p) * prime1), 23) * prime2 + prime3;
+			p += 4;
+		}
+		for(; p < end; p++){
+			h = rotl(h ^ (*p * prime5), 11) * prime1;
+		}
+		h ^= h >> 33;
+		h *= prime2;
+		h ^= h >> 29;
+		h *= prime3;
+		h ^= h >> 32;
+		return h;
+	}
+
+	// pixels and meshes start with a header that keeps the data after it
+	// aligned when the entry is mapped
+	struct PixelsHeader{
+		char magic[8];
+		uint64_t width;
+		uint64_t height;
+		uint64_t totalBytes;
+		uint32_t pixelFormat;
+		uint32_t bytesPerChannel;
+		uint8_t reserved[24];
+	};
+
+	struct MeshHeader{
+		char magic[8];
+		uint32_t mode;
+		uint16_t indexSize;
+		uint16_t vertexSize;
+		uint16_t normalSize;
+		uint16_t colorSize;
+		uint16_t texCoordSize;
+		uint16_t reserved;
+		uint64_t numVertices;
+		uint64_t numNormals;
+		uint64_t numColors;
+		uint64_t numTexCoords;
+		uint64_t numIndices;
+	};
+
+	static_assert(sizeof(PixelsHeader) == 64 && sizeof(MeshHeader) == 64, "cache headers have to keep the data aligned");
+
+	const char pixelsMagic[8] = {'o','f','P','i','x','e','l','s'};
+	const char meshMagic[8] = {'o','f','M','e','s','h','\0','\1'};
+
+	// filesystem errors only mean an entry can't be used or removed yet,
+	// the cache works without it
+	bool removeEntry(const std::filesystem::path & path){
+		try{
+			return std::filesystem::remove(path);
+		}catch(...){
+			return false;
+		}
+	}
+}
+
+struct ofAssetCache::Impl{
+	ofCoreMutex mutex;
+	std::filesystem::path directory = ".ofcache";
+	uint64_t maxSize = 512 * 1024 * 1024;
+	// -1 until the directory is listed the first time
+	int64_t size = -1;
+	std::atomic<uint64_t> nextTemporary{0};
+
+	// has to be called with the mutex locked
+	std::filesystem::path getAbsoluteDirectory() const{
+		return ofToDataPath(directory, true);
+	}
+
+	// has to be called with the mutex locked
+	ofDirectoryListing list() const{
+		auto absolute = getAbsoluteDirectory();
+		if(!ofDirectory::doesDirectoryExist(absolute.string(), false)){
+			return ofDirectoryListing();
+		}
+		return ofDirectory(absolute).scan(false);
+	}
+
+	// has to be called with the mutex locked
+	uint64_t getSize(){
+		if(size < 0){
+			auto listing = list();
+			size = 0;
+			for(std::size_t i = 0; i < listing.size(); i++){
+				size += listing.getSize(i);
+			}
+		}
+		return size;
+	}
+};
+
+//--------------------------------------------------
+ofAssetCache::ofAssetCache()
+:impl(new Impl){}
+
+//--------------------------------------------------
+ofAssetCache::~ofAssetCache(){}
+
+//--------------------------------------------------
+void ofAssetCache::setDirectory(const std::filesystem::path & directory){
+	ofCoreLock lock(impl->mutex);
+	impl->directory = directory;
+	impl->size = -1;
+}
+
+//--------------------------------------------------
+std::filesystem::path ofAssetCache::getDirectory() const{
+	ofCoreLock lock(impl->mutex);
+	return impl->directory;
+}
+
+//--------------------------------------------------
+void ofAssetCache::setMaxSize(uint64_t bytes){
+	ofCoreLock lock(impl->mutex);
+	impl->maxSize = bytes;
+	if(impl->getSize() > impl->maxSize){
+		evict();
+	}
+}
+
+//--------------------------------------------------
+uint64_t ofAssetCache::getMaxSize() const{
+	ofCoreLock lock(impl->mutex);
+	return impl->maxSize;
+}
+
+//--------------------------------------------------
+uint64_t ofAssetCache::getSize() const{
+	ofCoreLock lock(impl->mutex);
+	return impl->getSize();
+}
+
+//--------------------------------------------------
+void ofAssetCache::clear(){
+	ofCoreLock lock(impl->mutex);
+	auto listing = impl->list();
+	for(std::size_t i = 0; i < listing.size(); i++){
+		removeEntry(listing.getPath(i));
+	}
+	impl->size = -1;
+}
+
+//--------------------------------------------------
+// has to be called with the mutex locked
+void ofAssetCache::evict(){
+	auto listing = impl->list();
+	listing.sortByDate();
+	uint64_t size = 0;
+	for(std::size_t i = 0; i < listing.size(); i++){
+		size += listing.getSize(i);
+	}
+
+	// remove a bit more than needed so not every new entry evicts another
+	auto target = impl->maxSize - impl->maxSize / 4;
+	auto now = std::time(nullptr);
+	for(std::size_t i = 0; i < listing.size() && size > target; i++){
+		// entries being written by other threads or processes are skipped,
+		// the ones left by a crash are removed after a while
+		if(listing.getName(i).endsWith(".tmp") && now - listing.getModified(i) < 3600){
+			continue;
+		}
+		if(removeEntry(listing.getPath(i))){
+			size -= listing.getSize(i);
+		}
+	}
+	impl->size = size;
+}
+
+//--------------------------------------------------
+std::string ofAssetCache::makeKey(const ofBuffer & source, ofStringView parameters){
+	auto sourceHash = hash64(source.getData(), source.size(), 0);
+	auto parametersHash = hash64(parameters.data(), parameters.size(), sourceHash);
+	char key[33];
+	snprintf(key, sizeof(key), "%016llx%016llx", (unsigned long long)sourceHash, (unsigned long long)parametersHash);
+	return key;
+}
+
+//--------------------------------------------------
+bool ofAssetCache::load(const std::string & key, ofBuffer & data){
+	std::filesystem::path path;
+	{
+		ofCoreLock lock(impl->mutex);
+		path = impl->getAbsoluteDirectory() / key;
+	}
+	if(!data.map(path)){
+		return false;
+	}
+	// the modification time is the last use for eviction
+	try{
+		std::filesystem::last_write_time(path, std::time(nullptr));
+	}catch(...){}
+	return true;
+}
+
+//--------------------------------------------------
+bool ofAssetCache::store(const std::string & key, const std::vector<std::pair<const void*, std::size_t>> & parts){
+	std::filesystem::path directory;
+	{
+		ofCoreLock lock(impl->mutex);
+		directory = impl->getAbsoluteDirectory();
+	}
+	try{
+		std::filesystem::create_directories(directory);
+	}catch(...){
+		ofLogError("ofAssetCache") << "store(): couldn't create " << directory;
+		return false;
+	}
+	auto path = directory / key;
+	auto temporary = directory / (key + "." + ofToString(impl->nextTemporary++) + "." + ofToString(ofGetSystemTimeMicros()) + ".tmp");
+
+	uint64_t size = 0;
+	{
+		std::ofstream out(temporary.string(), std::ios::binary);
+		for(auto & part: parts){
+			out.write(static_cast<const char*>(part.first), part.second);
+			size += part.second;
+		}
+		out.close();
+		if(out.fail()){
+			ofLogError("ofAssetCache") << "store(): couldn't write " << temporary;
+			removeEntry(temporary);
+			return false;
+		}
+	}
+
+	// the size of the entry being replaced is found with the mutex locked
+	// so stores of the same key at the same time don't count it twice
+	ofCoreLock lock(impl->mutex);
+	uint64_t replacedSize = 0;
+	try{
+		if(std::filesystem::exists(path)){
+			replacedSize = std::filesystem::file_size(path);
+		}
+		// replacing an entry that's mapped fails on some systems, it'll be
+		// stored again next time
+		std::filesystem::rename(temporary, path);
+	}catch(...){
+		removeEntry(temporary);
+		return false;
+	}
+
+	if(impl->size >= 0){
+		impl->size += int64_t(size) - int64_t(replacedSize);
+	}
+	if(impl->getSize() > impl->maxSize){
+		evict();
+	}
+	return true;
+}
+
+//--------------------------------------------------
+bool ofAssetCache::store(const std::string & key, const ofBuffer & data){
+	return store(key, {{data.getData(), data.size()}});
+}
+
+//--------------------------------------------------
+template<typename PixelType>
+bool ofAssetCache::loadPixels(const std::string & key, ofPixels_<PixelType> & pixels){
+	ofBuffer data;
+	if(!load(key, data) || data.size() < sizeof(PixelsHeader)){
+		return false;
+	}
+	PixelsHeader header;
+	memcpy(&header, data.getData(), sizeof(header));
+	if(memcmp(header.magic, pixelsMagic, sizeof(pixelsMagic)) != 0
+	   || header.bytesPerChannel != sizeof(PixelType)
+	   || header.width > std::numeric_limits<int32_t>::max() || header.height > std::numeric_limits<int32_t>::max()
+	   || header.totalBytes != data.size() - sizeof(header)
+	   || header.totalBytes != ofPixels_<PixelType>::bytesFromPixelFormat(header.width, header.height, ofPixelFormat(header.pixelFormat))){
+		return false;
+	}
+	pixels.setFromPixels(reinterpret_cast<const PixelType*>(data.getData() + sizeof(header)), header.width, header.height, ofPixelFormat(header.pixelFormat));
+	return true;
+}
+
+//--------------------------------------------------
+template<typename PixelType>
+bool ofAssetCache::storePixels(const std::string & key, const ofPixels_<PixelType> & pixels){
+	PixelsHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, pixelsMagic, sizeof(pixelsMagic));
+	header.width = pixels.getWidth();
+	header.height = pixels.getHeight();
+	header.totalBytes = pixels.getTotalBytes();
+	header.pixelFormat = pixels.getPixelFormat();
+	header.bytesPerChannel = sizeof(PixelType);
+	return store(key, {{&header, sizeof(header)}, {pixels.getData(), pixels.getTotalBytes()}});
+}
+
+//--------------------------------------------------
+bool ofAssetCache::load(const std::string & key, ofPixels & pixels){
+	return loadPixels(key, pixels);
+}
+
+//--------------------------------------------------
+bool ofAssetCache::load(const std::string & key, ofFloatPixels & pixels){
+	return loadPixels(key, pixels);
+}
+
+//--------------------------------------------------
+bool ofAssetCache::load(const std::string & key, ofShortPixels & pixels){
+	return loadPixels(key, pixels);
+}
+
+//--------------------------------------------------
+bool ofAssetCache::store(const std::string & key, const ofPixels & pixels){
+	return storePixels(key, pixels);
+}
+
+//--------------------------------------------------
+bool ofAssetCache::store(const std::string & key, const ofFloatPixels & pixels){
+	return storePixels(key, pixels);
+}
+
+//--------------------------------------------------
+bool ofAssetCache::store(const std::string & key, const ofShortPixels & pixels){
+	return storePixels(key, pixels);
+}
+
+//--------------------------------------------------
+bool ofAssetCache::load(const std::string & key, ofMesh & mesh){
+	ofBuffer data;
+	if(!load(key, data) || data.size() < sizeof(MeshHeader)){
+		return false;
+	}
+	MeshHeader header;
+	memcpy(&header, data.getData(), sizeof(header));
+	if(memcmp(header.magic, meshMagic, sizeof(meshMagic)) != 0
+	   || header.indexSize != sizeof(ofIndexType)
+	   || header.vertexSize != sizeof(ofDefaultVertexType)
+	   || header.normalSize != sizeof(ofDefaultNormalType)
+	   || header.colorSize != sizeof(ofDefaultColorType)
+	   || header.texCoordSize != sizeof(ofDefaultTexCoordType)){
+		return false;
+	}
+	// every count is checked against the size left so a truncated or
+	// corrupt entry can't be read past its end
+	const char * next = data.getData() + sizeof(header);
+	auto left = data.size() - sizeof(header);
+	auto take = [&](uint64_t count, std::size_t elementSize){
+		auto start = next;
+		if(count > left / elementSize){
+			return static_cast<const char*>(nullptr);
+		}
+		next += count * elementSize;
+		left -= count * elementSize;
+		return start;
+	};
+	auto vertices = take(header.numVertices, header.vertexSize);
+	auto normals = take(header.numNormals, header.normalSize);
+	auto colors = take(header.numColors, header.colorSize);
+	auto texCoords = take(header.numTexCoords, header.texCoordSize);
+	auto indices = take(header.numIndices, header.indexSize);
+	if(!vertices || !normals || !colors || !texCoords || !indices || left != 0){
+		return false;
+	}
+
+	mesh.clear();
+	mesh.setMode(ofPrimitiveMode(header.mode));
+	mesh.addVertices(reinterpret_cast<const ofDefaultVertexType*>(vertices), header.numVertices);
+	mesh.addNormals(reinterpret_cast<const ofDefaultNormalType*>(normals), header.numNormals);
+	mesh.addColors(reinterpret_cast<const ofDefaultColorType*>(colors), header.numColors);
+	mesh.addTexCoords(reinterpret_cast<const ofDefaultTexCoordType*>(texCoords), header.numTexCoords);
+	mesh.addIndices(reinterpret_cast<const ofIndexType*>(indices), header.numIndices);
+	return true;
+}
+
+//--------------------------------------------------
+bool ofAssetCache::store(const std::string & key, const ofMesh & mesh){
+	MeshHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, meshMagic, sizeof(meshMagic));
+	header.mode = mesh.getMode();
+	header.indexSize = sizeof(ofIndexType);
+	header.vertexSize = sizeof(ofDefaultVertexType);
+	header.normalSize = sizeof(ofDefaultNormalType);
+	header.colorSize = sizeof(ofDefaultColorType);
+	header.texCoordSize = sizeof(ofDefaultTexCoordType);
+	header.numVertices = mesh.getNumVertices();
+	header.numNormals = mesh.getNumNormals();
+	header.numColors = mesh.getNumColors();
+	header.numTexCoords = mesh.getNumTexCoords();
+	header.numIndices = mesh.getNumIndices();
+	return store(key, {
+		{&header, sizeof(header)},
+		{mesh.getVerticesPointer(), header.numVertices * header.vertexSize},
+		{mesh.getNormalsPointer(), header.numNormals * header.normalSize},
+		{mesh.getColorsPointer(), header.numColors * header.colorSize},
+		{mesh.getTexCoordsPointer(), header.numTexCoords * header.texCoordSize},
+		{mesh.getIndexPointer(), header.numIndices * header.indexSize},
+	});
+}
+
+//--------------------------------------------------
+ofAssetCache & ofGetAssetCache(){
+	static ofAssetCache * cache = new ofAssetCache;
+	return *cache;
+}
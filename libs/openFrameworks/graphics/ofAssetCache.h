@@ -0,0 +1,99 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofFileUtils.h"
+#include "ofPixels.h"
+#include "ofMesh.h"
+
+/// \class ofAssetCache
+///
+/// A disk cache for decoded assets, so images, fonts and meshes are only
+/// decoded, rasterized or tessellated the first time an app runs.
+///
+/// Entries are keyed by a hash of the contents of the source file and the
+/// parameters used to decode it, see makeKey(), so a modified source or
+/// different settings never return stale data and identical files share
+/// one entry. They are stored in their in memory layout, aligned to 64
+/// bytes, and mapped when loaded.
+///
+/// ofLoadImage and ofImage::load use the cache when
+/// ofImageLoadSettings::useCache is set and ofTrueTypeFont::load when
+/// ofTtfSettings::useCache is, both through ofGetAssetCache(). Other
+/// assets can be stored with the load() and store() overloads:
+///
+/// ~~~~{.cpp}
+/// auto key = ofAssetCache::makeKey(ofBufferFromFile("logo.svg"), "tessellation 1");
+/// if(!ofGetAssetCache().load(key, mesh)){
+///     mesh = svg.getPathAt(0).getTessellation();
+///     ofGetAssetCache().store(key, mesh);
+/// }
+/// ~~~~
+///
+/// When the entries take more than getMaxSize() bytes, the ones used
+/// least recently are removed. Entries are written to a temporary file
+/// and renamed, so several threads or processes can share the directory.
+/// The cache holds data in the format of the machine that created it and
+/// isn't meant to be shipped with an app.
+class ofAssetCache{
+public:
+	/// \brief Create a cache in the .ofcache folder of the data folder
+	/// limited to 512MB.
+	ofAssetCache();
+	~ofAssetCache();
+
+	/// \brief Change the folder the entries are stored in, relative to the
+	/// data folder. It's created when the first entry is stored.
+	void setDirectory(const std::filesystem::path & directory);
+	std::filesystem::path getDirectory() const;
+
+	/// \brief Limit the size of all the entries, 512MB by default.
+	void setMaxSize(uint64_t bytes);
+	uint64_t getMaxSize() const;
+
+	/// \returns the size of all the entries in bytes.
+	uint64_t getSize() const;
+
+	/// \brief Remove all the entries.
+	void clear();
+
+	/// \brief The key of an entry, a hash of the contents of the source
+	/// and of a description of how it's decoded.
+	///
+	/// \param source Contents of the source file.
+	/// \param parameters Everything besides the source the decoded data
+	/// depends on, ie. "ofPixels 8 grayscale".
+	static std::string makeKey(const ofBuffer & source, ofStringView parameters);
+
+	/// \brief Map the entry with this key.
+	/// \returns false if there's no entry with this key.
+	bool load(const std::string & key, ofBuffer & data);
+	bool load(const std::string & key, ofPixels & pixels);
+	bool load(const std::string & key, ofFloatPixels & pixels);
+	bool load(const std::string & key, ofShortPixels & pixels);
+	bool load(const std::string & key, ofMesh & mesh);
+
+	/// \brief Store an entry, replacing any with the same key.
+	/// \returns false if the entry couldn't be written.
+	bool store(const std::string & key, const ofBuffer & data);
+	bool store(const std::string & key, const ofPixels & pixels);
+	bool store(const std::string & key, const ofFloatPixels & pixels);
+	bool store(const std::string & key, const ofShortPixels & pixels);
+	bool store(const std::string & key, const ofMesh & mesh);
+
+private:
+	ofAssetCache(const ofAssetCache &) = delete;
+	ofAssetCache & operator=(const ofAssetCache &) = delete;
+
+	template<typename PixelType>
+	bool loadPixels(const std::string & key, ofPixels_<PixelType> & pixels);
+	template<typename PixelType>
+	bool storePixels(const std::string & key, const ofPixels_<PixelType> & pixels);
+	bool store(const std::string & key, const std::vector<std::pair<const void*, std::size_t>> & parts);
+	void evict();
+
+	struct Impl;
+	std::unique_ptr<Impl> impl;
+};
+
+/// \returns the cache used by the image and font loaders.
+ofAssetCache & ofGetAssetCache();
@@ -0,0 +1,367 @@
+#include "ofGlyphAtlas.h"
+#include "ofLog.h"
+#include <limits>
+
+//--------------------------------------------------------------
+ofSkylinePacker::ofSkylinePacker()
+:ofSkylinePacker(0, 0){
+}
+
+//--------------------------------------------------------------
+ofSkylinePacker::ofSkylinePacker(int width, int height){
+	reset(width, height);
+}
+
+//--------------------------------------------------------------
+void ofSkylinePacker::reset(int w, int h){
+	width = w;
+	height = h;
+	usedArea = 0;
+	skyline.clear();
+	skyline.push_back({0, 0, width});
+}
+
+//--------------------------------------------------------------
+// top of a rectangle placed at the start of segment index, or -1 if it
+// doesn't fit there
+int ofSkylinePacker::fit(size_t index, int w, int h) const{
+	int x = skyline[index].x;
+	if(x + w > width){
+		return -1;
+	}
+	int y = 0;
+	int spaceLeft = w;
+	while(spaceLeft > 0){
+		if(index == skyline.size()){
+			return -1;
+		}
+		y = std::max(y, skyline[index].y);
+		if(y + h > height){
+			return -1;
+		}
+		spaceLeft -= skyline[index].width;
+		index++;
+	}
+	return y;
+}
+
+//--------------------------------------------------------------
+void ofSkylinePacker::addLevel(size_t index, int x, int y, int w, int h){
+	skyline.insert(skyline.begin() + index, {x, y + h, w});
+
+	// shrink or remove the segments now covered by the new one
+	for(size_t i = index + 1; i < skyline.size();){
+		auto & previous = skyline[i - 1];
+		auto & segment = skyline[i];
+		if(segment.x < previous.x + previous.width){
+			int shrink = previous.x + previous.width - segment.x;
+			segment.x += shrink;
+			segment.width -= shrink;
+			if(segment.width <= 0){
+				skyline.erase(skyline.begin() + i);
+				continue;
+			}
+		}
+		break;
+	}
+
+	// merge neighbours at the same height
+	for(size_t i = 0; i + 1 < skyline.size();){
+		if(skyline[i].y == skyline[i + 1].y){
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase(skyline.begin() + i + 1);
+		}else{
+			i++;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+bool ofSkylinePacker::pack(int w, int h, int & x, int & y){
+	if(w <= 0 || h <= 0 || w > width || h > height){
+		return false;
+	}
+	int bestIndex = -1;
+	int bestBottom = height + 1;
+	int bestWidth = width + 1;
+	for(size_t i = 0; i < skyline.size(); i++){
+		int top = fit(i, w, h);
+		if(top == -1){
+			continue;
+		}
+		if(top + h < bestBottom || (top + h == bestBottom && skyline[i].width < bestWidth)){
+			bestIndex = i;
+			bestBottom = top + h;
+			bestWidth = skyline[i].width;
+			x = skyline[i].x;
+			y = top;
+		}
+	}
+	if(bestIndex == -1){
+		return false;
+	}
+	addLevel(bestIndex, x, y, w, h);
+	usedArea += size_t(w) * size_t(h);
+	return true;
+}
+
+//--------------------------------------------------------------
+int ofSkylinePacker::getWidth() const{
+	return width;
+}
+
+//--------------------------------------------------------------
+int ofSkylinePacker::getHeight() const{
+	return height;
+}
+
+//--------------------------------------------------------------
+float ofSkylinePacker::getOccupancy() const{
+	if(width == 0 || height == 0){
+		return 0;
+	}
+	return float(usedArea) / (float(width) * float(height));
+}
+
+
+//--------------------------------------------------------------
+ofGlyphAtlas::ofGlyphAtlas()
+:border(1)
+,useClock(0)
+,batchBegin(std::numeric_limits<uint64_t>::max())
+,batchFull(false)
+,numEvicted(0)
+,generation(0)
+,dirtyBegin(0)
+,dirtyEnd(0){
+}
+
+//--------------------------------------------------------------
+void ofGlyphAtlas::allocate(int width, int height, int b){
+	border = b;
+	pixels.allocate(width, height, OF_PIXELS_GRAY_ALPHA);
+	numEvicted = 0;
+	tooLarge.clear();
+	clear();
+}
+
+//--------------------------------------------------------------
+void ofGlyphAtlas::clear(){
+	entries.clear();
+	packer.reset(pixels.getWidth(), pixels.getHeight());
+	if(pixels.isAllocated()){
+		pixels.set(0, 255);
+		pixels.set(1, 0);
+	}
+	useClock = 0;
+	// no batch until beginBatch() is called
+	batchBegin = std::numeric_limits<uint64_t>::max();
+	batchFull = false;
+	generation++;
+	setDirty(0, pixels.getHeight());
+}
+
+//--------------------------------------------------------------
+const ofGlyphAtlas::Region * ofGlyphAtlas::get(uint32_t glyph){
+	auto it = entries.find(glyph);
+	if(it == entries.end()){
+		return nullptr;
+	}
+	it->second.lastUse = ++useClock;
+	return &it->second.region;
+}
+
+//--------------------------------------------------------------
+const ofGlyphAtlas::Region * ofGlyphAtlas::add(uint32_t glyph, const ofPixels & glyphPixels){
+	auto it = entries.find(glyph);
+	if(it != entries.end()){
+		it->second.lastUse = ++useClock;
+		return &it->second.region;
+	}
+
+	Entry entry;
+	entry.region = {0, 0, 0, 0};
+	int width = glyphPixels.getWidth();
+	int height = glyphPixels.getHeight();
+	if(glyphPixels.isAllocated() && width > 0 && height > 0){
+		if(glyphPixels.getNumChannels() != pixels.getNumChannels()){
+			ofLogError("ofGlyphAtlas") << "add(): glyph " << glyph << " has " << glyphPixels.getNumChannels()
+				<< " channels, expected " << pixels.getNumChannels();
+			return nullptr;
+		}
+		if(width + border * 2 > int(pixels.getWidth()) || height + border * 2 > int(pixels.getHeight())){
+			// only warn the first time, strings with this glyph try to add
+			// it every time they are laid out
+			if(tooLarge.insert(glyph).second){
+				ofLogWarning("ofGlyphAtlas") << "add(): glyph " << glyph << " is " << width << "x" << height
+					<< ", too large for a " << pixels.getWidth() << "x" << pixels.getHeight() << " atlas";
+			}
+			return nullptr;
+		}
+		if(!pack(width, height, entry.region)){
+			// once the current batch alone fills the atlas evicting again
+			// won't free anything until the next batch
+			if(batchFull){
+				return nullptr;
+			}
+			evict();
+			if(!pack(width, height, entry.region)){
+				batchFull = true;
+				return nullptr;
+			}
+		}
+		copyGlyph(glyphPixels, 0, 0, entry.region);
+	}
+	entry.lastUse = ++useClock;
+	return &(entries[glyph] = entry).region;
+}
+
+//--------------------------------------------------------------
+bool ofGlyphAtlas::isTooLarge(uint32_t glyph) const{
+	return tooLarge.find(glyph) != tooLarge.end();
+}
+
+//--------------------------------------------------------------
+void ofGlyphAtlas::beginBatch(){
+	batchBegin = useClock + 1;
+	batchFull = false;
+}
+
+//--------------------------------------------------------------
+bool ofGlyphAtlas::contains(uint32_t glyph) const{
+	return entries.find(glyph) != entries.end();
+}
+
+//--------------------------------------------------------------
+size_t ofGlyphAtlas::size() const{
+	return entries.size();
+}
+
+//--------------------------------------------------------------
+size_t ofGlyphAtlas::getNumEvicted() const{
+	return numEvicted;
+}
+
+//--------------------------------------------------------------
+uint64_t ofGlyphAtlas::getGeneration() const{
+	return generation;
+}
+
+//--------------------------------------------------------------
+const ofPixels & ofGlyphAtlas::getPixels() const{
+	return pixels;
+}
+
+//--------------------------------------------------------------
+float ofGlyphAtlas::getOccupancy() const{
+	return packer.getOccupancy();
+}
+
+//--------------------------------------------------------------
+bool ofGlyphAtlas::isDirty() const{
+	return dirtyEnd > dirtyBegin;
+}
+
+//--------------------------------------------------------------
+int ofGlyphAtlas::getDirtyBegin() const{
+	return dirtyBegin;
+}
+
+//--------------------------------------------------------------
+int ofGlyphAtlas::getDirtyEnd() const{
+	return dirtyEnd;
+}
+
+//--------------------------------------------------------------
+void ofGlyphAtlas::clearDirty(){
+	dirtyBegin = dirtyEnd = 0;
+}
+
+//--------------------------------------------------------------
+bool ofGlyphAtlas::pack(int width, int height, Region & region){
+	int x, y;
+	if(!packer.pack(width + border * 2, height + border * 2, x, y)){
+		return false;
+	}
+	region = {x + border, y + border, width, height};
+	return true;
+}
+
+//--------------------------------------------------------------
+void ofGlyphAtlas::evict(){
+	// keep the glyphs used in the current batch and the most recently used
+	// ones up to half the atlas, so the next glyphs have space to go
+	std::vector<std::pair<uint32_t, Entry>> sorted(entries.begin(), entries.end());
+	std::sort(sorted.begin(), sorted.end(), [](const std::pair<uint32_t, Entry> & a, const std::pair<uint32_t, Entry> & b){
+		return a.second.lastUse > b.second.lastUse;
+	});
+
+	size_t budget = pixels.getWidth() * pixels.getHeight() / 2;
+	size_t keptArea = 0;
+	std::vector<std::pair<uint32_t, Entry>> kept;
+	for(auto & entry: sorted){
+		auto & region = entry.second.region;
+		size_t area = region.width > 0 ? size_t(region.width + border * 2) * size_t(region.height + border * 2) : 0;
+		if(entry.second.lastUse >= batchBegin || keptArea + area <= budget){
+			kept.push_back(entry);
+			keptArea += area;
+		}else{
+			numEvicted++;
+		}
+	}
+
+	// repack what's left tallest first, copying the pixels from the old atlas
+	std::sort(kept.begin(), kept.end(), [](const std::pair<uint32_t, Entry> & a, const std::pair<uint32_t, Entry> & b){
+		if(a.second.region.height != b.second.region.height){
+			return a.second.region.height > b.second.region.height;
+		}
+		if(a.second.region.width != b.second.region.width){
+			return a.second.region.width > b.second.region.width;
+		}
+		return a.first < b.first;
+	});
+
+	ofPixels old;
+	std::swap(old, pixels);
+	pixels.allocate(old.getWidth(), old.getHeight(), OF_PIXELS_GRAY_ALPHA);
+	pixels.set(0, 255);
+	pixels.set(1, 0);
+	packer.reset(pixels.getWidth(), pixels.getHeight());
+	entries.clear();
+	for(auto & entry: kept){
+		auto region = entry.second.region;
+		if(region.width > 0){
+			if(!pack(region.width, region.height, entry.second.region)){
+				numEvicted++;
+				continue;
+			}
+			copyGlyph(old, region.x, region.y, entry.second.region);
+		}
+		entries[entry.first] = entry.second;
+	}
+	generation++;
+	setDirty(0, pixels.getHeight());
+}
+
+//--------------------------------------------------------------
+void ofGlyphAtlas::copyGlyph(const ofPixels & src, int srcX, int srcY, const Region & region){
+	size_t bpp = pixels.getBytesPerPixel();
+	size_t rowBytes = region.width * bpp;
+	for(int y = 0; y < region.height; y++){
+		auto from = src.getData() + ((srcY + y) * src.getWidth() + srcX) * bpp;
+		auto to = pixels.getData() + ((region.y + y) * pixels.getWidth() + region.x) * bpp;
+		memcpy(to, from, rowBytes);
+	}
+	setDirty(region.y, region.y + region.height);
+}
+
+//--------------------------------------------------------------
+void ofGlyphAtlas::setDirty(int begin, int end){
+	if(dirtyEnd <= dirtyBegin){
+		dirtyBegin = begin;
+		dirtyEnd = end;
+	}else{
+		dirtyBegin = std::min(dirtyBegin, begin);
+		dirtyEnd = std::max(dirtyEnd, end);
+	}
+}
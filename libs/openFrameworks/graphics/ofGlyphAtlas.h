@@ -0,0 +1,152 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofPixels.h"
+#include <unordered_set>
+
+/// \brief Packs rectangles into a fixed size area.
+///
+/// Uses the skyline bottom-left heuristic: the packer keeps the top edge of
+/// the packed area as a list of horizontal segments and places every new
+/// rectangle where its top ends lowest. It's fast and wastes little space
+/// when rectangles of similar heights are added in any order, which makes
+/// it a good fit for glyphs rasterized on demand.
+class ofSkylinePacker{
+public:
+	ofSkylinePacker();
+	ofSkylinePacker(int width, int height);
+
+	/// \brief Remove every rectangle and change the size of the area.
+	void reset(int width, int height);
+
+	/// \brief Find space for a rectangle.
+	/// \param width Width of the rectangle.
+	/// \param height Height of the rectangle.
+	/// \param x Set to the left of the rectangle if it fits.
+	/// \param y Set to the top of the rectangle if it fits.
+	/// \returns false if there's no space left for a rectangle that size.
+	bool pack(int width, int height, int & x, int & y);
+
+	int getWidth() const;
+	int getHeight() const;
+
+	/// \returns The fraction of the area covered by packed rectangles.
+	float getOccupancy() const;
+
+private:
+	struct Segment{
+		int x, y, width;
+	};
+	int fit(size_t index, int width, int height) const;
+	void addLevel(size_t index, int x, int y, int width, int height);
+
+	std::vector<Segment> skyline;
+	int width, height;
+	size_t usedArea;
+};
+
+
+/// \brief A CPU side texture atlas for glyphs loaded on demand.
+///
+/// Glyph pixels (OF_PIXELS_GRAY_ALPHA, like the ofTrueTypeFont atlas) are
+/// copied into a single fixed size ofPixels using an ofSkylinePacker. When
+/// a new glyph doesn't fit, the least recently used glyphs are evicted and
+/// the rest are packed again from scratch, so evicting never leaves holes.
+///
+/// Glyphs used since the last call to beginBatch() are never evicted, that
+/// way every glyph needed to create one string mesh stays in the atlas
+/// while the rest of the string is loaded.
+///
+/// The atlas tracks the rows that changed since the last call to
+/// clearDirty() so a texture can be updated incrementally. It doesn't do
+/// any GL calls itself.
+class ofGlyphAtlas{
+public:
+	/// \brief Position of a glyph in the atlas in pixels, without the border.
+	struct Region{
+		int x, y, width, height;
+	};
+
+	ofGlyphAtlas();
+
+	/// \brief Allocate the atlas and remove every glyph.
+	/// \param width Width of the atlas in pixels.
+	/// \param height Height of the atlas in pixels.
+	/// \param border Empty pixels left around each glyph.
+	void allocate(int width, int height, int border = 1);
+
+	/// \brief Remove every glyph.
+	void clear();
+
+	/// \brief Get the region of a glyph and mark it as used.
+	/// \returns nullptr if the glyph isn't in the atlas.
+	const Region * get(uint32_t glyph);
+
+	/// \brief Copy the pixels of a glyph into the atlas.
+	///
+	/// Evicts the least recently used glyphs if there's no space left.
+	/// Glyphs without pixels are stored with an empty region.
+	///
+	/// \returns The region of the glyph, or nullptr if it doesn't fit even
+	/// after evicting every glyph not used in the current batch.
+	const Region * add(uint32_t glyph, const ofPixels & pixels);
+
+	/// \returns true if the glyph was added before and is bigger than the
+	/// whole atlas, it will never fit so there's no need to rasterize it
+	/// again. Reset by allocate().
+	bool isTooLarge(uint32_t glyph) const;
+
+	/// \brief Protect the glyphs used from now on from eviction, until the
+	/// next call to beginBatch().
+	void beginBatch();
+
+	/// \returns true if the glyph is in the atlas, without marking it as used.
+	bool contains(uint32_t glyph) const;
+
+	/// \returns The number of glyphs in the atlas.
+	size_t size() const;
+
+	/// \returns The number of glyphs evicted since the atlas was allocated.
+	size_t getNumEvicted() const;
+
+	/// \returns A number that changes every time glyphs already in the atlas
+	/// move or are removed, regions returned before are invalid after that.
+	uint64_t getGeneration() const;
+
+	const ofPixels & getPixels() const;
+	float getOccupancy() const;
+
+	/// \returns true if any pixels changed since the last clearDirty().
+	bool isDirty() const;
+
+	/// \returns The first row that changed since the last clearDirty().
+	int getDirtyBegin() const;
+
+	/// \returns One past the last row that changed since the last clearDirty().
+	int getDirtyEnd() const;
+
+	void clearDirty();
+
+private:
+	struct Entry{
+		Region region;
+		uint64_t lastUse;
+	};
+
+	bool pack(int width, int height, Region & region);
+	void evict();
+	void copyGlyph(const ofPixels & src, int srcX, int srcY, const Region & region);
+	void setDirty(int begin, int end);
+
+	std::unordered_map<uint32_t, Entry> entries;
+	std::unordered_set<uint32_t> tooLarge;
+	ofSkylinePacker packer;
+	ofPixels pixels;
+	int border;
+	uint64_t useClock;
+	uint64_t batchBegin;
+	bool batchFull;
+	size_t numEvicted;
+	uint64_t generation;
+	int dirtyBegin, dirtyEnd;
+};
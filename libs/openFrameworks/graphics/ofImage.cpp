@@ -6,8 +6,13 @@
 #include "ofConstants.h"
 
 #include "ofURLFileLoader.h"
+#include "ofAssetPack.h"
+#include "ofAssetCache.h"
 #include "uriparser/Uri.h"
 
+#include <atomic>
+#include <mutex>
+
 #if defined(TARGET_ANDROID)
 #include "ofxAndroidUtils.h"
 #endif
@@ -20,14 +25,21 @@ ofImageLoadSettings ofImageLoadSettings::defaultSetting;
 void ofInitFreeImage(bool deinit=false){
 	// need a new bool to avoid c++ "deinitialization order fiasco":
 	// http://www.parashift.com/c++-faq-lite/ctors.html#faq-10.15
-	static bool	* bFreeImageInited = new bool(false);
+	// images can be loaded from several threads at once, the flag is
+	// checked without locking once freeImage is initialized
+	static std::atomic<bool> * bFreeImageInited = new std::atomic<bool>(false);
+	static std::mutex * initMutex = new std::mutex;
+	if(!deinit && bFreeImageInited->load(std::memory_order_acquire)){
+		return;
+	}
+	std::unique_lock<std::mutex> lock(*initMutex);
 	if(!*bFreeImageInited && !deinit){
 		FreeImage_Initialise();
-		*bFreeImageInited = true;
+		bFreeImageInited->store(true, std::memory_order_release);
 	}
 	if(*bFreeImageInited && deinit){
 		FreeImage_DeInitialise();
-		*bFreeImageInited = false;
+		bFreeImageInited->store(false, std::memory_order_release);
 	}
 }
 
@@ -62,10 +74,46 @@ FREE_IMAGE_TYPE getFreeImageType(const ofFloatPixels& pix) {
 	}
 }
 
+//----------------------------------------------------
+// copies a row of 8 bit RGB or RGBA pixels swapping red and blue, FIBITMAP
+// stores them as BGR(A) on little endian machines
+static void copyRowSwappingRB(const unsigned char * src, unsigned char * dst, size_t width, size_t channels){
+	if(channels == 4){
+		for(size_t x = 0; x < width; x++, src += 4, dst += 4){
+			std::uint32_t pixel;
+			memcpy(&pixel, src, 4);
+			pixel = (pixel & 0xFF00FF00) | ((pixel >> 16) & 0xFF) | ((pixel & 0xFF) << 16);
+			memcpy(dst, &pixel, 4);
+		}
+	}else{
+		for(size_t x = 0; x < width; x++, src += 3, dst += 3){
+			dst[0] = src[2];
+			dst[1] = src[1];
+			dst[2] = src[0];
+		}
+	}
+}
+
+//----------------------------------------------------
+// copies pixels between ofPixels and a FIBITMAP in one pass. ofPixels are
+// top left and FIBITMAP bottom left so the rows are copied in reverse order
+static void copyRowsFlipped(const unsigned char * src, size_t srcStride, unsigned char * dst, size_t dstStride, size_t rowSize, size_t width, size_t height, size_t channels, bool swapRB){
+	if(height == 0){
+		return;
+	}
+	dst += (height - 1) * dstStride;
+	for(size_t y = 0; y < height; y++, src += srcStride, dst -= dstStride){
+		if(swapRB){
+			copyRowSwappingRB(src, dst, width, channels);
+		}else{
+			memcpy(dst, src, rowSize);
+		}
+	}
+}
+
 //----------------------------------------------------
 template<typename PixelType>
-FIBITMAP* getBmpFromPixels(ofPixels_<PixelType> &pix){
-	PixelType* pixels = pix.getData();
+FIBITMAP* getBmpFromPixels(const ofPixels_<PixelType> &pix, bool swapRB = false){
 	unsigned int width = pix.getWidth();
 	unsigned int height = pix.getHeight();
     unsigned int bpp = pix.getBitsPerPixel();
@@ -74,36 +122,79 @@ FIBITMAP* getBmpFromPixels(ofPixels_<PixelType> &pix){
 	FIBITMAP* bmp = FreeImage_AllocateT(freeImageType, width, height, bpp);
 	unsigned char* bmpBits = FreeImage_GetBits(bmp);
 	if(bmpBits != nullptr) {
-		int srcStride = width * pix.getBytesPerPixel();
-		int dstStride = FreeImage_GetPitch(bmp);
-		unsigned char* src = (unsigned char*) pixels;
-		unsigned char* dst = bmpBits;
-		if(srcStride != dstStride){
-			for(int i = 0; i < (int)height; i++) {
-				memcpy(dst, src, srcStride);
-				src += srcStride;
-				dst += dstStride;
-			}
-		}else{
-			memcpy(dst,src,dstStride*height);
-		}
+		size_t rowSize = width * pix.getBytesPerPixel();
+		swapRB = swapRB && sizeof(PixelType) == 1 && pix.getNumChannels() >= 3;
+		copyRowsFlipped((const unsigned char*) pix.getData(), rowSize, bmpBits, FreeImage_GetPitch(bmp), rowSize, width, height, pix.getNumChannels(), swapRB);
 	} else {
 		ofLogError("ofImage") << "getBmpFromPixels(): unable to get FIBITMAP from ofPixels";
 	}
-	
-	// ofPixels are top left, FIBITMAP is bottom left
-	FreeImage_FlipVertical(bmp);
 
 	return bmp;
 }
 
+//----------------------------------------------------
+// 8 bit palettes are looked up while copying instead of converting the
+// FIBITMAP to 24 or 32 bits first
+static void putPaletteBmpIntoPixels(FIBITMAP * bmp, ofPixels & pix, bool swapRB) {
+	unsigned int width = FreeImage_GetWidth(bmp);
+	unsigned int height = FreeImage_GetHeight(bmp);
+	unsigned int pitch = FreeImage_GetPitch(bmp);
+	bool transparent = FreeImage_IsTransparent(bmp);
+	size_t channels = transparent ? 4 : 3;
+
+	// the palette in the order the pixels are stored
+	size_t red = swapRB ? 0 : FI_RGBA_RED;
+	size_t green = swapRB ? 1 : FI_RGBA_GREEN;
+	size_t blue = swapRB ? 2 : FI_RGBA_BLUE;
+	unsigned char lookup[256][4];
+	RGBQUAD * palette = FreeImage_GetPalette(bmp);
+	unsigned int paletteSize = std::min(256u, FreeImage_GetColorsUsed(bmp));
+	BYTE * alphas = FreeImage_GetTransparencyTable(bmp);
+	unsigned int numAlphas = transparent ? FreeImage_GetTransparencyCount(bmp) : 0;
+	for(unsigned int i = 0; i < 256; i++){
+		RGBQUAD color = (palette != nullptr && i < paletteSize) ? palette[i] : RGBQUAD{0, 0, 0, 0};
+		lookup[i][red] = color.rgbRed;
+		lookup[i][green] = color.rgbGreen;
+		lookup[i][blue] = color.rgbBlue;
+		lookup[i][3] = (alphas != nullptr && i < numAlphas) ? alphas[i] : 255;
+	}
+
+	pix.allocate(width, height, transparent ? OF_PIXELS_RGBA : OF_PIXELS_RGB);
+	const unsigned char * src = FreeImage_GetBits(bmp);
+	if(src == nullptr){
+		ofLogError("ofImage") << "putBmpIntoPixels(): unable to set ofPixels from FIBITMAP";
+		return;
+	}
+	for(size_t y = 0; y < height; y++, src += pitch){
+		unsigned char * dst = pix.getData() + (height - 1 - y) * width * channels;
+		for(size_t x = 0; x < width; x++, dst += channels){
+			memcpy(dst, lookup[src[x]], channels);
+		}
+	}
+}
+
+template<typename PixelType>
+static void putPaletteBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType> & pix, bool swapRB) {
+	ofLogError("ofImage") << "putBmpIntoPixels(): palettes can only be loaded into 8 bit pixels";
+}
+
 //----------------------------------------------------
 template<typename PixelType>
 void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType>& pix, bool swapOnLittleEndian = true) {
+#ifdef TARGET_LITTLE_ENDIAN
+	bool swapOnLoad = swapOnLittleEndian;
+#else
+	bool swapOnLoad = false;
+#endif
+
+	FREE_IMAGE_TYPE imgType = FreeImage_GetImageType(bmp);
+	if(sizeof(PixelType)==1 && imgType==FIT_BITMAP && FreeImage_GetBPP(bmp)==8 && FreeImage_GetColorType(bmp)==FIC_PALETTE) {
+		putPaletteBmpIntoPixels(bmp, pix, swapOnLoad);
+		return;
+	}
 
 	// convert to correct type depending on type of input bmp and PixelType
 	FIBITMAP* bmpConverted = nullptr;
-	FREE_IMAGE_TYPE imgType = FreeImage_GetImageType(bmp);
 	if(sizeof(PixelType)==1 &&
 		(FreeImage_GetColorType(bmp) == FIC_PALETTE || FreeImage_GetBPP(bmp) < 8
 		||  imgType!=FIT_BITMAP)) {
@@ -134,29 +225,20 @@ void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType>& pix, bool swapOnLitt
 	unsigned int bpp = FreeImage_GetBPP(bmp);
 	unsigned int channels = (bpp / sizeof(PixelType)) / 8;
     unsigned int pitch = FreeImage_GetPitch(bmp);
-#ifdef TARGET_LITTLE_ENDIAN
-    bool swapRG = channels && swapOnLittleEndian && (bpp/channels == 8);
-#else
-    bool swapRG = false;
-#endif
-
+	// 8 bit pixels are swapped while copying so they end up as RGB
+    bool swapRG = swapOnLoad && channels >= 3 && (bpp/channels == 8);
 
-	ofPixelFormat pixFormat;
+	ofPixelFormat pixFormat = OF_PIXELS_UNKNOWN;
     if(channels==1) pixFormat=OF_PIXELS_GRAY;
-    if(swapRG){
-		if(channels==3) pixFormat=OF_PIXELS_BGR;
-		if(channels==4) pixFormat=OF_PIXELS_BGRA;
-	}else{
-		if(channels==3) pixFormat=OF_PIXELS_RGB;
-		if(channels==4) pixFormat=OF_PIXELS_RGBA;
-    }
+	if(channels==3) pixFormat=OF_PIXELS_RGB;
+	if(channels==4) pixFormat=OF_PIXELS_RGBA;
 
-	// ofPixels are top left, FIBITMAP is bottom left
-	FreeImage_FlipVertical(bmp);
-	
 	unsigned char* bmpBits = FreeImage_GetBits(bmp);
-	if(bmpBits != nullptr) {
-		pix.setFromAlignedPixels((PixelType*) bmpBits, width, height, pixFormat, pitch);
+	if(bmpBits != nullptr && pixFormat != OF_PIXELS_UNKNOWN) {
+		pix.allocate(width, height, pixFormat);
+		size_t rowSize = pix.getBytesStride();
+		// ofPixels are top left, FIBITMAP is bottom left
+		copyRowsFlipped(bmpBits, pitch, (unsigned char*) pix.getData(), rowSize, rowSize, width, height, channels, swapRG);
 	} else {
 		ofLogError("ofImage") << "putBmpIntoPixels(): unable to set ofPixels from FIBITMAP";
 	}
@@ -164,10 +246,413 @@ void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType>& pix, bool swapOnLitt
 	if(bmpConverted != nullptr) {
 		FreeImage_Unload(bmpConverted);
 	}
+}
+
+//----------------------------------------------------
+// QOI, the "Quite OK Image" format from https://qoiformat.org, lossless
+// and many times faster to encode and decode than PNG. Encoded here since
+// FreeImage doesn't support it
+namespace{
+const size_t qoiHeaderSize = 14;
+const unsigned char qoiPadding[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+const unsigned char QOI_OP_INDEX = 0x00;
+const unsigned char QOI_OP_DIFF = 0x40;
+const unsigned char QOI_OP_LUMA = 0x80;
+const unsigned char QOI_OP_RUN = 0xc0;
+const unsigned char QOI_OP_RGB = 0xfe;
+const unsigned char QOI_OP_RGBA = 0xff;
+const unsigned char QOI_MASK = 0xc0;
+
+struct QOIPixel{
+	unsigned char r, g, b, a;
+	bool operator==(const QOIPixel & other) const{
+		return r == other.r && g == other.g && b == other.b && a == other.a;
+	}
+};
 
-    if(swapRG && channels >=3 ) {
-		pix.swapRgb();
-    }
+inline size_t qoiHash(const QOIPixel & pixel){
+	return (pixel.r * 3 + pixel.g * 5 + pixel.b * 7 + pixel.a * 11) % 64;
+}
+
+inline void qoiWrite32(unsigned char * bytes, std::uint32_t value){
+	bytes[0] = value >> 24;
+	bytes[1] = value >> 16;
+	bytes[2] = value >> 8;
+	bytes[3] = value;
+}
+
+inline std::uint32_t qoiRead32(const unsigned char * bytes){
+	return std::uint32_t(bytes[0]) << 24 | std::uint32_t(bytes[1]) << 16 | std::uint32_t(bytes[2]) << 8 | bytes[3];
+}
+}
+
+/// internal
+static bool isQOI(const ofBuffer & buffer){
+	return buffer.size() >= qoiHeaderSize + sizeof(qoiPadding) && memcmp(buffer.getData(), "qoif", 4) == 0;
+}
+
+/// internal
+static bool saveQOI(const ofPixels & pix, ofBuffer & buffer){
+	// offsets of each channel in the source pixels, gray is saved as RGB
+	size_t channels = pix.getNumChannels();
+	size_t red = 0, green = 1, blue = 2;
+	bool alpha = false;
+	switch(pix.getPixelFormat()){
+	case OF_PIXELS_RGBA:
+		alpha = true;
+		break;
+	case OF_PIXELS_BGRA:
+		alpha = true;
+		red = 2;
+		blue = 0;
+		break;
+	case OF_PIXELS_RGB:
+		break;
+	case OF_PIXELS_BGR:
+		red = 2;
+		blue = 0;
+		break;
+	case OF_PIXELS_GRAY:
+		green = blue = 0;
+		break;
+	default:
+		ofLogError("ofImage") << "saveImage(): qoi only supports RGB, RGBA and grayscale pixels";
+		return false;
+	}
+	size_t numPixels = pix.getWidth() * pix.getHeight();
+	if(numPixels == 0 || pix.getWidth() > 0xFFFFFFFF || pix.getHeight() > 0xFFFFFFFF){
+		ofLogError("ofImage") << "saveImage(): can't save " << pix.getWidth() << "x" << pix.getHeight() << " pixels as qoi";
+		return false;
+	}
+
+	// every pixel takes at most one byte more than its channels
+	buffer.allocate(qoiHeaderSize + numPixels * (alpha ? 5 : 4) + sizeof(qoiPadding));
+	unsigned char * bytes = (unsigned char*) buffer.getData();
+	unsigned char * out = bytes;
+	memcpy(out, "qoif", 4);
+	qoiWrite32(out + 4, pix.getWidth());
+	qoiWrite32(out + 8, pix.getHeight());
+	out[12] = alpha ? 4 : 3;
+	out[13] = 0; // sRGB with linear alpha
+	out += qoiHeaderSize;
+
+	QOIPixel index[64] = {};
+	QOIPixel previous{0, 0, 0, 255};
+	QOIPixel pixel = previous;
+	size_t run = 0;
+	const unsigned char * src = pix.getData();
+	for(size_t i = 0; i < numPixels; i++, src += channels){
+		pixel.r = src[red];
+		pixel.g = src[green];
+		pixel.b = src[blue];
+		if(alpha){
+			pixel.a = src[3];
+		}
+
+		if(pixel == previous){
+			run++;
+			if(run == 62 || i == numPixels - 1){
+				*out++ = QOI_OP_RUN | (run - 1);
+				run = 0;
+			}
+			continue;
+		}
+		if(run > 0){
+			*out++ = QOI_OP_RUN | (run - 1);
+			run = 0;
+		}
+
+		size_t hash = qoiHash(pixel);
+		if(index[hash] == pixel){
+			*out++ = QOI_OP_INDEX | hash;
+		}else{
+			index[hash] = pixel;
+			if(pixel.a == previous.a){
+				signed char vr = pixel.r - previous.r;
+				signed char vg = pixel.g - previous.g;
+				signed char vb = pixel.b - previous.b;
+				signed char vgr = vr - vg;
+				signed char vgb = vb - vg;
+				if(vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2){
+					*out++ = QOI_OP_DIFF | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2);
+				}else if(vgr > -9 && vgr < 8 && vg > -33 && vg < 32 && vgb > -9 && vgb < 8){
+					*out++ = QOI_OP_LUMA | (vg + 32);
+					*out++ = (vgr + 8) << 4 | (vgb + 8);
+				}else{
+					*out++ = QOI_OP_RGB;
+					*out++ = pixel.r;
+					*out++ = pixel.g;
+					*out++ = pixel.b;
+				}
+			}else{
+				*out++ = QOI_OP_RGBA;
+				*out++ = pixel.r;
+				*out++ = pixel.g;
+				*out++ = pixel.b;
+				*out++ = pixel.a;
+			}
+		}
+		previous = pixel;
+	}
+	memcpy(out, qoiPadding, sizeof(qoiPadding));
+	out += sizeof(qoiPadding);
+	buffer.resize(out - bytes);
+	return true;
+}
+
+/// internal
+static bool loadQOI(const ofBuffer & buffer, ofPixels & pix){
+	if(!isQOI(buffer)){
+		return false;
+	}
+	const unsigned char * bytes = (const unsigned char*) buffer.getData();
+	std::uint32_t width = qoiRead32(bytes + 4);
+	std::uint32_t height = qoiRead32(bytes + 8);
+	size_t channels = bytes[12];
+	size_t end = buffer.size() - sizeof(qoiPadding);
+	// a run of 62 pixels is the most a byte can hold, so bigger sizes
+	// can only come from a corrupt header
+	std::uint64_t numPixels = std::uint64_t(width) * height;
+	if(width == 0 || height == 0 || (channels != 3 && channels != 4) || numPixels > std::uint64_t(end - qoiHeaderSize) * 62){
+		ofLogError("ofImage") << "loadImage(): couldn't load qoi image, invalid header";
+		return false;
+	}
+
+	pix.allocate(width, height, channels == 4 ? OF_PIXELS_RGBA : OF_PIXELS_RGB);
+	QOIPixel index[64] = {};
+	QOIPixel pixel{0, 0, 0, 255};
+	size_t run = 0;
+	size_t pos = qoiHeaderSize;
+	unsigned char * out = pix.getData();
+	for(std::uint64_t i = 0; i < numPixels; i++, out += channels){
+		if(run > 0){
+			run--;
+		}else if(pos < end){
+			unsigned char op = bytes[pos++];
+			if(op == QOI_OP_RGB){
+				if(pos + 3 > end) break;
+				pixel.r = bytes[pos];
+				pixel.g = bytes[pos + 1];
+				pixel.b = bytes[pos + 2];
+				pos += 3;
+			}else if(op == QOI_OP_RGBA){
+				if(pos + 4 > end) break;
+				pixel.r = bytes[pos];
+				pixel.g = bytes[pos + 1];
+				pixel.b = bytes[pos + 2];
+				pixel.a = bytes[pos + 3];
+				pos += 4;
+			}else if((op & QOI_MASK) == QOI_OP_INDEX){
+				pixel = index[op];
+			}else if((op & QOI_MASK) == QOI_OP_DIFF){
+				pixel.r += ((op >> 4) & 0x03) - 2;
+				pixel.g += ((op >> 2) & 0x03) - 2;
+				pixel.b += (op & 0x03) - 2;
+			}else if((op & QOI_MASK) == QOI_OP_LUMA){
+				if(pos + 1 > end) break;
+				unsigned char next = bytes[pos++];
+				int vg = (op & 0x3f) - 32;
+				pixel.r += vg - 8 + ((next >> 4) & 0x0f);
+				pixel.g += vg;
+				pixel.b += vg - 8 + (next & 0x0f);
+			}else{
+				run = op & 0x3f;
+			}
+			index[qoiHash(pixel)] = pixel;
+		}else{
+			break;
+		}
+		out[0] = pixel.r;
+		out[1] = pixel.g;
+		out[2] = pixel.b;
+		if(channels == 4){
+			out[3] = pixel.a;
+		}
+	}
+	if(out != pix.getData() + pix.size()){
+		ofLogError("ofImage") << "loadImage(): couldn't load qoi image, the data is truncated";
+		pix.clear();
+		return false;
+	}
+	return true;
+}
+
+/// internal
+static void assignPixels(ofPixels & dst, ofPixels && src){
+	dst = std::move(src);
+}
+
+template<typename PixelType>
+static void assignPixels(ofPixels_<PixelType> & dst, ofPixels && src){
+	dst = src;
+}
+
+/// internal
+static bool isQOIPath(const std::filesystem::path & path){
+	return ofToLower(ofFilePath::getFileExt(path)) == "qoi";
+}
+
+//----------------------------------------------------
+// .ofpix, the pixels as they are in memory after a 64 byte header so
+// they stay aligned when the file is mapped and can be used without
+// copying them
+namespace{
+struct OfPixHeader{
+	char magic[8];
+	std::uint32_t pixelFormat;
+	std::uint32_t bytesPerChannel; // 1 unsigned char, 2 unsigned short, 4 float
+	std::uint64_t width;
+	std::uint64_t height;
+	std::uint64_t stride; // bytes from one row to the next
+	std::uint64_t dataOffset; // from the start of the file, multiple of 64
+	std::uint64_t dataSize;
+	std::uint8_t reserved[8];
+};
+
+static_assert(sizeof(OfPixHeader) == 64, "the ofpix header has to keep the data aligned");
+
+const char ofPixMagic[8] = {'o','f','p','i','x','\0','\0','\1'};
+const size_t ofPixAlignment = 64;
+}
+
+/// internal
+static bool isOfPix(const ofBuffer & buffer){
+	return buffer.size() >= sizeof(OfPixHeader) && memcmp(buffer.getData(), ofPixMagic, sizeof(ofPixMagic)) == 0;
+}
+
+/// internal
+static bool isOfPixPath(const std::filesystem::path & path){
+	return ofToLower(ofFilePath::getFileExt(path)) == "ofpix";
+}
+
+/// internal
+template<typename PixelType>
+static void saveOfPix(const ofPixels_<PixelType> & pix, ofBuffer & buffer){
+	OfPixHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, ofPixMagic, sizeof(ofPixMagic));
+	header.pixelFormat = pix.getPixelFormat();
+	header.bytesPerChannel = sizeof(PixelType);
+	header.width = pix.getWidth();
+	header.height = pix.getHeight();
+	header.stride = pix.getBytesStride();
+	header.dataOffset = ofPixAlignment;
+	header.dataSize = pix.getTotalBytes();
+	buffer.allocate(header.dataOffset + header.dataSize);
+	memcpy(buffer.getData(), &header, sizeof(header));
+	memcpy(buffer.getData() + header.dataOffset, pix.getData(), header.dataSize);
+}
+
+/// internal
+/// the pixels are used without copying them when they have the type
+/// requested, aren't padded and the owner of the data is passed
+template<typename PixelType>
+static bool setOfPixData(ofPixels_<PixelType> & pix, PixelType * data, const OfPixHeader & header, std::shared_ptr<ofBuffer> owner){
+	ofPixels_<PixelType> view;
+	view.setFromExternalPixels(data, header.width, header.height, ofPixelFormat(header.pixelFormat));
+	if(header.stride == view.getBytesStride() && header.dataSize >= view.getTotalBytes()){
+		if(owner){
+			pix.setFromExternalPixels(data, header.width, header.height, ofPixelFormat(header.pixelFormat), owner);
+		}else{
+			pix = view;
+		}
+		return true;
+	}
+	// padded rows can only be copied
+	if(view.getNumPlanes() == 1 && header.stride > view.getBytesStride() && header.dataSize / header.stride >= header.height){
+		pix.allocate(header.width, header.height, ofPixelFormat(header.pixelFormat));
+		auto src = reinterpret_cast<const unsigned char*>(data);
+		auto dst = reinterpret_cast<unsigned char*>(pix.getData());
+		size_t rowSize = pix.getBytesStride();
+		for(size_t y = 0; y < header.height; y++){
+			memcpy(dst + y * rowSize, src + y * header.stride, rowSize);
+		}
+		return true;
+	}
+	return false;
+}
+
+/// internal
+template<typename SrcType, typename PixelType>
+static bool setOfPixData(ofPixels_<PixelType> & pix, SrcType * data, const OfPixHeader & header, std::shared_ptr<ofBuffer>){
+	ofPixels_<SrcType> src;
+	if(!setOfPixData(src, data, header, nullptr)){
+		return false;
+	}
+	pix = src;
+	return true;
+}
+
+/// internal
+/// \param owner if not null, buffer is kept alive by the pixels and they
+/// use its data without copying it
+template<typename PixelType>
+static bool loadOfPix(const ofBuffer & buffer, ofPixels_<PixelType> & pix, std::shared_ptr<ofBuffer> owner){
+	if(!isOfPix(buffer)){
+		return false;
+	}
+	OfPixHeader header;
+	memcpy(&header, buffer.getData(), sizeof(header));
+	// every format has at least a byte per pixel, so the sizes computed
+	// from a header that passes these checks can't overflow
+	if(header.width == 0 || header.height == 0
+	   || header.width > std::numeric_limits<std::int32_t>::max() || header.height > std::numeric_limits<std::int32_t>::max()
+	   || header.pixelFormat >= OF_PIXELS_NUM_FORMATS
+	   || header.dataOffset < sizeof(header) || header.dataOffset % ofPixAlignment != 0
+	   || header.dataOffset > buffer.size() || header.dataSize > buffer.size() - header.dataOffset
+	   || header.width * header.height > header.dataSize){
+		ofLogError("ofImage") << "loadImage(): couldn't load ofpix image, invalid header";
+		return false;
+	}
+
+	// the data is only written through the owner, which is a private copy
+	// of the file when mapped
+	auto data = const_cast<char*>(buffer.getData()) + header.dataOffset;
+	bool loaded;
+	switch(header.bytesPerChannel){
+	case 1:
+		loaded = setOfPixData(pix, reinterpret_cast<unsigned char*>(data), header, owner);
+		break;
+	case 2:
+		loaded = setOfPixData(pix, reinterpret_cast<unsigned short*>(data), header, owner);
+		break;
+	case 4:
+		loaded = setOfPixData(pix, reinterpret_cast<float*>(data), header, owner);
+		break;
+	default:
+		loaded = false;
+		break;
+	}
+	if(!loaded){
+		ofLogError("ofImage") << "loadImage(): couldn't load ofpix image, invalid header";
+	}
+	return loaded;
+}
+
+/// internal
+/// written to a temporary file that then replaces the destination, so
+/// pixels still mapped from the previous file keep their data instead of
+/// losing it when the file is truncated
+template<typename PixelType>
+static bool saveOfPix(const ofPixels_<PixelType> & pix, const std::filesystem::path & path){
+	ofBuffer buffer;
+	saveOfPix(pix, buffer);
+	ofFilePath::createEnclosingDirectory(path);
+	std::filesystem::path dst = ofToDataPath(path);
+	std::filesystem::path temporary = dst.string() + ".tmp";
+	if(!ofBufferToFile(temporary, buffer, true)){
+		return false;
+	}
+	try{
+		std::filesystem::rename(temporary, dst);
+	}catch(...){
+		ofLogError("ofImage") << "saveImage(): couldn't save " << path << ", the file is in use";
+		try{
+			std::filesystem::remove(temporary);
+		}catch(...){}
+		return false;
+	}
+	return true;
 }
 
 /// internal
@@ -180,6 +665,62 @@ static int getJpegOptionFromImageLoadSetting(const ofImageLoadSettings &settings
 	return option;
 }
 
+/// internal
+/// the size of an image once scaled to fit the limits of the settings
+static void getLoadSize(size_t width, size_t height, const ofImageLoadSettings &settings, size_t & loadWidth, size_t & loadHeight) {
+	double scale = 1;
+	if(settings.maxWidth > 0 && width > settings.maxWidth){
+		scale = double(settings.maxWidth) / width;
+	}
+	if(settings.maxHeight > 0 && height > settings.maxHeight){
+		scale = std::min(scale, double(settings.maxHeight) / height);
+	}
+	if(scale < 1){
+		loadWidth = std::max<size_t>(1, std::round(width * scale));
+		loadHeight = std::max<size_t>(1, std::round(height * scale));
+	}else{
+		loadWidth = width;
+		loadHeight = height;
+	}
+}
+
+/// internal
+/// libjpeg can decode at 1/2, 1/4 or 1/8 of the size using the DCT, the
+/// JPEG plugin of FreeImage uses the smallest of those that's at least
+/// the size in the high 16 bits of the flags. header is a bitmap loaded
+/// with FIF_LOAD_NOPIXELS
+static int getJpegScaleOptionFromImageLoadSetting(FIBITMAP * header, const ofImageLoadSettings &settings) {
+	if(header == nullptr || (settings.maxWidth == 0 && settings.maxHeight == 0)){
+		return 0;
+	}
+	size_t width = FreeImage_GetWidth(header);
+	size_t height = FreeImage_GetHeight(header);
+	// the image might be rotated by the exif orientation when loaded
+	size_t loadWidth, loadHeight, rotatedWidth, rotatedHeight;
+	getLoadSize(width, height, settings, loadWidth, loadHeight);
+	getLoadSize(height, width, settings, rotatedHeight, rotatedWidth);
+	size_t size = std::max(std::max(loadWidth, loadHeight), std::max(rotatedWidth, rotatedHeight));
+	if(size >= std::max(width, height) || size > 0x7FFF){
+		return 0;
+	}
+	return int(size) << 16;
+}
+
+/// internal
+/// scales the loaded pixels down to fit the limits of the settings, after
+/// any scaling done by the decoder
+template<typename PixelType>
+static void fitToImageLoadSetting(ofPixels_<PixelType> & pix, const ofImageLoadSettings &settings) {
+	size_t width, height;
+	getLoadSize(pix.getWidth(), pix.getHeight(), settings, width, height);
+	if(width != pix.getWidth() || height != pix.getHeight()){
+		pix.resize(width, height, OF_INTERPOLATE_AREA);
+	}
+}
+
+template<typename PixelType>
+static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer, const ofImageLoadSettings &settings, FREE_IMAGE_FORMAT fallbackFormat = FIF_UNKNOWN);
+
 template<typename PixelType>
 static bool loadImage(ofPixels_<PixelType> & pix, const std::filesystem::path& _fileName, const ofImageLoadSettings& settings){
 	ofInitFreeImage();
@@ -198,6 +739,33 @@ static bool loadImage(ofPixels_<PixelType> & pix, const std::filesystem::path& _
 	if(scheme == "http" || scheme == "https"){
 		return ofLoadImage(pix, ofLoadURL(_fileName.string()).data);
 	}
+
+	// decoding from memory only guesses the format from the contents, files
+	// read into a buffer still fall back to the extension like FreeImage_Load
+	auto formatFromName = FreeImage_GetFIFFromFilename(_fileName.string().c_str());
+
+	ofBuffer packed;
+	if(ofReadFromMountedAssetPack(_fileName, packed)){
+		return loadImage(pix, packed, settings, formatFromName);
+	}
+	if(isOfPixPath(_fileName)){
+		// the pixels keep the file mapped and use it without copying it
+		auto buffer = std::make_shared<ofBuffer>(ofBufferFromFile(_fileName, ofBufferLoadMode::Mapped));
+		if(!isOfPix(*buffer)){
+			ofLogError("ofImage") << "loadImage(): couldn't load " << _fileName << ", it's not an ofpix file";
+			return false;
+		}
+		if(!loadOfPix(*buffer, pix, settings.keepMapped ? buffer : nullptr)){
+			return false;
+		}
+		fitToImageLoadSetting(pix, settings);
+		return true;
+	}
+	if(isQOIPath(_fileName) || (settings.useCache && ofFile::doesFileExist(_fileName))){
+		// cached pixels are found by the contents of the file and qoi isn't
+		// supported by FreeImage
+		return loadImage(pix, ofBufferFromFile(_fileName, ofBufferLoadMode::Mapped), settings, formatFromName);
+	}
 	
 	std::string fileName = ofToDataPath(_fileName);
 	bool bLoaded = false;
@@ -212,6 +780,13 @@ static bool loadImage(ofPixels_<PixelType> & pix, const std::filesystem::path& _
 	if((fif != FIF_UNKNOWN) && FreeImage_FIFSupportsReading(fif)) {
 		if(fif == FIF_JPEG) {
 			int option = getJpegOptionFromImageLoadSetting(settings);
+			if(settings.maxWidth > 0 || settings.maxHeight > 0){
+				FIBITMAP * header = FreeImage_Load(fif, fileName.c_str(), FIF_LOAD_NOPIXELS);
+				option |= getJpegScaleOptionFromImageLoadSetting(header, settings);
+				if(header != nullptr){
+					FreeImage_Unload(header);
+				}
+			}
 			bmp = FreeImage_Load(fif, fileName.c_str(), option);
 		} else {
 			bmp = FreeImage_Load(fif, fileName.c_str(), 0);
@@ -226,6 +801,7 @@ static bool loadImage(ofPixels_<PixelType> & pix, const std::filesystem::path& _
 
 	if ( bLoaded ){
 		putBmpIntoPixels(bmp,pix);
+		fitToImageLoadSetting(pix, settings);
 	}
 
 	if (bmp != nullptr){
@@ -236,7 +812,40 @@ static bool loadImage(ofPixels_<PixelType> & pix, const std::filesystem::path& _
 }
 
 template<typename PixelType>
-static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer, const ofImageLoadSettings &settings){
+static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer, const ofImageLoadSettings &settings, FREE_IMAGE_FORMAT fallbackFormat){
+	if(isOfPix(buffer)){
+		// the buffer might not outlive the pixels so they are copied
+		if(!loadOfPix(buffer, pix, nullptr)){
+			return false;
+		}
+		fitToImageLoadSetting(pix, settings);
+		return true;
+	}
+
+	std::string cacheKey;
+	if(settings.useCache){
+		auto parameters = "ofPixels " + ofToString(sizeof(PixelType))
+			+ " " + ofToString(settings.accurate) + ofToString(settings.exifRotate)
+			+ ofToString(settings.grayscale) + ofToString(settings.separateCMYK);
+		if(settings.maxWidth > 0 || settings.maxHeight > 0){
+			parameters += " " + ofToString(settings.maxWidth) + "x" + ofToString(settings.maxHeight);
+		}
+		cacheKey = ofAssetCache::makeKey(buffer, parameters);
+		if(ofGetAssetCache().load(cacheKey, pix)){
+			return true;
+		}
+	}
+
+	if(isQOI(buffer)){
+		ofPixels decoded;
+		if(!loadQOI(buffer, decoded)){
+			return false;
+		}
+		assignPixels(pix, std::move(decoded));
+		fitToImageLoadSetting(pix, settings);
+		return true;
+	}
+
 	ofInitFreeImage();
 	bool bLoaded = false;
 	FIBITMAP* bmp = nullptr;
@@ -250,7 +859,11 @@ static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer, const
 
 	//get the file type!
 	FREE_IMAGE_FORMAT fif = FreeImage_GetFileTypeFromMemory(hmem);
-	if( fif == -1 ){
+	if(fif == FIF_UNKNOWN){
+		// formats without a signature, like tga, can't be guessed
+		fif = fallbackFormat;
+	}
+	if(fif == FIF_UNKNOWN || !FreeImage_FIFSupportsReading(fif)){
 		ofLogError("ofImage") << "loadImage(): couldn't load image from ofBuffer, unable to guess image format from memory";
 		FreeImage_CloseMemory(hmem);
 		return false;
@@ -260,6 +873,14 @@ static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer, const
 	//make the image!!
 	if(fif == FIF_JPEG) {
 		int option = getJpegOptionFromImageLoadSetting(settings);
+		if(settings.maxWidth > 0 || settings.maxHeight > 0){
+			FIBITMAP * header = FreeImage_LoadFromMemory(fif, hmem, FIF_LOAD_NOPIXELS);
+			option |= getJpegScaleOptionFromImageLoadSetting(header, settings);
+			if(header != nullptr){
+				FreeImage_Unload(header);
+			}
+			FreeImage_SeekMemory(hmem, 0, SEEK_SET);
+		}
 		bmp = FreeImage_LoadFromMemory(fif, hmem, option);
 	} else {
 		bmp = FreeImage_LoadFromMemory(fif, hmem, 0);
@@ -273,6 +894,10 @@ static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer, const
 	
 	if (bLoaded){
 		putBmpIntoPixels(bmp,pix);
+		fitToImageLoadSetting(pix, settings);
+		if(settings.useCache){
+			ofGetAssetCache().store(cacheKey, pix);
+		}
 	}
 
 	if (bmp != nullptr){
@@ -316,6 +941,32 @@ bool ofLoadImage(ofFloatPixels & pix, const ofBuffer & buffer, const ofImageLoad
 	return loadImage(pix, buffer, settings);
 }
 
+//----------------------------------------------------------------
+template<typename PixelType>
+static int loadImageAsync(const std::filesystem::path& path, std::function<void(ofPixels_<PixelType> &, const ofFileLoadResult &)> done, const ofImageLoadSettings &settings, int priority){
+	auto pixels = std::make_shared<ofPixels_<PixelType>>();
+	return ofLoadFileAsync(path, [pixels, settings](const std::filesystem::path & path){
+		return loadImage(*pixels, path, settings);
+	}, [pixels, done](const ofFileLoadResult & result){
+		done(*pixels, result);
+	}, priority);
+}
+
+//----------------------------------------------------------------
+int ofLoadImageAsync(const std::filesystem::path& path, std::function<void(ofPixels &, const ofFileLoadResult &)> done, const ofImageLoadSettings &settings, int priority){
+	return loadImageAsync(path, done, settings, priority);
+}
+
+//----------------------------------------------------------------
+int ofLoadImageAsync(const std::filesystem::path& path, std::function<void(ofFloatPixels &, const ofFileLoadResult &)> done, const ofImageLoadSettings &settings, int priority){
+	return loadImageAsync(path, done, settings, priority);
+}
+
+//----------------------------------------------------------------
+int ofLoadImageAsync(const std::filesystem::path& path, std::function<void(ofShortPixels &, const ofFileLoadResult &)> done, const ofImageLoadSettings &settings, int priority){
+	return loadImageAsync(path, done, settings, priority);
+}
+
 //----------------------------------------------------------------
 bool ofLoadImage(ofTexture & tex, const std::filesystem::path& path, const ofImageLoadSettings &settings){
 	ofPixels pixels;
@@ -340,29 +991,39 @@ bool ofLoadImage(ofTexture & tex, const ofBuffer & buffer, const ofImageLoadSett
 
 //----------------------------------------------------------------
 template<typename PixelType>
-static void saveImage(const ofPixels_<PixelType> & _pix, const std::filesystem::path& _fileName, ofImageQualityType qualityLevel) {
-	// Make a local copy.
-	ofPixels_<PixelType> pix = _pix;
+static bool swapRgbOnSave(const ofPixels_<PixelType> & pix) {
+#ifdef TARGET_LITTLE_ENDIAN
+	return sizeof(PixelType) == 1 && (pix.getPixelFormat()==OF_PIXELS_RGB || pix.getPixelFormat()==OF_PIXELS_RGBA);
+#else
+	return false;
+#endif
+}
 
+//----------------------------------------------------------------
+template<typename PixelType>
+static void saveImage(const ofPixels_<PixelType> & pix, const std::filesystem::path& _fileName, ofImageQualityType qualityLevel) {
 	ofInitFreeImage();
 	if (pix.isAllocated() == false){
 		ofLogError("ofImage") << "saveImage(): couldn't save \"" << _fileName << "\", pixels are not allocated";
 		return;
 	}
 
-	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1 && (pix.getPixelFormat()==OF_PIXELS_RGB || pix.getPixelFormat()==OF_PIXELS_RGBA)) {
-		pix.swapRgb();
+	if(isOfPixPath(_fileName)){
+		saveOfPix(pix, _fileName);
+		return;
 	}
-	#endif
-
-	FIBITMAP * bmp	= getBmpFromPixels(pix);
 
-	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1 && (pix.getPixelFormat()==OF_PIXELS_BGR || pix.getPixelFormat()==OF_PIXELS_BGRA)) {
-		pix.swapRgb();
+	if(isQOIPath(_fileName)){
+		ofBuffer buffer;
+		if(saveQOI(pix, buffer)){
+			ofFilePath::createEnclosingDirectory(_fileName);
+			ofBufferToFile(_fileName, buffer, true);
+		}
+		return;
 	}
-	#endif
+
+	// FIBITMAP stores 8 bit pixels as BGR on little endian machines
+	FIBITMAP * bmp	= getBmpFromPixels(pix, swapRgbOnSave(pix));
 	
 	ofFilePath::createEnclosingDirectory(_fileName);
 	std::string fileName = ofToDataPath(_fileName);
@@ -430,12 +1091,9 @@ void ofSaveImage(const ofShortPixels & pix, const std::filesystem::path& fileNam
 
 //----------------------------------------------------------------
 template<typename PixelType>
-static void saveImage(const ofPixels_<PixelType> & _pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
+static void saveImage(const ofPixels_<PixelType> & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
 	// thanks to alvaro casinelli for the implementation
 
-	// Make a local copy.
-	ofPixels_<PixelType> pix = _pix;
-
 	ofInitFreeImage();
 
 	if (pix.isAllocated() == false){
@@ -443,6 +1101,16 @@ static void saveImage(const ofPixels_<PixelType> & _pix, ofBuffer & buffer, ofIm
 		return;
 	}
 
+	if(format==OF_IMAGE_FORMAT_QOI){
+		saveQOI(pix, buffer);
+		return;
+	}
+
+	if(format==OF_IMAGE_FORMAT_OFPIX){
+		saveOfPix(pix, buffer);
+		return;
+	}
+
 	if(format==OF_IMAGE_FORMAT_JPEG && pix.getNumChannels()==4){
 		ofPixels pix3 = pix;
 		pix3.setNumChannels(3);
@@ -450,19 +1118,7 @@ static void saveImage(const ofPixels_<PixelType> & _pix, ofBuffer & buffer, ofIm
 		return;
 	}
 
-	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1) {
-		pix.swapRgb();
-	}
-	#endif
-
-	FIBITMAP * bmp	= getBmpFromPixels(pix);
-
-	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1) {
-		pix.swapRgb();
-	}
-	#endif
+	FIBITMAP * bmp	= getBmpFromPixels(pix, swapRgbOnSave(pix));
 
 	if (bmp)  // bitmap successfully created
 	{
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ofFileUtils.h"
+#include "ofAsyncFileLoader.h"
 #include "ofTexture.h"
 #include "ofPixels.h"
 #include "ofBaseTypes.h"
@@ -70,7 +71,16 @@ enum ofImageFormat {
     OF_IMAGE_FORMAT_JP2     = 31,
     OF_IMAGE_FORMAT_PFM     = 32,
     OF_IMAGE_FORMAT_PICT    = 33,
-    OF_IMAGE_FORMAT_RAW     = 34
+    OF_IMAGE_FORMAT_RAW     = 34,
+    /// \brief Lossless format that's many times faster to encode and decode
+    /// than PNG, for capturing frames to compress later. Not a FreeImage
+    /// format, other pixels are converted to 8 bits.
+    OF_IMAGE_FORMAT_QOI     = 100,
+    /// \brief Uncompressed pixels of any type and format after a small
+    /// header. Loading maps the file and uses it as the pixels without
+    /// decoding or copying them, for large images loaded every launch.
+    /// Not a FreeImage format.
+    OF_IMAGE_FORMAT_OFPIX   = 101
 };
 
 inline std::string ofImageFormatExtension(ofImageFormat format){
@@ -110,6 +120,8 @@ inline std::string ofImageFormatExtension(ofImageFormat format){
     case OF_IMAGE_FORMAT_PFM: return "pfm";
     case OF_IMAGE_FORMAT_PICT: return "pict";
     case OF_IMAGE_FORMAT_RAW: return "raw";
+    case OF_IMAGE_FORMAT_QOI: return "qoi";
+    case OF_IMAGE_FORMAT_OFPIX: return "ofpix";
     }
 }
 
@@ -124,6 +136,23 @@ struct ofImageLoadSettings {
     bool exifRotate;
     bool grayscale;
     bool separateCMYK;
+    /// Store the decoded pixels in ofGetAssetCache() and load them from
+    /// there the next time the same file is loaded with the same settings.
+    bool useCache = false;
+    /// Limit the size of the decoded image, larger images are scaled down
+    /// to fit keeping their aspect ratio. 0 means no limit. JPEGs are
+    /// scaled while they are decoded, so loading thumbnails of large
+    /// photos takes a fraction of the time and memory of loading them
+    /// and calling resize().
+    size_t maxWidth = 0;
+    size_t maxHeight = 0;
+    /// Use .ofpix files mapped into memory as the pixels, the mapping is
+    /// released when the pixels are cleared or destroyed. Modifying the
+    /// pixels only changes a private copy of the pages modified, never the
+    /// file. Set to false to copy the pixels instead, for example so the
+    /// file can be replaced while the pixels exist, which some systems
+    /// don't allow while it's mapped.
+    bool keepMapped = true;
     static ofImageLoadSettings defaultSetting;
 };
 
@@ -139,6 +168,24 @@ bool ofLoadImage(ofFloatPixels & pix, const ofBuffer & buffer, const ofImageLoad
 bool ofLoadImage(ofShortPixels & pix, const std::filesystem::path& path, const ofImageLoadSettings &settings = ofImageLoadSettings::defaultSetting);
 bool ofLoadImage(ofShortPixels & pix, const ofBuffer & buffer, const ofImageLoadSettings &settings = ofImageLoadSettings::defaultSetting);
 
+/// \brief Load an image without blocking the calling thread.
+///
+/// The image is read and decoded in one of the file loader threads and
+/// \p done is called with the pixels from the main thread during a later
+/// update, where they can be uploaded to a texture:
+///
+/// ~~~~{.cpp}
+/// ofLoadImageAsync("photo.jpg", [this](ofPixels & pixels, const ofFileLoadResult & result){
+///     if(result.loaded) image.setFromPixels(pixels);
+/// });
+/// ~~~~
+///
+/// \returns The id of the request, see ofCancelFileRequest() and
+/// ofSetFileRequestPriority().
+int ofLoadImageAsync(const std::filesystem::path& path, std::function<void(ofPixels & pix, const ofFileLoadResult & result)> done, const ofImageLoadSettings &settings = ofImageLoadSettings::defaultSetting, int priority = 0);
+int ofLoadImageAsync(const std::filesystem::path& path, std::function<void(ofFloatPixels & pix, const ofFileLoadResult & result)> done, const ofImageLoadSettings &settings = ofImageLoadSettings::defaultSetting, int priority = 0);
+int ofLoadImageAsync(const std::filesystem::path& path, std::function<void(ofShortPixels & pix, const ofFileLoadResult & result)> done, const ofImageLoadSettings &settings = ofImageLoadSettings::defaultSetting, int priority = 0);
+
 /// \todo Needs documentation.
 bool ofLoadImage(ofTexture & tex, const std::filesystem::path& path, const ofImageLoadSettings &settings = ofImageLoadSettings::defaultSetting);
 bool ofLoadImage(ofTexture & tex, const ofBuffer & buffer, const ofImageLoadSettings &settings = ofImageLoadSettings::defaultSetting);
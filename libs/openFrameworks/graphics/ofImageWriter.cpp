@@ -0,0 +1,289 @@
+#include "ofImageWriter.h"
+#include "ofThreadPool.h"
+#include "ofUtils.h"
+#include "ofLog.h"
+#include <map>
+
+#ifndef TARGET_NO_THREADS
+#include <thread>
+#include <condition_variable>
+#endif
+
+namespace{
+bool getImageFormat(const std::filesystem::path & path, ofImageFormat & format){
+	auto extension = ofToLower(ofFilePath::getFileExt(path));
+	if(extension == "jpeg"){
+		extension = "jpg";
+	}else if(extension == "tiff"){
+		extension = "tif";
+	}
+	if(extension == ofImageFormatExtension(OF_IMAGE_FORMAT_QOI)){
+		format = OF_IMAGE_FORMAT_QOI;
+		return true;
+	}
+	if(extension == ofImageFormatExtension(OF_IMAGE_FORMAT_OFPIX)){
+		format = OF_IMAGE_FORMAT_OFPIX;
+		return true;
+	}
+	for(int i = OF_IMAGE_FORMAT_BMP; i <= OF_IMAGE_FORMAT_RAW; i++){
+		if(ofImageFormatExtension(ofImageFormat(i)) == extension){
+			format = ofImageFormat(i);
+			return true;
+		}
+	}
+	return false;
+}
+}
+
+//--------------------------------------------------
+ofImageWriterSettings::ofImageWriterSettings(){
+#ifdef TARGET_NO_THREADS
+	numThreads = 0;
+#else
+	numThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+#endif
+}
+
+struct ofImageWriter::Impl{
+	struct Image{
+		uint64_t sequence = 0;
+		std::filesystem::path path;
+		ofImageFormat format = OF_IMAGE_FORMAT_PNG;
+		ofImageQualityType quality = OF_IMAGE_QUALITY_BEST;
+		ofPixels pixels;
+		ofShortPixels shortPixels;
+		ofFloatPixels floatPixels;
+		ofBuffer encoded;
+	};
+
+	ofCoreMutex mutex;
+#ifndef TARGET_NO_THREADS
+	std::condition_variable condition;
+	std::unique_ptr<ofThreadPool> pool;
+#endif
+
+	ofImageWriterSettings settings;
+	ofImageWriterStats stats;
+	uint64_t nextSequence = 0;
+	uint64_t nextToWrite = 0;
+	std::map<uint64_t, std::shared_ptr<Image>> encoded; // compressed, waiting for the ones before them
+	bool writing = false;
+	bool paused = false;
+
+	template<typename PixelType>
+	bool write(ofPixels_<PixelType> && pixels, const std::filesystem::path & path){
+		auto image = std::make_shared<Image>();
+		if(!getImageFormat(path, image->format)){
+			ofLogError("ofImageWriter") << "couldn't write " << path << ", unknown image format";
+			ofCoreLock lock(mutex);
+			stats.failed++;
+			return false;
+		}
+		image->path = path;
+		setPixels(*image, std::move(pixels));
+
+		{
+			ofCoreLock lock(mutex);
+			size_t maxQueued = std::max<size_t>(settings.maxQueuedImages, 1);
+			if(stats.queued >= maxQueued){
+				if(settings.dropWhenFull){
+					stats.dropped++;
+					return false;
+				}
+#ifndef TARGET_NO_THREADS
+				auto start = ofGetElapsedTimeMicros();
+				condition.wait(lock, [&]{ return stats.queued < maxQueued; });
+				stats.secondsBlocked += (ofGetElapsedTimeMicros() - start) / 1000000.;
+#endif
+			}
+			image->sequence = nextSequence++;
+			image->quality = settings.quality;
+			stats.queued++;
+			stats.maxQueued = std::max(stats.maxQueued, stats.queued);
+#ifndef TARGET_NO_THREADS
+			if(!pool){
+				pool.reset(new ofThreadPool(settings.numThreads));
+			}
+#endif
+		}
+
+#ifdef TARGET_NO_THREADS
+		encode(image);
+#else
+		pool->push([this, image]{
+			encode(image);
+		});
+#endif
+		return true;
+	}
+
+	void setPixels(Image & image, ofPixels && pixels){
+		image.pixels = std::move(pixels);
+	}
+
+	void setPixels(Image & image, ofShortPixels && pixels){
+		image.shortPixels = std::move(pixels);
+	}
+
+	void setPixels(Image & image, ofFloatPixels && pixels){
+		image.floatPixels = std::move(pixels);
+	}
+
+	// compresses an image and writes it and any compressed after it
+	// that were waiting for it
+	void encode(std::shared_ptr<Image> image){
+		if(image->pixels.isAllocated()){
+			ofSaveImage(image->pixels, image->encoded, image->format, image->quality);
+		}else if(image->shortPixels.isAllocated()){
+			ofSaveImage(image->shortPixels, image->encoded, image->format, image->quality);
+		}else if(image->floatPixels.isAllocated()){
+			ofSaveImage(image->floatPixels, image->encoded, image->format, image->quality);
+		}
+		// release the pixels while waiting for the images before this one
+		image->pixels.clear();
+		image->shortPixels.clear();
+		image->floatPixels.clear();
+
+		ofCoreLock lock(mutex);
+		encoded[image->sequence] = image;
+		writeEncoded(lock);
+	}
+
+	// writes the compressed images that are next in order. only one thread
+	// writes at a time, the others queue what they compressed for it
+	void writeEncoded(ofCoreLock & lock){
+		if(writing || paused){
+			return;
+		}
+		writing = true;
+		while(!paused && !encoded.empty() && encoded.begin()->first == nextToWrite){
+			auto next = encoded.begin()->second;
+			encoded.erase(encoded.begin());
+			lock.unlock();
+
+			bool written = false;
+			if(next->encoded.size() > 0){
+				ofFilePath::createEnclosingDirectory(next->path);
+				written = ofBufferToFile(next->path, next->encoded, true);
+			}
+			if(!written){
+				ofLogError("ofImageWriter") << "couldn't write " << next->path;
+			}
+
+			lock.lock();
+			nextToWrite++;
+			stats.queued--;
+			if(written){
+				stats.written++;
+			}else{
+				stats.failed++;
+			}
+#ifndef TARGET_NO_THREADS
+			condition.notify_all();
+#endif
+		}
+		writing = false;
+	}
+
+	void resume(){
+		ofCoreLock lock(mutex);
+		if(!paused){
+			return;
+		}
+		paused = false;
+#ifndef TARGET_NO_THREADS
+		// the images written while paused are written by the pool, writing
+		// them here could block the calling thread for long
+		if(pool && pool->getNumThreads() > 0){
+			pool->push([this]{
+				ofCoreLock lock(mutex);
+				writeEncoded(lock);
+			});
+			return;
+		}
+#endif
+		writeEncoded(lock);
+	}
+
+	void waitForAll(){
+		resume();
+#ifndef TARGET_NO_THREADS
+		ofCoreLock lock(mutex);
+		condition.wait(lock, [this]{ return stats.queued == 0; });
+#endif
+	}
+};
+
+//--------------------------------------------------
+ofImageWriter::ofImageWriter()
+:impl(new Impl){}
+
+//--------------------------------------------------
+ofImageWriter::~ofImageWriter(){
+	impl->waitForAll();
+}
+
+//--------------------------------------------------
+void ofImageWriter::setup(const ofImageWriterSettings & settings){
+	impl->waitForAll();
+	ofCoreLock lock(impl->mutex);
+	impl->settings = settings;
+#ifndef TARGET_NO_THREADS
+	// recreated with the new number of threads on the next write
+	impl->pool.reset();
+#endif
+}
+
+//--------------------------------------------------
+const ofImageWriterSettings & ofImageWriter::getSettings() const{
+	return impl->settings;
+}
+
+//--------------------------------------------------
+bool ofImageWriter::write(ofPixels && pixels, const std::filesystem::path & path){
+	return impl->write(std::move(pixels), path);
+}
+
+//--------------------------------------------------
+bool ofImageWriter::write(ofShortPixels && pixels, const std::filesystem::path & path){
+	return impl->write(std::move(pixels), path);
+}
+
+//--------------------------------------------------
+bool ofImageWriter::write(ofFloatPixels && pixels, const std::filesystem::path & path){
+	return impl->write(std::move(pixels), path);
+}
+
+//--------------------------------------------------
+bool ofImageWriter::isFull() const{
+	ofCoreLock lock(impl->mutex);
+	return impl->stats.queued >= std::max<size_t>(impl->settings.maxQueuedImages, 1);
+}
+
+//--------------------------------------------------
+void ofImageWriter::pause(){
+	ofCoreLock lock(impl->mutex);
+	impl->paused = true;
+}
+
+//--------------------------------------------------
+void ofImageWriter::resume(){
+	impl->resume();
+}
+
+//--------------------------------------------------
+bool ofImageWriter::isPaused() const{
+	ofCoreLock lock(impl->mutex);
+	return impl->paused;
+}
+
+//--------------------------------------------------
+void ofImageWriter::waitForAll(){
+	impl->waitForAll();
+}
+
+//--------------------------------------------------
+ofImageWriterStats ofImageWriter::getStats() const{
+	ofCoreLock lock(impl->mutex);
+	return impl->stats;
+}
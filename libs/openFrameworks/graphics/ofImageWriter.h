@@ -0,0 +1,122 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofImage.h"
+#include <memory>
+
+/// \brief Settings of an ofImageWriter.
+struct ofImageWriterSettings{
+	/// Create settings that compress with one thread less than the number
+	/// of cores.
+	ofImageWriterSettings();
+
+	/// Threads compressing images, 0 compresses them in the thread calling
+	/// write().
+	size_t numThreads;
+
+	/// Images waiting to be compressed or written, once there's this many
+	/// write() waits or drops the image.
+	size_t maxQueuedImages = 16;
+
+	/// Drop images when the queue is full instead of waiting, for capturing
+	/// a live stream where blocking would drop frames anyway.
+	bool dropWhenFull = false;
+
+	/// Quality of the images saved as JPEG.
+	ofImageQualityType quality = OF_IMAGE_QUALITY_BEST;
+};
+
+/// \brief What an ofImageWriter has done so far.
+struct ofImageWriterStats{
+	/// Images written to disk.
+	uint64_t written = 0;
+	/// Images dropped because the queue was full.
+	uint64_t dropped = 0;
+	/// Images that couldn't be compressed or written.
+	uint64_t failed = 0;
+	/// Images waiting to be compressed or written.
+	size_t queued = 0;
+	/// Most images that were ever queued at the same time.
+	size_t maxQueued = 0;
+	/// Time write() spent waiting for space in the queue.
+	double secondsBlocked = 0;
+};
+
+/// \class ofImageWriter
+///
+/// Saves images without blocking the calling thread, meant for recording
+/// the frames of an app to disk.
+///
+/// Pixels are moved into a bounded queue and compressed by a pool of
+/// threads, in the format of the extension of each file. Files are
+/// written in the order write() was called even if they are compressed
+/// in parallel, so a sequence on disk never has gaps while recording.
+///
+/// PNG and JPEG compression are often too slow to keep up with large
+/// frames, even with several threads. Saving as .qoi, see
+/// OF_IMAGE_FORMAT_QOI, is lossless and many times faster, the images
+/// can be loaded and compressed to other formats after recording.
+///
+/// ~~~~{.cpp}
+/// void ofApp::draw(){
+///     // ...
+///     ofPixels pixels;
+///     fbo.readToPixels(pixels);
+///     writer.write(std::move(pixels), "frames/" + ofToString(ofGetFrameNum(), 6, '0') + ".qoi");
+/// }
+/// ~~~~
+class ofImageWriter{
+public:
+	ofImageWriter();
+
+	/// \brief Write all the queued images and stop the threads.
+	~ofImageWriter();
+
+	/// \brief Change the settings, waits for the queued images to be
+	/// written first.
+	void setup(const ofImageWriterSettings & settings);
+	const ofImageWriterSettings & getSettings() const;
+
+	/// \brief Queue pixels to be saved to a file.
+	///
+	/// If the queue is full it waits for space unless
+	/// ofImageWriterSettings::dropWhenFull is set.
+	///
+	/// \param pixels Pixels to save, moved into the writer.
+	/// \param path Path of the file, relative to the data folder. Its
+	/// extension selects the format.
+	/// \returns false if the image was dropped or the format is unknown.
+	bool write(ofPixels && pixels, const std::filesystem::path & path);
+	bool write(ofShortPixels && pixels, const std::filesystem::path & path);
+	bool write(ofFloatPixels && pixels, const std::filesystem::path & path);
+
+	/// \returns true if the next call to write() would wait or drop the
+	/// image, to skip the work of reading it back from the GPU.
+	bool isFull() const;
+
+	/// \brief Stop writing files until resume().
+	///
+	/// Images are still compressed but stay queued, so once the queue is
+	/// full write() drops them, or waits for resume() from another thread
+	/// unless ofImageWriterSettings::dropWhenFull is set. Useful to keep
+	/// the disk idle while the app needs it for something else.
+	void pause();
+
+	/// \brief Write the images queued while paused and the ones after them.
+	void resume();
+
+	bool isPaused() const;
+
+	/// \brief Wait until all the queued images are written, resumes the
+	/// writer if it's paused.
+	void waitForAll();
+
+	ofImageWriterStats getStats() const;
+
+private:
+	ofImageWriter(const ofImageWriter &) = delete;
+	ofImageWriter & operator=(const ofImageWriter &) = delete;
+
+	struct Impl;
+	std::unique_ptr<Impl> impl;
+};
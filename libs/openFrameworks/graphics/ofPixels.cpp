@@ -1,5 +1,8 @@
 #include "ofPixels.h"
+#include "ofPixelsInternal.h"
+#include "ofPixelsPool.h"
 #include "ofMath.h"
+#include "ofThreadPool.h"
 #include <algorithm>
 
 static ofImageType getImageTypeFromChannels(size_t channels){
@@ -191,7 +194,8 @@ ofPixels_<PixelType>::~ofPixels_(){
 }
 
 template<typename PixelType>
-ofPixels_<PixelType>::ofPixels_(const ofPixels_<PixelType> & mom){
+ofPixels_<PixelType>::ofPixels_(const ofPixels_<PixelType> & mom)
+:pool(mom.pool){
 	copyFrom( mom );
 }
 
@@ -203,6 +207,8 @@ ofPixels_<PixelType>::ofPixels_(ofPixels_<PixelType> && mom)
 ,pixelsSize(mom.pixelsSize)
 ,bAllocated(mom.bAllocated)
 ,pixelsOwner(mom.pixelsOwner)
+,externalOwner(std::move(mom.externalOwner))
+,pool(mom.pool)
 ,pixelFormat(mom.pixelFormat){
 	mom.pixelsOwner = false;
 }
@@ -216,6 +222,7 @@ void ofPixels_<PixelType>::swap(ofPixels_<PixelType> & pix){
 	std::swap(pixelsSize,pix.pixelsSize);
 	std::swap(bAllocated, pix.bAllocated);
 	std::swap(pixelsOwner, pix.pixelsOwner);
+	std::swap(externalOwner, pix.externalOwner);
 	std::swap(pixelFormat,pix.pixelFormat);
 }
 
@@ -241,6 +248,7 @@ ofPixels_<PixelType>& ofPixels_<PixelType>::operator=(ofPixels_<PixelType> && mo
 	pixelsSize = mom.pixelsSize;
 	bAllocated = mom.bAllocated;
 	pixelsOwner = mom.pixelsOwner;
+	externalOwner = std::move(mom.externalOwner);
 	pixelFormat = mom.pixelFormat;
 	mom.pixelsOwner = false;
 	return *this;
@@ -333,6 +341,12 @@ void ofPixels_<PixelType>::setFromExternalPixels(PixelType * newPixels, size_t w
 	bAllocated = true;
 }
 
+template<typename PixelType>
+void ofPixels_<PixelType>::setFromExternalPixels(PixelType * newPixels, size_t w, size_t h, ofPixelFormat _pixelFormat, std::shared_ptr<void> owner){
+	setFromExternalPixels(newPixels, w, h, _pixelFormat);
+	externalOwner = std::move(owner);
+}
+
 template<typename PixelType>
 void ofPixels_<PixelType>::setFromAlignedPixels(const PixelType * newPixels, size_t width, size_t height, size_t channels, size_t stride){
 	setFromAlignedPixels(newPixels,width,height,pixelFormatFromNumChannels(channels),stride);
@@ -462,9 +476,15 @@ void ofPixels_<PixelType>::allocate(size_t w, size_t h, ofPixelFormat format){
 
 	pixelsSize = newSize / sizeof(PixelType);
 
-	pixels = new PixelType[pixelsSize];
+	if(pool){
+		externalOwner = pool->acquire(newSize);
+		pixels = static_cast<PixelType*>(externalOwner.get());
+		pixelsOwner = false;
+	}else{
+		pixels = new PixelType[pixelsSize];
+		pixelsOwner = true;
+	}
 	bAllocated = true;
-	pixelsOwner = true;
 }
 
 template<typename PixelType>
@@ -472,6 +492,16 @@ void ofPixels_<PixelType>::allocate(size_t w, size_t h, ofImageType type){
 	allocate(w,h,ofPixelFormatFromImageType(type));
 }
 
+template<typename PixelType>
+void ofPixels_<PixelType>::setPool(std::shared_ptr<ofPixelsPool> pool){
+	this->pool = pool;
+}
+
+template<typename PixelType>
+std::shared_ptr<ofPixelsPool> ofPixels_<PixelType>::getPool() const{
+	return pool;
+}
+
 template<typename PixelType>
 void ofPixels_<PixelType>::swapRgb(){
 	switch(pixelFormat){
@@ -512,6 +542,7 @@ void ofPixels_<PixelType>::clear(){
 		if(pixelsOwner) delete[] pixels;
 		pixels = nullptr;
 	}
+	externalOwner.reset();
 
 	width			= 0;
 	height			= 0;
@@ -883,6 +914,7 @@ template<typename PixelType>
 void ofPixels_<PixelType>::setImageType(ofImageType imageType){
 	if(!isAllocated() || imageType==getImageType()) return;
 	ofPixels_<PixelType> dst;
+	dst.setPool(pool);
 	dst.allocate(width,height,imageType);
 	PixelType * dstPtr = &dst[0];
 	PixelType * srcPtr = &pixels[0];
@@ -958,6 +990,7 @@ template<typename PixelType>
 void ofPixels_<PixelType>::crop(size_t x, size_t y, size_t _width, size_t _height){
 	if (bAllocated){
 		ofPixels_<PixelType> crop;
+		crop.setPool(pool);
 		cropTo(crop,x,y,_width,_height);
 		swap(crop);
 	}
@@ -1027,7 +1060,7 @@ void ofPixels_<PixelType>::rotate90To(ofPixels_<PixelType> & dst, int nClockwise
 	}
 
 	// otherwise, we will need to do some new allocaiton.
-	dst.allocate(height,width,getImageType());
+	dst.allocate(height,width,getPixelFormat());
 
 	size_t strideSrc = width * channels;
 	size_t strideDst = dst.width * channels;
@@ -1089,11 +1122,9 @@ void ofPixels_<PixelType>::rotate90(int nClockwiseRotations){
 	}
 
 	ofPixels_<PixelType> newPixels;
+	newPixels.setPool(pool);
 	rotate90To(newPixels,nClockwiseRotations);
-	std::swap(newPixels.pixels,pixels);
-	width = newPixels.width;
-	height = newPixels.height;
-	pixelsSize = newPixels.size();
+	swap(newPixels);
 
 }
 
@@ -1190,16 +1221,12 @@ bool ofPixels_<PixelType>::resize(size_t dstWidth, size_t dstHeight, ofInterpola
 	if ((dstWidth == 0) || (dstHeight == 0) || !(isAllocated())) return false;
 
 	ofPixels_<PixelType> dstPixels;
+	dstPixels.setPool(pool);
 	dstPixels.allocate(dstWidth, dstHeight, getPixelFormat());
 
 	if(!resizeTo(dstPixels,interpMethod)) return false;
 
-	delete [] pixels;
-	pixels = dstPixels.getData();
-	width  = dstWidth;
-	height = dstHeight;
-	pixelsSize = dstPixels.size();
-	dstPixels.pixelsOwner = false;
+	swap(dstPixels);
 	return true;
 }
 
@@ -1256,6 +1283,29 @@ float ofPixels_<PixelType>::bicubicInterpolate (const float *patch, float x,floa
 	return std::min(static_cast<size_t>(255), std::max(static_cast<size_t>(out), static_cast<size_t>(0)));
 }
 
+//----------------------------------------------------------------------
+// the source pixels covered by each destination pixel when scaling
+// srcSize to dstSize, and how much of the destination pixel each covers.
+// the weights of destination pixel i are in [begin[i], begin[i+1]) and
+// start at source pixel first[i]
+static void getAreaWeights(size_t srcSize, size_t dstSize, std::vector<size_t> & first, std::vector<size_t> & begin, std::vector<float> & weights){
+	double scale = double(srcSize) / dstSize;
+	first.resize(dstSize);
+	begin.resize(dstSize + 1);
+	weights.clear();
+	for(size_t i = 0; i < dstSize; i++){
+		double start = i * scale;
+		double end = std::min(double(srcSize), (i + 1) * scale);
+		first[i] = std::min(srcSize - 1, static_cast<size_t>(start));
+		begin[i] = weights.size();
+		for(size_t src = first[i]; src < srcSize && src < end; src++){
+			double covered = std::min(end, src + 1.0) - std::max(start, double(src));
+			weights.push_back(covered / scale);
+		}
+	}
+	begin[dstSize] = weights.size();
+}
+
 //----------------------------------------------------------------------
 template<typename PixelType>
 bool ofPixels_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMethod interpMethod) const{
@@ -1298,6 +1348,44 @@ bool ofPixels_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMe
 			}
 		}break;
 
+			//----------------------------------------
+		case OF_INTERPOLATE_AREA:{
+			// the source rows of each destination row are added into a float
+			// row first, then the columns of that row
+			size_t channels = getNumChannels();
+			if(channels == 0 || channels != dst.getNumChannels()){
+				ofLogError("ofPixels") << "resizeTo(): area resize needs pixels with channels, not resizing";
+				return false;
+			}
+			std::vector<size_t> firstX, beginX, firstY, beginY;
+			std::vector<float> weightsX, weightsY;
+			getAreaWeights(srcWidth, dstWidth, firstX, beginX, weightsX);
+			getAreaWeights(srcHeight, dstHeight, firstY, beginY, weightsY);
+			size_t srcRowSize = srcWidth * channels;
+			std::vector<float> row(srcRowSize);
+			float rounding = std::is_integral<PixelType>::value ? 0.5f : 0.f;
+			for(size_t dsty = 0; dsty < dstHeight; dsty++){
+				std::fill(row.begin(), row.end(), 0.f);
+				const PixelType * srcRow = pixels + firstY[dsty] * srcRowSize;
+				for(size_t j = beginY[dsty]; j < beginY[dsty + 1]; j++, srcRow += srcRowSize){
+					float weight = weightsY[j];
+					for(size_t i = 0; i < srcRowSize; i++){
+						row[i] += srcRow[i] * weight;
+					}
+				}
+				for(size_t dstx = 0; dstx < dstWidth; dstx++){
+					for(size_t c = 0; c < channels; c++){
+						const float * srcPixel = row.data() + firstX[dstx] * channels + c;
+						float value = 0;
+						for(size_t j = beginX[dstx]; j < beginX[dstx + 1]; j++, srcPixel += channels){
+							value += *srcPixel * weightsX[j];
+						}
+						*dstPixels++ = static_cast<PixelType>(value + rounding);
+					}
+				}
+			}
+		}break;
+
 			//----------------------------------------
 		case OF_INTERPOLATE_BILINEAR:
 			// not implemented yet
@@ -1386,56 +1474,365 @@ bool ofPixels_<PixelType>::pasteInto(ofPixels_<PixelType> &dst, size_t xTo, size
 }
 
 
-template<typename A, typename B>
-inline A clampedAdd(const A& a, const B& b) {
-	return CLAMP((float) a + (float) b, 0, ofColor_<A>::limit());
-}
+namespace{
+	// the blend formulas work on values normalized to [0, 1], limit()
+	// stands for 1 and every result is clamped to the range of the type
+	template<typename T>
+	struct BlendOps{
+		static double limit(){
+			return ofColor_<T>::limit();
+		}
+		static T clamp(double v){
+			v = std::min(std::max(v, 0.0), limit());
+			return std::numeric_limits<T>::is_integer ? T(v + 0.5) : T(v);
+		}
+		static T mul(T x, T y){
+			return clamp(double(x) * double(y) / limit());
+		}
+		static T add(T x, T y){
+			return clamp(double(x) + double(y));
+		}
+		static T sub(T x, T y){
+			return clamp(double(x) - double(y));
+		}
+		static T inv(T x){
+			return clamp(limit() - double(x));
+		}
+	};
+
+	// x * y / 255 rounded, exact for every pair of 8 bit values
+	template<>
+	struct BlendOps<unsigned char>{
+		static unsigned char mul(uint32_t x, uint32_t y){
+			uint32_t t = x * y + 128;
+			return (t + (t >> 8)) >> 8;
+		}
+		static unsigned char add(uint32_t x, uint32_t y){
+			return std::min<uint32_t>(x + y, 255);
+		}
+		static unsigned char sub(uint32_t x, uint32_t y){
+			return x > y ? x - y : 0;
+		}
+		static unsigned char inv(uint32_t x){
+			return 255 - x;
+		}
+	};
 
+	template<>
+	struct BlendOps<unsigned short>{
+		static unsigned short mul(uint32_t x, uint32_t y){
+			uint32_t t = x * y + 32768;
+			return (t + (t >> 16)) >> 16;
+		}
+		static unsigned short add(uint32_t x, uint32_t y){
+			return std::min<uint32_t>(x + y, 65535);
+		}
+		static unsigned short sub(uint32_t x, uint32_t y){
+			return x > y ? x - y : 0;
+		}
+		static unsigned short inv(uint32_t x){
+			return 65535 - x;
+		}
+	};
+
+	template<>
+	struct BlendOps<float>{
+		static float clamp(float v){
+			return std::min(std::max(v, 0.f), 1.f);
+		}
+		static float mul(float x, float y){
+			return x * y;
+		}
+		static float add(float x, float y){
+			return clamp(x + y);
+		}
+		static float sub(float x, float y){
+			return clamp(x - y);
+		}
+		static float inv(float x){
+			return 1.f - x;
+		}
+	};
+
+	// s is the source color already multiplied by its alpha, ia one minus
+	// the source alpha
+	template<typename T, ofBlendMode Mode>
+	inline T blendValue(T s, T d, T ia){
+		typedef BlendOps<T> Ops;
+		switch(Mode){
+		case OF_BLENDMODE_ADD:
+			return Ops::add(s, d);
+		case OF_BLENDMODE_SUBTRACT:
+			return Ops::sub(d, s);
+		case OF_BLENDMODE_MULTIPLY:
+			return Ops::add(Ops::mul(s, d), Ops::mul(d, ia));
+		case OF_BLENDMODE_SCREEN:
+			return Ops::add(s, Ops::mul(d, Ops::inv(s)));
+		case OF_BLENDMODE_ALPHA:
+		default:
+			return Ops::add(s, Ops::mul(d, ia));
+		}
+	}
+
+	// pixels without alpha, every value is blended as an opaque color
+	template<typename T, ofBlendMode Mode>
+	void blendOpaque(const T * src, T * dst, size_t count){
+		for(size_t i = 0; i < count; i++){
+			dst[i] = blendValue<T, Mode>(src[i], dst[i], T(0));
+		}
+	}
+
+	// pixels with alpha in their last channel, the destination alpha is
+	// always composited over
+	template<typename T, ofBlendMode Mode>
+	void blendAlpha(const T * src, T * dst, size_t numPixels, size_t channels, bool premultiplied){
+		typedef BlendOps<T> Ops;
+		size_t alpha = channels - 1;
+		for(size_t i = 0; i < numPixels; i++, src += channels, dst += channels){
+			T a = src[alpha];
+			T ia = Ops::inv(a);
+			for(size_t c = 0; c < alpha; c++){
+				T s = premultiplied ? src[c] : Ops::mul(src[c], a);
+				dst[c] = blendValue<T, Mode>(s, dst[c], ia);
+			}
+			dst[alpha] = Ops::add(a, Ops::mul(dst[alpha], ia));
+		}
+	}
+
+#if OF_SSE2
+	// 8 bit values in 16 bit lanes
+	inline __m128i blendMul(__m128i x, __m128i y){
+		__m128i t = _mm_add_epi16(_mm_mullo_epi16(x, y), _mm_set1_epi16(128));
+		return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+	}
+
+	// results can go over 255 or under 0, saturated when packed to 8 bits
+	template<ofBlendMode Mode>
+	inline __m128i blendValues(__m128i s, __m128i d, __m128i ia){
+		switch(Mode){
+		case OF_BLENDMODE_ADD:
+			return _mm_add_epi16(s, d);
+		case OF_BLENDMODE_SUBTRACT:
+			return _mm_sub_epi16(d, s);
+		case OF_BLENDMODE_MULTIPLY:
+			return _mm_add_epi16(blendMul(s, d), blendMul(d, ia));
+		case OF_BLENDMODE_SCREEN:
+			return _mm_add_epi16(s, blendMul(d, _mm_sub_epi16(_mm_set1_epi16(255), s)));
+		case OF_BLENDMODE_ALPHA:
+		default:
+			return _mm_add_epi16(s, blendMul(d, ia));
+		}
+	}
+
+	template<ofBlendMode Mode>
+	void blendOpaqueSSE2(const unsigned char * src, unsigned char * dst, size_t count){
+		__m128i zero = _mm_setzero_si128();
+		size_t i = 0;
+		for(; i + 16 <= count; i += 16){
+			__m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+			__m128i lo = blendValues<Mode>(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), zero);
+			__m128i hi = blendValues<Mode>(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), zero);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+		}
+		blendOpaque<unsigned char, Mode>(src + i, dst + i, count - i);
+	}
+
+	// two rgba pixels in 16 bit lanes
+	template<ofBlendMode Mode>
+	inline __m128i blendRGBA(__m128i s, __m128i d, bool premultiplied){
+		__m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+		__m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		__m128i ia = _mm_sub_epi16(_mm_set1_epi16(255), a);
+		__m128i color = blendValues<Mode>(premultiplied ? s : blendMul(s, a), d, ia);
+		__m128i alpha = _mm_add_epi16(a, blendMul(d, ia));
+		return _mm_or_si128(_mm_andnot_si128(alphaLanes, color), _mm_and_si128(alphaLanes, alpha));
+	}
+
+	template<ofBlendMode Mode>
+	void blendRGBASSE2(const unsigned char * src, unsigned char * dst, size_t numPixels, bool premultiplied){
+		__m128i zero = _mm_setzero_si128();
+		size_t i = 0;
+		for(; i + 4 <= numPixels; i += 4){
+			__m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+			__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i * 4));
+			__m128i lo = blendRGBA<Mode>(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), premultiplied);
+			__m128i hi = blendRGBA<Mode>(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), premultiplied);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(lo, hi));
+		}
+		blendAlpha<unsigned char, Mode>(src + i * 4, dst + i * 4, numPixels - i, 4, premultiplied);
+	}
+
+	template<ofBlendMode Mode>
+	inline __m128 blendValues(__m128 s, __m128 d, __m128 ia){
+		__m128 zero = _mm_setzero_ps();
+		__m128 one = _mm_set1_ps(1.f);
+		auto clamp = [&](__m128 v){
+			return _mm_min_ps(_mm_max_ps(v, zero), one);
+		};
+		switch(Mode){
+		case OF_BLENDMODE_ADD:
+			return clamp(_mm_add_ps(s, d));
+		case OF_BLENDMODE_SUBTRACT:
+			return clamp(_mm_sub_ps(d, s));
+		case OF_BLENDMODE_MULTIPLY:
+			return clamp(_mm_add_ps(_mm_mul_ps(s, d), _mm_mul_ps(d, ia)));
+		case OF_BLENDMODE_SCREEN:
+			return clamp(_mm_add_ps(s, _mm_mul_ps(d, _mm_sub_ps(one, s))));
+		case OF_BLENDMODE_ALPHA:
+		default:
+			return clamp(_mm_add_ps(s, _mm_mul_ps(d, ia)));
+		}
+	}
+
+	template<ofBlendMode Mode>
+	void blendOpaqueSSE2(const float * src, float * dst, size_t count){
+		__m128 zero = _mm_setzero_ps();
+		size_t i = 0;
+		for(; i + 4 <= count; i += 4){
+			__m128 s = _mm_loadu_ps(src + i);
+			__m128 d = _mm_loadu_ps(dst + i);
+			_mm_storeu_ps(dst + i, blendValues<Mode>(s, d, zero));
+		}
+		blendOpaque<float, Mode>(src + i, dst + i, count - i);
+	}
+
+	template<ofBlendMode Mode>
+	void blendRGBASSE2(const float * src, float * dst, size_t numPixels, bool premultiplied){
+		__m128 alphaLane = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+		__m128 one = _mm_set1_ps(1.f);
+		for(size_t i = 0; i < numPixels; i++, src += 4, dst += 4){
+			__m128 s = _mm_loadu_ps(src);
+			__m128 d = _mm_loadu_ps(dst);
+			__m128 a = _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 3, 3));
+			__m128 ia = _mm_sub_ps(one, a);
+			__m128 color = blendValues<Mode>(premultiplied ? s : _mm_mul_ps(s, a), d, ia);
+			__m128 alpha = _mm_min_ps(_mm_max_ps(_mm_add_ps(a, _mm_mul_ps(d, ia)), _mm_setzero_ps()), one);
+			_mm_storeu_ps(dst, _mm_or_ps(_mm_andnot_ps(alphaLane, color), _mm_and_ps(alphaLane, alpha)));
+		}
+	}
+#endif
+
+	template<typename T, ofBlendMode Mode>
+	struct BlendRow{
+		static void run(const T * src, T * dst, size_t numPixels, size_t channels, bool premultiplied){
+			if(channels == 2 || channels == 4){
+				blendAlpha<T, Mode>(src, dst, numPixels, channels, premultiplied);
+			}else{
+				blendOpaque<T, Mode>(src, dst, numPixels * channels);
+			}
+		}
+	};
+
+#if OF_SSE2
+	template<ofBlendMode Mode>
+	struct BlendRow<unsigned char, Mode>{
+		static void run(const unsigned char * src, unsigned char * dst, size_t numPixels, size_t channels, bool premultiplied){
+			if(channels == 4){
+				blendRGBASSE2<Mode>(src, dst, numPixels, premultiplied);
+			}else if(channels == 2){
+				blendAlpha<unsigned char, Mode>(src, dst, numPixels, channels, premultiplied);
+			}else{
+				blendOpaqueSSE2<Mode>(src, dst, numPixels * channels);
+			}
+		}
+	};
+
+	template<ofBlendMode Mode>
+	struct BlendRow<float, Mode>{
+		static void run(const float * src, float * dst, size_t numPixels, size_t channels, bool premultiplied){
+			if(channels == 4){
+				blendRGBASSE2<Mode>(src, dst, numPixels, premultiplied);
+			}else if(channels == 2){
+				blendAlpha<float, Mode>(src, dst, numPixels, channels, premultiplied);
+			}else{
+				blendOpaqueSSE2<Mode>(src, dst, numPixels * channels);
+			}
+		}
+	};
+#endif
+
+	template<typename T>
+	void blendRow(const T * src, T * dst, size_t numPixels, size_t channels, ofBlendMode mode, bool premultiplied){
+		switch(mode){
+		case OF_BLENDMODE_DISABLED:
+			memcpy(dst, src, numPixels * channels * sizeof(T));
+			break;
+		case OF_BLENDMODE_ALPHA:
+			BlendRow<T, OF_BLENDMODE_ALPHA>::run(src, dst, numPixels, channels, premultiplied);
+			break;
+		case OF_BLENDMODE_ADD:
+			BlendRow<T, OF_BLENDMODE_ADD>::run(src, dst, numPixels, channels, premultiplied);
+			break;
+		case OF_BLENDMODE_SUBTRACT:
+			BlendRow<T, OF_BLENDMODE_SUBTRACT>::run(src, dst, numPixels, channels, premultiplied);
+			break;
+		case OF_BLENDMODE_MULTIPLY:
+			BlendRow<T, OF_BLENDMODE_MULTIPLY>::run(src, dst, numPixels, channels, premultiplied);
+			break;
+		case OF_BLENDMODE_SCREEN:
+			BlendRow<T, OF_BLENDMODE_SCREEN>::run(src, dst, numPixels, channels, premultiplied);
+			break;
+		}
+	}
+
+	bool isBlendableFormat(ofPixelFormat pixelFormat){
+		switch(pixelFormat){
+		case OF_PIXELS_GRAY:
+		case OF_PIXELS_GRAY_ALPHA:
+		case OF_PIXELS_RGB:
+		case OF_PIXELS_BGR:
+		case OF_PIXELS_RGBA:
+		case OF_PIXELS_BGRA:
+			return true;
+		default:
+			return false;
+		}
+	}
+}
 
 //----------------------------------------------------------------------
 template<typename PixelType>
 bool ofPixels_<PixelType>::blendInto(ofPixels_<PixelType> &dst, size_t xTo, size_t yTo) const{
 	if (!(isAllocated()) || !(dst.isAllocated()) || getBytesPerPixel() != dst.getBytesPerPixel() || xTo + getWidth()>dst.getWidth() || yTo + getHeight()>dst.getHeight() || getNumChannels()==0) return false;
 
-	std::function<void(const ConstPixel&,Pixel&)> blendFunc;
-	switch(getNumChannels()){
-	case 1:
-		blendFunc = [](const ConstPixel&src, Pixel&dst){
-			dst[0] = clampedAdd(src[0], dst[0]);
-		};
-		break;
-	case 2:
-		blendFunc = [](const ConstPixel&src, Pixel&dst){
-			dst[0] = clampedAdd(src[0], dst[0] / ofColor_<PixelType>::limit() * (ofColor_<PixelType>::limit() - src[1]));
-			dst[1] = clampedAdd(src[1], dst[1] / ofColor_<PixelType>::limit() * (ofColor_<PixelType>::limit() - src[1]));
-		};
-		break;
-	case 3:
-		blendFunc = [](const ConstPixel&src, Pixel&dst){
-			dst[0] = clampedAdd(src[0], dst[0]);
-			dst[1] = clampedAdd(src[1], dst[1]);
-			dst[2] = clampedAdd(src[2], dst[2]);
-		};
-		break;
-	case 4:
-		blendFunc = [](const ConstPixel&src, Pixel&dst){
-			dst[0] = clampedAdd(src[0], dst[0] / ofColor_<PixelType>::limit() * (ofColor_<PixelType>::limit() - src[3]));
-			dst[1] = clampedAdd(src[1], dst[1] / ofColor_<PixelType>::limit() * (ofColor_<PixelType>::limit() - src[3]));
-			dst[2] = clampedAdd(src[2], dst[2] / ofColor_<PixelType>::limit() * (ofColor_<PixelType>::limit() - src[3]));
-			dst[3] = clampedAdd(src[3], dst[3] / ofColor_<PixelType>::limit() * (ofColor_<PixelType>::limit() - src[3]));
-		};
-		break;
+	// pixels without alpha are added, with alpha they are composited as
+	// premultiplied
+	auto channels = getNumChannels();
+	auto mode = channels == 2 || channels == 4 ? OF_BLENDMODE_ALPHA : OF_BLENDMODE_ADD;
+	return blendInto(dst, int(xTo), int(yTo), mode, true);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixels_<PixelType>::blendInto(ofPixels_<PixelType> &dst, int xTo, int yTo, ofBlendMode blendMode, bool premultipliedAlpha) const{
+	if(!isAllocated() || !dst.isAllocated() || &dst == this
+	   || !isBlendableFormat(pixelFormat) || pixelFormat != dst.getPixelFormat()){
+		return false;
 	}
-	auto dstLine = dst.getLine(yTo);
-	for(auto line: getConstLines()){
-		auto dstPixel = dstLine.getPixels().begin() + xTo;
-		for(auto p: line.getPixels()){
-			blendFunc(p,dstPixel);
-			dstPixel++;
-		}
-		dstLine++;
+
+	// only the part of the source that lands inside the destination
+	int64_t x0 = std::max<int64_t>(xTo, 0);
+	int64_t y0 = std::max<int64_t>(yTo, 0);
+	int64_t x1 = std::min<int64_t>(int64_t(xTo) + int64_t(width), dst.getWidth());
+	int64_t y1 = std::min<int64_t>(int64_t(yTo) + int64_t(height), dst.getHeight());
+	if(x0 >= x1 || y0 >= y1){
+		return true;
 	}
 
+	size_t channels = getNumChannels();
+	size_t numPixels = x1 - x0;
+	const PixelType * srcPixels = pixels + ((y0 - yTo) * width + (x0 - xTo)) * channels;
+	PixelType * dstPixels = dst.getData() + (y0 * dst.getWidth() + x0) * channels;
+	size_t srcStride = width * channels;
+	size_t dstStride = dst.getWidth() * channels;
+
+	ofParallelFor(0, y1 - y0, [&](size_t begin, size_t end){
+		for(size_t y = begin; y < end; y++){
+			blendRow(srcPixels + y * srcStride, dstPixels + y * dstStride, numPixels, channels, blendMode, premultipliedAlpha);
+		}
+	}, of::priv::rowGrain(numPixels * channels));
+
 	return true;
 }
 
@@ -7,6 +7,8 @@
 #include "ofLog.h"
 #include <limits>
 
+class ofPixelsPool;
+
 
 /// \file
 /// ofPixels is an object for working with blocks of pixels, those pixels can
@@ -52,7 +54,10 @@
 enum ofInterpolationMethod {
 	OF_INTERPOLATE_NEAREST_NEIGHBOR =1,
 	OF_INTERPOLATE_BILINEAR			=2,
-	OF_INTERPOLATE_BICUBIC			=3
+	OF_INTERPOLATE_BICUBIC			=3,
+	/// Average of the source pixels covered by each destination pixel,
+	/// best and fastest for downscaling
+	OF_INTERPOLATE_AREA				=4
 };
 
 
@@ -116,6 +121,17 @@ public:
 	/// the ofPixels object again to use it.
 	void clear();
 
+	/// \brief Allocate the memory of these pixels from a pool, see
+	/// ofPixelsPool.
+	///
+	/// Applies to the next allocations, memory is given back to the pool
+	/// when the pixels are cleared, reallocated or destroyed. Pixels
+	/// constructed as a copy or a move of others use their pool, assigning
+	/// or swapping pixels keeps the pool of each. nullptr, the default,
+	/// allocates with new.
+	void setPool(std::shared_ptr<ofPixelsPool> pool);
+	std::shared_ptr<ofPixelsPool> getPool() const;
+
 	ofPixels_<PixelType>& operator=(const ofPixels_<PixelType> & mom);
 	ofPixels_<PixelType>& operator=(ofPixels_<PixelType> && mom);
 
@@ -133,6 +149,13 @@ public:
 	void setFromPixels(const PixelType * newPixels,size_t w, size_t h, ofImageType type);
 	void setFromExternalPixels(PixelType * newPixels,size_t w, size_t h, size_t channels);
 	void setFromExternalPixels(PixelType * newPixels,size_t w, size_t h, ofPixelFormat pixelFormat);
+	/// \brief Use external data as the pixels without copying it, keeping
+	/// \p owner alive while the pixels use the data.
+	///
+	/// The owner is released when the pixels are cleared, set to other data
+	/// or destroyed, and moves with them. Useful to keep a file mapped for
+	/// as long as pixels that point into it exist.
+	void setFromExternalPixels(PixelType * newPixels,size_t w, size_t h, ofPixelFormat pixelFormat, std::shared_ptr<void> owner);
 	void setFromAlignedPixels(const PixelType * newPixels, size_t width, size_t height, size_t channels, size_t stride);
 	void setFromAlignedPixels(const PixelType * newPixels, size_t width, size_t height, ofPixelFormat pixelFormat, size_t stride);
 	/// \brief used to copy i420 pixels from gstreamer when (width % 4) != 0
@@ -174,6 +197,7 @@ public:
 	///     OF_INTERPOLATE_NEAREST_NEIGHBOR
 	///     OF_INTERPOLATE_BILINEAR		
 	///     OF_INTERPOLATE_BICUBIC		
+	///     OF_INTERPOLATE_AREA
 	bool resize(size_t dstWidth, size_t dstHeight, ofInterpolationMethod interpMethod=OF_INTERPOLATE_NEAREST_NEIGHBOR);	
 
 	/// \brief Resize the ofPixels instance to the size of the ofPixels object passed in dst. 
@@ -183,6 +207,7 @@ public:
 	///     OF_INTERPOLATE_NEAREST_NEIGHBOR
 	///     OF_INTERPOLATE_BILINEAR		
 	///     OF_INTERPOLATE_BICUBIC		
+	///     OF_INTERPOLATE_AREA
 	bool resizeTo(ofPixels_<PixelType> & dst, ofInterpolationMethod interpMethod=OF_INTERPOLATE_NEAREST_NEIGHBOR) const;
 	
 	/// \brief Paste the ofPixels object into another ofPixels object at the
@@ -191,8 +216,40 @@ public:
 	/// copied doesn't fit into the destination then the image is cropped.
 	bool pasteInto(ofPixels_<PixelType> &dst, size_t x, size_t y) const;
 
+	/// \brief Blend the ofPixels object into another ofPixels object at the
+	/// specified index. Pixels without alpha are added to the destination,
+	/// pixels with alpha are composited over it as premultiplied alpha.
+	///
+	/// \returns false if the pixels don't fit in the destination or their
+	/// formats are different.
 	bool blendInto(ofPixels_<PixelType> &dst, size_t x, size_t y) const;
 
+	/// \brief Blend the ofPixels object into another ofPixels object with
+	/// its top left corner at x, y, clipped to the destination.
+	///
+	/// Both pixels need the same format, one of OF_PIXELS_GRAY,
+	/// OF_PIXELS_GRAY_ALPHA, OF_PIXELS_RGB, OF_PIXELS_BGR, OF_PIXELS_RGBA or
+	/// OF_PIXELS_BGRA. With values normalized to [0, 1], s the source color
+	/// multiplied by its alpha a and d the destination color, each mode
+	/// gives:
+	///
+	///     OF_BLENDMODE_DISABLED  s, copies the source including its alpha
+	///     OF_BLENDMODE_ALPHA     s + d * (1 - a)
+	///     OF_BLENDMODE_ADD       s + d
+	///     OF_BLENDMODE_SUBTRACT  d - s
+	///     OF_BLENDMODE_MULTIPLY  s * d + d * (1 - a)
+	///     OF_BLENDMODE_SCREEN    s + d * (1 - s)
+	///
+	/// The destination alpha, if any, becomes a + alpha * (1 - a) and
+	/// results are clamped to [0, 1] even for float pixels. Pixels without
+	/// alpha are opaque. Large blends are split by rows across ofParallelFor.
+	///
+	/// \param premultipliedAlpha true if the color of the source is already
+	/// multiplied by its alpha.
+	/// \returns false if the formats aren't supported or don't match, or
+	/// the destination is the same object.
+	bool blendInto(ofPixels_<PixelType> &dst, int x, int y, ofBlendMode blendMode, bool premultipliedAlpha = false) const;
+
 	/// \brief Swaps the R and B channels of an
 	/// image, leaving the G and A channels as is.
 	void swapRgb();
@@ -550,6 +607,8 @@ private:
 	size_t 	pixelsSize = 0;
 	bool	bAllocated = false;
 	bool	pixelsOwner = true;			// if set from external data don't delete it
+	std::shared_ptr<void> externalOwner;	// keeps external data alive while it's used
+	std::shared_ptr<ofPixelsPool> pool;		// allocates the pixels if set
 	ofPixelFormat pixelFormat = OF_PIXELS_UNKNOWN;
 
 };
@@ -573,7 +632,8 @@ typedef ofShortPixels& ofShortPixelsRef;
 
 template<typename PixelType>
 template<typename SrcType>
-ofPixels_<PixelType>::ofPixels_(const ofPixels_<SrcType> & mom){
+ofPixels_<PixelType>::ofPixels_(const ofPixels_<SrcType> & mom)
+:pool(mom.getPool()){
 	bAllocated = false;
 	pixelsOwner = false;
 	pixelsSize = 0;
@@ -0,0 +1,824 @@
+#include "ofPixelsFilters.h"
+#include "ofPixelsInternal.h"
+#include "ofPixelsPool.h"
+#include "ofThreadPool.h"
+#include "ofFileUtils.h"
+#include "ofUtils.h"
+#include "ofLog.h"
+#include <cmath>
+#include <cstdlib>
+#include <cctype>
+
+namespace{
+	using of::priv::rowGrain;
+
+	// the biggest size the .cube format allows, 256^3 entries take 256MB
+	const size_t maxLutSize = 256;
+
+	size_t clampIndex(int64_t i, size_t size){
+		return size_t(std::min<int64_t>(std::max<int64_t>(i, 0), int64_t(size) - 1));
+	}
+
+	template<typename PixelType>
+	bool isFilterable(const ofPixels_<PixelType> & pixels, const char * function){
+		if(!pixels.isAllocated()){
+			ofLogError("ofPixelsFilters") << function << "(): pixels not allocated";
+			return false;
+		}
+		if(!of::priv::isInterleavedFormat(pixels.getPixelFormat())){
+			ofLogError("ofPixelsFilters") << function << "(): pixel format not supported, only formats with one plane of interleaved channels";
+			return false;
+		}
+		return true;
+	}
+
+	// temporary images come from a pool so filtering every frame doesn't
+	// allocate and page fault large buffers
+	template<typename PixelType, typename SrcType>
+	void allocateScratch(ofPixels_<PixelType> & scratch, const ofPixels_<SrcType> & like){
+		scratch.setPool(ofGetPixelsFiltersPool());
+		scratch.allocate(like.getWidth(), like.getHeight(), like.getPixelFormat());
+	}
+
+	//--------------------------------------------------
+	// conversions between pixels and floats, rounding and clamping integers
+	template<typename T>
+	struct Convert{
+		static void toFloat(const T * src, float * dst, size_t count){
+			for(size_t i = 0; i < count; i++){
+				dst[i] = float(src[i]);
+			}
+		}
+		static void fromFloat(const float * src, T * dst, size_t count){
+			const float limit = float(std::numeric_limits<T>::max());
+			for(size_t i = 0; i < count; i++){
+				dst[i] = T(std::min(std::max(src[i], 0.f), limit) + 0.5f);
+			}
+		}
+	};
+
+	template<>
+	struct Convert<float>{
+		static void toFloat(const float * src, float * dst, size_t count){
+			memcpy(dst, src, count * sizeof(float));
+		}
+		static void fromFloat(const float * src, float * dst, size_t count){
+			memcpy(dst, src, count * sizeof(float));
+		}
+	};
+
+#if OF_SSE2
+	template<>
+	struct Convert<unsigned char>{
+		static void toFloat(const unsigned char * src, float * dst, size_t count){
+			__m128i zero = _mm_setzero_si128();
+			size_t i = 0;
+			for(; i + 16 <= count; i += 16){
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+				__m128i lo = _mm_unpacklo_epi8(v, zero);
+				__m128i hi = _mm_unpackhi_epi8(v, zero);
+				_mm_storeu_ps(dst + i, _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)));
+				_mm_storeu_ps(dst + i + 4, _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)));
+				_mm_storeu_ps(dst + i + 8, _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)));
+				_mm_storeu_ps(dst + i + 12, _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)));
+			}
+			for(; i < count; i++){
+				dst[i] = float(src[i]);
+			}
+		}
+		static void fromFloat(const float * src, unsigned char * dst, size_t count){
+			__m128 zero = _mm_setzero_ps();
+			__m128 limit = _mm_set1_ps(255.f);
+			__m128 half = _mm_set1_ps(0.5f);
+			auto convert = [&](const float * p){
+				return _mm_cvttps_epi32(_mm_add_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(p), zero), limit), half));
+			};
+			size_t i = 0;
+			for(; i + 16 <= count; i += 16){
+				__m128i lo = _mm_packs_epi32(convert(src + i), convert(src + i + 4));
+				__m128i hi = _mm_packs_epi32(convert(src + i + 8), convert(src + i + 12));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+			}
+			for(; i < count; i++){
+				dst[i] = (unsigned char)(std::min(std::max(src[i], 0.f), 255.f) + 0.5f);
+			}
+		}
+	};
+#endif
+
+	//--------------------------------------------------
+	// operations on rows of floats, the inner loops of the filters
+
+	// dst += src * k
+	void madRow(float * dst, const float * src, float k, size_t count){
+		size_t i = 0;
+#if OF_SSE2
+		__m128 vk = _mm_set1_ps(k);
+		for(; i + 4 <= count; i += 4){
+			_mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), vk)));
+		}
+#endif
+		for(; i < count; i++){
+			dst[i] += src[i] * k;
+		}
+	}
+
+	// acc += add - sub
+	void slideRow(float * acc, const float * add, const float * sub, size_t count){
+		size_t i = 0;
+#if OF_SSE2
+		for(; i + 4 <= count; i += 4){
+			__m128 d = _mm_sub_ps(_mm_loadu_ps(add + i), _mm_loadu_ps(sub + i));
+			_mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), d));
+		}
+#endif
+		for(; i < count; i++){
+			acc[i] += add[i] - sub[i];
+		}
+	}
+
+	// dst = src * k
+	void scaleRow(float * dst, const float * src, float k, size_t count){
+		size_t i = 0;
+#if OF_SSE2
+		__m128 vk = _mm_set1_ps(k);
+		for(; i + 4 <= count; i += 4){
+			_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(src + i), vk));
+		}
+#endif
+		for(; i < count; i++){
+			dst[i] = src[i] * k;
+		}
+	}
+
+	// copies a row leaving room for radius pixels at each side, filled with
+	// the pixels at the edges
+	template<typename T>
+	void padRow(const T * src, T * dst, size_t width, size_t channels, size_t radius){
+		size_t pad = radius * channels;
+		memcpy(dst + pad, src, width * channels * sizeof(T));
+		for(size_t x = 0; x < radius; x++){
+			memcpy(dst + x * channels, src, channels * sizeof(T));
+			memcpy(dst + pad + (width + x) * channels, src + (width - 1) * channels, channels * sizeof(T));
+		}
+	}
+
+	//--------------------------------------------------
+	// box blurs with running sums, in place on an image of floats
+
+	// blurs each row once per radius
+	void boxRows(float * data, size_t width, size_t height, size_t channels, const std::vector<size_t> & radii){
+		size_t rowValues = width * channels;
+		size_t maxRadius = 0;
+		for(auto radius: radii){
+			maxRadius = std::max(maxRadius, radius);
+		}
+		ofParallelFor(0, height, [&](size_t begin, size_t end){
+			// one more pixel than the padding so the last sums updated, which
+			// aren't used, don't read past the row
+			std::vector<float> padded(rowValues + (2 * maxRadius + 1) * channels);
+			float sums[4];
+			for(size_t y = begin; y < end; y++){
+				float * line = data + y * rowValues;
+				for(auto radius: radii){
+					if(radius == 0){
+						continue;
+					}
+					padRow(line, padded.data(), width, channels, radius);
+					float scale = 1.f / (2 * radius + 1);
+					size_t window = (2 * radius + 1) * channels;
+					for(size_t c = 0; c < channels; c++){
+						sums[c] = 0;
+						for(size_t i = c; i < window; i += channels){
+							sums[c] += padded[i];
+						}
+					}
+					const float * add = padded.data() + window;
+					const float * sub = padded.data();
+					for(size_t x = 0; x < width; x++){
+						for(size_t c = 0; c < channels; c++){
+							line[c] = sums[c] * scale;
+							sums[c] += add[c] - sub[c];
+						}
+						line += channels;
+						add += channels;
+						sub += channels;
+					}
+					line -= rowValues;
+				}
+			}
+		}, rowGrain(rowValues));
+	}
+
+	// blurs each column once per radius, working on strips of columns so the
+	// sums of a whole strip are updated with vector operations row by row
+	void boxColumns(float * data, size_t width, size_t height, size_t channels, const std::vector<size_t> & radii){
+		const size_t stripValues = 512;
+		size_t rowValues = width * channels;
+		size_t numStrips = (rowValues + stripValues - 1) / stripValues;
+		size_t maxRadius = 0;
+		for(auto radius: radii){
+			maxRadius = std::max(maxRadius, radius);
+		}
+		ofParallelFor(0, numStrips, [&](size_t begin, size_t end){
+			// the rows that are overwritten but still have to be subtracted
+			// from the sums
+			size_t maxRingRows = std::min(maxRadius + 1, height);
+			std::vector<float> sums(stripValues);
+			std::vector<float> ring(maxRingRows * stripValues);
+			for(size_t strip = begin; strip < end; strip++){
+				size_t first = strip * stripValues;
+				size_t count = std::min(stripValues, rowValues - first);
+				auto row = [&](size_t y){
+					return data + y * rowValues + first;
+				};
+				for(auto radius: radii){
+					if(radius == 0){
+						continue;
+					}
+					size_t ringRows = std::min(radius + 1, height);
+					float scale = 1.f / (2 * radius + 1);
+					std::fill(sums.begin(), sums.end(), 0.f);
+					for(int64_t k = -int64_t(radius); k <= int64_t(radius); k++){
+						madRow(sums.data(), row(clampIndex(k, height)), 1.f, count);
+					}
+					for(size_t y = 0; y < height; y++){
+						memcpy(&ring[(y % ringRows) * stripValues], row(y), count * sizeof(float));
+						scaleRow(row(y), sums.data(), scale, count);
+						if(y + 1 < height){
+							const float * add = row(std::min(y + radius + 1, height - 1));
+							const float * sub = &ring[(y >= radius ? (y - radius) % ringRows : 0) * stripValues];
+							slideRow(sums.data(), add, sub, count);
+						}
+					}
+				}
+			}
+		}, 1);
+	}
+
+	// sizes of three box blurs that approximate a gaussian, from "Fast
+	// almost-gaussian filtering" by Peter Kovesi
+	std::vector<size_t> gaussianBoxRadii(float sigma){
+		const int n = 3;
+		double ideal = std::sqrt(12.0 * sigma * sigma / n + 1);
+		int lower = int(std::floor(ideal));
+		if(lower % 2 == 0){
+			lower--;
+		}
+		lower = std::max(lower, 1);
+		int upper = lower + 2;
+		double idealLower = (12.0 * sigma * sigma - n * lower * lower - 4.0 * n * lower - 3.0 * n) / (-4.0 * lower - 4);
+		int numLower = int(std::round(idealLower));
+		std::vector<size_t> radii;
+		for(int i = 0; i < n; i++){
+			radii.push_back(size_t(((i < numLower ? lower : upper) - 1) / 2));
+		}
+		return radii;
+	}
+
+	template<typename PixelType>
+	void toFloat(const ofPixels_<PixelType> & src, ofFloatPixels & dst){
+		size_t rowValues = src.getWidth() * src.getNumChannels();
+		ofParallelFor(0, src.getHeight(), [&](size_t begin, size_t end){
+			Convert<PixelType>::toFloat(src.getData() + begin * rowValues, dst.getData() + begin * rowValues, (end - begin) * rowValues);
+		}, rowGrain(rowValues));
+	}
+
+	template<typename PixelType>
+	void fromFloat(const ofFloatPixels & src, ofPixels_<PixelType> & dst){
+		size_t rowValues = src.getWidth() * src.getNumChannels();
+		ofParallelFor(0, src.getHeight(), [&](size_t begin, size_t end){
+			Convert<PixelType>::fromFloat(src.getData() + begin * rowValues, dst.getData() + begin * rowValues, (end - begin) * rowValues);
+		}, rowGrain(rowValues));
+	}
+
+	template<typename PixelType>
+	void boxBlur(const ofPixels_<PixelType> & src, ofFloatPixels & blurred, const std::vector<size_t> & radii){
+		allocateScratch(blurred, src);
+		toFloat(src, blurred);
+		boxRows(blurred.getData(), src.getWidth(), src.getHeight(), src.getNumChannels(), radii);
+		boxColumns(blurred.getData(), src.getWidth(), src.getHeight(), src.getNumChannels(), radii);
+	}
+
+	//--------------------------------------------------
+	// minimum and maximum of rows for erode and dilate
+	template<typename T, bool Max>
+	struct MinMax{
+		static void apply(T * dst, const T * src, size_t count){
+			for(size_t i = 0; i < count; i++){
+				dst[i] = Max ? std::max(dst[i], src[i]) : std::min(dst[i], src[i]);
+			}
+		}
+	};
+
+#if OF_SSE2
+	template<bool Max>
+	struct MinMax<unsigned char, Max>{
+		static void apply(unsigned char * dst, const unsigned char * src, size_t count){
+			size_t i = 0;
+			for(; i + 16 <= count; i += 16){
+				__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+				__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), Max ? _mm_max_epu8(a, b) : _mm_min_epu8(a, b));
+			}
+			for(; i < count; i++){
+				dst[i] = Max ? std::max(dst[i], src[i]) : std::min(dst[i], src[i]);
+			}
+		}
+	};
+
+	template<bool Max>
+	struct MinMax<float, Max>{
+		static void apply(float * dst, const float * src, size_t count){
+			size_t i = 0;
+			for(; i + 4 <= count; i += 4){
+				__m128 a = _mm_loadu_ps(dst + i);
+				__m128 b = _mm_loadu_ps(src + i);
+				_mm_storeu_ps(dst + i, Max ? _mm_max_ps(a, b) : _mm_min_ps(a, b));
+			}
+			for(; i < count; i++){
+				dst[i] = Max ? std::max(dst[i], src[i]) : std::min(dst[i], src[i]);
+			}
+		}
+	};
+#endif
+
+	template<typename PixelType, bool Max>
+	bool morphology(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst, size_t radius, const char * function){
+		if(!isFilterable(src, function)){
+			return false;
+		}
+		size_t width = src.getWidth();
+		size_t height = src.getHeight();
+		size_t channels = src.getNumChannels();
+		size_t rowValues = width * channels;
+		if(radius == 0){
+			dst = src;
+			return true;
+		}
+
+		ofPixels_<PixelType> rows;
+		allocateScratch(rows, src);
+		ofParallelFor(0, height, [&](size_t begin, size_t end){
+			std::vector<PixelType> padded(rowValues + 2 * radius * channels);
+			for(size_t y = begin; y < end; y++){
+				PixelType * out = rows.getData() + y * rowValues;
+				padRow(src.getData() + y * rowValues, padded.data(), width, channels, radius);
+				memcpy(out, padded.data(), rowValues * sizeof(PixelType));
+				for(size_t k = 1; k <= 2 * radius; k++){
+					MinMax<PixelType, Max>::apply(out, padded.data() + k * channels, rowValues);
+				}
+			}
+		}, rowGrain(rowValues));
+
+		dst.allocate(width, height, src.getPixelFormat());
+		ofParallelFor(0, height, [&](size_t begin, size_t end){
+			for(size_t y = begin; y < end; y++){
+				PixelType * out = dst.getData() + y * rowValues;
+				memcpy(out, rows.getData() + clampIndex(int64_t(y) - int64_t(radius), height) * rowValues, rowValues * sizeof(PixelType));
+				for(int64_t k = -int64_t(radius) + 1; k <= int64_t(radius); k++){
+					MinMax<PixelType, Max>::apply(out, rows.getData() + clampIndex(int64_t(y) + k, height) * rowValues, rowValues);
+				}
+			}
+		}, rowGrain(rowValues));
+		return true;
+	}
+
+	//--------------------------------------------------
+	// gradient magnitude of 3 padded rows with one pixel at each side
+	void sobelRow(const float * above, const float * center, const float * below, float * out, size_t count, size_t channels){
+		size_t i = 0;
+		const float * a0 = above;
+		const float * a2 = above + 2 * channels;
+		const float * c0 = center;
+		const float * c2 = center + 2 * channels;
+		const float * b0 = below;
+		const float * b2 = below + 2 * channels;
+		const float * a1 = above + channels;
+		const float * b1 = below + channels;
+#if OF_SSE2
+		__m128 two = _mm_set1_ps(2.f);
+		for(; i + 4 <= count; i += 4){
+			__m128 gx = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_loadu_ps(a2 + i), _mm_loadu_ps(a0 + i)),
+				_mm_mul_ps(two, _mm_sub_ps(_mm_loadu_ps(c2 + i), _mm_loadu_ps(c0 + i)))),
+				_mm_sub_ps(_mm_loadu_ps(b2 + i), _mm_loadu_ps(b0 + i)));
+			__m128 gy = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_loadu_ps(b0 + i), _mm_loadu_ps(a0 + i)),
+				_mm_mul_ps(two, _mm_sub_ps(_mm_loadu_ps(b1 + i), _mm_loadu_ps(a1 + i)))),
+				_mm_sub_ps(_mm_loadu_ps(b2 + i), _mm_loadu_ps(a2 + i)));
+			_mm_storeu_ps(out + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(gx, gx), _mm_mul_ps(gy, gy))));
+		}
+#endif
+		for(; i < count; i++){
+			float gx = ((a2[i] - a0[i]) + 2.f * (c2[i] - c0[i])) + (b2[i] - b0[i]);
+			float gy = ((b0[i] - a0[i]) + 2.f * (b1[i] - a1[i])) + (b2[i] - a2[i]);
+			out[i] = std::sqrt(gx * gx + gy * gy);
+		}
+	}
+
+	//--------------------------------------------------
+	// color of a normalized rgb through a table of size entries per side
+	// with 4 floats per entry
+	void lutColor(const float * table, size_t size, float r, float g, float b, float * out){
+		float maxIndex = float(size - 1);
+		auto split = [&](float v, size_t & index, float & fraction){
+			v = std::min(std::max(v, 0.f), 1.f) * maxIndex;
+			index = std::min(size_t(v), size - 2);
+			fraction = v - float(index);
+		};
+		size_t ix, iy, iz;
+		float tx, ty, tz;
+		split(r, ix, tx);
+		split(g, iy, ty);
+		split(b, iz, tz);
+		const float * c000 = table + ((iz * size + iy) * size + ix) * 4;
+		size_t dy = size * 4;
+		size_t dz = size * size * 4;
+#if OF_SSE2
+		auto lerp = [](__m128 a, __m128 b, __m128 t){
+			return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+		};
+		__m128 vx = _mm_set1_ps(tx);
+		__m128 x00 = lerp(_mm_loadu_ps(c000), _mm_loadu_ps(c000 + 4), vx);
+		__m128 x10 = lerp(_mm_loadu_ps(c000 + dy), _mm_loadu_ps(c000 + dy + 4), vx);
+		__m128 x01 = lerp(_mm_loadu_ps(c000 + dz), _mm_loadu_ps(c000 + dz + 4), vx);
+		__m128 x11 = lerp(_mm_loadu_ps(c000 + dz + dy), _mm_loadu_ps(c000 + dz + dy + 4), vx);
+		__m128 vy = _mm_set1_ps(ty);
+		_mm_storeu_ps(out, lerp(lerp(x00, x10, vy), lerp(x01, x11, vy), _mm_set1_ps(tz)));
+#else
+		auto lerp = [](float a, float b, float t){
+			return a + (b - a) * t;
+		};
+		for(size_t c = 0; c < 3; c++){
+			float x00 = lerp(c000[c], c000[c + 4], tx);
+			float x10 = lerp(c000[dy + c], c000[dy + c + 4], tx);
+			float x01 = lerp(c000[dz + c], c000[dz + c + 4], tx);
+			float x11 = lerp(c000[dz + dy + c], c000[dz + dy + c + 4], tx);
+			out[c] = lerp(lerp(x00, x10, ty), lerp(x01, x11, ty), tz);
+		}
+#endif
+	}
+}
+
+//--------------------------------------------------
+std::shared_ptr<ofPixelsPool> ofGetPixelsFiltersPool(){
+	static std::shared_ptr<ofPixelsPool> pool = std::make_shared<ofPixelsPool>();
+	return pool;
+}
+
+//--------------------------------------------------
+template<typename PixelType>
+bool ofConvolve(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst, const std::vector<float> & kernelX, const std::vector<float> & kernelY){
+	if(!isFilterable(src, "ofConvolve")){
+		return false;
+	}
+	if((kernelX.size() % 2) == 0 && !kernelX.empty()){
+		ofLogError("ofPixelsFilters") << "ofConvolve(): the horizontal kernel has an even size, it needs a center";
+		return false;
+	}
+	if((kernelY.size() % 2) == 0 && !kernelY.empty()){
+		ofLogError("ofPixelsFilters") << "ofConvolve(): the vertical kernel has an even size, it needs a center";
+		return false;
+	}
+	std::vector<float> identity(1, 1.f);
+	const auto & kx = kernelX.empty() ? identity : kernelX;
+	const auto & ky = kernelY.empty() ? identity : kernelY;
+	size_t width = src.getWidth();
+	size_t height = src.getHeight();
+	size_t channels = src.getNumChannels();
+	size_t rowValues = width * channels;
+
+	ofFloatPixels rows;
+	allocateScratch(rows, src);
+	size_t radiusX = kx.size() / 2;
+	ofParallelFor(0, height, [&](size_t begin, size_t end){
+		std::vector<float> padded(rowValues + 2 * radiusX * channels);
+		std::vector<float> converted(rowValues);
+		for(size_t y = begin; y < end; y++){
+			float * out = rows.getData() + y * rowValues;
+			Convert<PixelType>::toFloat(src.getData() + y * rowValues, converted.data(), rowValues);
+			padRow(converted.data(), padded.data(), width, channels, radiusX);
+			std::fill(out, out + rowValues, 0.f);
+			for(size_t k = 0; k < kx.size(); k++){
+				madRow(out, padded.data() + k * channels, kx[k], rowValues);
+			}
+		}
+	}, rowGrain(rowValues));
+
+	dst.allocate(width, height, src.getPixelFormat());
+	int64_t radiusY = ky.size() / 2;
+	ofParallelFor(0, height, [&](size_t begin, size_t end){
+		std::vector<float> sums(rowValues);
+		for(size_t y = begin; y < end; y++){
+			std::fill(sums.begin(), sums.end(), 0.f);
+			for(size_t k = 0; k < ky.size(); k++){
+				auto row = rows.getData() + clampIndex(int64_t(y) + int64_t(k) - radiusY, height) * rowValues;
+				madRow(sums.data(), row, ky[k], rowValues);
+			}
+			Convert<PixelType>::fromFloat(sums.data(), dst.getData() + y * rowValues, rowValues);
+		}
+	}, rowGrain(rowValues));
+	return true;
+}
+
+//--------------------------------------------------
+template<typename PixelType>
+bool ofBoxBlur(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst, size_t radius){
+	if(!isFilterable(src, "ofBoxBlur")){
+		return false;
+	}
+	ofFloatPixels blurred;
+	boxBlur(src, blurred, {radius});
+	dst.allocate(src.getWidth(), src.getHeight(), src.getPixelFormat());
+	fromFloat(blurred, dst);
+	return true;
+}
+
+//--------------------------------------------------
+template<typename PixelType>
+bool ofGaussianBlur(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst, float sigma){
+	if(!isFilterable(src, "ofGaussianBlur")){
+		return false;
+	}
+	ofFloatPixels blurred;
+	boxBlur(src, blurred, gaussianBoxRadii(std::max(sigma, 0.f)));
+	dst.allocate(src.getWidth(), src.getHeight(), src.getPixelFormat());
+	fromFloat(blurred, dst);
+	return true;
+}
+
+//--------------------------------------------------
+template<typename PixelType>
+bool ofSharpen(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst, float sigma, float amount){
+	if(!isFilterable(src, "ofSharpen")){
+		return false;
+	}
+	ofFloatPixels blurred;
+	boxBlur(src, blurred, gaussianBoxRadii(std::max(sigma, 0.f)));
+	dst.allocate(src.getWidth(), src.getHeight(), src.getPixelFormat());
+	size_t rowValues = src.getWidth() * src.getNumChannels();
+	// src and dst can be the same pixels, each value is read before it's
+	// written
+	ofParallelFor(0, src.getHeight(), [&](size_t begin, size_t end){
+		std::vector<float> row(rowValues);
+		for(size_t y = begin; y < end; y++){
+			Convert<PixelType>::toFloat(src.getData() + y * rowValues, row.data(), rowValues);
+			const float * blur = blurred.getData() + y * rowValues;
+			for(size_t i = 0; i < rowValues; i++){
+				row[i] += amount * (row[i] - blur[i]);
+			}
+			Convert<PixelType>::fromFloat(row.data(), dst.getData() + y * rowValues, rowValues);
+		}
+	}, rowGrain(rowValues));
+	return true;
+}
+
+//--------------------------------------------------
+template<typename PixelType>
+bool ofErode(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst, size_t radius){
+	return morphology<PixelType, false>(src, dst, radius, "ofErode");
+}
+
+//--------------------------------------------------
+template<typename PixelType>
+bool ofDilate(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst, size_t radius){
+	return morphology<PixelType, true>(src, dst, radius, "ofDilate");
+}
+
+//--------------------------------------------------
+template<typename PixelType>
+bool ofSobel(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst){
+	if(!isFilterable(src, "ofSobel")){
+		return false;
+	}
+	// the rows around each row are read after it's written when filtering
+	// in place, so they are read from a copy
+	ofPixels_<PixelType> copy;
+	const ofPixels_<PixelType> * input = &src;
+	if(&src == &dst){
+		allocateScratch(copy, src);
+		memcpy(copy.getData(), src.getData(), src.getTotalBytes());
+		input = &copy;
+	}
+	size_t width = src.getWidth();
+	size_t height = src.getHeight();
+	size_t channels = src.getNumChannels();
+	size_t rowValues = width * channels;
+	dst.allocate(width, height, src.getPixelFormat());
+	ofParallelFor(0, height, [&](size_t begin, size_t end){
+		std::vector<float> converted(rowValues);
+		std::vector<float> padded(3 * (rowValues + 2 * channels));
+		std::vector<float> magnitude(rowValues);
+		float * rows[3];
+		for(size_t i = 0; i < 3; i++){
+			rows[i] = padded.data() + i * (rowValues + 2 * channels);
+		}
+		for(size_t y = begin; y < end; y++){
+			for(int64_t k = -1; k <= 1; k++){
+				Convert<PixelType>::toFloat(input->getData() + clampIndex(int64_t(y) + k, height) * rowValues, converted.data(), rowValues);
+				padRow(converted.data(), rows[k + 1], width, channels, 1);
+			}
+			sobelRow(rows[0], rows[1], rows[2], magnitude.data(), rowValues, channels);
+			Convert<PixelType>::fromFloat(magnitude.data(), dst.getData() + y * rowValues, rowValues);
+		}
+	}, rowGrain(rowValues));
+	return true;
+}
+
+//--------------------------------------------------
+bool ofLut3D::load(const std::filesystem::path & path){
+	clear();
+	auto buffer = ofBufferFromFile(path);
+	if(buffer.size() == 0){
+		ofLogError("ofLut3D") << "load(): couldn't read " << path;
+		return false;
+	}
+
+	size_t lutSize = 0;
+	float domainMin[3] = {0, 0, 0};
+	float domainMax[3] = {1, 1, 1};
+	std::vector<ofFloatColor> colors;
+	size_t lineNumber = 0;
+	for(const auto & view: buffer.getLineViews()){
+		lineNumber++;
+		auto line = ofTrim(std::string(view));
+		if(line.empty() || line[0] == '#'){
+			continue;
+		}
+		if(!std::isalpha((unsigned char)line[0])){
+			// an entry of the table, 3 floats
+			const char * p = line.c_str();
+			char * next;
+			float values[3];
+			for(auto & value: values){
+				value = std::strtof(p, &next);
+				if(next == p){
+					ofLogError("ofLut3D") << "load(): couldn't parse line " << lineNumber << " of " << path;
+					return false;
+				}
+				p = next;
+			}
+			colors.emplace_back(values[0], values[1], values[2]);
+			continue;
+		}
+
+		auto words = ofSplitString(line, " ", true, true);
+		auto & keyword = words[0];
+		if(keyword == "LUT_3D_SIZE" && words.size() > 1){
+			lutSize = std::max(ofToInt(words[1]), 0);
+		}else if(keyword == "LUT_1D_SIZE"){
+			ofLogError("ofLut3D") << "load(): " << path << " is a 1D table, only 3D tables are supported";
+			return false;
+		}else if(keyword == "DOMAIN_MIN" && words.size() > 3){
+			for(size_t i = 0; i < 3; i++){
+				domainMin[i] = ofToFloat(words[i + 1]);
+			}
+		}else if(keyword == "DOMAIN_MAX" && words.size() > 3){
+			for(size_t i = 0; i < 3; i++){
+				domainMax[i] = ofToFloat(words[i + 1]);
+			}
+		}
+		// TITLE and other keywords don't change the table
+	}
+
+	// checked before cubing the size so it can't overflow
+	if(lutSize < 2 || lutSize > maxLutSize){
+		ofLogError("ofLut3D") << "load(): " << path << " has a LUT_3D_SIZE of " << lutSize << ", it has to be between 2 and " << maxLutSize;
+		return false;
+	}
+	if(colors.size() != lutSize * lutSize * lutSize){
+		ofLogError("ofLut3D") << "load(): " << path << " has " << colors.size() << " entries, expected LUT_3D_SIZE^3";
+		return false;
+	}
+	if(domainMin[0] != 0 || domainMin[1] != 0 || domainMin[2] != 0 || domainMax[0] != 1 || domainMax[1] != 1 || domainMax[2] != 1){
+		ofLogWarning("ofLut3D") << "load(): " << path << " has a domain other than [0, 1], it will be applied to colors in [0, 1]";
+	}
+	return setup(lutSize, colors);
+}
+
+//--------------------------------------------------
+bool ofLut3D::setup(size_t lutSize, const std::vector<ofFloatColor> & colors){
+	if(lutSize < 2 || lutSize > maxLutSize || colors.size() != lutSize * lutSize * lutSize){
+		ofLogError("ofLut3D") << "setup(): expected size^3 colors and a size between 2 and " << maxLutSize;
+		return false;
+	}
+	size = lutSize;
+	table.resize(colors.size() * 4);
+	for(size_t i = 0; i < colors.size(); i++){
+		table[i * 4] = colors[i].r;
+		table[i * 4 + 1] = colors[i].g;
+		table[i * 4 + 2] = colors[i].b;
+		table[i * 4 + 3] = 0;
+	}
+	return true;
+}
+
+//--------------------------------------------------
+void ofLut3D::setupIdentity(size_t lutSize){
+	lutSize = std::min(std::max<size_t>(lutSize, 2), maxLutSize);
+	std::vector<ofFloatColor> colors;
+	colors.reserve(lutSize * lutSize * lutSize);
+	float step = 1.f / (lutSize - 1);
+	for(size_t b = 0; b < lutSize; b++){
+		for(size_t g = 0; g < lutSize; g++){
+			for(size_t r = 0; r < lutSize; r++){
+				colors.emplace_back(r * step, g * step, b * step);
+			}
+		}
+	}
+	setup(lutSize, colors);
+}
+
+//--------------------------------------------------
+bool ofLut3D::isLoaded() const{
+	return size > 0;
+}
+
+//--------------------------------------------------
+void ofLut3D::clear(){
+	table.clear();
+	size = 0;
+}
+
+//--------------------------------------------------
+size_t ofLut3D::getSize() const{
+	return size;
+}
+
+//--------------------------------------------------
+ofFloatColor ofLut3D::getColor(const ofFloatColor & color) const{
+	if(!isLoaded()){
+		return color;
+	}
+	float out[4];
+	lutColor(table.data(), size, color.r, color.g, color.b, out);
+	return ofFloatColor(out[0], out[1], out[2], color.a);
+}
+
+//--------------------------------------------------
+const float * ofLut3D::getData() const{
+	return table.data();
+}
+
+//--------------------------------------------------
+template<typename PixelType>
+bool ofApplyLut(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst, const ofLut3D & lut){
+	if(!src.isAllocated() || !lut.isLoaded()){
+		return false;
+	}
+	bool bgr;
+	switch(src.getPixelFormat()){
+	case OF_PIXELS_RGB:
+	case OF_PIXELS_RGBA:
+		bgr = false;
+		break;
+	case OF_PIXELS_BGR:
+	case OF_PIXELS_BGRA:
+		bgr = true;
+		break;
+	default:
+		ofLogError("ofPixelsFilters") << "ofApplyLut(): pixel format not supported, only RGB, BGR, RGBA and BGRA";
+		return false;
+	}
+	size_t width = src.getWidth();
+	size_t channels = src.getNumChannels();
+	size_t rowValues = width * channels;
+	dst.allocate(width, src.getHeight(), src.getPixelFormat());
+	const float limit = ofColor_<PixelType>::limit();
+	const float * table = lut.getData();
+	size_t size = lut.getSize();
+	// every pixel is read before it's written so src and dst can be the
+	// same pixels
+	ofParallelFor(0, src.getHeight(), [&](size_t begin, size_t end){
+		std::vector<float> row(rowValues);
+		for(size_t y = begin; y < end; y++){
+			Convert<PixelType>::toFloat(src.getData() + y * rowValues, row.data(), rowValues);
+			for(size_t x = 0; x < width; x++){
+				float * pixel = &row[x * channels];
+				float r = pixel[bgr ? 2 : 0] / limit;
+				float g = pixel[1] / limit;
+				float b = pixel[bgr ? 0 : 2] / limit;
+				float mapped[4];
+				lutColor(table, size, r, g, b, mapped);
+				pixel[bgr ? 2 : 0] = mapped[0] * limit;
+				pixel[1] = mapped[1] * limit;
+				pixel[bgr ? 0 : 2] = mapped[2] * limit;
+			}
+			Convert<PixelType>::fromFloat(row.data(), dst.getData() + y * rowValues, rowValues);
+		}
+	}, rowGrain(rowValues));
+	return true;
+}
+
+#define OF_PIXELS_FILTERS_INSTANTIATE(PixelType) \
+	template bool ofConvolve(const ofPixels_<PixelType> &, ofPixels_<PixelType> &, const std::vector<float> &, const std::vector<float> &); \
+	template bool ofBoxBlur(const ofPixels_<PixelType> &, ofPixels_<PixelType> &, size_t); \
+	template bool ofGaussianBlur(const ofPixels_<PixelType> &, ofPixels_<PixelType> &, float); \
+	template bool ofSharpen(const ofPixels_<PixelType> &, ofPixels_<PixelType> &, float, float); \
+	template bool ofErode(const ofPixels_<PixelType> &, ofPixels_<PixelType> &, size_t); \
+	template bool ofDilate(const ofPixels_<PixelType> &, ofPixels_<PixelType> &, size_t); \
+	template bool ofSobel(const ofPixels_<PixelType> &, ofPixels_<PixelType> &); \
+	template bool ofApplyLut(const ofPixels_<PixelType> &, ofPixels_<PixelType> &, const ofLut3D &);
+
+OF_PIXELS_FILTERS_INSTANTIATE(unsigned char)
+OF_PIXELS_FILTERS_INSTANTIATE(unsigned short)
+OF_PIXELS_FILTERS_INSTANTIATE(float)
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofPixels.h"
+#include "ofColor.h"
+
+class ofPixelsPool;
+
+/// \file
+/// Filters that process ofPixels on the CPU: blurs, convolution,
+/// morphology, edge detection and color lookup tables.
+///
+/// Every filter reads from \p src and writes to \p dst, which can be the
+/// same pixels to filter them in place. \p dst is only reallocated if its
+/// size or format differ from the source, so passing the same destination
+/// every frame doesn't allocate. Large images are split in rows across
+/// ofParallelFor and the inner loops use SSE2 when it's available.
+///
+/// The filters are implemented for ofPixels, ofShortPixels and
+/// ofFloatPixels in any format with a single plane and interleaved
+/// channels: gray, gray alpha, RGB, BGR, RGBA, BGRA and the Y, U, V, UV and
+/// VU formats. Every channel is filtered, including alpha. Pixels outside
+/// the image take the value of the closest edge pixel. Results are rounded
+/// and clamped for integer pixels, float pixels aren't clamped.
+///
+/// ~~~~{.cpp}
+/// void ofApp::update(){
+///     grabber.update();
+///     if(grabber.isFrameNew()){
+///         ofGaussianBlur(grabber.getPixels(), blurred, 4);
+///         texture.loadData(blurred);
+///     }
+/// }
+/// ~~~~
+
+/// \returns the pool the filters take their temporary images from. Its
+/// buffers are kept after filtering, call trim() on it to free them.
+std::shared_ptr<ofPixelsPool> ofGetPixelsFiltersPool();
+
+/// \brief Convolve pixels with a separable kernel, first each row with
+/// \p kernelX and then each column with \p kernelY.
+///
+/// Kernels are centered on the pixel being filtered and applied as they
+/// are, without flipping them. An empty kernel leaves that direction as
+/// is.
+///
+/// \returns false if a kernel has an even size or the format isn't
+/// supported.
+template<typename PixelType>
+bool ofConvolve(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst, const std::vector<float> & kernelX, const std::vector<float> & kernelY);
+
+/// \brief Average each pixel with the ones around it in a square of
+/// 2 * radius + 1 pixels.
+///
+/// Uses running sums so the cost doesn't depend on the radius.
+template<typename PixelType>
+bool ofBoxBlur(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst, size_t radius);
+
+/// \brief Approximate a gaussian blur with three box blurs.
+///
+/// The cost doesn't depend on \p sigma, large blurs are as fast as small
+/// ones. The result is within a few percent of a true gaussian.
+///
+/// \param sigma Standard deviation of the gaussian in pixels.
+template<typename PixelType>
+bool ofGaussianBlur(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst, float sigma);
+
+/// \brief Sharpen pixels by adding the difference between them and a
+/// gaussian blur of them, known as unsharp masking.
+///
+/// \param sigma Standard deviation of the blur, the size of the details
+/// that are enhanced.
+/// \param amount How much of the difference is added, 1 doubles it.
+template<typename PixelType>
+bool ofSharpen(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst, float sigma, float amount = 1);
+
+/// \brief Replace each value with the minimum in a square of 2 * radius + 1
+/// pixels around it, shrinking bright areas.
+template<typename PixelType>
+bool ofErode(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst, size_t radius = 1);
+
+/// \brief Replace each value with the maximum in a square of 2 * radius + 1
+/// pixels around it, growing bright areas.
+template<typename PixelType>
+bool ofDilate(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst, size_t radius = 1);
+
+/// \brief Detect edges with the 3x3 Sobel operator.
+///
+/// Each value becomes the magnitude of the gradient of its channel,
+/// sqrt(gx * gx + gy * gy), so flat areas are 0 and edges are bright.
+template<typename PixelType>
+bool ofSobel(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst);
+
+/// \class ofLut3D
+///
+/// A 3D color lookup table that maps each RGB color to another one, used
+/// to grade images. Colors between the entries of the table are
+/// interpolated linearly. Tables can be loaded from .cube files, the
+/// format most grading software exports.
+class ofLut3D{
+public:
+	/// \brief Load a 3D table from a .cube file.
+	bool load(const std::filesystem::path & path);
+
+	/// \brief Set up a table from its entries.
+	///
+	/// \param size Entries in each dimension, between 2 and 256.
+	/// \param colors size * size * size colors ordered with red changing
+	/// fastest, then green, then blue, like in .cube files.
+	bool setup(size_t size, const std::vector<ofFloatColor> & colors);
+
+	/// \brief Set up a table that maps every color to itself.
+	/// \param size Entries in each dimension, clamped to [2, 256].
+	void setupIdentity(size_t size = 2);
+
+	bool isLoaded() const;
+	void clear();
+
+	/// \returns the entries of the table in each dimension.
+	size_t getSize() const;
+
+	/// \returns the color a color maps to, both with components in [0, 1].
+	ofFloatColor getColor(const ofFloatColor & color) const;
+
+	/// \cond INTERNAL
+	const float * getData() const;
+	/// \endcond
+
+private:
+	// entries as red, green, blue and an unused fourth float so they can be
+	// loaded as one vector
+	std::vector<float> table;
+	size_t size = 0;
+};
+
+/// \brief Map the colors of pixels through a 3D lookup table.
+///
+/// Only the color channels of RGB, BGR, RGBA and BGRA pixels are mapped,
+/// alpha is copied as is.
+template<typename PixelType>
+bool ofApplyLut(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst, const ofLut3D & lut);
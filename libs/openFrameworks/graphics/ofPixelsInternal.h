@@ -0,0 +1,40 @@
+#pragma once
+
+#include "ofPixels.h"
+#include "ofSimdInternal.h"
+
+/// \cond INTERNAL
+// helpers shared by the implementations of ofPixels and the pixel filters
+// and statistics, not part of the api
+
+namespace of{
+namespace priv{
+	// images with less values than this per chunk aren't split across
+	// threads, the work wouldn't pay for waking them
+	inline size_t rowGrain(size_t rowValues){
+		return std::max<size_t>(1, 65536 / std::max<size_t>(rowValues, 1));
+	}
+
+	// formats with a single plane of interleaved channels, one value per
+	// channel, that can be processed as rows of width * channels values
+	inline bool isInterleavedFormat(ofPixelFormat format){
+		switch(format){
+		case OF_PIXELS_GRAY:
+		case OF_PIXELS_GRAY_ALPHA:
+		case OF_PIXELS_RGB:
+		case OF_PIXELS_BGR:
+		case OF_PIXELS_RGBA:
+		case OF_PIXELS_BGRA:
+		case OF_PIXELS_Y:
+		case OF_PIXELS_U:
+		case OF_PIXELS_V:
+		case OF_PIXELS_UV:
+		case OF_PIXELS_VU:
+			return true;
+		default:
+			return false;
+		}
+	}
+}
+}
+/// \endcond
@@ -0,0 +1,173 @@
+#include "ofPixelsPool.h"
+#include "ofThreadPool.h"
+#include <map>
+#include <vector>
+#include <new>
+#include <algorithm>
+
+struct ofPixelsPool::Impl{
+	ofCoreMutex mutex;
+
+	// released buffers by size class
+	std::map<size_t, std::vector<void*>> cached;
+	ofPixelsPoolStats stats;
+	size_t maxCachedBytes = 0;
+
+	~Impl(){
+		for(auto & sizeClass: cached){
+			for(auto buffer: sizeClass.second){
+				::operator delete(buffer);
+			}
+		}
+	}
+
+	// removes cached buffers, largest first and skipping the ones of the
+	// size class passed, until the pool can keep the bytes passed
+	void evict(size_t bytes, size_t keepSizeClass, std::vector<void*> & toFree){
+		auto sizeClass = cached.end();
+		while(stats.bytesCached + bytes > maxCachedBytes && sizeClass != cached.begin()){
+			--sizeClass;
+			if(sizeClass->first == keepSizeClass){
+				continue;
+			}
+			auto & buffers = sizeClass->second;
+			while(!buffers.empty() && stats.bytesCached + bytes > maxCachedBytes){
+				toFree.push_back(buffers.back());
+				buffers.pop_back();
+				stats.bytesCached -= sizeClass->first;
+				stats.buffersCached -= 1;
+				stats.evicted += 1;
+			}
+		}
+	}
+
+	void release(void * buffer, size_t sizeClass){
+		std::vector<void*> toFree;
+		{
+			ofCoreLock lock(mutex);
+			stats.bytesInUse -= sizeClass;
+			stats.buffersInUse -= 1;
+			evict(sizeClass, sizeClass, toFree);
+			if(stats.bytesCached + sizeClass > maxCachedBytes){
+				toFree.push_back(buffer);
+				stats.evicted += 1;
+			}else{
+				cached[sizeClass].push_back(buffer);
+				stats.bytesCached += sizeClass;
+				stats.buffersCached += 1;
+			}
+		}
+		// freeing large buffers can take a while, so it's done without
+		// blocking other threads using the pool
+		for(auto buffer: toFree){
+			::operator delete(buffer);
+		}
+	}
+};
+
+//--------------------------------------------------
+ofPixelsPool::ofPixelsPool(size_t maxCachedBytes)
+:impl(new Impl){
+	impl->maxCachedBytes = maxCachedBytes;
+}
+
+//--------------------------------------------------
+ofPixelsPool::~ofPixelsPool(){
+	// buffers still in use keep the rest of the pool alive until they
+	// are released
+	trim();
+}
+
+//--------------------------------------------------
+size_t ofPixelsPool::getSizeClass(size_t bytes){
+	if(bytes <= 64){
+		return 64;
+	}
+	// four classes between each power of two
+	size_t powerOfTwo = 64;
+	while(powerOfTwo < (bytes - 1) / 2 + 1){
+		powerOfTwo *= 2;
+	}
+	size_t step = powerOfTwo / 4;
+	return (bytes + step - 1) / step * step;
+}
+
+//--------------------------------------------------
+std::shared_ptr<void> ofPixelsPool::acquire(size_t bytes){
+	auto sizeClass = getSizeClass(bytes);
+	void * buffer = nullptr;
+	{
+		ofCoreLock lock(impl->mutex);
+		auto & stats = impl->stats;
+		auto cached = impl->cached.find(sizeClass);
+		if(cached != impl->cached.end() && !cached->second.empty()){
+			buffer = cached->second.back();
+			cached->second.pop_back();
+			stats.bytesCached -= sizeClass;
+			stats.buffersCached -= 1;
+			stats.hits += 1;
+		}else{
+			stats.misses += 1;
+		}
+		stats.bytesInUse += sizeClass;
+		stats.buffersInUse += 1;
+		stats.highWaterBytes = std::max(stats.highWaterBytes, stats.bytesInUse);
+	}
+
+	if(!buffer){
+		try{
+			buffer = ::operator new(sizeClass);
+		}catch(...){
+			ofCoreLock lock(impl->mutex);
+			impl->stats.bytesInUse -= sizeClass;
+			impl->stats.buffersInUse -= 1;
+			throw;
+		}
+	}
+
+	auto pool = impl;
+	return std::shared_ptr<void>(buffer, [pool, sizeClass](void * buffer){
+		pool->release(buffer, sizeClass);
+	});
+}
+
+//--------------------------------------------------
+void ofPixelsPool::setMaxCachedBytes(size_t maxCachedBytes){
+	std::vector<void*> toFree;
+	{
+		ofCoreLock lock(impl->mutex);
+		impl->maxCachedBytes = maxCachedBytes;
+		impl->evict(0, 0, toFree);
+	}
+	for(auto buffer: toFree){
+		::operator delete(buffer);
+	}
+}
+
+//--------------------------------------------------
+size_t ofPixelsPool::getMaxCachedBytes() const{
+	ofCoreLock lock(impl->mutex);
+	return impl->maxCachedBytes;
+}
+
+//--------------------------------------------------
+void ofPixelsPool::trim(){
+	std::map<size_t, std::vector<void*>> toFree;
+	{
+		ofCoreLock lock(impl->mutex);
+		std::swap(toFree, impl->cached);
+		impl->stats.bytesCached = 0;
+		impl->stats.buffersCached = 0;
+	}
+	for(auto & sizeClass: toFree){
+		for(auto buffer: sizeClass.second){
+			::operator delete(buffer);
+		}
+	}
+}
+
+//--------------------------------------------------
+ofPixelsPoolStats ofPixelsPool::getStats() const{
+	ofCoreLock lock(impl->mutex);
+	return impl->stats;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "ofConstants.h"
+#include <memory>
+
+/// \brief What an ofPixelsPool has done since it was created.
+struct ofPixelsPoolStats{
+	/// Buffers acquired that were reused from the pool.
+	uint64_t hits = 0;
+	/// Buffers acquired that had to be allocated.
+	uint64_t misses = 0;
+	/// Buffers freed instead of kept because the pool was full.
+	uint64_t evicted = 0;
+	/// Buffers acquired and not released yet.
+	size_t buffersInUse = 0;
+	/// Bytes in the buffers acquired and not released yet.
+	size_t bytesInUse = 0;
+	/// Most bytes that were ever in use at the same time.
+	size_t highWaterBytes = 0;
+	/// Buffers released and kept to be reused.
+	size_t buffersCached = 0;
+	/// Bytes in the buffers kept to be reused.
+	size_t bytesCached = 0;
+};
+
+/// \class ofPixelsPool
+///
+/// Keeps the memory of pixels that are released to reuse it for the next
+/// pixels of a similar size, instead of freeing and allocating it again.
+///
+/// Video players, grabbers and filters allocate and free buffers of the
+/// same size every frame. At high resolutions that means page faults and
+/// a fragmented heap, since buffers that large are usually mapped and
+/// unmapped from the system each time. Pixels that use a pool get their
+/// memory from it and give it back when they are cleared or destroyed:
+///
+/// ~~~~{.cpp}
+/// auto pool = std::make_shared<ofPixelsPool>();
+/// ofPixels frame;
+/// frame.setPool(pool);
+/// frame.allocate(3840, 2160, OF_PIXELS_RGBA); // a miss, allocates
+/// frame.clear();                              // back to the pool
+/// frame.allocate(3840, 2160, OF_PIXELS_RGBA); // a hit, reuses it
+/// ~~~~
+///
+/// Sizes are rounded up to one of four classes per power of two so
+/// buffers for sizes that are close can be shared, wasting at most a
+/// quarter of the memory. The pool is thread safe and buffers can be released from any
+/// thread, even after the pool itself is destroyed.
+class ofPixelsPool{
+public:
+	/// \param maxCachedBytes Bytes to keep in released buffers, once the
+	/// pool holds this many buffers of other sizes are freed first, then
+	/// the released one.
+	ofPixelsPool(size_t maxCachedBytes = 256 * 1024 * 1024);
+	~ofPixelsPool();
+
+	/// \brief Get a buffer of at least the size passed.
+	///
+	/// The memory isn't initialized. It goes back to the pool when the
+	/// last copy of the pointer returned is destroyed.
+	std::shared_ptr<void> acquire(size_t bytes);
+
+	void setMaxCachedBytes(size_t maxCachedBytes);
+	size_t getMaxCachedBytes() const;
+
+	/// \brief Free the buffers kept in the pool, the ones in use are kept
+	/// again when they are released.
+	void trim();
+
+	ofPixelsPoolStats getStats() const;
+
+	/// \returns the size of the buffers the pool allocates to hold a
+	/// number of bytes.
+	static size_t getSizeClass(size_t bytes);
+
+private:
+	ofPixelsPool(const ofPixelsPool &) = delete;
+	ofPixelsPool & operator=(const ofPixelsPool &) = delete;
+
+	struct Impl;
+	std::shared_ptr<Impl> impl;
+};
@@ -0,0 +1,664 @@
+#include "ofPixelsStats.h"
+#include "ofPixelsInternal.h"
+#include "ofThreadPool.h"
+#include "ofColor.h"
+#include "ofLog.h"
+#include "ofMath.h"
+#include <cmath>
+
+namespace{
+	using of::priv::rowGrain;
+
+	struct Region{
+		size_t x = 0;
+		size_t y = 0;
+		size_t width = 0;
+		size_t height = 0;
+	};
+
+	template<typename PixelType>
+	bool getRegion(const ofPixels_<PixelType> & pixels, size_t x, size_t y, size_t width, size_t height, Region & region, const char * function){
+		if(!pixels.isAllocated()){
+			ofLogError("ofPixelsStats") << function << "(): pixels not allocated";
+			return false;
+		}
+		if(!of::priv::isInterleavedFormat(pixels.getPixelFormat())){
+			ofLogError("ofPixelsStats") << function << "(): pixel format not supported, only formats with one plane of interleaved channels";
+			return false;
+		}
+		region.x = std::min(x, pixels.getWidth());
+		region.y = std::min(y, pixels.getHeight());
+		region.width = std::min(width, pixels.getWidth() - region.x);
+		region.height = std::min(height, pixels.getHeight() - region.y);
+		return true;
+	}
+
+	template<typename PixelType>
+	const PixelType * rowStart(const ofPixels_<PixelType> & pixels, const Region & region, size_t y){
+		return pixels.getData() + ((region.y + y) * pixels.getWidth() + region.x) * pixels.getNumChannels();
+	}
+
+	// splits the rows of a region across ofParallelFor, each subrange
+	// accumulates into its own partial result and the partials are
+	// returned to be merged
+	template<typename Partial, typename Function>
+	std::vector<std::unique_ptr<Partial>> parallelRows(size_t rows, size_t rowValues, Function function){
+		std::vector<std::unique_ptr<Partial>> partials(rows);
+		ofParallelFor(0, rows, [&](size_t begin, size_t end){
+			std::unique_ptr<Partial> partial(new Partial);
+			function(begin, end, *partial);
+			partials[begin] = std::move(partial);
+		}, rowGrain(rowValues));
+		return partials;
+	}
+
+	//--------------------------------------------------
+	// bins of the values of a row, looked up in a table for integer
+	// pixels. The Table is built once per histogram and shared by the
+	// binners of every subrange, which only point into it
+	template<typename PixelType>
+	struct Binner{
+		struct Table{
+			std::vector<uint32_t> bins;
+			Table(const ofPixelsHistogram & histogram){
+				bins.resize(size_t(std::numeric_limits<PixelType>::max()) + 1);
+				for(size_t v = 0; v < bins.size(); v++){
+					bins[v] = uint32_t(histogram.getBin(float(v)));
+				}
+			}
+		};
+		const uint32_t * table;
+		const PixelType * values = nullptr;
+		Binner(const Table & table)
+		:table(table.bins.data()){}
+		void setRow(const PixelType * row, size_t){
+			values = row;
+		}
+		uint32_t operator[](size_t i) const{
+			return table[values[i]];
+		}
+	};
+
+	template<>
+	struct Binner<float>{
+		struct Table{
+			float minValue;
+			float scale;
+			float lastBin;
+			Table(const ofPixelsHistogram & histogram)
+			:minValue(histogram.getMinValue())
+			,lastBin(float(histogram.getNumBins() - 1)){
+				scale = histogram.getNumBins() / (histogram.getMaxValue() - histogram.getMinValue());
+			}
+		};
+		const Table & table;
+		Binner(const Table & table)
+		:table(table){}
+		// bins of a row computed in vectors before counting them
+		std::vector<uint32_t> bins;
+		void setRow(const float * values, size_t count){
+			bins.resize(count);
+			uint32_t * out = bins.data();
+			size_t i = 0;
+			float minValue = table.minValue;
+			float scale = table.scale;
+			float lastBin = table.lastBin;
+#if OF_SSE2
+			__m128 vmin = _mm_set1_ps(minValue);
+			__m128 vscale = _mm_set1_ps(scale);
+			__m128 vlast = _mm_set1_ps(lastBin);
+			__m128 zero = _mm_setzero_ps();
+			for(; i + 4 <= count; i += 4){
+				// max returns its second operand for NaN so those go to the
+				// first bin
+				__m128 bin = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(values + i), vmin), vscale);
+				bin = _mm_min_ps(_mm_max_ps(bin, zero), vlast);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_cvttps_epi32(bin));
+			}
+#endif
+			for(; i < count; i++){
+				float bin = (values[i] - minValue) * scale;
+				out[i] = !(bin > 0) ? 0 : uint32_t(std::min(bin, lastBin));
+			}
+		}
+		uint32_t operator[](size_t i) const{
+			return bins[i];
+		}
+	};
+
+	// counts per channel and bin in 32 bits, several copies of them when
+	// there are few channels so consecutive values that fall in the same
+	// bin don't wait for each other's increments
+	struct PartialHistogram{
+		std::vector<uint32_t> counts;
+		size_t copies = 0;
+	};
+
+	template<typename PixelType>
+	void countHistogram(const ofPixels_<PixelType> & pixels, const Region & region, ofPixelsHistogram & histogram){
+		size_t channels = pixels.getNumChannels();
+		size_t numBins = histogram.getNumBins();
+		size_t rowValues = region.width * channels;
+		if(rowValues == 0 || region.height == 0){
+			return;
+		}
+		typename Binner<PixelType>::Table table(histogram);
+		auto partials = parallelRows<PartialHistogram>(region.height, rowValues, [&](size_t begin, size_t end, PartialHistogram & partial){
+			size_t copies = std::max<size_t>(1, 4 / channels);
+			partial.copies = copies;
+			partial.counts.assign(copies * channels * numBins, 0);
+			Binner<PixelType> binner(table);
+			for(size_t y = begin; y < end; y++){
+				binner.setRow(rowStart(pixels, region, y), rowValues);
+				size_t i = 0;
+				size_t x = 0;
+				for(; x + copies <= region.width; x += copies){
+					uint32_t * counts = partial.counts.data();
+					for(size_t copy = 0; copy < copies; copy++){
+						for(size_t c = 0; c < channels; c++){
+							counts[binner[i++]]++;
+							counts += numBins;
+						}
+					}
+				}
+				uint32_t * counts = partial.counts.data();
+				for(; x < region.width; x++){
+					for(size_t c = 0; c < channels; c++){
+						counts[c * numBins + binner[i++]]++;
+					}
+				}
+			}
+		});
+		for(auto & partial: partials){
+			if(!partial){
+				continue;
+			}
+			for(size_t copy = 0; copy < partial->copies; copy++){
+				for(size_t c = 0; c < channels; c++){
+					uint64_t * counts = histogram.getCounts(c);
+					const uint32_t * partialCounts = partial->counts.data() + (copy * channels + c) * numBins;
+					for(size_t bin = 0; bin < numBins; bin++){
+						counts[bin] += partialCounts[bin];
+					}
+				}
+			}
+		}
+	}
+
+	//--------------------------------------------------
+	// sums of the values of each channel
+	struct PartialStats{
+		double sum[4] = {0, 0, 0, 0};
+		double squaredSum[4] = {0, 0, 0, 0};
+		double min[4];
+		double max[4];
+		PartialStats(){
+			std::fill(min, min + 4, std::numeric_limits<double>::max());
+			std::fill(max, max + 4, std::numeric_limits<double>::lowest());
+		}
+	};
+
+	template<typename PixelType>
+	void accumulateValues(const PixelType * values, size_t count, size_t channels, PartialStats & stats){
+		for(size_t i = 0; i < count; i += channels){
+			for(size_t c = 0; c < channels; c++){
+				double value = values[i + c];
+				stats.sum[c] += value;
+				stats.squaredSum[c] += value * value;
+				stats.min[c] = std::min(stats.min[c], value);
+				stats.max[c] = std::max(stats.max[c], value);
+			}
+		}
+	}
+
+	template<typename PixelType>
+	struct StatsRow{
+		static void accumulate(const PixelType * values, size_t count, size_t channels, PartialStats & stats){
+			accumulateValues(values, count, channels, stats);
+		}
+	};
+
+#if OF_SSE2
+	template<>
+	struct StatsRow<float>{
+		// sums of each row are kept in lanes of vectors, which line up with
+		// the channels every 4 values or every 12 for 3 channels. They are
+		// added in doubles, squares of floats lose too much precision in
+		// floats for the standard deviation of flat images
+		static void accumulate(const float * values, size_t count, size_t channels, PartialStats & stats){
+			const size_t numVectors = channels == 3 ? 3 : 1;
+			__m128d sum[6], squaredSum[6];
+			__m128 min[3], max[3];
+			for(size_t v = 0; v < numVectors; v++){
+				sum[v * 2] = sum[v * 2 + 1] = _mm_setzero_pd();
+				squaredSum[v * 2] = squaredSum[v * 2 + 1] = _mm_setzero_pd();
+				min[v] = _mm_set1_ps(std::numeric_limits<float>::max());
+				max[v] = _mm_set1_ps(std::numeric_limits<float>::lowest());
+			}
+			size_t i = 0;
+			for(; i + numVectors * 4 <= count; i += numVectors * 4){
+				for(size_t v = 0; v < numVectors; v++){
+					__m128 value = _mm_loadu_ps(values + i + v * 4);
+					__m128d low = _mm_cvtps_pd(value);
+					__m128d high = _mm_cvtps_pd(_mm_movehl_ps(value, value));
+					sum[v * 2] = _mm_add_pd(sum[v * 2], low);
+					sum[v * 2 + 1] = _mm_add_pd(sum[v * 2 + 1], high);
+					squaredSum[v * 2] = _mm_add_pd(squaredSum[v * 2], _mm_mul_pd(low, low));
+					squaredSum[v * 2 + 1] = _mm_add_pd(squaredSum[v * 2 + 1], _mm_mul_pd(high, high));
+					min[v] = _mm_min_ps(min[v], value);
+					max[v] = _mm_max_ps(max[v], value);
+				}
+			}
+			double sumLanes[2][12];
+			float minMaxLanes[2][12];
+			for(size_t v = 0; v < numVectors; v++){
+				_mm_storeu_pd(sumLanes[0] + v * 4, sum[v * 2]);
+				_mm_storeu_pd(sumLanes[0] + v * 4 + 2, sum[v * 2 + 1]);
+				_mm_storeu_pd(sumLanes[1] + v * 4, squaredSum[v * 2]);
+				_mm_storeu_pd(sumLanes[1] + v * 4 + 2, squaredSum[v * 2 + 1]);
+				_mm_storeu_ps(minMaxLanes[0] + v * 4, min[v]);
+				_mm_storeu_ps(minMaxLanes[1] + v * 4, max[v]);
+			}
+			for(size_t lane = 0; lane < numVectors * 4; lane++){
+				size_t c = lane % channels;
+				stats.sum[c] += sumLanes[0][lane];
+				stats.squaredSum[c] += sumLanes[1][lane];
+				stats.min[c] = std::min<double>(stats.min[c], minMaxLanes[0][lane]);
+				stats.max[c] = std::max<double>(stats.max[c], minMaxLanes[1][lane]);
+			}
+			accumulateValues(values + i, count - i, channels, stats);
+		}
+	};
+#endif
+
+	std::vector<ofPixelsChannelStats> finishStats(const PartialStats & totals, size_t channels, uint64_t count){
+		std::vector<ofPixelsChannelStats> result(channels);
+		if(count == 0){
+			return result;
+		}
+		for(size_t c = 0; c < channels; c++){
+			auto & stats = result[c];
+			stats.count = count;
+			stats.min = totals.min[c];
+			stats.max = totals.max[c];
+			stats.mean = totals.sum[c] / count;
+			stats.stddev = std::sqrt(std::max(totals.squaredSum[c] / count - stats.mean * stats.mean, 0.0));
+		}
+		return result;
+	}
+
+	template<typename PixelType>
+	std::vector<ofPixelsChannelStats> computeStats(const ofPixels_<PixelType> & pixels, const Region & region){
+		size_t channels = pixels.getNumChannels();
+		size_t rowValues = region.width * channels;
+		PartialStats totals;
+		if(rowValues > 0 && region.height > 0){
+			auto partials = parallelRows<PartialStats>(region.height, rowValues, [&](size_t begin, size_t end, PartialStats & partial){
+				for(size_t y = begin; y < end; y++){
+					StatsRow<PixelType>::accumulate(rowStart(pixels, region, y), rowValues, channels, partial);
+				}
+			});
+			for(auto & partial: partials){
+				if(!partial){
+					continue;
+				}
+				for(size_t c = 0; c < channels; c++){
+					totals.sum[c] += partial->sum[c];
+					totals.squaredSum[c] += partial->squaredSum[c];
+					totals.min[c] = std::min(totals.min[c], partial->min[c]);
+					totals.max[c] = std::max(totals.max[c], partial->max[c]);
+				}
+			}
+		}
+		return finishStats(totals, channels, uint64_t(region.width) * region.height);
+	}
+
+	// 8 bit pixels have only 256 values, so their statistics come exactly
+	// and faster from a histogram than from adding every value
+	template<>
+	std::vector<ofPixelsChannelStats> computeStats(const ofPixels_<unsigned char> & pixels, const Region & region){
+		size_t channels = pixels.getNumChannels();
+		ofPixelsHistogram histogram(channels, 256, 0, 255, true);
+		countHistogram(pixels, region, histogram);
+		PartialStats totals;
+		for(size_t c = 0; c < channels; c++){
+			auto counts = histogram.getCounts(c);
+			uint64_t sum = 0;
+			uint64_t squaredSum = 0;
+			for(uint64_t value = 0; value < 256; value++){
+				if(counts[value] > 0){
+					totals.min[c] = std::min(totals.min[c], double(value));
+					totals.max[c] = double(value);
+					sum += counts[value] * value;
+					squaredSum += counts[value] * value * value;
+				}
+			}
+			totals.sum[c] = double(sum);
+			totals.squaredSum[c] = double(squaredSum);
+		}
+		return finishStats(totals, channels, uint64_t(region.width) * region.height);
+	}
+
+	//--------------------------------------------------
+	// adds the row above to each row of a table, in strips of columns
+	void accumulateColumns(std::vector<double> & table, size_t rows, size_t rowValues){
+		const size_t stripValues = 512;
+		size_t numStrips = (rowValues + stripValues - 1) / stripValues;
+		ofParallelFor(0, numStrips, [&](size_t begin, size_t end){
+			for(size_t strip = begin; strip < end; strip++){
+				size_t first = strip * stripValues;
+				size_t count = std::min(stripValues, rowValues - first);
+				for(size_t y = 1; y < rows; y++){
+					const double * above = table.data() + (y - 1) * rowValues + first;
+					double * row = table.data() + y * rowValues + first;
+					size_t i = 0;
+#if OF_SSE2
+					for(; i + 2 <= count; i += 2){
+						_mm_storeu_pd(row + i, _mm_add_pd(_mm_loadu_pd(row + i), _mm_loadu_pd(above + i)));
+					}
+#endif
+					for(; i < count; i++){
+						row[i] += above[i];
+					}
+				}
+			}
+		}, 1);
+	}
+}
+
+//--------------------------------------------------
+template<typename PixelType>
+std::vector<ofPixelsChannelStats> ofGetPixelsStats(const ofPixels_<PixelType> & pixels){
+	return ofGetPixelsStats(pixels, 0, 0, pixels.getWidth(), pixels.getHeight());
+}
+
+//--------------------------------------------------
+template<typename PixelType>
+std::vector<ofPixelsChannelStats> ofGetPixelsStats(const ofPixels_<PixelType> & pixels, size_t x, size_t y, size_t width, size_t height){
+	Region region;
+	if(!getRegion(pixels, x, y, width, height, region, "ofGetPixelsStats")){
+		return std::vector<ofPixelsChannelStats>();
+	}
+	return computeStats(pixels, region);
+}
+
+//--------------------------------------------------
+ofPixelsHistogram::ofPixelsHistogram(size_t numChannels, size_t numBins, float minValue, float maxValue, bool integerValues)
+:counts(numChannels * numBins, 0)
+,numChannels(numChannels)
+,numBins(numBins)
+,minValue(minValue)
+,maxValue(maxValue){
+	float range = maxValue - minValue + (integerValues ? 1 : 0);
+	scale = range > 0 ? numBins / range : 0;
+}
+
+//--------------------------------------------------
+size_t ofPixelsHistogram::getNumChannels() const{
+	return numChannels;
+}
+
+//--------------------------------------------------
+size_t ofPixelsHistogram::getNumBins() const{
+	return numBins;
+}
+
+//--------------------------------------------------
+float ofPixelsHistogram::getMinValue() const{
+	return minValue;
+}
+
+//--------------------------------------------------
+float ofPixelsHistogram::getMaxValue() const{
+	return maxValue;
+}
+
+//--------------------------------------------------
+uint64_t ofPixelsHistogram::getCount(size_t channel, size_t bin) const{
+	return counts[channel * numBins + bin];
+}
+
+//--------------------------------------------------
+uint64_t ofPixelsHistogram::getTotal(size_t channel) const{
+	uint64_t total = 0;
+	auto channelCounts = getCounts(channel);
+	for(size_t bin = 0; bin < numBins; bin++){
+		total += channelCounts[bin];
+	}
+	return total;
+}
+
+//--------------------------------------------------
+const uint64_t * ofPixelsHistogram::getCounts(size_t channel) const{
+	return counts.data() + channel * numBins;
+}
+
+//--------------------------------------------------
+uint64_t * ofPixelsHistogram::getCounts(size_t channel){
+	return counts.data() + channel * numBins;
+}
+
+//--------------------------------------------------
+size_t ofPixelsHistogram::getBin(float value) const{
+	float bin = (value - minValue) * scale;
+	if(!(bin > 0) || numBins == 0){
+		return 0;
+	}
+	return std::min(size_t(std::min(bin, float(numBins))), numBins - 1);
+}
+
+//--------------------------------------------------
+float ofPixelsHistogram::getBinValue(size_t bin) const{
+	return scale > 0 ? minValue + bin / scale : minValue;
+}
+
+//--------------------------------------------------
+float ofPixelsHistogram::getPercentile(size_t channel, float percent) const{
+	auto total = getTotal(channel);
+	if(total == 0){
+		return minValue;
+	}
+	// the smallest number of values that makes the percentage, at least 1
+	double target = std::max(std::ceil(double(ofClamp(percent, 0, 100)) / 100.0 * total), 1.0);
+	auto channelCounts = getCounts(channel);
+	uint64_t accumulated = 0;
+	for(size_t bin = 0; bin < numBins; bin++){
+		accumulated += channelCounts[bin];
+		if(accumulated >= target){
+			return getBinValue(bin);
+		}
+	}
+	return getBinValue(numBins - 1);
+}
+
+//--------------------------------------------------
+template<typename PixelType>
+ofPixelsHistogram ofGetHistogram(const ofPixels_<PixelType> & pixels, size_t numBins){
+	float maxValue = ofColor_<PixelType>::limit();
+	return ofGetHistogram(pixels, numBins, 0, maxValue, 0, 0, pixels.getWidth(), pixels.getHeight());
+}
+
+//--------------------------------------------------
+template<typename PixelType>
+ofPixelsHistogram ofGetHistogram(const ofPixels_<PixelType> & pixels, size_t numBins, float minValue, float maxValue, size_t x, size_t y, size_t width, size_t height){
+	Region region;
+	if(numBins == 0 || !(maxValue > minValue)){
+		ofLogError("ofPixelsStats") << "ofGetHistogram(): needs at least one bin and a maximum greater than the minimum";
+		return ofPixelsHistogram();
+	}
+	if(!getRegion(pixels, x, y, width, height, region, "ofGetHistogram")){
+		return ofPixelsHistogram();
+	}
+	ofPixelsHistogram histogram(pixels.getNumChannels(), numBins, minValue, maxValue, std::numeric_limits<PixelType>::is_integer);
+	countHistogram(pixels, region, histogram);
+	return histogram;
+}
+
+//--------------------------------------------------
+template<typename PixelType>
+bool ofIntegralImage::setup(const ofPixels_<PixelType> & pixels, bool withSquares){
+	Region region;
+	if(!getRegion(pixels, 0, 0, pixels.getWidth(), pixels.getHeight(), region, "ofIntegralImage::setup")){
+		clear();
+		return false;
+	}
+	width = pixels.getWidth();
+	height = pixels.getHeight();
+	numChannels = pixels.getNumChannels();
+	size_t rowValues = (width + 1) * numChannels;
+	sums.resize(rowValues * (height + 1));
+	if(withSquares){
+		squaredSums.resize(sums.size());
+	}else{
+		squaredSums.clear();
+	}
+
+	// the first row and column are zeros so rectangles touching the top or
+	// left edges don't need special cases
+	std::fill(sums.begin(), sums.begin() + rowValues, 0.0);
+	if(withSquares){
+		std::fill(squaredSums.begin(), squaredSums.begin() + rowValues, 0.0);
+	}
+
+	// sums of each row first, then of the rows above each row
+	ofParallelFor(0, height, [&](size_t begin, size_t end){
+		for(size_t y = begin; y < end; y++){
+			const PixelType * values = pixels.getData() + y * width * numChannels;
+			double * row = sums.data() + (y + 1) * rowValues;
+			double * squaredRow = withSquares ? squaredSums.data() + (y + 1) * rowValues : nullptr;
+			double sum[4] = {0, 0, 0, 0};
+			double squaredSum[4] = {0, 0, 0, 0};
+			for(size_t c = 0; c < numChannels; c++){
+				row[c] = 0;
+				if(squaredRow){
+					squaredRow[c] = 0;
+				}
+			}
+			for(size_t x = 0; x < width; x++){
+				for(size_t c = 0; c < numChannels; c++){
+					double value = values[x * numChannels + c];
+					sum[c] += value;
+					row[(x + 1) * numChannels + c] = sum[c];
+					if(squaredRow){
+						squaredSum[c] += value * value;
+						squaredRow[(x + 1) * numChannels + c] = squaredSum[c];
+					}
+				}
+			}
+		}
+	}, rowGrain(rowValues));
+	accumulateColumns(sums, height + 1, rowValues);
+	if(withSquares){
+		accumulateColumns(squaredSums, height + 1, rowValues);
+	}
+	return true;
+}
+
+//--------------------------------------------------
+bool ofIntegralImage::isAllocated() const{
+	return !sums.empty();
+}
+
+//--------------------------------------------------
+void ofIntegralImage::clear(){
+	sums.clear();
+	squaredSums.clear();
+	width = 0;
+	height = 0;
+	numChannels = 0;
+}
+
+//--------------------------------------------------
+size_t ofIntegralImage::getWidth() const{
+	return width;
+}
+
+//--------------------------------------------------
+size_t ofIntegralImage::getHeight() const{
+	return height;
+}
+
+//--------------------------------------------------
+size_t ofIntegralImage::getNumChannels() const{
+	return numChannels;
+}
+
+//--------------------------------------------------
+bool ofIntegralImage::clip(int & x, int & y, int & w, int & h) const{
+	if(x < 0){
+		w += x;
+		x = 0;
+	}
+	if(y < 0){
+		h += y;
+		y = 0;
+	}
+	w = std::min<int64_t>(w, int64_t(width) - x);
+	h = std::min<int64_t>(h, int64_t(height) - y);
+	return w > 0 && h > 0;
+}
+
+//--------------------------------------------------
+double ofIntegralImage::getRectangle(const std::vector<double> & table, int x, int y, int w, int h, size_t channel) const{
+	size_t rowValues = (width + 1) * numChannels;
+	auto at = [&](size_t x, size_t y){
+		return table[y * rowValues + x * numChannels + channel];
+	};
+	return at(x + w, y + h) - at(x + w, y) - at(x, y + h) + at(x, y);
+}
+
+//--------------------------------------------------
+double ofIntegralImage::getSum(int x, int y, int w, int h, size_t channel) const{
+	if(channel >= numChannels || !clip(x, y, w, h)){
+		return 0;
+	}
+	return getRectangle(sums, x, y, w, h, channel);
+}
+
+//--------------------------------------------------
+double ofIntegralImage::getMean(int x, int y, int w, int h, size_t channel) const{
+	if(channel >= numChannels || !clip(x, y, w, h)){
+		return 0;
+	}
+	return getRectangle(sums, x, y, w, h, channel) / (double(w) * h);
+}
+
+//--------------------------------------------------
+double ofIntegralImage::getVariance(int x, int y, int w, int h, size_t channel) const{
+	if(squaredSums.empty()){
+		ofLogError("ofIntegralImage") << "getVariance(): the table wasn't set up with squares";
+		return 0;
+	}
+	if(channel >= numChannels || !clip(x, y, w, h)){
+		return 0;
+	}
+	double count = double(w) * h;
+	double mean = getRectangle(sums, x, y, w, h, channel) / count;
+	return std::max(getRectangle(squaredSums, x, y, w, h, channel) / count - mean * mean, 0.0);
+}
+
+//--------------------------------------------------
+double ofIntegralImage::getStdDev(int x, int y, int w, int h, size_t channel) const{
+	return std::sqrt(getVariance(x, y, w, h, channel));
+}
+
+//--------------------------------------------------
+const std::vector<double> & ofIntegralImage::getSums() const{
+	return sums;
+}
+
+//--------------------------------------------------
+const std::vector<double> & ofIntegralImage::getSquaredSums() const{
+	return squaredSums;
+}
+
+#define OF_PIXELS_STATS_INSTANTIATE(PixelType) \
+	template std::vector<ofPixelsChannelStats> ofGetPixelsStats(const ofPixels_<PixelType> &); \
+	template std::vector<ofPixelsChannelStats> ofGetPixelsStats(const ofPixels_<PixelType> &, size_t, size_t, size_t, size_t); \
+	template ofPixelsHistogram ofGetHistogram(const ofPixels_<PixelType> &, size_t); \
+	template ofPixelsHistogram ofGetHistogram(const ofPixels_<PixelType> &, size_t, float, float, size_t, size_t, size_t, size_t); \
+	template bool ofIntegralImage::setup(const ofPixels_<PixelType> &, bool);
+
+OF_PIXELS_STATS_INSTANTIATE(unsigned char)
+OF_PIXELS_STATS_INSTANTIATE(unsigned short)
+OF_PIXELS_STATS_INSTANTIATE(float)
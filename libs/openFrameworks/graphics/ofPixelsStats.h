@@ -0,0 +1,182 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofPixels.h"
+
+/// \file
+/// Statistics of the values in ofPixels: minimum, maximum, mean and
+/// standard deviation, histograms with percentiles and summed-area tables
+/// to sum any rectangle of an image in constant time.
+///
+/// The functions are implemented for ofPixels, ofShortPixels and
+/// ofFloatPixels in any format with a single plane and interleaved
+/// channels, and compute each channel separately. They can be restricted
+/// to a region of the pixels. Large images are split in rows across
+/// ofParallelFor and the inner loops use SSE2 when it's available.
+///
+/// ~~~~{.cpp}
+/// // auto exposure: aim for the 95th percentile of the luminance at 240
+/// auto histogram = ofGetHistogram(grayPixels);
+/// exposure *= 240.f / std::max(histogram.getPercentile(0, 95), 1.f);
+/// ~~~~
+
+/// \brief Statistics of a channel of some pixels.
+struct ofPixelsChannelStats{
+	double min = 0;
+	double max = 0;
+	double mean = 0;
+	/// Population standard deviation.
+	double stddev = 0;
+	/// Values the statistics were computed from.
+	uint64_t count = 0;
+};
+
+/// \brief Compute the minimum, maximum, mean and standard deviation of each
+/// channel.
+///
+/// \returns one element per channel, empty if the pixels aren't allocated
+/// or the format isn't supported.
+template<typename PixelType>
+std::vector<ofPixelsChannelStats> ofGetPixelsStats(const ofPixels_<PixelType> & pixels);
+
+/// \brief Compute the statistics of each channel in a region of the pixels.
+///
+/// The region is clipped to the pixels.
+template<typename PixelType>
+std::vector<ofPixelsChannelStats> ofGetPixelsStats(const ofPixels_<PixelType> & pixels, size_t x, size_t y, size_t width, size_t height);
+
+/// \class ofPixelsHistogram
+///
+/// Counts of the values of each channel of some pixels in bins of the same
+/// width, returned by ofGetHistogram().
+///
+/// For integer pixels the bins cover every value from the minimum to the
+/// maximum of the range, so 256 bins over [0, 255] have one value each.
+/// For float pixels they split [min, max] in equal parts. Values outside
+/// the range are counted in the first or last bin.
+class ofPixelsHistogram{
+public:
+	ofPixelsHistogram(){}
+	ofPixelsHistogram(size_t numChannels, size_t numBins, float minValue, float maxValue, bool integerValues);
+
+	size_t getNumChannels() const;
+	size_t getNumBins() const;
+	float getMinValue() const;
+	float getMaxValue() const;
+
+	/// \returns the values counted in a bin of a channel.
+	uint64_t getCount(size_t channel, size_t bin) const;
+
+	/// \returns the values counted in every bin of a channel.
+	uint64_t getTotal(size_t channel) const;
+
+	/// \returns the counts of a channel, one per bin.
+	const uint64_t * getCounts(size_t channel) const;
+
+	/// \returns the bin a value is counted in.
+	size_t getBin(float value) const;
+
+	/// \returns the lowest value counted in a bin.
+	float getBinValue(size_t bin) const;
+
+	/// \brief Get the value below which a percentage of the values of a
+	/// channel are.
+	///
+	/// The result is the lowest value of the first bin that reaches the
+	/// percentage, which is exact when bins hold one value each, like for
+	/// ofPixels with 256 bins. getPercentile(channel, 50) is the median.
+	///
+	/// \param percent Percentage between 0 and 100.
+	float getPercentile(size_t channel, float percent) const;
+
+	/// \cond INTERNAL
+	uint64_t * getCounts(size_t channel);
+	/// \endcond
+
+private:
+	std::vector<uint64_t> counts;
+	size_t numChannels = 0;
+	size_t numBins = 0;
+	float minValue = 0;
+	float maxValue = 0;
+	// bins per unit of value
+	float scale = 0;
+};
+
+/// \brief Count the values of each channel of the pixels in bins.
+///
+/// The bins cover the whole range of the pixel type: [0, 255] for
+/// ofPixels, [0, 65535] for ofShortPixels and [0, 1] for ofFloatPixels.
+///
+/// \param numBins Bins per channel.
+template<typename PixelType>
+ofPixelsHistogram ofGetHistogram(const ofPixels_<PixelType> & pixels, size_t numBins = 256);
+
+/// \brief Count the values of each channel in a region of the pixels in
+/// bins that cover [minValue, maxValue].
+///
+/// The region is clipped to the pixels.
+template<typename PixelType>
+ofPixelsHistogram ofGetHistogram(const ofPixels_<PixelType> & pixels, size_t numBins, float minValue, float maxValue, size_t x, size_t y, size_t width, size_t height);
+
+/// \class ofIntegralImage
+///
+/// A summed-area table of some pixels: each entry holds the sum of the
+/// values above and to the left of it, so the sum, mean or variance of any
+/// rectangle takes four lookups whatever its size. Used for adaptive
+/// thresholds, box filters of varying sizes and region statistics.
+///
+/// ~~~~{.cpp}
+/// ofIntegralImage integral;
+/// integral.setup(grayPixels);
+/// float localMean = integral.getMean(x - 8, y - 8, 17, 17);
+/// ~~~~
+///
+/// Sums are stored as doubles, 8 bytes per value of the pixels, or 16 if
+/// the table also sums squares.
+class ofIntegralImage{
+public:
+	/// \brief Compute the table of some pixels.
+	///
+	/// Setting up again with pixels of the same size reuses the memory.
+	///
+	/// \param withSquares Also sum the squares of the values, needed for
+	/// getVariance() and getStdDev().
+	template<typename PixelType>
+	bool setup(const ofPixels_<PixelType> & pixels, bool withSquares = false);
+
+	bool isAllocated() const;
+	void clear();
+
+	size_t getWidth() const;
+	size_t getHeight() const;
+	size_t getNumChannels() const;
+
+	/// \returns the sum of a channel in a rectangle, clipped to the image.
+	double getSum(int x, int y, int width, int height, size_t channel = 0) const;
+
+	/// \returns the mean of a channel in a rectangle, clipped to the image,
+	/// or 0 if the rectangle is outside of it.
+	double getMean(int x, int y, int width, int height, size_t channel = 0) const;
+
+	/// \returns the population variance of a channel in a rectangle,
+	/// clipped to the image. Needs a table set up with squares.
+	double getVariance(int x, int y, int width, int height, size_t channel = 0) const;
+	double getStdDev(int x, int y, int width, int height, size_t channel = 0) const;
+
+	/// \returns the table, (width + 1) * (height + 1) entries per channel
+	/// with a first row and column of zeros.
+	const std::vector<double> & getSums() const;
+	const std::vector<double> & getSquaredSums() const;
+
+private:
+	// clips a rectangle to the image, false if nothing is left
+	bool clip(int & x, int & y, int & width, int & height) const;
+	double getRectangle(const std::vector<double> & table, int x, int y, int width, int height, size_t channel) const;
+
+	std::vector<double> sums;
+	std::vector<double> squaredSums;
+	size_t width = 0;
+	size_t height = 0;
+	size_t numChannels = 0;
+};
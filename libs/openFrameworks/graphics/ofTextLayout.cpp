@@ -0,0 +1,100 @@
+#include "ofTextLayout.h"
+#include "ofTrueTypeFont.h"
+#include "ofGraphics.h"
+
+//--------------------------------------------------------------
+ofTextLayout::ofTextLayout()
+:font(nullptr)
+,vFlipped(true)
+,dirty(true)
+,fontGeneration(0)
+,atlasGeneration(0)
+,letterSpacing(1)
+,spaceSize(1)
+,lineHeight(0){
+}
+
+//--------------------------------------------------------------
+ofTextLayout::ofTextLayout(const ofTrueTypeFont & font, const std::string & text)
+:ofTextLayout(){
+	setup(font, text);
+}
+
+//--------------------------------------------------------------
+void ofTextLayout::setup(const ofTrueTypeFont & font, const std::string & text){
+	this->font = &font;
+	this->text = text;
+	dirty = true;
+}
+
+//--------------------------------------------------------------
+void ofTextLayout::setText(const std::string & text){
+	if(text != this->text){
+		this->text = text;
+		dirty = true;
+	}
+}
+
+//--------------------------------------------------------------
+const std::string & ofTextLayout::getText() const{
+	return text;
+}
+
+//--------------------------------------------------------------
+const ofMesh & ofTextLayout::getMesh() const{
+	update();
+	return mesh;
+}
+
+//--------------------------------------------------------------
+const ofRectangle & ofTextLayout::getBoundingBox() const{
+	update();
+	return boundingBox;
+}
+
+//--------------------------------------------------------------
+void ofTextLayout::draw(float x, float y) const{
+	if(!font || !font->isLoaded()){
+		ofLogError("ofTextLayout") << "draw(): font not loaded";
+		return;
+	}
+	update();
+	auto blendMode = ofGetStyle().blendingMode;
+	ofEnableBlendMode(OF_BLENDMODE_ALPHA);
+	ofPushMatrix();
+	// glyphs are laid out on whole pixels, translating by a fraction would
+	// blur them
+	ofTranslate(floor(x), floor(y));
+	font->getFontTexture().bind();
+	mesh.draw();
+	font->getFontTexture().unbind();
+	ofPopMatrix();
+	ofEnableBlendMode(blendMode);
+}
+
+//--------------------------------------------------------------
+void ofTextLayout::update() const{
+	if(!font || !font->isLoaded()){
+		return;
+	}
+	// the layout also depends on the current flip, the font not being
+	// reloaded, its settings and the glyphs not moving in the font texture
+	bool flip = ofIsVFlipped();
+	if(!dirty && flip == vFlipped
+		&& fontGeneration == font->getGeneration()
+		&& atlasGeneration == font->getAtlasGeneration()
+		&& letterSpacing == font->getLetterSpacing()
+		&& spaceSize == font->getSpaceSize()
+		&& lineHeight == font->getLineHeight()){
+		return;
+	}
+	vFlipped = flip;
+	letterSpacing = font->getLetterSpacing();
+	spaceSize = font->getSpaceSize();
+	lineHeight = font->getLineHeight();
+	mesh = font->getStringMesh(text, 0, 0, vFlipped);
+	boundingBox = font->getStringBoundingBox(text, 0, 0, vFlipped);
+	fontGeneration = font->getGeneration();
+	atlasGeneration = font->getAtlasGeneration();
+	dirty = false;
+}
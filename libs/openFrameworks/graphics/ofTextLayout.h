@@ -0,0 +1,60 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofMesh.h"
+#include "ofRectangle.h"
+
+class ofTrueTypeFont;
+class ofTexture;
+
+/// \brief A string laid out once with an ofTrueTypeFont, for text that is
+/// drawn often but changes rarely.
+///
+/// The mesh is created when the text or font changes, drawing it only
+/// translates and draws it. Unlike the string mesh cache in ofTrueTypeFont
+/// it's never discarded to make space for other strings.
+///
+/// ~~~~{.cpp}
+/// // setup
+/// label.setup(font, "score: 0");
+///
+/// // draw
+/// label.draw(20, 40);
+/// ~~~~
+///
+/// The font has to outlive the layout.
+class ofTextLayout{
+public:
+	ofTextLayout();
+	ofTextLayout(const ofTrueTypeFont & font, const std::string & text);
+
+	void setup(const ofTrueTypeFont & font, const std::string & text);
+
+	/// \brief Change the text, the layout is only updated if it's different.
+	void setText(const std::string & text);
+	const std::string & getText() const;
+
+	/// \returns The mesh of the text laid out at the origin, to be drawn
+	/// with the font texture.
+	const ofMesh & getMesh() const;
+
+	/// \returns The bounding box of the text laid out at the origin.
+	const ofRectangle & getBoundingBox() const;
+
+	/// \brief Draw the text with its origin at x, y, rounded down to whole
+	/// pixels.
+	void draw(float x, float y) const;
+
+private:
+	void update() const;
+
+	const ofTrueTypeFont * font;
+	std::string text;
+	mutable ofMesh mesh;
+	mutable ofRectangle boundingBox;
+	mutable bool vFlipped;
+	mutable bool dirty;
+	mutable uint64_t fontGeneration;
+	mutable uint64_t atlasGeneration;
+	mutable float letterSpacing, spaceSize, lineHeight;
+};
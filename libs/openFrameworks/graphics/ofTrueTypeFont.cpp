@@ -14,12 +14,18 @@
 
 #include <algorithm>
 #include <numeric>
+#include <list>
 
 #include "ofUtils.h"
 #include "ofGraphics.h"
 #include "ofAppRunner.h"
 #include "utf8.h"
 #include "ofVectorMath.h"
+#include "ofGlyphAtlas.h"
+#include "ofGLUtils.h"
+#include "ofThreadPool.h"
+#include "ofAssetPack.h"
+#include "ofAssetCache.h"
 
 
 const ofUnicode::range ofUnicode::Space {32, 32};
@@ -145,9 +151,26 @@ const ofTrueTypeFont::glyphProps ofTrueTypeFont::invalidProps{
 	0.0f,0.0f,0.0f,0.0f
 };
 
+//--------------------------------------------------------
+// least recently used meshes laid out at the origin, keyed by the string and
+// every setting that changes its layout
+struct ofTrueTypeFont::StringMeshCache{
+	struct Entry{
+		std::string key;
+		ofMesh mesh;
+		uint64_t atlasGeneration;
+		std::vector<uint32_t> glyphs; // with a dynamic atlas, to keep them in it while the mesh is used
+	};
+	std::list<Entry> entries;
+	std::unordered_map<std::string, std::list<Entry>::iterator> index;
+	size_t capacity = 256;
+};
+
+
 static bool printVectorInfo = false;
 static int ttfGlobalDpi = 96;
 static bool librariesInitialized = false;
+static uint64_t nextFontGeneration = 0;
 static FT_Library library;
 
 //--------------------------------------------------------
@@ -441,11 +464,15 @@ static std::string linuxFontPathByName(const std::string& fontname){
 #endif
 
 //-----------------------------------------------------------
-static bool loadFontFace(std::filesystem::path fontname, FT_Face & face, std::filesystem::path & filename){
+static bool loadFontFace(std::filesystem::path fontname, FT_Face & face, std::filesystem::path & filename, std::shared_ptr<ofBuffer> & data){
 	filename = ofToDataPath(fontname,true);
+	data = std::make_shared<ofBuffer>();
+	if(!ofReadFromMountedAssetPack(fontname, *data)){
+		data.reset();
+	}
 	ofFile fontFile(filename,ofFile::Reference);
 	int fontID = 0;
-	if(!fontFile.exists()){
+	if(!data && !fontFile.exists()){
 #ifdef TARGET_LINUX
         filename = linuxFontPathByName(fontname.string());
 #elif defined(TARGET_OSX)
@@ -475,7 +502,13 @@ static bool loadFontFace(std::filesystem::path fontname, FT_Face & face, std::fi
 		ofLogVerbose("ofTrueTypeFont") << "loadFontFace(): \"" << fontname << "\" not a file in data loading system font from \"" << filename << "\"";
 	}
 	FT_Error err;
-    err = FT_New_Face( library, filename.string().c_str(), fontID, &face );
+	if(data){
+		// freetype reads fonts in memory as it needs them, the data has to
+		// live as long as the face
+		err = FT_New_Memory_Face( library, reinterpret_cast<const FT_Byte*>(data->getData()), data->size(), fontID, &face );
+	}else{
+		err = FT_New_Face( library, filename.string().c_str(), fontID, &face );
+	}
 	if (err) {
 		// simple error table in lieu of full table (see fterrors.h)
 		string errorString = "unknown freetype";
@@ -530,9 +563,11 @@ ofTrueTypeFont::ofTrueTypeFont()
 	spaceSize = 1;
 	fontUnitScale = 1;
 	stringQuads.setMode(OF_PRIMITIVE_TRIANGLES);
+	meshCache = std::make_shared<StringMeshCache>();
 	ascenderHeight = 0;
 	descenderHeight = 0;
 	lineHeight = 0;
+	generation = 0;
 }
 
 //------------------------------------------------------------------
@@ -568,10 +603,15 @@ ofTrueTypeFont::ofTrueTypeFont(const ofTrueTypeFont& mom)
 	fontUnitScale = mom.fontUnitScale;
 
 	cps = mom.cps; // properties for each character
+	cpsLoaded = mom.cpsLoaded;
 	settings = mom.settings;
 	glyphIndexMap = mom.glyphIndexMap;
 	texAtlas = mom.texAtlas;
+	glyphAtlas = mom.glyphAtlas;
+	meshCache = mom.meshCache;
+	generation = mom.generation;
 	face = mom.face;
+	faceData = mom.faceData;
 }
 
 //------------------------------------------------------------------
@@ -600,10 +640,15 @@ ofTrueTypeFont & ofTrueTypeFont::operator=(const ofTrueTypeFont& mom){
 	fontUnitScale = mom.fontUnitScale;
 
 	cps = mom.cps; // properties for each character
+	cpsLoaded = mom.cpsLoaded;
 	settings = mom.settings;
 	glyphIndexMap = mom.glyphIndexMap;
 	texAtlas = mom.texAtlas;
+	glyphAtlas = mom.glyphAtlas;
+	meshCache = mom.meshCache;
+	generation = mom.generation;
 	face = mom.face;
+	faceData = mom.faceData;
 
 	return *this;
 }
@@ -633,10 +678,15 @@ ofTrueTypeFont::ofTrueTypeFont(ofTrueTypeFont&& mom)
 	fontUnitScale = mom.fontUnitScale;
 
 	cps = mom.cps; // properties for each character
+	cpsLoaded = std::move(mom.cpsLoaded);
 	settings = mom.settings;
 	glyphIndexMap = std::move(mom.glyphIndexMap);
 	texAtlas = mom.texAtlas;
+	glyphAtlas = std::move(mom.glyphAtlas);
+	meshCache = std::move(mom.meshCache);
+	generation = mom.generation;
 	face = mom.face;
+	faceData = mom.faceData;
 }
 
 //------------------------------------------------------------------
@@ -664,10 +714,15 @@ ofTrueTypeFont & ofTrueTypeFont::operator=(ofTrueTypeFont&& mom){
 	fontUnitScale = mom.fontUnitScale;
 
 	cps = mom.cps; // properties for each character
+	cpsLoaded = std::move(mom.cpsLoaded);
 	settings = mom.settings;
 	glyphIndexMap = std::move(mom.glyphIndexMap);
 	texAtlas = mom.texAtlas;
+	glyphAtlas = std::move(mom.glyphAtlas);
+	meshCache = std::move(mom.meshCache);
+	generation = mom.generation;
 	face = mom.face;
+	faceData = mom.faceData;
 	return *this;
 }
 
@@ -689,33 +744,38 @@ bool ofTrueTypeFont::loadFont(string filename, int fontSize, bool bAntiAliased,
 
 //-----------------------------------------------------------
 ofTrueTypeFont::glyph ofTrueTypeFont::loadGlyph(uint32_t utf8) const{
+	return loadGlyph(face.get(), utf8);
+}
+
+//-----------------------------------------------------------
+ofTrueTypeFont::glyph ofTrueTypeFont::loadGlyph(FT_Face glyphFace, uint32_t utf8) const{
 	glyph aGlyph;
-	auto err = FT_Load_Glyph( face.get(), FT_Get_Char_Index( face.get(), utf8 ), settings.antialiased ?  FT_LOAD_FORCE_AUTOHINT : FT_LOAD_DEFAULT );
+	auto err = FT_Load_Glyph( glyphFace, FT_Get_Char_Index( glyphFace, utf8 ), settings.antialiased ?  FT_LOAD_FORCE_AUTOHINT : FT_LOAD_DEFAULT );
 	if(err){
 		ofLogError("ofTrueTypeFont") << "loadFont(): FT_Load_Glyph failed for utf8 code " << utf8 << ": FT_Error " << err;
 		return aGlyph;
 	}
 
-	if (settings.antialiased) FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL);
-	else FT_Render_Glyph(face->glyph, FT_RENDER_MODE_MONO);
+	if (settings.antialiased) FT_Render_Glyph(glyphFace->glyph, FT_RENDER_MODE_NORMAL);
+	else FT_Render_Glyph(glyphFace->glyph, FT_RENDER_MODE_MONO);
 
 
 	// -------------------------
 	// info about the character:
 	aGlyph.props.glyph		= utf8;
-	aGlyph.props.height 	= face->glyph->metrics.height>>6;
-	aGlyph.props.width 		= face->glyph->metrics.width>>6;
-	aGlyph.props.bearingX	= face->glyph->metrics.horiBearingX>>6;
-	aGlyph.props.bearingY	= face->glyph->metrics.horiBearingY>>6;
-	aGlyph.props.xmin		= face->glyph->bitmap_left;
+	aGlyph.props.height 	= glyphFace->glyph->metrics.height>>6;
+	aGlyph.props.width 		= glyphFace->glyph->metrics.width>>6;
+	aGlyph.props.bearingX	= glyphFace->glyph->metrics.horiBearingX>>6;
+	aGlyph.props.bearingY	= glyphFace->glyph->metrics.horiBearingY>>6;
+	aGlyph.props.xmin		= glyphFace->glyph->bitmap_left;
 	aGlyph.props.xmax		= aGlyph.props.xmin + aGlyph.props.width;
-	aGlyph.props.ymin		= -face->glyph->bitmap_top;
+	aGlyph.props.ymin		= -glyphFace->glyph->bitmap_top;
 	aGlyph.props.ymax		= aGlyph.props.ymin + aGlyph.props.height;
-	aGlyph.props.advance	= face->glyph->metrics.horiAdvance>>6;
+	aGlyph.props.advance	= glyphFace->glyph->metrics.horiAdvance>>6;
 	aGlyph.props.tW			= aGlyph.props.width;
 	aGlyph.props.tH			= aGlyph.props.height;
 
-	FT_Bitmap& bitmap= face->glyph->bitmap;
+	FT_Bitmap& bitmap= glyphFace->glyph->bitmap;
 	int width  = bitmap.width;
 	int height = bitmap.rows;
 	if(width==0 || height==0) return aGlyph;
@@ -758,6 +818,45 @@ ofTrueTypeFont::glyph ofTrueTypeFont::loadGlyph(uint32_t utf8) const{
 	return aGlyph;
 }
 
+//-----------------------------------------------------------
+vector<ofTrueTypeFont::glyph> ofTrueTypeFont::loadGlyphs(const vector<uint32_t> & codepoints) const{
+	vector<glyph> glyphs(codepoints.size());
+
+	// a face can only be used from one thread at a time so every chunk of
+	// glyphs gets its own. Faces are created and destroyed here since that
+	// can't happen concurrently either with the shared library
+	size_t numChunks = 1;
+#ifndef TARGET_NO_THREADS
+	const size_t minGlyphsPerChunk = 64;
+	numChunks = std::min(ofGetThreadPool().getNumThreads() + 1, codepoints.size() / minGlyphsPerChunk);
+#endif
+	vector<shared_ptr<struct FT_FaceRec_>> faces{face};
+	for(size_t i = 1; i < numChunks; i++){
+		FT_Face chunkFace;
+		auto err = faceData ?
+			FT_New_Memory_Face(library, reinterpret_cast<const FT_Byte*>(faceData->getData()), faceData->size(), face->face_index, &chunkFace) :
+			FT_New_Face(library, settings.fontName.string().c_str(), face->face_index, &chunkFace);
+		if(err){
+			break;
+		}
+		FT_Set_Char_Size(chunkFace, settings.fontSize << 6, settings.fontSize << 6, settings.dpi, settings.dpi);
+		faces.emplace_back(chunkFace, FT_Done_Face);
+	}
+	numChunks = faces.size();
+
+	// interleave the glyphs so expensive ranges are split between chunks,
+	// each glyph only depends on its codepoint so the result is the same
+	// as loading them in order
+	ofParallelFor(0, numChunks, [&](size_t begin, size_t end){
+		for(size_t chunk = begin; chunk < end; chunk++){
+			for(size_t i = chunk; i < codepoints.size(); i += numChunks){
+				glyphs[i] = loadGlyph(faces[chunk].get(), codepoints[i]);
+			}
+		}
+	});
+	return glyphs;
+}
+
 //-----------------------------------------------------------
 bool ofTrueTypeFont::load(std::filesystem::path filename, int fontSize, bool antialiased, bool fullCharacterSet, bool makeContours, float simplifyAmt, int dpi) {
 	ofTtfSettings settings(filename,fontSize);
@@ -787,12 +886,20 @@ bool ofTrueTypeFont::load(const ofTtfSettings & _settings){
 
 	bLoadedOk = false;
 
+	// copies of this font keep using the old cache
+	auto cacheSize = meshCache ? meshCache->capacity : 256;
+	meshCache = std::make_shared<StringMeshCache>();
+	meshCache->capacity = cacheSize;
+	generation = ++nextFontGeneration;
+
 	//--------------- load the library and typeface
 	FT_Face loadFace;
-    if(!loadFontFace(settings.fontName, loadFace, settings.fontName)){
+	std::shared_ptr<ofBuffer> loadFaceData;
+    if(!loadFontFace(settings.fontName, loadFace, settings.fontName, loadFaceData)){
 		return false;
 	}
 	face = std::shared_ptr<struct FT_FaceRec_>(loadFace,FT_Done_Face);
+	faceData = loadFaceData;
 
 	if(settings.ranges.empty()){
 		settings.ranges.push_back(ofUnicode::Latin1Supplement);
@@ -815,6 +922,40 @@ bool ofTrueTypeFont::load(const ofTtfSettings & _settings){
 			[](uint32_t acc, ofUnicode::range range){
 				return acc + range.getNumGlyphs();
 			});
+
+	if(settings.dynamicAtlas && settings.contours){
+		ofLogWarning("ofTrueTypeFont") << "load(): contours need every glyph loaded, ignoring dynamicAtlas";
+	}else if(settings.dynamicAtlas){
+		// only map the characters to their index here, glyphs are rasterized
+		// and added to the atlas the first time they are used
+		cps.assign(nGlyphs, invalidProps);
+		cpsLoaded.assign(nGlyphs, false);
+		charOutlines.resize(1);
+		auto i = 0u;
+		for(auto & range: settings.ranges){
+			for (uint32_t g = range.begin; g <= range.end; g++, i++){
+				glyphIndexMap[g] = i;
+			}
+		}
+		glyphAtlas = std::make_shared<ofGlyphAtlas>();
+		glyphAtlas->allocate(settings.atlasSize, settings.atlasSize, border);
+		allocateAtlasTexture(glyphAtlas->getPixels());
+		glyphAtlas->clearDirty();
+		bLoadedOk = true;
+		return true;
+	}
+	glyphAtlas.reset();
+	cpsLoaded.clear();
+
+	std::string cacheKey;
+	if(settings.useCache && !settings.contours){
+		cacheKey = getAtlasCacheKey();
+		if(loadAtlasFromCache(cacheKey, nGlyphs)){
+			bLoadedOk = true;
+			return true;
+		}
+	}
+
 	cps.resize(nGlyphs);
 	if(settings.contours){
 		charOutlines.resize(nGlyphs);
@@ -827,13 +968,28 @@ bool ofTrueTypeFont::load(const ofTtfSettings & _settings){
 
 	vector<ofTrueTypeFont::glyph> all_glyphs;
 
+	// contours are created from the glyph last loaded in the face so in that
+	// case glyphs are loaded one by one below
+	if(!settings.contours){
+		vector<uint32_t> codepoints;
+		codepoints.reserve(nGlyphs);
+		for(auto & range: settings.ranges){
+			for (uint32_t g = range.begin; g <= range.end; g++){
+				codepoints.push_back(g);
+			}
+		}
+		all_glyphs = loadGlyphs(codepoints);
+	}
+
 	uint32_t areaSum=0;
 
 	//--------------------- load each char -----------------------
 	auto i = 0u;
 	for(auto & range: settings.ranges){
 		for (uint32_t g = range.begin; g <= range.end; g++, i++){
-			all_glyphs.push_back(loadGlyph(g));
+			if(settings.contours){
+				all_glyphs.push_back(loadGlyph(g));
+			}
 			all_glyphs[i].props.characterIndex	= i;
 			glyphIndexMap[g] = i;
 			cps[i] = all_glyphs[i].props;
@@ -935,7 +1091,90 @@ bool ofTrueTypeFont::load(const ofTtfSettings & _settings){
 		charPixels.pasteInto(atlasPixelsLuminanceAlpha,x+border,y+border);
 		x+= glyph.tW + border*2;
 	}
-	texAtlas.allocate(atlasPixelsLuminanceAlpha,false);
+	allocateAtlasTexture(atlasPixelsLuminanceAlpha);
+	if(!cacheKey.empty()){
+		storeAtlasInCache(cacheKey, atlasPixelsLuminanceAlpha);
+	}
+	bLoadedOk = true;
+	return true;
+}
+
+//-----------------------------------------------------------
+// the glyph properties and the atlas follow the header, aligned
+struct AtlasCacheHeader{
+	uint64_t numGlyphs;
+	uint64_t propsSize;
+	uint64_t width;
+	uint64_t height;
+	uint8_t reserved[32];
+};
+
+//-----------------------------------------------------------
+std::string ofTrueTypeFont::getAtlasCacheKey() const{
+	// everything the rasterized glyphs and their layout depend on
+	auto parameters = "ofTrueTypeFont " + ofToString(FREETYPE_MAJOR) + "." + ofToString(FREETYPE_MINOR) + "." + ofToString(FREETYPE_PATCH)
+		+ " " + ofToString(face->face_index) + " " + ofToString(settings.fontSize) + " " + ofToString(settings.dpi)
+		+ " " + ofToString(settings.antialiased) + " " + ofToString(sizeof(glyphProps));
+	for(auto & range: settings.ranges){
+		parameters += " " + ofToString(range.begin) + "-" + ofToString(range.end);
+	}
+	if(faceData){
+		return ofAssetCache::makeKey(*faceData, parameters);
+	}else{
+		return ofAssetCache::makeKey(ofBufferFromFile(settings.fontName, ofBufferLoadMode::Mapped), parameters);
+	}
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::loadAtlasFromCache(const std::string & key, size_t numGlyphs){
+	ofBuffer data;
+	if(!ofGetAssetCache().load(key, data) || data.size() < sizeof(AtlasCacheHeader)){
+		return false;
+	}
+	AtlasCacheHeader header;
+	memcpy(&header, data.getData(), sizeof(header));
+	if(header.numGlyphs != numGlyphs || header.propsSize != sizeof(glyphProps)
+	   || header.width > 16384 || header.height > 16384
+	   || data.size() != sizeof(header) + numGlyphs * sizeof(glyphProps) + header.width * header.height * 2){
+		return false;
+	}
+
+	auto props = data.getData() + sizeof(header);
+	cps.resize(numGlyphs);
+	memcpy(cps.data(), props, numGlyphs * sizeof(glyphProps));
+	charOutlines.resize(1);
+	auto i = 0u;
+	for(auto & range: settings.ranges){
+		for (uint32_t g = range.begin; g <= range.end; g++, i++){
+			glyphIndexMap[g] = i;
+		}
+	}
+
+	ofPixels atlas;
+	atlas.setFromPixels(reinterpret_cast<const unsigned char*>(props + numGlyphs * sizeof(glyphProps)), header.width, header.height, OF_PIXELS_GRAY_ALPHA);
+	allocateAtlasTexture(atlas);
+	return true;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::storeAtlasInCache(const std::string & key, const ofPixels & atlas) const{
+	AtlasCacheHeader header;
+	memset(&header, 0, sizeof(header));
+	header.numGlyphs = cps.size();
+	header.propsSize = sizeof(glyphProps);
+	header.width = atlas.getWidth();
+	header.height = atlas.getHeight();
+	ofBuffer data;
+	data.allocate(sizeof(header) + cps.size() * sizeof(glyphProps) + atlas.getTotalBytes());
+	memcpy(data.getData(), &header, sizeof(header));
+	memcpy(data.getData() + sizeof(header), cps.data(), cps.size() * sizeof(glyphProps));
+	memcpy(data.getData() + sizeof(header) + cps.size() * sizeof(glyphProps), atlas.getData(), atlas.getTotalBytes());
+	ofGetAssetCache().store(key, data);
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::allocateAtlasTexture(const ofPixels & pixels){
+	texAtlas.allocate(pixels,false);
 	texAtlas.setRGToRGBASwizzles(true);
 
 	if(settings.antialiased && settings.fontSize>20){
@@ -943,9 +1182,49 @@ bool ofTrueTypeFont::load(const ofTtfSettings & _settings){
 	}else{
 		texAtlas.setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
 	}
-	texAtlas.loadData(atlasPixelsLuminanceAlpha);
-	bLoadedOk = true;
-	return true;
+	texAtlas.loadData(pixels);
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::loadDynamicGlyph(uint32_t glyph) const{
+	auto index = indexForGlyph(glyph);
+	auto loaded = loadGlyph(glyph);
+	loaded.props.characterIndex = index;
+	cps[index] = loaded.props;
+	cpsLoaded[index] = true;
+	glyphAtlas->add(glyph, loaded.pixels);
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::addGlyphToAtlas(uint32_t glyph) const{
+	if(!isValidGlyph(glyph)){
+		return;
+	}
+	auto index = indexForGlyph(glyph);
+	if(!cpsLoaded[index]){
+		loadDynamicGlyph(glyph);
+	}else if(!glyphAtlas->get(glyph) && !glyphAtlas->isTooLarge(glyph)){
+		// evicted since it was loaded, rasterize it again
+		glyphAtlas->add(glyph, loadGlyph(glyph).pixels);
+	}
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::updateAtlasTexture() const{
+	if(!glyphAtlas->isDirty() || !texAtlas.isAllocated()){
+		return;
+	}
+	// upload only the rows that changed since the last update
+	auto & pixels = glyphAtlas->getPixels();
+	auto begin = glyphAtlas->getDirtyBegin();
+	auto rows = glyphAtlas->getDirtyEnd() - begin;
+	auto & texData = texAtlas.getTextureData();
+	glBindTexture(texData.textureTarget, texData.textureID);
+	ofSetPixelStoreiAlignment(GL_UNPACK_ALIGNMENT, pixels.getWidth(), 1, 2);
+	glTexSubImage2D(texData.textureTarget, 0, 0, begin, pixels.getWidth(), rows,
+		ofGetGlFormat(pixels), GL_UNSIGNED_BYTE, pixels.getData() + begin * pixels.getBytesStride());
+	glBindTexture(texData.textureTarget, 0);
+	glyphAtlas->clearDirty();
 }
 
 //-----------------------------------------------------------
@@ -1050,14 +1329,30 @@ void ofTrueTypeFont::drawChar(uint32_t c, float x, float y, bool vFlipped) const
 	long xmin, ymin, xmax, ymax;
 	float t1, v1, t2, v2;
 	auto props = getGlyphProperties(c);
-	t1		= props.t1;
-	t2		= props.t2;
-	v2		= props.v2;
-	v1		= props.v1;
+	if(glyphAtlas){
+		auto region = glyphAtlas->get(c);
+		if(!region){
+			// didn't fit in the atlas
+			return;
+		}
+		float w = glyphAtlas->getPixels().getWidth();
+		float h = glyphAtlas->getPixels().getHeight();
+		t1		= region->x/w;
+		v1		= region->y/h;
+		t2		= (region->x + props.tW)/w;
+		v2		= (region->y + props.tH)/h;
+	}else{
+		t1		= props.t1;
+		t2		= props.t2;
+		v2		= props.v2;
+		v1		= props.v1;
+	}
 
-	xmin		= long(props.xmin+x);
+	// floor instead of truncating so moving a string by whole pixels moves
+	// every glyph by the same amount, that's what allows caching meshes
+	xmin		= long(floor(props.xmin+x));
 	ymin		= props.ymin;
-	xmax		= long(props.xmax+x);
+	xmax		= long(floor(props.xmax+x));
 	ymax		= props.ymax;
 
 	if(!vFlipped){
@@ -1065,8 +1360,8 @@ void ofTrueTypeFont::drawChar(uint32_t c, float x, float y, bool vFlipped) const
 	   ymax *= -1;
 	}
 
-	ymin += y;
-	ymax += y;
+	ymin		= long(floor(ymin+y));
+	ymax		= long(floor(ymax+y));
 
 	ofIndexType firstIndex = stringQuads.getVertices().size();
 
@@ -1180,7 +1475,11 @@ size_t ofTrueTypeFont::indexForGlyph(uint32_t glyph) const{
 
 const ofTrueTypeFont::glyphProps & ofTrueTypeFont::getGlyphProperties(uint32_t glyph) const{
 	if(isValidGlyph(glyph)){
-		return cps[indexForGlyph(glyph)];
+		auto index = indexForGlyph(glyph);
+		if(glyphAtlas && !cpsLoaded[index]){
+			loadDynamicGlyph(glyph);
+		}
+		return cps[index];
 	}else{
 		return invalidProps;
 	}
@@ -1211,7 +1510,8 @@ float ofTrueTypeFont::stringWidth(const std::string& c) const{
 
 //-----------------------------------------------------------
 ofRectangle ofTrueTypeFont::getStringBoundingBox(const std::string& c, float x, float y, bool vflip) const{
-	ofMesh mesh = getStringMesh(c,x,y,vflip);
+	glm::vec2 translation;
+	const ofMesh & mesh = getCachedStringMesh(c,x,y,vflip,translation);
 
 	if(mesh.getNumVertices() == 0)
 	    return ofRectangle(x,y,0,0);
@@ -1228,7 +1528,7 @@ ofRectangle ofTrueTypeFont::getStringBoundingBox(const std::string& c, float x,
 	}
 	float width = maxX - minX;
 	float height = maxY - minY;
-	return ofRectangle(minX, minY, width, height);
+	return ofRectangle(minX + translation.x, minY + translation.y, width, height);
 }
 
 //-----------------------------------------------------------
@@ -1239,6 +1539,15 @@ float ofTrueTypeFont::stringHeight(const std::string& c) const{
 
 //-----------------------------------------------------------
 void ofTrueTypeFont::createStringMesh(const std::string& str, float x, float y, bool vflip) const{
+	if(glyphAtlas){
+		// make sure every glyph in the string is in the atlas before using
+		// their positions, adding one can move the rest when evicting
+		glyphAtlas->beginBatch();
+		iterateString(str,x,y,vflip,[&](uint32_t c, glm::vec2){
+			addGlyphToAtlas(c);
+		});
+		updateAtlasTexture();
+	}
 	iterateString(str,x,y,vflip,[&](uint32_t c, glm::vec2 pos){
 		drawChar(c, pos.x, pos.y, vflip);
 	});
@@ -1246,11 +1555,128 @@ void ofTrueTypeFont::createStringMesh(const std::string& str, float x, float y,
 
 //-----------------------------------------------------------
 const ofMesh & ofTrueTypeFont::getStringMesh(const std::string& c, float x, float y, bool vFlipped) const{
-	stringQuads.clear();
-	createStringMesh(c,x,y,vFlipped);
+	if(meshCache->capacity == 0){
+		stringQuads.clear();
+		createStringMesh(c,x,y,vFlipped);
+		return stringQuads;
+	}
+	glm::vec2 translation;
+	auto & mesh = getCachedStringMesh(c,x,y,vFlipped,translation);
+	if(translation == glm::vec2(0,0)){
+		return mesh;
+	}
+	stringQuads = mesh;
+	for(auto & v: stringQuads.getVertices()){
+		v.x += translation.x;
+		v.y += translation.y;
+	}
 	return stringQuads;
 }
 
+//-----------------------------------------------------------
+const ofMesh & ofTrueTypeFont::getCachedStringMesh(const std::string& c, float x, float y, bool vFlipped, glm::vec2 & translation) const{
+	// glyphs are snapped to whole pixels so only the integer part of the
+	// position can be applied as a translation, the fraction is part of
+	// the layout. it's rounded to a few steps so strings that move
+	// smoothly don't need a new mesh for every position
+	const float subpixelSteps = 4;
+	float integerX = floor(x);
+	float fractionX = round((x - integerX) * subpixelSteps) / subpixelSteps;
+	if(fractionX == 1){
+		integerX += 1;
+		fractionX = 0;
+	}
+	float integerY = floor(y);
+	float fractionY = round((y - integerY) * subpixelSteps) / subpixelSteps;
+	if(fractionY == 1){
+		integerY += 1;
+		fractionY = 0;
+	}
+	translation = {integerX, integerY};
+
+	if(meshCache->capacity == 0){
+		stringQuads.clear();
+		createStringMesh(c,fractionX,fractionY,vFlipped);
+		return stringQuads;
+	}
+
+	std::string key = c;
+	key.push_back('\0');
+	auto append = [&](const void * data, size_t size){
+		key.append(static_cast<const char*>(data), size);
+	};
+	append(&vFlipped, sizeof(vFlipped));
+	append(&fractionX, sizeof(fractionX));
+	append(&fractionY, sizeof(fractionY));
+	append(&letterSpacing, sizeof(letterSpacing));
+	append(&spaceSize, sizeof(spaceSize));
+	append(&lineHeight, sizeof(lineHeight));
+	append(&settings.direction, sizeof(settings.direction));
+
+	auto & cache = *meshCache;
+	auto generation = getAtlasGeneration();
+	auto it = cache.index.find(key);
+	if(it != cache.index.end()){
+		auto entry = it->second;
+		cache.entries.splice(cache.entries.begin(), cache.entries, entry);
+		if(entry->atlasGeneration == generation){
+			for(auto glyph: entry->glyphs){
+				glyphAtlas->get(glyph);
+			}
+			return entry->mesh;
+		}
+		// glyphs moved in the atlas since the mesh was created
+		stringQuads.clear();
+		createStringMesh(c,fractionX,fractionY,vFlipped);
+		entry->mesh = stringQuads;
+		entry->atlasGeneration = getAtlasGeneration();
+		return entry->mesh;
+	}
+
+	stringQuads.clear();
+	createStringMesh(c,fractionX,fractionY,vFlipped);
+	cache.entries.push_front({key, stringQuads, getAtlasGeneration(), {}});
+	cache.index[key] = cache.entries.begin();
+	if(glyphAtlas){
+		auto & glyphs = cache.entries.front().glyphs;
+		for(auto glyph: ofUTF8Iterator(c)){
+			if(isValidGlyph(glyph)){
+				glyphs.push_back(glyph);
+			}
+		}
+	}
+	while(cache.entries.size() > cache.capacity){
+		cache.index.erase(cache.entries.back().key);
+		cache.entries.pop_back();
+	}
+	return cache.entries.front().mesh;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::setStringMeshCacheSize(size_t numStrings){
+	auto & cache = *meshCache;
+	cache.capacity = numStrings;
+	while(cache.entries.size() > cache.capacity){
+		cache.index.erase(cache.entries.back().key);
+		cache.entries.pop_back();
+	}
+}
+
+//-----------------------------------------------------------
+size_t ofTrueTypeFont::getStringMeshCacheSize() const{
+	return meshCache->capacity;
+}
+
+//-----------------------------------------------------------
+uint64_t ofTrueTypeFont::getGeneration() const{
+	return generation;
+}
+
+//-----------------------------------------------------------
+uint64_t ofTrueTypeFont::getAtlasGeneration() const{
+	return glyphAtlas ? glyphAtlas->getGeneration() : 0;
+}
+
 //-----------------------------------------------------------
 const ofTexture & ofTrueTypeFont::getFontTexture() const{
 	return texAtlas;
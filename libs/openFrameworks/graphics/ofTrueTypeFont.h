@@ -26,6 +26,7 @@
 
 typedef ofPath ofTTFCharacter;
 typedef struct FT_FaceRec_*  FT_Face;
+class ofGlyphAtlas;
 
 /// \endcond
 
@@ -137,6 +138,19 @@ public:
 	};
 	Direction direction = LeftToRight;
 
+	/// rasterize glyphs the first time they are drawn into an atlas of
+	/// atlasSize x atlasSize pixels, evicting the least recently used ones
+	/// when it's full, instead of rasterizing every glyph in the ranges
+	/// when loading. Meant for fonts with big alphabets like CJK, it's
+	/// ignored if contours are enabled.
+	bool dynamicAtlas = false;
+	int atlasSize = 1024;
+
+	/// store the rasterized atlas in ofGetAssetCache() and load it from
+	/// there the next time the same font is loaded with the same settings.
+	/// It's ignored with a dynamic atlas or if contours are enabled.
+	bool useCache = false;
+
 	void addRanges(std::initializer_list<ofUnicode::range> alphabet){
 		ranges.insert(ranges.end(), alphabet);
 	}
@@ -348,7 +362,42 @@ public:
 	/// \todo
 	ofTTFCharacter getCharacterAsPoints(uint32_t character, bool vflip=true, bool filled=true) const;
 	vector<ofTTFCharacter> getStringAsPoints(const std::string &  str, bool vflip=true, bool filled=true) const;
+	/// \brief Get the mesh to draw a string with the font texture.
+	///
+	/// With ofTtfSettings::dynamicAtlas this also adds the glyphs in the
+	/// string to the atlas, which can move other glyphs so meshes returned
+	/// earlier might not be valid anymore.
 	const ofMesh & getStringMesh(const std::string &  s, float x, float y, bool vflip=true) const;
+
+	/// \brief Get the mesh to draw a string from the string mesh cache.
+	///
+	/// The returned mesh is laid out close to the origin and has to be
+	/// drawn translated by translation to end up at x, y. Strings drawn
+	/// with the same font settings only need to be laid out once, after
+	/// that drawing them costs a transform and a draw call.
+	///
+	/// The mesh stays valid until the next call that modifies the cache.
+	///
+	/// \param translation Set to the translation to draw the mesh with,
+	/// always whole pixels so the glyphs stay sharp.
+	const ofMesh & getCachedStringMesh(const std::string & s, float x, float y, bool vflip, glm::vec2 & translation) const;
+
+	/// \brief Set how many string meshes drawString() and getStringMesh()
+	/// keep, the least recently used ones are discarded first.
+	///
+	/// Defaults to 256, 0 disables the cache.
+	void setStringMeshCacheSize(size_t numStrings);
+	size_t getStringMeshCacheSize() const;
+
+	/// \returns A number that changes every time the font is loaded, which
+	/// invalidates the meshes created with it before.
+	uint64_t getGeneration() const;
+
+	/// \returns A number that changes every time glyphs move in the font
+	/// texture, which invalidates the texture coordinates of meshes created
+	/// before. Only happens with ofTtfSettings::dynamicAtlas.
+	uint64_t getAtlasGeneration() const;
+
 	const ofTexture & getFontTexture() const;
 	ofTexture getStringTexture(const std::string &  s, bool vflip=true) const;
 	glm::vec2 getFirstGlyphPosForTexture(const std::string & str, bool vflip) const;
@@ -392,7 +441,8 @@ protected:
 		ofPixels pixels;
 	};
 
-	vector<glyphProps> cps; // properties for each character
+	mutable vector<glyphProps> cps; // properties for each character
+	mutable vector<bool> cpsLoaded; // with a dynamic atlas, whether cps has been loaded for each character
 
 	ofTtfSettings settings;
 	unordered_map<uint32_t,size_t> glyphIndexMap;
@@ -403,13 +453,27 @@ protected:
 	void drawCharAsShape(uint32_t c, float x, float y, bool vFlipped, bool filled) const;
 	void createStringMesh(const string & s, float x, float y, bool vFlipped) const;
 	glyph loadGlyph(uint32_t utf8) const;
+	glyph loadGlyph(FT_Face face, uint32_t utf8) const;
+	vector<glyph> loadGlyphs(const vector<uint32_t> & codepoints) const;
 	const glyphProps & getGlyphProperties(uint32_t glyph) const;
 	void iterateString(const string & str, float x, float y, bool vFlipped, std::function<void(uint32_t, glm::vec2)> f) const;
 	size_t indexForGlyph(uint32_t glyph) const;
-
-	ofTexture texAtlas;
+	void allocateAtlasTexture(const ofPixels & pixels);
+	std::string getAtlasCacheKey() const;
+	bool loadAtlasFromCache(const std::string & key, size_t numGlyphs);
+	void storeAtlasInCache(const std::string & key, const ofPixels & atlas) const;
+	void loadDynamicGlyph(uint32_t glyph) const;
+	void addGlyphToAtlas(uint32_t glyph) const;
+	void updateAtlasTexture() const;
+
+	mutable ofTexture texAtlas;
+	shared_ptr<ofGlyphAtlas> glyphAtlas;
 	mutable ofMesh stringQuads;
 
+	struct StringMeshCache;
+	shared_ptr<StringMeshCache> meshCache;
+	uint64_t generation;
+
 	/// \endcond
 
 private:
@@ -417,6 +481,9 @@ private:
 	friend void ofUnloadAllFontTextures();
 	friend void ofReloadAllFontTextures();
 #endif
+	// contents of fonts read from an asset pack, declared before the face
+	// so it's destroyed after it
+	shared_ptr<ofBuffer>	faceData;
 	shared_ptr<struct FT_FaceRec_>	face;
 	static const glyphProps invalidProps;
 	void		unloadTextures();
@@ -1,12 +1,15 @@
 #include "ofMath.h"
 #include "ofUtils.h"
 #include "float.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 #ifndef TARGET_WIN32
 	#include <sys/time.h>
 #endif
 
-#include "ofNoise.h"
 #include "ofPolyline.h"
 
 //--------------------------------------------------
@@ -17,6 +20,73 @@ int ofNextPow2(int a){
 	return rval;
 }
 
+namespace{
+	// ofSeedRandom bumps the generation so every thread reseeds its engine
+	// the next time it's used
+	std::atomic<uint64_t> randomSeed(0);
+	std::atomic<uint32_t> randomSeedGeneration(0);
+	std::atomic<uint64_t> nextRandomStream(1);
+
+	struct ThreadRandomEngine{
+		ofRandomEngine engine;
+		uint32_t generation = std::numeric_limits<uint32_t>::max();
+	};
+
+#if defined(TARGET_EMSCRIPTEN)
+	ThreadRandomEngine & getThreadRandomEngine(){
+		static ThreadRandomEngine engine;
+		return engine;
+	}
+#elif HAS_TLS
+	ThreadRandomEngine & getThreadRandomEngine(){
+		thread_local ThreadRandomEngine engine;
+		return engine;
+	}
+#else
+	// without thread_local every thread gets its engine from a map, the
+	// elements don't move when others are added so each thread can keep
+	// using its own without locking
+	ThreadRandomEngine & getThreadRandomEngine(){
+		static std::mutex * mutex = new std::mutex;
+		static auto * engines = new std::unordered_map<std::thread::id, ThreadRandomEngine>;
+		std::unique_lock<std::mutex> lock(*mutex);
+		return (*engines)[std::this_thread::get_id()];
+	}
+#endif
+
+	void seedRandomEngines(uint64_t seed){
+		srand((unsigned int)seed);
+		randomSeed = seed;
+		nextRandomStream = 1;
+		auto & threadEngine = getThreadRandomEngine();
+		threadEngine.engine.seed(seed, 0);
+		threadEngine.generation = ++randomSeedGeneration;
+	}
+
+	// a float in [min(a, b), max(a, b))
+	float randomValue(ofRandomEngine & engine, float a, float b){
+		float high = MAX(a, b);
+		float low = MIN(a, b);
+		return std::min(low + (high - low) * engine.getUniform(), std::nextafter(high, low));
+	}
+}
+
+//--------------------------------------------------
+ofRandomEngine & ofGetRandomEngine(){
+	auto & threadEngine = getThreadRandomEngine();
+	auto generation = randomSeedGeneration.load();
+	if(threadEngine.generation != generation){
+		threadEngine.engine.seed(randomSeed, nextRandomStream++);
+		threadEngine.generation = generation;
+	}
+	return threadEngine.engine;
+}
+
+//--------------------------------------------------
+uint64_t ofGetRandomSeed(){
+	return randomSeed;
+}
+
 //--------------------------------------------------
 void ofSeedRandom() {
 
@@ -24,46 +94,95 @@ void ofSeedRandom() {
 	// http://stackoverflow.com/questions/322938/recommended-way-to-initialize-srand
 
 	#ifdef TARGET_WIN32
-		srand(GetTickCount());
+		seedRandomEngines(GetTickCount());
 	#elif !defined(TARGET_EMSCRIPTEN)
 		// use XOR'd second, microsecond precision AND pid as seed
 		struct timeval tv;
 		gettimeofday(&tv, 0);
 		long int n = (tv.tv_sec ^ tv.tv_usec) ^ getpid();
-		srand(n);
+		seedRandomEngines(n);
 	#else
 		struct timeval tv;
 		gettimeofday(&tv, 0);
 		long int n = (tv.tv_sec ^ tv.tv_usec);
-		srand(n);
+		seedRandomEngines(n);
 	#endif
 }
 
 //--------------------------------------------------
 void ofSeedRandom(int val) {
-	srand((long) val);
+	seedRandomEngines(val);
 }
 
 //--------------------------------------------------
 float ofRandom(float max) {
-	return (max * rand() / float(RAND_MAX)) * (1.0f - std::numeric_limits<float>::epsilon());
+	return randomValue(ofGetRandomEngine(), 0, max);
 }
 
 //--------------------------------------------------
 float ofRandom(float x, float y) {
-	float high = MAX(x, y);
-	float low = MIN(x, y);
-	return max(low, (low + ((high - low) * rand() / float(RAND_MAX))) * (1.0f - std::numeric_limits<float>::epsilon()));
+	return randomValue(ofGetRandomEngine(), x, y);
 }
 
 //--------------------------------------------------
 float ofRandomf() {
-	return -1.0f + (2.0f * rand() / float(RAND_MAX)) * (1.0f - std::numeric_limits<float>::epsilon());
+	return randomValue(ofGetRandomEngine(), -1, 1);
 }
 
 //--------------------------------------------------
 float ofRandomuf() {
-	return (rand() / float(RAND_MAX)) * (1.0f - std::numeric_limits<float>::epsilon());
+	return ofGetRandomEngine().getUniform();
+}
+
+//--------------------------------------------------
+void ofRandom(float * out, size_t count, float min, float max){
+	auto & engine = ofGetRandomEngine();
+	for(size_t i = 0; i < count; i++){
+		out[i] = randomValue(engine, min, max);
+	}
+}
+
+//--------------------------------------------------
+void ofRandomf(float * out, size_t count){
+	ofRandom(out, count, -1, 1);
+}
+
+//--------------------------------------------------
+void ofRandomuf(float * out, size_t count){
+	auto & engine = ofGetRandomEngine();
+	for(size_t i = 0; i < count; i++){
+		out[i] = engine.getUniform();
+	}
+}
+
+//--------------------------------------------------
+void ofRandom(glm::vec2 * out, size_t count, const glm::vec2 & min, const glm::vec2 & max){
+	auto & engine = ofGetRandomEngine();
+	for(size_t i = 0; i < count; i++){
+		out[i].x = randomValue(engine, min.x, max.x);
+		out[i].y = randomValue(engine, min.y, max.y);
+	}
+}
+
+//--------------------------------------------------
+void ofRandom(glm::vec3 * out, size_t count, const glm::vec3 & min, const glm::vec3 & max){
+	auto & engine = ofGetRandomEngine();
+	for(size_t i = 0; i < count; i++){
+		out[i].x = randomValue(engine, min.x, max.x);
+		out[i].y = randomValue(engine, min.y, max.y);
+		out[i].z = randomValue(engine, min.z, max.z);
+	}
+}
+
+//--------------------------------------------------
+void ofRandom(glm::vec4 * out, size_t count, const glm::vec4 & min, const glm::vec4 & max){
+	auto & engine = ofGetRandomEngine();
+	for(size_t i = 0; i < count; i++){
+		out[i].x = randomValue(engine, min.x, max.x);
+		out[i].y = randomValue(engine, min.y, max.y);
+		out[i].z = randomValue(engine, min.z, max.z);
+		out[i].w = randomValue(engine, min.w, max.w);
+	}
 }
 
 //---- new to 006
@@ -180,76 +299,6 @@ float ofLerpRadians(float currentAngle, float targetAngle, float pct) {
 	return currentAngle + ofAngleDifferenceRadians(currentAngle,targetAngle) * pct;
 }
 
-//--------------------------------------------------
-float ofNoise(float x){
-	return _slang_library_noise1(x)*0.5f + 0.5f;
-}
-
-//--------------------------------------------------
-float ofNoise(float x, float y){
-	return _slang_library_noise2(x,y)*0.5f + 0.5f;
-}
-
-//--------------------------------------------------
-float ofNoise(const glm::vec2& p){
-	return ofNoise( p.x, p.y );
-}
-
-//--------------------------------------------------
-float ofNoise(float x, float y, float z){
-	return _slang_library_noise3(x,y,z)*0.5f + 0.5f;
-}
-
-//--------------------------------------------------
-float ofNoise(const glm::vec3& p){
-	return ofNoise( p.x, p.y, p.z );
-}
-
-//--------------------------------------------------
-float ofNoise(float x, float y, float z, float w){
-	return _slang_library_noise4(x,y,z,w)*0.5f + 0.5f;
-}
-
-//--------------------------------------------------
-float ofNoise(const glm::vec4& p){
-	return ofNoise( p.x, p.y, p.z, p.w );
-}
-
-//--------------------------------------------------
-float ofSignedNoise(float x){
-	return _slang_library_noise1(x);
-}
-
-//--------------------------------------------------
-float ofSignedNoise(float x, float y){
-	return _slang_library_noise2(x,y);
-}
-
-//--------------------------------------------------
-float ofSignedNoise(const glm::vec2& p){
-	return ofSignedNoise( p.x, p.y );
-}
-
-//--------------------------------------------------
-float ofSignedNoise(float x, float y, float z){
-	return _slang_library_noise3(x,y,z);
-}
-
-//--------------------------------------------------
-float ofSignedNoise(const glm::vec3& p){
-	return ofSignedNoise( p.x, p.y, p.z );
-}
-
-//--------------------------------------------------
-float ofSignedNoise(float x, float y, float z, float w){
-	return _slang_library_noise4(x,y,z,w);
-}
-
-//--------------------------------------------------
-float ofSignedNoise(const glm::vec4& p){
-	return ofSignedNoise( p.x, p.y, p.z, p.w );
-}
-
 //--------------------------------------------------
 float ofAngleDifferenceDegrees(float currentAngle, float targetAngle) {
 	return ofWrapDegrees(targetAngle - currentAngle);
@@ -1,15 +1,24 @@
 #pragma once
 
 #include "ofConstants.h"
+#include "ofRandomEngine.h"
+
+template<typename T>
+class ofPixels_;
+typedef ofPixels_<float> ofFloatPixels;
 
 /// \file
 /// ofMath provides a collection of mathematical utilities and functions.
 ///
-/// \warning Many ofRandom-style functions wrap `rand()` which is not reentrant
-/// or thread safe.  To generate random numbers simultaneously in multiple
-/// threads, consider using c++11 uniform_real_distribution.
+/// The ofRandom-style functions draw from an ofRandomEngine owned by the
+/// calling thread, so they can be used from several threads at once without
+/// contention. After ofSeedRandom(val) the thread that called it repeats the
+/// same sequence every run; other threads get their own stream derived from
+/// the same seed, numbered in the order they first ask for a random number.
+/// When the results of threaded code have to be reproducible regardless of
+/// that order, create an ofRandomEngine per task with an explicit stream.
 ///
-/// \sa http://en.cppreference.com/w/cpp/numeric/random/uniform_real_distribution
+/// \sa ofRandomEngine
 
 /// \name Random Numbers
 /// \{
@@ -24,8 +33,6 @@
 /// float randomNumber = ofRandom(20);
 /// ~~~~~
 ///
-/// \warning ofRandom wraps C++'s `rand()` which is not reentrant or thread safe.
-///
 /// \param max The maximum value of the random number.
 float ofRandom(float max); 
 
@@ -39,8 +46,6 @@ float ofRandom(float max);
 /// float randomNumber = ofRandom(-30, 20);
 /// ~~~~~
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \param val0 the minimum value of the random number.
 /// \param val1 The maximum value of the random number.
 /// \returns A random floating point number between val0 and val1.
@@ -48,15 +53,11 @@ float ofRandom(float val0, float val1);
 
 /// \brief Get a random floating point number.
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \returns A random floating point number between -1 and 1.
 float ofRandomf();
 
 /// \brief Get a random unsigned floating point number.
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \returns A random floating point number between 0 and 1.
 float ofRandomuf();
 
@@ -65,8 +66,6 @@ float ofRandomuf();
 ///
 /// A random number in the range [0, ofGetWidth()) will be returned.
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \returns a random number between 0 and ofGetWidth().
 float ofRandomWidth();
 
@@ -74,8 +73,6 @@ float ofRandomWidth();
 ///
 /// A random number in the range [0, ofGetHeight()) will be returned.
 ///
-/// \warning ofRandom wraps `rand()` which is not reentrant or thread safe.
-///
 /// \returns a random number between 0 and ofGetHeight().
 float ofRandomHeight();
 
@@ -91,9 +88,53 @@ void ofSeedRandom();
 /// seed can be used to initialize the random number generator during app
 /// setup.  This can be useful for debugging and testing.
 ///
+/// This also seeds `rand()` for code that still uses it directly.
+///
 /// \param val The value with which to seed the generator.
 void ofSeedRandom(int val);
 
+/// \returns The seed last passed to ofSeedRandom, or generated by it.
+uint64_t ofGetRandomSeed();
+
+/// \brief Get the random number engine of the calling thread.
+///
+/// This is the engine used by ofRandom and friends in this thread. It can be
+/// passed to std::shuffle or the distributions in `<random>`:
+///
+/// ~~~~{.cpp}
+/// std::normal_distribution<float> gaussian(0, 1);
+/// float value = gaussian(ofGetRandomEngine());
+/// ~~~~
+///
+/// The returned reference is only valid in the calling thread.
+ofRandomEngine & ofGetRandomEngine();
+
+/// \brief Fill an array with random numbers between min and max.
+///
+/// Equivalent to calling ofRandom(min, max) count times, but without the
+/// per call overhead.
+///
+/// \param out Array of count floats to fill.
+/// \param count Number of values to generate.
+/// \param min The minimum value of the random numbers.
+/// \param max The maximum value of the random numbers.
+void ofRandom(float * out, size_t count, float min, float max);
+
+/// \brief Fill an array with random numbers between -1 and 1.
+void ofRandomf(float * out, size_t count);
+
+/// \brief Fill an array with random numbers between 0 and 1.
+void ofRandomuf(float * out, size_t count);
+
+/// \brief Fill an array with random points inside the box between min and max.
+void ofRandom(glm::vec2 * out, size_t count, const glm::vec2 & min, const glm::vec2 & max);
+
+/// \brief Fill an array with random points inside the box between min and max.
+void ofRandom(glm::vec3 * out, size_t count, const glm::vec3 & min, const glm::vec3 & max);
+
+/// \brief Fill an array with random points inside the box between min and max.
+void ofRandom(glm::vec4 * out, size_t count, const glm::vec4 & min, const glm::vec4 & max);
+
 /// \}
 
 /// \name Number Ranges
@@ -416,6 +457,139 @@ float ofSignedNoise(const glm::vec4 & p);
 
 /// \}
 
+/// \name Batch Noise
+///
+/// These functions evaluate noise for many points at once, using SIMD
+/// instructions when available and splitting the work across the shared
+/// thread pool (see ofParallelFor). Every value is exactly the same as
+/// calling the equivalent scalar function for that point, so they can be
+/// mixed freely with ofNoise and ofSignedNoise.
+///
+/// ~~~~{.cpp}
+/// ofFloatPixels field;
+/// field.allocate(512, 512, 1);
+/// // field[x + y*512] == ofNoise(x*0.01f, y*0.01f, time)
+/// ofNoise(field, glm::vec3(0, 0, time), glm::vec2(0.01f, 0.01f));
+/// ~~~~
+///
+/// The fractal variants add octaves of noise, each one scaled in frequency
+/// by lacunarity and in amplitude by gain relative to the previous one, and
+/// normalize the sum by the total amplitude so the range stays the same as
+/// a single octave.
+/// \{
+
+/// \brief Calculates count one dimensional noise values between 0.0...1.0.
+/// \param x Array of count coordinates.
+/// \param out Array of count values to write the results to.
+/// \param count Number of values to calculate.
+void ofNoise(const float * x, float * out, size_t count);
+
+/// \brief Calculates count two dimensional noise values between 0.0...1.0.
+void ofNoise(const glm::vec2 * points, float * out, size_t count);
+
+/// \brief Calculates count three dimensional noise values between 0.0...1.0.
+void ofNoise(const glm::vec3 * points, float * out, size_t count);
+
+/// \brief Calculates count four dimensional noise values between 0.0...1.0.
+void ofNoise(const glm::vec4 * points, float * out, size_t count);
+
+/// \brief Calculates count one dimensional noise values between -1.0...1.0.
+void ofSignedNoise(const float * x, float * out, size_t count);
+
+/// \brief Calculates count two dimensional noise values between -1.0...1.0.
+void ofSignedNoise(const glm::vec2 * points, float * out, size_t count);
+
+/// \brief Calculates count three dimensional noise values between -1.0...1.0.
+void ofSignedNoise(const glm::vec3 * points, float * out, size_t count);
+
+/// \brief Calculates count four dimensional noise values between -1.0...1.0.
+void ofSignedNoise(const glm::vec4 * points, float * out, size_t count);
+
+/// \brief Fills every channel of the pixels with noise values between 0.0...1.0
+/// sampled over a grid.
+///
+/// The pixel at (x, y) gets ofNoise(origin.x + x * step.x, origin.y + y * step.y).
+/// Pixels that aren't allocated are left untouched.
+///
+/// \param pixels Pixels to fill.
+/// \param origin Coordinates of the noise at the first pixel.
+/// \param step Distance in noise space between contiguous pixels.
+void ofNoise(ofFloatPixels & pixels, const glm::vec2 & origin, const glm::vec2 & step);
+
+/// \brief Fills every channel of the pixels with a grid of three dimensional
+/// noise values between 0.0...1.0, at a constant origin.z.
+void ofNoise(ofFloatPixels & pixels, const glm::vec3 & origin, const glm::vec2 & step);
+
+/// \brief Fills every channel of the pixels with a grid of four dimensional
+/// noise values between 0.0...1.0, at a constant origin.z and origin.w.
+void ofNoise(ofFloatPixels & pixels, const glm::vec4 & origin, const glm::vec2 & step);
+
+/// \brief Calculates one dimensional fractal noise between 0.0...1.0.
+/// \param x Coordinate of the first octave.
+/// \param octaves Number of octaves to add.
+/// \param lacunarity Frequency multiplier between octaves.
+/// \param gain Amplitude multiplier between octaves.
+float ofFractalNoise(float x, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Calculates two dimensional fractal noise between 0.0...1.0.
+float ofFractalNoise(const glm::vec2 & p, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Calculates three dimensional fractal noise between 0.0...1.0.
+float ofFractalNoise(const glm::vec3 & p, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Calculates four dimensional fractal noise between 0.0...1.0.
+float ofFractalNoise(const glm::vec4 & p, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Calculates one dimensional fractal noise between -1.0...1.0.
+float ofSignedFractalNoise(float x, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Calculates two dimensional fractal noise between -1.0...1.0.
+float ofSignedFractalNoise(const glm::vec2 & p, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Calculates three dimensional fractal noise between -1.0...1.0.
+float ofSignedFractalNoise(const glm::vec3 & p, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Calculates four dimensional fractal noise between -1.0...1.0.
+float ofSignedFractalNoise(const glm::vec4 & p, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Calculates count one dimensional fractal noise values between 0.0...1.0.
+void ofFractalNoise(const float * x, float * out, size_t count, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Calculates count two dimensional fractal noise values between 0.0...1.0.
+void ofFractalNoise(const glm::vec2 * points, float * out, size_t count, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Calculates count three dimensional fractal noise values between 0.0...1.0.
+void ofFractalNoise(const glm::vec3 * points, float * out, size_t count, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Calculates count four dimensional fractal noise values between 0.0...1.0.
+void ofFractalNoise(const glm::vec4 * points, float * out, size_t count, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Calculates count one dimensional fractal noise values between -1.0...1.0.
+void ofSignedFractalNoise(const float * x, float * out, size_t count, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Calculates count two dimensional fractal noise values between -1.0...1.0.
+void ofSignedFractalNoise(const glm::vec2 * points, float * out, size_t count, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Calculates count three dimensional fractal noise values between -1.0...1.0.
+void ofSignedFractalNoise(const glm::vec3 * points, float * out, size_t count, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Calculates count four dimensional fractal noise values between -1.0...1.0.
+void ofSignedFractalNoise(const glm::vec4 * points, float * out, size_t count, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Fills every channel of the pixels with a grid of two dimensional
+/// fractal noise values between 0.0...1.0, see ofNoise(ofFloatPixels&, const glm::vec2&, const glm::vec2&).
+void ofFractalNoise(ofFloatPixels & pixels, const glm::vec2 & origin, const glm::vec2 & step, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Fills every channel of the pixels with a grid of three dimensional
+/// fractal noise values between 0.0...1.0.
+void ofFractalNoise(ofFloatPixels & pixels, const glm::vec3 & origin, const glm::vec2 & step, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \brief Fills every channel of the pixels with a grid of four dimensional
+/// fractal noise values between 0.0...1.0.
+void ofFractalNoise(ofFloatPixels & pixels, const glm::vec4 & origin, const glm::vec2 & step, int octaves, float lacunarity = 2, float gain = 0.5);
+
+/// \}
+
 
 /// \name Geometry
 /// \{
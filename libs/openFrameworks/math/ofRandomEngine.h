@@ -0,0 +1,87 @@
+#pragma once
+
+#include "ofConstants.h"
+
+/// \brief A fast, seedable pseudo random number generator.
+///
+/// ofRandomEngine implements xoshiro256** (http://xoshiro.di.unimi.it), a
+/// small generator with a period of 2^256 - 1 that passes the usual
+/// statistical test suites and takes a few nanoseconds per number.
+///
+/// Every thread gets its own engine, used by ofRandom and friends, through
+/// ofGetRandomEngine(). An engine can also be created explicitly to get a
+/// sequence that doesn't depend on which thread runs the code, for example
+/// one per chunk of work in ofParallelFor, seeded with the same seed and a
+/// different stream each:
+///
+/// ~~~~{.cpp}
+/// ofParallelFor(0, numChunks, [&](size_t begin, size_t end){
+///     for(size_t chunk = begin; chunk < end; chunk++){
+///         ofRandomEngine random(ofGetRandomSeed(), chunk);
+///         // ...
+///     }
+/// });
+/// ~~~~
+///
+/// It satisfies the requirements of a c++11 UniformRandomBitGenerator so it
+/// can also be used with std::shuffle or the distributions in `<random>`.
+class ofRandomEngine{
+public:
+	typedef uint64_t result_type;
+
+	/// \brief Create an engine for a seed and stream.
+	///
+	/// Engines created with the same seed and stream produce the same
+	/// sequence, different streams of the same seed produce unrelated ones.
+	ofRandomEngine(uint64_t seed = 0, uint64_t stream = 0){
+		this->seed(seed, stream);
+	}
+
+	/// \brief Restart the engine with a seed and stream.
+	void seed(uint64_t seed, uint64_t stream = 0){
+		// expand seed and stream into the 256 bits of state using splitmix64
+		// as recommended by the xoshiro authors, this also guarantees the
+		// state is never all zeros
+		uint64_t x = seed + stream * 0xd1b54a32d192ed03ull;
+		for(auto & s: state){
+			uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+			s = z ^ (z >> 31);
+		}
+	}
+
+	/// \returns The next 64 random bits.
+	uint64_t operator()(){
+		uint64_t result = rotl(state[1] * 5, 7) * 9;
+		uint64_t t = state[1] << 17;
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = rotl(state[3], 45);
+		return result;
+	}
+
+	/// \returns A random float in the range [0, 1), every value is a
+	/// multiple of 2^-24.
+	float getUniform(){
+		return ((*this)() >> 40) * (1.0f / 16777216.0f);
+	}
+
+	static constexpr uint64_t min(){
+		return 0;
+	}
+
+	static constexpr uint64_t max(){
+		return ~uint64_t(0);
+	}
+
+private:
+	static uint64_t rotl(uint64_t x, int k){
+		return (x << k) | (x >> (64 - k));
+	}
+
+	uint64_t state[4];
+};
@@ -8,13 +8,18 @@
 #include "ofSystemUtils.h"
 
 #include "ofURLFileLoader.h"
+#include "ofAsyncFileLoader.h"
+#include "ofFileWatcher.h"
+#include "ofAssetPack.h"
 
 #include "ofUtils.h"
+#include "ofStringView.h"
 
 #if !defined(TARGET_EMSCRIPTEN)
 #include "ofThread.h"
 #include "ofThreadChannel.h"
 #endif
+#include "ofThreadPool.h"
 
 #include "ofFpsCounter.h"
 #include "ofJson.h"
@@ -63,14 +68,21 @@
 #if !defined( TARGET_OF_IOS ) & !defined(TARGET_ANDROID) & !defined(TARGET_EMSCRIPTEN)
 	#include "ofCairoRenderer.h"
 #endif
+#include "ofAssetCache.h"
 #include "ofGraphics.h"
 #include "ofImage.h"
+#include "ofImageWriter.h"
 #include "ofPath.h"
 #include "ofPixels.h"
+#include "ofPixelsPool.h"
+#include "ofPixelsFilters.h"
+#include "ofPixelsStats.h"
 #include "ofPolyline.h"
 #include "ofRendererCollection.h"
 #include "ofTessellator.h"
 #include "ofTrueTypeFont.h"
+#include "ofGlyphAtlas.h"
+#include "ofTextLayout.h"
 
 //--------------------------
 // app
@@ -98,6 +110,7 @@
 // video
 #include "ofVideoGrabber.h"
 #include "ofVideoPlayer.h"
+#include "ofImageSequencePlayer.h"
 
 //--------------------------
 // events
@@ -0,0 +1,620 @@
+#include "ofAssetPack.h"
+#include "ofLog.h"
+#include "ofThreadPool.h"
+#include "ofUtils.h"
+
+#include <algorithm>
+#include <limits>
+
+#ifndef TARGET_NO_THREADS
+#include <atomic>
+#endif
+
+// all the values are stored little endian, the byte order of every
+// platform openFrameworks runs on
+struct ofAssetPack::Header{
+	char magic[8];
+	uint32_t version;
+	uint32_t numEntries;
+	uint64_t indexOffset;
+	uint64_t namesOffset;
+	uint64_t namesSize;
+	uint8_t reserved[24];
+};
+
+struct ofAssetPack::Entry{
+	uint64_t offset;
+	uint64_t storedSize;
+	uint64_t size;
+	uint32_t nameOffset;
+	uint32_t nameLength;
+	uint32_t compression;
+	uint32_t reserved;
+};
+
+namespace{
+	const char packMagic[8] = {'O','F','P','A','C','K','\r','\n'};
+	const uint32_t packVersion = 1;
+	const uint64_t packAlignment = 64;
+
+	uint64_t alignOffset(uint64_t offset){
+		return (offset + packAlignment - 1) & ~(packAlignment - 1);
+	}
+
+	// LZ4 block format, see https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+	// sequences of a token, literals and a match 4 to n bytes long copied
+	// from up to 64KB before. The last 5 bytes are always literals and the
+	// last match starts at least 12 bytes before the end.
+	const std::size_t lz4MinMatch = 4;
+	const std::size_t lz4LastLiterals = 5;
+	const std::size_t lz4MatchFindLimit = 12;
+	const std::size_t lz4MaxOffset = 65535;
+	const int lz4HashBits = 12;
+
+	std::size_t lz4CompressBound(std::size_t size){
+		return size + size / 255 + 16;
+	}
+
+	uint32_t read32(const uint8_t * p){
+		uint32_t v;
+		memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	uint8_t * writeLength(uint8_t * op, std::size_t length){
+		while(length >= 255){
+			*op++ = 255;
+			length -= 255;
+		}
+		*op++ = uint8_t(length);
+		return op;
+	}
+
+	// dst needs lz4CompressBound(srcSize) bytes, returns the compressed size
+	std::size_t lz4Compress(const uint8_t * src, std::size_t srcSize, uint8_t * dst){
+		auto op = dst;
+		auto anchor = src;
+		auto end = src + srcSize;
+		if(srcSize > lz4MatchFindLimit){
+			std::vector<uint32_t> table(std::size_t(1) << lz4HashBits, 0);
+			auto matchLimit = end - lz4LastLiterals;
+			auto ipLimit = end - lz4MatchFindLimit;
+			auto ip = src;
+			while(ip < ipLimit){
+				auto sequence = read32(ip);
+				auto hash = (sequence * 2654435761u) >> (32 - lz4HashBits);
+				auto ref = src + table[hash];
+				table[hash] = uint32_t(ip - src);
+				if(ref >= ip || std::size_t(ip - ref) > lz4MaxOffset || read32(ref) != sequence){
+					// skip faster through data that doesn't compress
+					ip += 1 + ((ip - anchor) >> 6);
+					continue;
+				}
+				while(ip > anchor && ref > src && ip[-1] == ref[-1]){
+					--ip;
+					--ref;
+				}
+				auto matchEnd = ip + lz4MinMatch;
+				auto refEnd = ref + lz4MinMatch;
+				while(matchEnd < matchLimit && *matchEnd == *refEnd){
+					++matchEnd;
+					++refEnd;
+				}
+
+				std::size_t literals = ip - anchor;
+				std::size_t matchLength = matchEnd - ip - lz4MinMatch;
+				auto token = op++;
+				*token = uint8_t((std::min<std::size_t>(literals, 15) << 4) | std::min<std::size_t>(matchLength, 15));
+				if(literals >= 15){
+					op = writeLength(op, literals - 15);
+				}
+				memcpy(op, anchor, literals);
+				op += literals;
+				auto offset = ip - ref;
+				*op++ = uint8_t(offset);
+				*op++ = uint8_t(offset >> 8);
+				if(matchLength >= 15){
+					op = writeLength(op, matchLength - 15);
+				}
+				ip = anchor = matchEnd;
+			}
+		}
+
+		std::size_t literals = end - anchor;
+		*op++ = uint8_t(std::min<std::size_t>(literals, 15) << 4);
+		if(literals >= 15){
+			op = writeLength(op, literals - 15);
+		}
+		memcpy(op, anchor, literals);
+		op += literals;
+		return op - dst;
+	}
+
+	// returns false unless src decompresses to exactly dstSize bytes
+	bool lz4Decompress(const uint8_t * src, std::size_t srcSize, uint8_t * dst, std::size_t dstSize){
+		auto ip = src;
+		auto ipEnd = src + srcSize;
+		auto op = dst;
+		auto opEnd = dst + dstSize;
+		auto readLength = [&](std::size_t & length){
+			uint8_t b;
+			do{
+				if(ip == ipEnd){
+					return false;
+				}
+				b = *ip++;
+				length += b;
+			}while(b == 255);
+			return true;
+		};
+
+		while(ip < ipEnd){
+			auto token = *ip++;
+			std::size_t literals = token >> 4;
+			if(literals == 15 && !readLength(literals)){
+				return false;
+			}
+			if(literals > std::size_t(ipEnd - ip) || literals > std::size_t(opEnd - op)){
+				return false;
+			}
+			memcpy(op, ip, literals);
+			ip += literals;
+			op += literals;
+			if(ip == ipEnd){
+				return op == opEnd;
+			}
+
+			if(ipEnd - ip < 2){
+				return false;
+			}
+			std::size_t offset = ip[0] | (std::size_t(ip[1]) << 8);
+			ip += 2;
+			std::size_t matchLength = token & 15;
+			if(matchLength == 15 && !readLength(matchLength)){
+				return false;
+			}
+			matchLength += lz4MinMatch;
+			if(offset == 0 || offset > std::size_t(op - dst) || matchLength > std::size_t(opEnd - op)){
+				return false;
+			}
+			auto ref = op - offset;
+			if(offset >= matchLength){
+				memcpy(op, ref, matchLength);
+				op += matchLength;
+			}else{
+				// overlapping matches repeat the last offset bytes
+				for(std::size_t i = 0; i < matchLength; i++){
+					*op++ = *ref++;
+				}
+			}
+		}
+		return false;
+	}
+}
+
+//--------------------------------------------------
+ofAssetPack::ofAssetPack()
+:entries(nullptr)
+,names(nullptr)
+,numEntries(0){}
+
+//--------------------------------------------------
+bool ofAssetPack::open(const std::filesystem::path & path){
+	close();
+	if(!data.map(path)){
+		// mapping can fail on some filesystems, read the whole pack instead
+		ofFile file(path, ofFile::ReadOnly, true);
+		if(!file.exists()){
+			ofLogError("ofAssetPack") << "open(): couldn't open " << path;
+			return false;
+		}
+		data = ofBuffer(file, file.getSize() + 1);
+	}
+
+	auto invalid = [&](const char * reason){
+		ofLogError("ofAssetPack") << "open(): " << path << " isn't a valid pack, " << reason;
+		data.clear();
+		return false;
+	};
+
+	uint64_t fileSize = data.size();
+	if(fileSize < sizeof(Header)){
+		return invalid("it's too short");
+	}
+	auto header = reinterpret_cast<const Header*>(data.getData());
+	if(memcmp(header->magic, packMagic, sizeof(packMagic)) != 0){
+		return invalid("wrong file type");
+	}
+	if(header->version != packVersion){
+		return invalid("unsupported version");
+	}
+	if(header->indexOffset % alignof(Entry) != 0 || header->indexOffset > fileSize
+	   || header->numEntries > (fileSize - header->indexOffset) / sizeof(Entry)){
+		return invalid("the index is out of bounds");
+	}
+	if(header->namesOffset > fileSize || header->namesSize > fileSize - header->namesOffset){
+		return invalid("the names are out of bounds");
+	}
+
+	auto packEntries = reinterpret_cast<const Entry*>(data.getData() + header->indexOffset);
+	auto packNames = data.getData() + header->namesOffset;
+	ofStringView previous;
+	for(uint32_t i = 0; i < header->numEntries; i++){
+		auto & entry = packEntries[i];
+		if(entry.offset > fileSize || entry.storedSize > fileSize - entry.offset){
+			return invalid("a file is out of bounds");
+		}
+		if(entry.nameOffset > header->namesSize || entry.nameLength > header->namesSize - entry.nameOffset){
+			return invalid("a name is out of bounds");
+		}
+		if(entry.compression > uint32_t(ofAssetPackCompression::LZ4)
+		   || (entry.compression == uint32_t(ofAssetPackCompression::None) && entry.storedSize != entry.size)
+		   || (entry.compression == uint32_t(ofAssetPackCompression::LZ4) && entry.size / 255 > entry.storedSize)){
+			return invalid("unknown compression");
+		}
+		ofStringView name(packNames + entry.nameOffset, entry.nameLength);
+		if(i > 0 && !(previous < name)){
+			return invalid("the index isn't sorted");
+		}
+		previous = name;
+	}
+
+	entries = packEntries;
+	names = packNames;
+	numEntries = header->numEntries;
+	return true;
+}
+
+//--------------------------------------------------
+void ofAssetPack::close(){
+	data.clear();
+	entries = nullptr;
+	names = nullptr;
+	numEntries = 0;
+}
+
+//--------------------------------------------------
+bool ofAssetPack::isOpen() const{
+	return entries != nullptr;
+}
+
+//--------------------------------------------------
+std::size_t ofAssetPack::size() const{
+	return numEntries;
+}
+
+//--------------------------------------------------
+ofStringView ofAssetPack::getName(std::size_t i) const{
+	return ofStringView(names + entries[i].nameOffset, entries[i].nameLength);
+}
+
+//--------------------------------------------------
+uint64_t ofAssetPack::getSize(std::size_t i) const{
+	return entries[i].size;
+}
+
+//--------------------------------------------------
+ofAssetPackCompression ofAssetPack::getCompression(std::size_t i) const{
+	return ofAssetPackCompression(entries[i].compression);
+}
+
+//--------------------------------------------------
+std::size_t ofAssetPack::find(ofStringView name) const{
+	std::size_t first = 0;
+	std::size_t count = numEntries;
+	while(count > 0){
+		auto step = count / 2;
+		if(getName(first + step) < name){
+			first += step + 1;
+			count -= step + 1;
+		}else{
+			count = step;
+		}
+	}
+	return first < numEntries && getName(first) == name ? first : ofStringView::npos;
+}
+
+//--------------------------------------------------
+bool ofAssetPack::contains(ofStringView name) const{
+	return find(name) != ofStringView::npos;
+}
+
+//--------------------------------------------------
+bool ofAssetPack::read(ofStringView name, ofBuffer & buffer) const{
+	auto i = find(name);
+	return i != ofStringView::npos && read(i, buffer);
+}
+
+//--------------------------------------------------
+bool ofAssetPack::read(std::size_t i, ofBuffer & buffer) const{
+	auto & entry = entries[i];
+	auto stored = data.getData() + entry.offset;
+	if(entry.compression == uint32_t(ofAssetPackCompression::None)){
+		buffer.set(stored, entry.size);
+		return true;
+	}
+
+	buffer.allocate(entry.size);
+	if(!lz4Decompress(reinterpret_cast<const uint8_t*>(stored), entry.storedSize, reinterpret_cast<uint8_t*>(buffer.getData()), entry.size)){
+		ofLogError("ofAssetPack") << "read(): " << getName(i) << " is corrupt";
+		buffer.clear();
+		return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------
+bool ofAssetPack::create(const std::filesystem::path & directory, const std::filesystem::path & packPath, ofAssetPackCompression compression){
+	ofDirectory dir(directory);
+	if(!dir.isDirectory()){
+		ofLogError("ofAssetPack") << "create(): " << directory << " isn't a directory";
+		return false;
+	}
+	auto listing = dir.scan(true);
+
+	// a pack created before in the same directory isn't packed again
+	auto packAbsolutePath = ofToDataPath(packPath, true);
+	auto packName = ofFilePath::getFileName(packPath);
+	std::vector<std::size_t> files;
+	for(std::size_t i = 0; i < listing.size(); i++){
+		if(!listing.isFile(i)){
+			continue;
+		}
+		if(listing.getName(i) == packName && ofToDataPath(listing.getPath(i), true) == packAbsolutePath){
+			continue;
+		}
+		files.push_back(i);
+	}
+	std::sort(files.begin(), files.end(), [&](std::size_t a, std::size_t b){
+		return listing.getRelativePath(a) < listing.getRelativePath(b);
+	});
+
+	ofFile out(packPath, ofFile::WriteOnly, true);
+	if(!out.is_open()){
+		ofLogError("ofAssetPack") << "create(): couldn't create " << packPath;
+		return false;
+	}
+
+	Header header;
+	memset(&header, 0, sizeof(header));
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	std::vector<Entry> packEntries;
+	std::string packNames;
+	std::vector<uint8_t> compressed;
+	const char padding[packAlignment] = {0};
+	uint64_t offset = sizeof(header);
+	for(auto i: files){
+		auto name = listing.getRelativePath(i);
+		if(packNames.size() + name.size() > std::numeric_limits<uint32_t>::max()){
+			ofLogError("ofAssetPack") << "create(): too many files in " << directory;
+			return false;
+		}
+
+		ofBuffer contents;
+		if(listing.getSize(i) > 0 && !contents.map(listing.getPath(i))){
+			ofFile file(listing.getPath(i), ofFile::ReadOnly, true);
+			contents = ofBuffer(file, listing.getSize(i) + 1);
+		}
+
+		Entry entry;
+		memset(&entry, 0, sizeof(entry));
+		entry.offset = offset;
+		entry.size = contents.size();
+		entry.storedSize = contents.size();
+		entry.nameOffset = uint32_t(packNames.size());
+		entry.nameLength = uint32_t(name.size());
+		entry.compression = uint32_t(ofAssetPackCompression::None);
+		const char * stored = contents.getData();
+
+		if(compression == ofAssetPackCompression::LZ4 && contents.size() > 0){
+			compressed.resize(lz4CompressBound(contents.size()));
+			auto compressedSize = lz4Compress(reinterpret_cast<const uint8_t*>(contents.getData()), contents.size(), compressed.data());
+			// already compressed formats are stored as they are so they
+			// don't have to be decompressed when read
+			if(compressedSize < contents.size() - contents.size() / 10){
+				entry.storedSize = compressedSize;
+				entry.compression = uint32_t(ofAssetPackCompression::LZ4);
+				stored = reinterpret_cast<const char*>(compressed.data());
+			}
+		}
+
+		out.write(stored, entry.storedSize);
+		offset += entry.storedSize;
+		auto aligned = alignOffset(offset);
+		out.write(padding, aligned - offset);
+		offset = aligned;
+
+		packEntries.push_back(entry);
+		packNames.append(name.data(), name.size());
+	}
+
+	memcpy(header.magic, packMagic, sizeof(packMagic));
+	header.version = packVersion;
+	header.numEntries = uint32_t(packEntries.size());
+	header.indexOffset = offset;
+	header.namesOffset = offset + packEntries.size() * sizeof(Entry);
+	header.namesSize = packNames.size();
+	out.write(reinterpret_cast<const char*>(packEntries.data()), packEntries.size() * sizeof(Entry));
+	out.write(packNames.data(), packNames.size());
+	out.seekp(0);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.close();
+	if(out.fail()){
+		ofLogError("ofAssetPack") << "create(): couldn't write " << packPath;
+		return false;
+	}
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------
+// -- mounted packs
+//------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------
+
+namespace{
+	// lexically resolves . and .. and uses / as separator so paths to the
+	// same file given in different ways can be compared
+	std::string normalizePath(std::string path){
+		std::replace(path.begin(), path.end(), '\\', '/');
+		bool absolute = !path.empty() && path[0] == '/';
+		std::vector<ofStringView> parts;
+		for(auto part: ofSplitStringView(path, "/", true)){
+			if(part == "."){
+				continue;
+			}
+			if(part == ".." && !parts.empty() && parts.back() != ".."){
+				parts.pop_back();
+			}else{
+				parts.push_back(part);
+			}
+		}
+		std::string normalized = absolute ? "/" : "";
+		for(auto & part: parts){
+			normalized.append(part.data(), part.size());
+			normalized += '/';
+		}
+		if(!parts.empty()){
+			normalized.pop_back();
+		}
+		return normalized;
+	}
+
+	std::string directoryPrefix(std::string path){
+		path = normalizePath(path);
+		if(!path.empty() && path.back() != '/'){
+			path += '/';
+		}
+		return path;
+	}
+
+	struct Mount{
+		std::shared_ptr<ofAssetPack> pack;
+		std::string packPath;
+		// relative paths are compared with the mount point relative to the
+		// working directory and absolute paths with its absolute form, and
+		// if it's in a symbolic link, its canonical form
+		std::string relativeRoot;
+		std::string absoluteRoot;
+		std::string canonicalRoot;
+	};
+
+	typedef std::vector<Mount> Mounts;
+
+	class MountedPacks{
+	public:
+		std::shared_ptr<const Mounts> get(){
+			if(empty){
+				return nullptr;
+			}
+			ofCoreLock lock(mutex);
+			return mounts;
+		}
+
+		void set(std::shared_ptr<const Mounts> newMounts){
+			ofCoreLock lock(mutex);
+			mounts = newMounts;
+			empty = mounts->empty();
+		}
+
+	private:
+		ofCoreMutex mutex;
+#ifdef TARGET_NO_THREADS
+		bool empty = true;
+#else
+		std::atomic<bool> empty{true};
+#endif
+		std::shared_ptr<const Mounts> mounts = std::make_shared<Mounts>();
+	};
+
+	MountedPacks & mountedPacks(){
+		static MountedPacks * packs = new MountedPacks;
+		return *packs;
+	}
+
+	// mounts only change from the main thread, readers get a snapshot so
+	// packs unmounted while a loader thread reads them stay mapped
+	Mounts copyMounts(){
+		auto mounts = mountedPacks().get();
+		return mounts ? *mounts : Mounts();
+	}
+
+	const ofAssetPack * findInMountedPacks(const Mounts & mounts, const std::filesystem::path & path, std::string & name){
+		auto absolute = path.is_absolute();
+		auto normalized = normalizePath(absolute ? path.string() : ofToDataPath(path));
+		for(auto mount = mounts.rbegin(); mount != mounts.rend(); ++mount){
+			const std::string * roots[] = {&mount->relativeRoot, nullptr};
+			if(absolute){
+				roots[0] = &mount->absoluteRoot;
+				roots[1] = &mount->canonicalRoot;
+			}
+			for(auto root: roots){
+				if(root && ofStringView(normalized).startsWith(*root)){
+					name = normalized.substr(root->size());
+					if(mount->pack->contains(name)){
+						return mount->pack.get();
+					}
+				}
+			}
+		}
+		return nullptr;
+	}
+}
+
+//--------------------------------------------------
+bool ofMountAssetPack(const std::filesystem::path & packPath, const std::filesystem::path & mountPoint){
+	auto pack = std::make_shared<ofAssetPack>();
+	if(!pack->open(packPath)){
+		return false;
+	}
+
+	Mount mount;
+	mount.pack = pack;
+	mount.packPath = normalizePath(ofToDataPath(packPath, true));
+	mount.relativeRoot = directoryPrefix(ofToDataPath(mountPoint));
+	mount.absoluteRoot = directoryPrefix(std::filesystem::absolute(ofToDataPath(mountPoint)).string());
+	mount.canonicalRoot = directoryPrefix(ofToDataPath(mountPoint, true));
+
+	auto mounts = copyMounts();
+	mounts.erase(std::remove_if(mounts.begin(), mounts.end(), [&](const Mount & mounted){
+		return mounted.packPath == mount.packPath;
+	}), mounts.end());
+	mounts.push_back(mount);
+	mountedPacks().set(std::make_shared<Mounts>(std::move(mounts)));
+	return true;
+}
+
+//--------------------------------------------------
+void ofUnmountAssetPack(const std::filesystem::path & packPath){
+	auto path = normalizePath(ofToDataPath(packPath, true));
+	auto mounts = copyMounts();
+	mounts.erase(std::remove_if(mounts.begin(), mounts.end(), [&](const Mount & mounted){
+		return mounted.packPath == path;
+	}), mounts.end());
+	mountedPacks().set(std::make_shared<Mounts>(std::move(mounts)));
+}
+
+//--------------------------------------------------
+void ofUnmountAllAssetPacks(){
+	mountedPacks().set(std::make_shared<Mounts>());
+}
+
+//--------------------------------------------------
+bool ofIsInMountedAssetPack(const std::filesystem::path & path){
+	auto mounts = mountedPacks().get();
+	std::string name;
+	return mounts && findInMountedPacks(*mounts, path, name);
+}
+
+//--------------------------------------------------
+bool ofReadFromMountedAssetPack(const std::filesystem::path & path, ofBuffer & buffer){
+	auto mounts = mountedPacks().get();
+	if(!mounts){
+		return false;
+	}
+	std::string name;
+	auto pack = findInMountedPacks(*mounts, path, name);
+	return pack && pack->read(name, buffer);
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofFileUtils.h"
+
+/// How the files in an ofAssetPack are stored.
+enum class ofAssetPackCompression{
+	/// Stored as they are.
+	None,
+	/// Compressed with the LZ4 block format, which decompresses faster than
+	/// the files can be read from most disks. Files that don't get at least
+	/// 10% smaller, like png, jpg or mp3, are stored without compression.
+	LZ4,
+};
+
+/// \class ofAssetPack
+///
+/// A read only archive of files, memory mapped and looked up through a
+/// sorted index.
+///
+/// Apps with thousands of small assets spend a good part of their startup
+/// opening and checking files. Packing them into a single file replaces
+/// all of that with one mapping, and the pages of the files that are never
+/// used aren't even read from disk.
+///
+/// Packs are created with ofAssetPack::create() or the assetPacker tool in
+/// apps/devApps, and mounted into the data folder with ofMountAssetPack(),
+/// after which ofBufferFromFile, ofLoadImage, ofTrueTypeFont::load,
+/// ofMesh::load and the asynchronous loaders read from the pack any file
+/// it contains.
+///
+/// The pack starts with a 64 byte header followed by the contents of the
+/// files, each aligned to 64 bytes, and ends with the index: one fixed
+/// size record per file sorted by name and the names themselves.
+class ofAssetPack{
+public:
+	ofAssetPack();
+
+	/// \brief Map a pack file.
+	/// \returns false if the file doesn't exist or isn't a valid pack.
+	bool open(const std::filesystem::path & path);
+	void close();
+	bool isOpen() const;
+
+	/// \returns the number of files in the pack.
+	std::size_t size() const;
+
+	/// \returns the name of file i, its path relative to the directory it
+	/// was packed from using / as separator, ie. "images/logo.png". Files
+	/// are sorted by name.
+	ofStringView getName(std::size_t i) const;
+
+	/// \returns the size of file i once read.
+	uint64_t getSize(std::size_t i) const;
+
+	/// \returns how file i is stored in the pack.
+	ofAssetPackCompression getCompression(std::size_t i) const;
+
+	/// \returns true if the pack has a file with this name.
+	bool contains(ofStringView name) const;
+
+	/// \brief Read a file from the pack, decompressing it if needed.
+	/// \returns false if there's no such file or its contents are corrupt.
+	bool read(ofStringView name, ofBuffer & buffer) const;
+	bool read(std::size_t i, ofBuffer & buffer) const;
+
+	/// \brief Pack every file in a directory and its subdirectories.
+	///
+	/// Hidden files are skipped.
+	///
+	/// \param directory Directory to pack, relative to the data folder.
+	/// \param packPath File to create, relative to the data folder.
+	/// \param compression How to store the files.
+	/// \returns false if the directory can't be read or the pack written.
+	static bool create(const std::filesystem::path & directory, const std::filesystem::path & packPath, ofAssetPackCompression compression = ofAssetPackCompression::LZ4);
+
+private:
+	ofAssetPack(const ofAssetPack &) = delete;
+	ofAssetPack & operator=(const ofAssetPack &) = delete;
+
+	struct Header;
+	struct Entry;
+	std::size_t find(ofStringView name) const;
+
+	ofBuffer data;
+	const Entry * entries;
+	const char * names;
+	std::size_t numEntries;
+};
+
+/// \brief Mount a pack so its files are read as if they were in the data
+/// folder.
+///
+/// Packs mounted later take precedence over earlier ones and both over
+/// the files on disk. Mounting a pack again moves it to the new mount
+/// point.
+///
+/// \param packPath Pack file, relative to the data folder.
+/// \param mountPoint Folder, relative to the data folder, the files in the
+/// pack appear in. By default the data folder itself.
+/// \returns false if the pack can't be opened.
+bool ofMountAssetPack(const std::filesystem::path & packPath, const std::filesystem::path & mountPoint = "");
+
+/// \brief Unmount a pack mounted with ofMountAssetPack().
+void ofUnmountAssetPack(const std::filesystem::path & packPath);
+
+/// \brief Unmount all the mounted packs.
+void ofUnmountAllAssetPacks();
+
+/// \returns true if a mounted pack contains the file at path.
+bool ofIsInMountedAssetPack(const std::filesystem::path & path);
+
+/// \brief Read a file from the mounted packs.
+///
+/// Loaders call this before reading a file from disk, it returns
+/// immediately if no pack is mounted.
+///
+/// \param path File to read, relative to the data folder or absolute.
+/// \param buffer Receives the contents of the file.
+/// \returns false if no mounted pack contains the file.
+bool ofReadFromMountedAssetPack(const std::filesystem::path & path, ofBuffer & buffer);
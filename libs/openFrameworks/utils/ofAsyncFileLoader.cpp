@@ -0,0 +1,285 @@
+#include "ofAsyncFileLoader.h"
+#include "ofAssetPack.h"
+#include "ofEvents.h"
+#include "ofLog.h"
+#include "ofThreadPool.h"
+#include <atomic>
+#include <map>
+#include <unordered_map>
+
+#ifndef TARGET_NO_THREADS
+#include <thread>
+#include <condition_variable>
+#endif
+
+namespace{
+struct FileRequest{
+	ofFileLoadResult result;
+	std::function<bool(const std::filesystem::path &)> load;
+	std::function<void(const ofFileLoadResult &)> done;
+	std::pair<int, uint64_t> order; // -priority, sequence: the queue's key
+	bool queued = true;
+	std::atomic<bool> cancelled{false};
+};
+
+void runRequest(FileRequest & request){
+	try{
+		request.result.loaded = request.load(request.result.path);
+		if(!request.result.loaded){
+			request.result.error = "couldn't load " + request.result.path.string();
+		}
+	}catch(std::exception & e){
+		request.result.loaded = false;
+		request.result.error = e.what();
+	}catch(...){
+		request.result.loaded = false;
+		request.result.error = "unknown error loading " + request.result.path.string();
+	}
+	// the loader is done with it, release what it captured in its thread
+	request.load = nullptr;
+}
+}
+
+class ofAsyncFileLoader{
+public:
+	ofAsyncFileLoader()
+	:nextId(0)
+	,nextSequence(0)
+	,numThreads(2)
+	,running(false)
+	,listening(false){}
+
+	int push(const std::filesystem::path & path, std::function<bool(const std::filesystem::path &)> load, std::function<void(const ofFileLoadResult &)> done, int priority){
+		auto request = std::make_shared<FileRequest>();
+		request->result.path = path;
+		request->load = std::move(load);
+		request->done = std::move(done);
+		if(!listening){
+			ofAddListener(ofEvents().update, this, &ofAsyncFileLoader::update);
+			listening = true;
+		}
+#ifdef TARGET_NO_THREADS
+		request->result.id = nextId++;
+		request->queued = false;
+		runRequest(*request);
+		requests[request->result.id] = request;
+		completed.push_back(request);
+#else
+		{
+			ofCoreLock lock(mutex);
+			request->result.id = nextId++;
+			request->order = std::make_pair(-priority, nextSequence++);
+			queue[request->order] = request;
+			requests[request->result.id] = request;
+			startThreads();
+		}
+		condition.notify_one();
+#endif
+		return request->result.id;
+	}
+
+	void cancel(int id){
+		ofCoreLock lock(mutex);
+		auto it = requests.find(id);
+		if(it == requests.end()){
+			return;
+		}
+		auto request = it->second;
+		request->cancelled = true;
+		if(request->queued){
+			queue.erase(request->order);
+		}
+		requests.erase(it);
+	}
+
+	void cancelAll(){
+		ofCoreLock lock(mutex);
+		for(auto & request: requests){
+			request.second->cancelled = true;
+		}
+		queue.clear();
+		requests.clear();
+	}
+
+	void setPriority(int id, int priority){
+		ofCoreLock lock(mutex);
+		auto it = requests.find(id);
+		if(it == requests.end() || !it->second->queued){
+			return;
+		}
+		auto request = it->second;
+		queue.erase(request->order);
+		request->order.first = -priority;
+		queue[request->order] = request;
+	}
+
+	size_t size(){
+		ofCoreLock lock(mutex);
+		return requests.size();
+	}
+
+	void setNumThreads(size_t n){
+		stopThreads();
+		ofCoreLock lock(mutex);
+		numThreads = std::max<size_t>(n, 1);
+#ifndef TARGET_NO_THREADS
+		if(!queue.empty()){
+			startThreads();
+		}
+#endif
+	}
+
+	void stop(){
+		cancelAll();
+		stopThreads();
+	}
+
+private:
+#ifdef TARGET_NO_THREADS
+	void stopThreads(){}
+#else
+	// has to be called with the mutex locked
+	void startThreads(){
+		if(running){
+			return;
+		}
+		running = true;
+		for(size_t i = 0; i < numThreads; i++){
+			threads.emplace_back(&ofAsyncFileLoader::threadedFunction, this);
+		}
+	}
+
+	void stopThreads(){
+		{
+			ofCoreLock lock(mutex);
+			running = false;
+		}
+		condition.notify_all();
+		for(auto & thread: threads){
+			thread.join();
+		}
+		threads.clear();
+	}
+
+	void threadedFunction(){
+		while(true){
+			std::shared_ptr<FileRequest> request;
+			{
+				ofCoreLock lock(mutex);
+				condition.wait(lock, [this]{ return !running || !queue.empty(); });
+				if(!running){
+					return;
+				}
+				request = queue.begin()->second;
+				queue.erase(queue.begin());
+				request->queued = false;
+			}
+			if(!request->cancelled){
+				runRequest(*request);
+			}
+			ofCoreLock lock(mutex);
+			if(!request->cancelled){
+				completed.push_back(request);
+			}
+		}
+	}
+#endif
+
+	void update(ofEventArgs &){
+		std::vector<std::shared_ptr<FileRequest>> finished;
+		{
+			ofCoreLock lock(mutex);
+			std::swap(finished, completed);
+		}
+		for(auto & request: finished){
+			// a previous callback might have cancelled this one
+			if(request->cancelled){
+				continue;
+			}
+			{
+				ofCoreLock lock(mutex);
+				requests.erase(request->result.id);
+			}
+			try{
+				request->done(request->result);
+			}catch(std::exception & e){
+				ofLogError("ofAsyncFileLoader") << "exception in callback for " << request->result.path << ": " << e.what();
+			}
+		}
+	}
+
+	int nextId;
+	uint64_t nextSequence;
+	size_t numThreads;
+	bool running;
+	bool listening;
+	std::map<std::pair<int, uint64_t>, std::shared_ptr<FileRequest>> queue;
+	std::unordered_map<int, std::shared_ptr<FileRequest>> requests;
+	std::vector<std::shared_ptr<FileRequest>> completed;
+	ofCoreMutex mutex;
+#ifndef TARGET_NO_THREADS
+	std::condition_variable condition;
+	std::vector<std::thread> threads;
+#endif
+};
+
+static bool initialized = false;
+static ofAsyncFileLoader & getAsyncFileLoader(){
+	static ofAsyncFileLoader * loader = new ofAsyncFileLoader;
+	initialized = true;
+	return *loader;
+}
+
+//--------------------------------------------------
+int ofLoadFileAsync(const std::filesystem::path & path, std::function<bool(const std::filesystem::path &)> load, std::function<void(const ofFileLoadResult &)> done, int priority){
+	return getAsyncFileLoader().push(path, std::move(load), std::move(done), priority);
+}
+
+//--------------------------------------------------
+int ofReadFileAsync(const std::filesystem::path & path, std::function<void(ofBuffer &, const ofFileLoadResult &)> done, int priority){
+	auto buffer = std::make_shared<ofBuffer>();
+	return ofLoadFileAsync(path, [buffer](const std::filesystem::path & path){
+		if(ofReadFromMountedAssetPack(path, *buffer)){
+			return true;
+		}
+		if(!ofFile::doesFileExist(path)){
+			return false;
+		}
+		*buffer = ofBufferFromFile(path);
+		return true;
+	}, [buffer, done](const ofFileLoadResult & result){
+		done(*buffer, result);
+	}, priority);
+}
+
+//--------------------------------------------------
+void ofCancelFileRequest(int id){
+	getAsyncFileLoader().cancel(id);
+}
+
+//--------------------------------------------------
+void ofCancelAllFileRequests(){
+	getAsyncFileLoader().cancelAll();
+}
+
+//--------------------------------------------------
+void ofSetFileRequestPriority(int id, int priority){
+	getAsyncFileLoader().setPriority(id, priority);
+}
+
+//--------------------------------------------------
+size_t ofGetNumFileRequests(){
+	return getAsyncFileLoader().size();
+}
+
+//--------------------------------------------------
+void ofSetNumFileLoaderThreads(size_t numThreads){
+	getAsyncFileLoader().setNumThreads(numThreads);
+}
+
+//--------------------------------------------------
+void ofAsyncFileLoaderShutdown(){
+	if(initialized){
+		getAsyncFileLoader().stop();
+	}
+}
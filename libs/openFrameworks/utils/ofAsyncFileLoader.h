@@ -0,0 +1,77 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofFileUtils.h"
+#include <functional>
+
+/// \brief Outcome of an asynchronous file request, passed to its callback.
+struct ofFileLoadResult{
+	int id = 0; ///< id returned when the request was made
+	std::filesystem::path path; ///< file that was requested
+	bool loaded = false; ///< false if the file couldn't be read or decoded
+	std::string error; ///< reason of the failure, empty if loaded
+};
+
+/// \brief Load something from a file without blocking the calling thread.
+///
+/// \p load runs in one of the file loader threads and \p done is called
+/// from the main thread during the next ofEvents().update after \p load
+/// finishes, so it's safe to upload textures or modify the app's state
+/// from it. ofReadFileAsync, ofLoadImageAsync and ofLoadMeshAsync are
+/// built on this, use it directly to load other kinds of files:
+///
+/// ~~~~{.cpp}
+/// auto json = std::make_shared<ofJson>();
+/// ofLoadFileAsync("settings.json", [json](const std::filesystem::path & path){
+///     *json = ofLoadJson(path);
+///     return !json->is_null();
+/// }, [json, this](const ofFileLoadResult & result){
+///     if(result.loaded) settings = *json;
+/// });
+/// ~~~~
+///
+/// Requests with higher priority are started first, requests with the same
+/// priority in the order they were made. On platforms without threads
+/// \p load runs immediately but \p done is still delayed until the next
+/// update.
+///
+/// \param path File to load, passed to \p load.
+/// \param load Loads the file, returns false or throws on failure.
+/// \param done Called on the main thread with the result unless the
+/// request is cancelled first.
+/// \param priority Higher priorities are loaded first.
+/// \returns The id of the request, to cancel it or change its priority.
+int ofLoadFileAsync(const std::filesystem::path & path, std::function<bool(const std::filesystem::path & path)> load, std::function<void(const ofFileLoadResult & result)> done, int priority = 0);
+
+/// \brief Read a whole file into a buffer without blocking.
+///
+/// The asynchronous version of ofBufferFromFile. \p done receives the
+/// buffer, which can be moved out of the callback to keep it.
+///
+/// \param path File to read.
+/// \param done Called on the main thread with the contents of the file.
+/// \param priority Higher priorities are loaded first.
+/// \returns The id of the request.
+int ofReadFileAsync(const std::filesystem::path & path, std::function<void(ofBuffer & buffer, const ofFileLoadResult & result)> done, int priority = 0);
+
+/// \brief Cancel a request made with any of the asynchronous load functions.
+///
+/// Once cancelled its callback is never called. Requests that haven't
+/// started yet are removed from the queue, the result of requests already
+/// loading is discarded when they finish.
+void ofCancelFileRequest(int id);
+
+/// \brief Cancel every pending asynchronous file request.
+void ofCancelAllFileRequests();
+
+/// \brief Change the priority of a request that hasn't started loading yet.
+void ofSetFileRequestPriority(int id, int priority);
+
+/// \returns The number of requests whose callback hasn't been called yet.
+size_t ofGetNumFileRequests();
+
+/// \brief Set how many threads load files, 2 by default.
+///
+/// Loading is mostly waiting on the disk but decoding images or parsing
+/// meshes is CPU bound, more threads help when loading many small files.
+void ofSetNumFileLoaderThreads(size_t numThreads);
@@ -2,9 +2,17 @@
 #ifndef TARGET_WIN32
 	#include <pwd.h>
 	#include <sys/stat.h>
+	#include <sys/mman.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <dirent.h>
 #endif
 
 #include "ofUtils.h"
+#include "ofThreadPool.h"
+#include "ofAssetPack.h"
+#include <limits>
+#include <numeric>
 
 
 #ifdef TARGET_OSX
@@ -19,11 +27,114 @@
 //------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------
 
+//--------------------------------------------------
+// a read only file mapped copy on write, so writing to the buffer never
+// changes the file
+struct ofBuffer::Mapping{
+	char * data = nullptr;
+	size_t size = 0;
+
+	bool map(const std::filesystem::path & path){
+#ifdef TARGET_WIN32
+		HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if(file == INVALID_HANDLE_VALUE){
+			return false;
+		}
+		LARGE_INTEGER fileSize;
+		if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0 || uint64_t(fileSize.QuadPart) > std::numeric_limits<size_t>::max()){
+			CloseHandle(file);
+			return false;
+		}
+		HANDLE fileMapping = CreateFileMapping(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+		CloseHandle(file);
+		if(!fileMapping){
+			return false;
+		}
+		// the view keeps the file mapped after closing the handles
+		data = static_cast<char*>(MapViewOfFile(fileMapping, FILE_MAP_COPY, 0, 0, 0));
+		CloseHandle(fileMapping);
+		if(!data){
+			return false;
+		}
+		size = fileSize.QuadPart;
+		return true;
+#else
+		int fd = open(path.string().c_str(), O_RDONLY);
+		if(fd == -1){
+			return false;
+		}
+		struct stat fileStat;
+		if(fstat(fd, &fileStat) == -1 || fileStat.st_size <= 0 || uint64_t(fileStat.st_size) > std::numeric_limits<size_t>::max()){
+			close(fd);
+			return false;
+		}
+		// the mapping keeps the file open after closing the descriptor
+		void * mapped = mmap(nullptr, fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if(mapped == MAP_FAILED){
+			return false;
+		}
+		data = static_cast<char*>(mapped);
+		size = fileStat.st_size;
+		return true;
+#endif
+	}
+
+	~Mapping(){
+		if(data){
+#ifdef TARGET_WIN32
+			UnmapViewOfFile(data);
+#else
+			munmap(data, size);
+#endif
+		}
+	}
+};
+
 //--------------------------------------------------
 ofBuffer::ofBuffer()
 :currentLine(end(),end()){
 }
 
+//--------------------------------------------------
+ofBuffer::~ofBuffer(){
+}
+
+//--------------------------------------------------
+ofBuffer::ofBuffer(const ofBuffer & other)
+:buffer(other.begin(), other.end())
+,currentLine(end(),end()){
+}
+
+//--------------------------------------------------
+ofBuffer & ofBuffer::operator=(const ofBuffer & other){
+	if(this != &other){
+		set(other.getData(), other.size());
+		currentLine = Line(end(),end());
+	}
+	return *this;
+}
+
+//--------------------------------------------------
+ofBuffer::ofBuffer(ofBuffer && other)
+:buffer(std::move(other.buffer))
+,mapping(std::move(other.mapping))
+,currentLine(end(),end()){
+	other.currentLine = Line(other.end(),other.end());
+}
+
+//--------------------------------------------------
+ofBuffer & ofBuffer::operator=(ofBuffer && other){
+	if(this != &other){
+		buffer = std::move(other.buffer);
+		mapping = std::move(other.mapping);
+		currentLine = Line(end(),end());
+		other.buffer.clear();
+		other.currentLine = Line(other.end(),other.end());
+	}
+	return *this;
+}
+
 //--------------------------------------------------
 ofBuffer::ofBuffer(const char * _buffer, std::size_t size)
 :buffer(_buffer,_buffer+size)
@@ -38,6 +149,7 @@ ofBuffer::ofBuffer(istream & stream, size_t ioBlockSize)
 
 //--------------------------------------------------
 bool ofBuffer::set(istream & stream, size_t ioBlockSize){
+	unmap(false);
 	if(stream.bad()){
 		clear();
 		return false;
@@ -45,17 +157,45 @@ bool ofBuffer::set(istream & stream, size_t ioBlockSize){
 		buffer.clear();
 	}
 
-	vector<char> aux_buffer(ioBlockSize);
+	size_t size = 0;
 	while(stream.good()){
-		stream.read(&aux_buffer[0], ioBlockSize);
-		append(aux_buffer.data(), stream.gcount());
+		buffer.resize(size + ioBlockSize);
+		stream.read(buffer.data() + size, ioBlockSize);
+		size += stream.gcount();
+	}
+	buffer.resize(size);
+	return true;
+}
+
+//--------------------------------------------------
+bool ofBuffer::map(const std::filesystem::path & path){
+	clear();
+	std::unique_ptr<Mapping> newMapping(new Mapping);
+	if(!newMapping->map(ofToDataPath(path, true))){
+		return false;
 	}
+	mapping = std::move(newMapping);
 	return true;
 }
 
+//--------------------------------------------------
+bool ofBuffer::isMapped() const{
+	return mapping != nullptr;
+}
+
+//--------------------------------------------------
+void ofBuffer::unmap(bool keepData){
+	if(mapping){
+		if(keepData){
+			buffer.assign(mapping->data, mapping->data + mapping->size);
+		}
+		mapping.reset();
+	}
+}
+
 //--------------------------------------------------
 void ofBuffer::setall(char mem){
-	buffer.assign(buffer.size(), mem);
+	std::fill(begin(), end(), mem);
 }
 
 //--------------------------------------------------
@@ -63,12 +203,13 @@ bool ofBuffer::writeTo(ostream & stream) const {
 	if(stream.bad()){
 		return false;
 	}
-	stream.write(buffer.data(), buffer.size());
+	stream.write(getData(), size());
 	return stream.good();
 }
 
 //--------------------------------------------------
 void ofBuffer::set(const char * _buffer, std::size_t _size){
+	unmap(false);
 	buffer.assign(_buffer, _buffer+_size);
 }
 
@@ -84,16 +225,19 @@ void ofBuffer::append(const string& _buffer){
 
 //--------------------------------------------------
 void ofBuffer::append(const char * _buffer, std::size_t _size){
+	unmap(true);
 	buffer.insert(buffer.end(), _buffer, _buffer + _size);
 }
 
 //--------------------------------------------------
 void ofBuffer::reserve(size_t size){
+	unmap(true);
 	buffer.reserve(size);
 }
 
 //--------------------------------------------------
 void ofBuffer::clear(){
+	unmap(false);
 	buffer.clear();
 }
 
@@ -104,18 +248,19 @@ void ofBuffer::allocate(std::size_t _size){
 
 //--------------------------------------------------
 void ofBuffer::resize(std::size_t _size){
+	unmap(true);
 	buffer.resize(_size);
 }
 
 
 //--------------------------------------------------
 char * ofBuffer::getData(){
-	return buffer.data();
+	return mapping ? mapping->data : buffer.data();
 }
 
 //--------------------------------------------------
 const char * ofBuffer::getData() const{
-	return buffer.data();
+	return mapping ? mapping->data : buffer.data();
 }
 
 //--------------------------------------------------
@@ -130,10 +275,15 @@ const char * ofBuffer::getBinaryBuffer() const {
 
 //--------------------------------------------------
 string ofBuffer::getText() const {
-	if(buffer.empty()){
+	if(size() == 0){
 		return "";
 	}
-	return std::string(buffer.begin(), buffer.end());
+	return std::string(begin(), end());
+}
+
+//--------------------------------------------------
+ofStringView ofBuffer::getTextView() const {
+	return ofStringView(getData(), size());
 }
 
 //--------------------------------------------------
@@ -149,7 +299,7 @@ ofBuffer & ofBuffer::operator=(const string & text){
 
 //--------------------------------------------------
 std::size_t ofBuffer::size() const {
-	return buffer.size();
+	return mapping ? mapping->size : buffer.size();
 }
 
 //--------------------------------------------------
@@ -179,47 +329,47 @@ void ofBuffer::resetLineReader(){
 }
 
 //--------------------------------------------------
-vector<char>::iterator ofBuffer::begin(){
-	return buffer.begin();
+char * ofBuffer::begin(){
+	return getData();
 }
 
 //--------------------------------------------------
-vector<char>::iterator ofBuffer::end(){
-	return buffer.end();
+char * ofBuffer::end(){
+	return getData() + size();
 }
 
 //--------------------------------------------------
-vector<char>::const_iterator ofBuffer::begin() const{
-	return buffer.begin();
+const char * ofBuffer::begin() const{
+	return getData();
 }
 
 //--------------------------------------------------
-vector<char>::const_iterator ofBuffer::end() const{
-	return buffer.end();
+const char * ofBuffer::end() const{
+	return getData() + size();
 }
 
 //--------------------------------------------------
-vector<char>::reverse_iterator ofBuffer::rbegin(){
-	return buffer.rbegin();
+std::reverse_iterator<char*> ofBuffer::rbegin(){
+	return std::reverse_iterator<char*>(end());
 }
 
 //--------------------------------------------------
-vector<char>::reverse_iterator ofBuffer::rend(){
-	return buffer.rend();
+std::reverse_iterator<char*> ofBuffer::rend(){
+	return std::reverse_iterator<char*>(begin());
 }
 
 //--------------------------------------------------
-vector<char>::const_reverse_iterator ofBuffer::rbegin() const{
-	return buffer.rbegin();
+std::reverse_iterator<const char*> ofBuffer::rbegin() const{
+	return std::reverse_iterator<const char*>(end());
 }
 
 //--------------------------------------------------
-vector<char>::const_reverse_iterator ofBuffer::rend() const{
-	return buffer.rend();
+std::reverse_iterator<const char*> ofBuffer::rend() const{
+	return std::reverse_iterator<const char*>(begin());
 }
 
 //--------------------------------------------------
-ofBuffer::Line::Line(vector<char>::iterator _begin, vector<char>::iterator _end)
+ofBuffer::Line::Line(char * _begin, char * _end)
 	:_current(_begin)
 	,_begin(_begin)
 	,_end(_end){
@@ -285,7 +435,7 @@ bool ofBuffer::Line::empty() const{
 
 
 //--------------------------------------------------
-ofBuffer::RLine::RLine(vector<char>::reverse_iterator _rbegin, vector<char>::reverse_iterator _rend)
+ofBuffer::RLine::RLine(std::reverse_iterator<char*> _rbegin, std::reverse_iterator<char*> _rend)
 	:_current(_rbegin)
 	,_rbegin(_rbegin)
 	,_rend(_rend){
@@ -344,10 +494,15 @@ bool ofBuffer::RLine::empty() const{
 }
 
 //--------------------------------------------------
-ofBuffer::Lines::Lines(vector<char>::iterator begin, vector<char>::iterator end)
+ofBuffer::Lines::Lines(char * begin, char * end)
 :_begin(begin)
 ,_end(end){}
 
+//--------------------------------------------------
+ofBuffer::Lines::Lines(vector<char>::iterator begin, vector<char>::iterator end)
+:_begin(begin == end ? nullptr : &*begin)
+,_end(_begin + (end - begin)){}
+
 //--------------------------------------------------
 ofBuffer::Line ofBuffer::Lines::begin(){
 	return Line(_begin,_end);
@@ -360,7 +515,81 @@ ofBuffer::Line ofBuffer::Lines::end(){
 
 
 //--------------------------------------------------
-ofBuffer::RLines::RLines(vector<char>::reverse_iterator rbegin, vector<char>::reverse_iterator rend)
+ofBuffer::LineView::LineView(const char * _begin, const char * _end)
+	:_current(_begin)
+	,_begin(_begin)
+	,_end(_end){
+
+	if(_begin == _end){
+		return;
+	}
+
+	_current = std::find(_begin, _end, '\n');
+	if(_current != _begin && *(_current - 1) == '\r'){
+		line = ofStringView(_begin, _current - 1 - _begin);
+	}else{
+		line = ofStringView(_begin, _current - _begin);
+	}
+	if(_current != _end){
+		_current+=1;
+	}
+}
+
+//--------------------------------------------------
+const ofStringView & ofBuffer::LineView::operator*() const{
+	return line;
+}
+
+//--------------------------------------------------
+const ofStringView * ofBuffer::LineView::operator->() const{
+	return &line;
+}
+
+//--------------------------------------------------
+ofBuffer::LineView & ofBuffer::LineView::operator++(){
+	*this = LineView(_current,_end);
+	return *this;
+}
+
+//--------------------------------------------------
+ofBuffer::LineView ofBuffer::LineView::operator++(int) {
+	LineView tmp(*this);
+	operator++();
+	return tmp;
+}
+
+//--------------------------------------------------
+bool ofBuffer::LineView::operator!=(LineView const& rhs) const{
+	return rhs._begin != _begin || rhs._end != _end;
+}
+
+//--------------------------------------------------
+bool ofBuffer::LineView::operator==(LineView const& rhs) const{
+	return rhs._begin == _begin && rhs._end == _end;
+}
+
+//--------------------------------------------------
+bool ofBuffer::LineView::empty() const{
+	return _begin == _end;
+}
+
+//--------------------------------------------------
+ofBuffer::LineViews::LineViews(const char * begin, const char * end)
+:_begin(begin)
+,_end(end){}
+
+//--------------------------------------------------
+ofBuffer::LineView ofBuffer::LineViews::begin() const{
+	return LineView(_begin,_end);
+}
+
+//--------------------------------------------------
+ofBuffer::LineView ofBuffer::LineViews::end() const{
+	return LineView(_end,_end);
+}
+
+//--------------------------------------------------
+ofBuffer::RLines::RLines(std::reverse_iterator<char*> rbegin, std::reverse_iterator<char*> rend)
 :_rbegin(rbegin)
 ,_rend(rend){}
 
@@ -384,6 +613,11 @@ ofBuffer::RLines ofBuffer::getReverseLines(){
 	return ofBuffer::RLines(rbegin(), rend());
 }
 
+//--------------------------------------------------
+ofBuffer::LineViews ofBuffer::getLineViews() const{
+	return ofBuffer::LineViews(begin(), end());
+}
+
 //--------------------------------------------------
 ostream & operator<<(ostream & ostr, const ofBuffer & buf){
 	buf.writeTo(ostr);
@@ -398,8 +632,26 @@ istream & operator>>(istream & istr, ofBuffer & buf){
 
 //--------------------------------------------------
 ofBuffer ofBufferFromFile(const std::filesystem::path & path, bool binary){
+	ofBuffer packed;
+	if(ofReadFromMountedAssetPack(path, packed)){
+		return packed;
+	}
 	ofFile f(path,ofFile::ReadOnly, binary);
-	return ofBuffer(f);
+	// a block one byte bigger than the file reads it with a single call and
+	// hits the end of the file, text mode on windows can read less
+	return ofBuffer(f, f.exists() ? f.getSize() + 1 : 1024);
+}
+
+//--------------------------------------------------
+ofBuffer ofBufferFromFile(const std::filesystem::path & path, ofBufferLoadMode mode){
+	if(mode == ofBufferLoadMode::Mapped){
+		ofBuffer buffer;
+		if(ofReadFromMountedAssetPack(path, buffer) || buffer.map(path)){
+			return buffer;
+		}
+		ofLogVerbose("ofBuffer") << "ofBufferFromFile(): couldn't map " << path << ", reading it instead";
+	}
+	return ofBufferFromFile(path, true);
 }
 
 //--------------------------------------------------
@@ -1335,19 +1587,28 @@ static bool natural(const ofFile& a, const ofFile& b) {
 	}
 }
 
-//------------------------------------------------------------------------------------------------------------
-static bool byDate(const ofFile& a, const ofFile& b) {
-	auto ta = std::filesystem::last_write_time(a);
-	auto tb = std::filesystem::last_write_time(b);
-	return ta < tb;
-}
-
 //------------------------------------------------------------------------------------------------------------
 void ofDirectory::sortByDate() {
 	if (files.empty() && !myDir.empty()) {
 		listDir();
 	}
-	ofSort(files, byDate);
+	// read each time once instead of twice per comparison
+	vector<std::time_t> times;
+	times.reserve(files.size());
+	for(auto & file: files){
+		times.push_back(std::filesystem::last_write_time(file));
+	}
+	vector<std::size_t> order(files.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b){
+		return times[a] < times[b];
+	});
+	vector<ofFile> sorted;
+	sorted.reserve(files.size());
+	for(auto i: order){
+		sorted.push_back(files[i]);
+	}
+	files = std::move(sorted);
 }
 
 //------------------------------------------------------------------------------------------------------------
@@ -1366,6 +1627,177 @@ ofDirectory ofDirectory::getSorted(){
 	return sorted;
 }
 
+//------------------------------------------------------------------------------------------------------------
+// calls found with the name, type, link flag, size and modification time of
+// every entry in dir without any other access to the filesystem than the
+// one needed to list it, returns false if the directory can't be read
+template<typename Found>
+static bool readDirectory(const std::filesystem::path & dir, bool showHidden, Found found){
+#ifdef TARGET_WIN32
+	// the find functions return the size, time and attributes along with
+	// the names so no file has to be opened
+	WIN32_FIND_DATAW data;
+	HANDLE handle = FindFirstFileExW((dir / "*").wstring().c_str(), FindExInfoBasic, &data, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+	if(handle == INVALID_HANDLE_VALUE){
+		return false;
+	}
+	std::string name;
+	do{
+		auto wname = data.cFileName;
+		if(wname[0] == L'.' && (wname[1] == 0 || (wname[1] == L'.' && wname[2] == 0))){
+			continue;
+		}
+		// hidden as in the file attributes or by the posix convention
+		if(!showHidden && (wname[0] == L'.' || (data.dwFileAttributes & FILE_ATTRIBUTE_HIDDEN))){
+			continue;
+		}
+		int length = WideCharToMultiByte(CP_UTF8, 0, wname, -1, nullptr, 0, nullptr, nullptr);
+		if(length <= 1){
+			continue;
+		}
+		name.resize(length);
+		WideCharToMultiByte(CP_UTF8, 0, wname, -1, &name[0], length, nullptr, nullptr);
+		name.resize(length - 1);
+		bool isDirectory = data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY;
+		bool isLink = data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT;
+		uint64_t size = isDirectory ? 0 : (uint64_t(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+		ULARGE_INTEGER time;
+		time.LowPart = data.ftLastWriteTime.dwLowDateTime;
+		time.HighPart = data.ftLastWriteTime.dwHighDateTime;
+		// from 100ns intervals since 1601 to seconds since 1970
+		int64_t modified = (int64_t(time.QuadPart) - 116444736000000000LL) / 10000000LL;
+		found(ofStringView(name), isDirectory ? ofDirectoryListing::Directory : ofDirectoryListing::File, isLink, size, modified);
+	}while(FindNextFileW(handle, &data));
+	FindClose(handle);
+	return true;
+#else
+	DIR * handle = opendir(dir.string().c_str());
+	if(!handle){
+		return false;
+	}
+	int fd = dirfd(handle);
+	while(auto entry = readdir(handle)){
+		const char * name = entry->d_name;
+		if(name[0] == '.' && (name[1] == 0 || (name[1] == '.' && name[2] == 0))){
+			continue;
+		}
+		if(!showHidden && name[0] == '.'){
+			continue;
+		}
+		struct stat info;
+		if(fstatat(fd, name, &info, AT_SYMLINK_NOFOLLOW) == -1){
+			continue;
+		}
+		bool isLink = S_ISLNK(info.st_mode);
+		if(isLink){
+			// broken links keep the data of the link itself
+			struct stat target;
+			if(fstatat(fd, name, &target, 0) == 0){
+				info = target;
+			}
+		}
+		auto type = S_ISREG(info.st_mode) ? ofDirectoryListing::File : S_ISDIR(info.st_mode) ? ofDirectoryListing::Directory : ofDirectoryListing::Other;
+		uint64_t size = type == ofDirectoryListing::File ? info.st_size : 0;
+		found(ofStringView(name), type, isLink, size, int64_t(info.st_mtime));
+	}
+	closedir(handle);
+	return true;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------
+// the extension as in ofDirectoryListing::getExtension
+static ofStringView getNameExtension(ofStringView name){
+	auto dot = name.size();
+	while(dot > 1 && name[dot - 1] != '.'){
+		dot--;
+	}
+	return dot > 1 ? name.substr(dot) : ofStringView();
+}
+
+//------------------------------------------------------------------------------------------------------------
+ofDirectoryListing ofDirectory::scan(bool recursive) const{
+	ofDirectoryListing listing;
+	listing.root = myDir;
+	if(path().empty() || !std::filesystem::is_directory(myDir)){
+		ofLogError("ofDirectory") << "scan(): source directory does not exist: \"" << myDir << "\"";
+		return listing;
+	}
+
+	bool filterExtensions = !extensions.empty() && !ofContains(extensions, (string)"*");
+	auto allowed = [&](ofStringView name){
+		if(!filterExtensions){
+			return true;
+		}
+		auto extension = getNameExtension(name);
+		return std::any_of(extensions.begin(), extensions.end(), [&](const std::string & allowed){
+			return allowed.size() == extension.size() && std::equal(extension.begin(), extension.end(), allowed.begin(), [](char a, char b){
+				return ::tolower((unsigned char)a) == b;
+			});
+		});
+	};
+
+	// each level of the tree is read in parallel, one directory per task,
+	// and then appended to the listing in the same order every time
+	struct Contents{
+		std::string paths;
+		vector<ofDirectoryListing::Entry> entries;
+		vector<std::string> subdirectories;
+		bool read = false;
+	};
+	vector<std::string> pending(1);
+	while(!pending.empty()){
+		vector<Contents> contents(pending.size());
+		ofParallelFor(0, pending.size(), [&](std::size_t begin, std::size_t end){
+			for(auto i = begin; i < end; i++){
+				auto & prefix = pending[i];
+				auto & dir = contents[i];
+				auto dirPath = prefix.empty() ? myDir : myDir / prefix;
+				dir.read = readDirectory(dirPath, showHidden, [&](ofStringView name, ofDirectoryListing::Type type, bool isLink, uint64_t size, int64_t modified){
+					if(recursive && type == ofDirectoryListing::Directory && !isLink){
+						dir.subdirectories.push_back(prefix);
+						dir.subdirectories.back().append(name.data(), name.size()).push_back('/');
+					}
+					if(!allowed(name)){
+						return;
+					}
+					ofDirectoryListing::Entry entry;
+					entry.size = size;
+					entry.modified = modified;
+					entry.path = dir.paths.size();
+					entry.pathLength = uint32_t(prefix.size() + name.size());
+					entry.nameOffset = uint32_t(prefix.size());
+					entry.type = type;
+					entry.link = isLink;
+					dir.paths += prefix;
+					dir.paths.append(name.data(), name.size());
+					dir.entries.push_back(entry);
+				});
+			}
+		});
+
+		vector<std::string> next;
+		for(std::size_t i = 0; i < contents.size(); i++){
+			auto & dir = contents[i];
+			if(!dir.read){
+				ofLogWarning("ofDirectory") << "scan(): couldn't read directory \"" << (myDir / pending[i]) << "\"";
+				continue;
+			}
+			auto offset = listing.paths.size();
+			listing.paths += dir.paths;
+			for(auto & entry: dir.entries){
+				entry.path += offset;
+				listing.entries.push_back(entry);
+			}
+			for(auto & subdirectory: dir.subdirectories){
+				next.push_back(std::move(subdirectory));
+			}
+		}
+		pending = std::move(next);
+	}
+	return listing;
+}
+
 //------------------------------------------------------------------------------------------------------------
 std::size_t ofDirectory::size() const{
 	return files.size();
@@ -1514,6 +1946,150 @@ vector<ofFile>::const_reverse_iterator ofDirectory::rend() const{
 }
 
 
+//------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------
+// -- ofDirectoryListing
+//------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------------------------------------
+std::size_t ofDirectoryListing::size() const{
+	return entries.size();
+}
+
+//------------------------------------------------------------------------------------------------------------
+bool ofDirectoryListing::empty() const{
+	return entries.empty();
+}
+
+//------------------------------------------------------------------------------------------------------------
+const std::filesystem::path & ofDirectoryListing::getRoot() const{
+	return root;
+}
+
+//------------------------------------------------------------------------------------------------------------
+ofStringView ofDirectoryListing::getRelativePath(const Entry & entry) const{
+	return ofStringView(paths.data() + entry.path, entry.pathLength);
+}
+
+//------------------------------------------------------------------------------------------------------------
+ofStringView ofDirectoryListing::getRelativePath(std::size_t i) const{
+	return getRelativePath(entries.at(i));
+}
+
+//------------------------------------------------------------------------------------------------------------
+std::filesystem::path ofDirectoryListing::getPath(std::size_t i) const{
+	return root / getRelativePath(i).toString();
+}
+
+//------------------------------------------------------------------------------------------------------------
+ofStringView ofDirectoryListing::getName(std::size_t i) const{
+	return getRelativePath(i).substr(entries[i].nameOffset);
+}
+
+//------------------------------------------------------------------------------------------------------------
+ofStringView ofDirectoryListing::getExtension(std::size_t i) const{
+	return getNameExtension(getName(i));
+}
+
+//------------------------------------------------------------------------------------------------------------
+ofDirectoryListing::Type ofDirectoryListing::getType(std::size_t i) const{
+	return entries.at(i).type;
+}
+
+//------------------------------------------------------------------------------------------------------------
+bool ofDirectoryListing::isFile(std::size_t i) const{
+	return getType(i) == File;
+}
+
+//------------------------------------------------------------------------------------------------------------
+bool ofDirectoryListing::isDirectory(std::size_t i) const{
+	return getType(i) == Directory;
+}
+
+//------------------------------------------------------------------------------------------------------------
+bool ofDirectoryListing::isLink(std::size_t i) const{
+	return entries.at(i).link;
+}
+
+//------------------------------------------------------------------------------------------------------------
+uint64_t ofDirectoryListing::getSize(std::size_t i) const{
+	return entries.at(i).size;
+}
+
+//------------------------------------------------------------------------------------------------------------
+std::time_t ofDirectoryListing::getModified(std::size_t i) const{
+	return std::time_t(entries.at(i).modified);
+}
+
+//------------------------------------------------------------------------------------------------------------
+ofFile ofDirectoryListing::getFile(std::size_t i, ofFile::Mode mode, bool binary) const{
+	return ofFile(getPath(i).string(), mode, binary);
+}
+
+//------------------------------------------------------------------------------------------------------------
+// compares runs of digits by their value and sorts / before anything else
+// so the contents of a directory go together
+static bool naturalLess(ofStringView a, ofStringView b){
+	auto isDigit = [](char c){
+		return c >= '0' && c <= '9';
+	};
+	std::size_t i = 0, j = 0;
+	while(i < a.size() && j < b.size()){
+		if(isDigit(a[i]) && isDigit(b[j])){
+			auto startA = i, startB = j;
+			while(i < a.size() && a[i] == '0') i++;
+			while(j < b.size() && b[j] == '0') j++;
+			auto numberA = i, numberB = j;
+			while(i < a.size() && isDigit(a[i])) i++;
+			while(j < b.size() && isDigit(b[j])) j++;
+			auto lengthA = i - numberA, lengthB = j - numberB;
+			if(lengthA != lengthB){
+				return lengthA < lengthB;
+			}
+			auto cmp = memcmp(a.data() + numberA, b.data() + numberB, lengthA);
+			if(cmp != 0){
+				return cmp < 0;
+			}
+			// same value, less leading zeros first
+			if(numberA - startA != numberB - startB){
+				return numberA - startA < numberB - startB;
+			}
+		}else{
+			unsigned char ca = a[i] == '/' ? 0 : a[i];
+			unsigned char cb = b[j] == '/' ? 0 : b[j];
+			if(ca != cb){
+				return ca < cb;
+			}
+			i++;
+			j++;
+		}
+	}
+	return a.size() - i < b.size() - j;
+}
+
+//------------------------------------------------------------------------------------------------------------
+void ofDirectoryListing::sort(){
+	std::sort(entries.begin(), entries.end(), [this](const Entry & a, const Entry & b){
+		return naturalLess(getRelativePath(a), getRelativePath(b));
+	});
+}
+
+//------------------------------------------------------------------------------------------------------------
+void ofDirectoryListing::sortByDate(){
+	std::stable_sort(entries.begin(), entries.end(), [](const Entry & a, const Entry & b){
+		return a.modified < b.modified;
+	});
+}
+
+//------------------------------------------------------------------------------------------------------------
+void ofDirectoryListing::sortBySize(){
+	std::stable_sort(entries.begin(), entries.end(), [](const Entry & a, const Entry & b){
+		return a.size < b.size;
+	});
+}
+
+
 //------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------
 // -- ofFilePath
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ofConstants.h"
+#include "ofStringView.h"
 #if !_MSC_VER
 #define BOOST_NO_CXX11_SCOPED_ENUMS
 #define BOOST_NO_SCOPED_ENUMS
@@ -14,14 +15,36 @@ namespace std {
 // ofBuffer
 //----------------------------------------------------------
 
+/// How ofBufferFromFile gets the contents of a file.
+enum class ofBufferLoadMode{
+	/// Read the whole file into memory owned by the buffer.
+	Copy,
+	/// Map the file into memory. Pages are only read from disk when they are
+	/// accessed and can be shared with other processes mapping the same file,
+	/// which makes it suitable for files of several GB. Writing to the buffer
+	/// only changes a private copy, never the file.
+	Mapped,
+};
+
 /// \class ofBuffer
 ///
 /// A buffer of data which can be accessed as simple bytes or text.
 ///
+/// The data is either owned by the buffer or a read only file mapped into
+/// memory, see ofBufferLoadMode. Modifying the size of a mapped buffer
+/// copies its contents into memory owned by the buffer first.
+///
 class ofBuffer{
 	
 public:
 	ofBuffer();
+	~ofBuffer();
+
+	/// Copy a buffer, the copy of a mapped buffer owns its data.
+	ofBuffer(const ofBuffer & other);
+	ofBuffer & operator=(const ofBuffer & other);
+	ofBuffer(ofBuffer && other);
+	ofBuffer & operator=(ofBuffer && other);
 	
 	/// Create a buffer and set its contents from a raw byte pointer.
 	///
@@ -52,8 +75,19 @@ public:
 	/// Set contents of the buffer from an input stream.
 	///
 	/// \param stream input stream to copy data from
-	/// \param ioBlockSize the number of bytes to read from the stream in chunks
+	/// \param ioBlockSize the number of bytes to read from the stream in chunks,
+	/// data is read straight into the buffer so a block size bigger than the
+	/// stream reads it all with a single call
 	bool set(istream & stream, size_t ioBlockSize = 1024);
+
+	/// Map a file into memory as the contents of the buffer.
+	///
+	/// \param path file to map
+	/// \returns false if the file couldn't be mapped, the buffer is left empty
+	bool map(const std::filesystem::path & path);
+
+	/// \returns true if the contents of the buffer are a mapped file.
+	bool isMapped() const;
 	
 	/// Set all bytes in the buffer to a given value.
 	///
@@ -118,6 +152,14 @@ public:
 	///
 	/// \returns buffer contents as a string
 	string getText() const;
+
+	/// get the contents of the buffer as a view, without copying them.
+	///
+	/// The view can be split with ofSplitStringView(). It's invalidated by
+	/// any call that changes the size of the buffer.
+	///
+	/// \returns buffer contents as a view
+	ofStringView getTextView() const;
 	
 	/// Use buffer as a string via cast.
 	///
@@ -140,19 +182,27 @@ public:
 	friend ostream & operator<<(ostream & ostr, const ofBuffer & buf);
 	friend istream & operator>>(istream & istr, ofBuffer & buf);
 
-	vector<char>::iterator begin();
-	vector<char>::iterator end();
-	vector<char>::const_iterator begin() const;
-	vector<char>::const_iterator end() const;
-	vector<char>::reverse_iterator rbegin();
-	vector<char>::reverse_iterator rend();
-	vector<char>::const_reverse_iterator rbegin() const;
-	vector<char>::const_reverse_iterator rend() const;
+	/// The iterators are pointers into the data since it can be a mapped
+	/// file, code that named them as vector<char> iterators should use
+	/// these types or auto instead.
+	typedef char * iterator;
+	typedef const char * const_iterator;
+	typedef std::reverse_iterator<char*> reverse_iterator;
+	typedef std::reverse_iterator<const char*> const_reverse_iterator;
+
+	iterator begin();
+	iterator end();
+	const_iterator begin() const;
+	const_iterator end() const;
+	reverse_iterator rbegin();
+	reverse_iterator rend();
+	const_reverse_iterator rbegin() const;
+	const_reverse_iterator rend() const;
 
 	/// A line of text in the buffer.
 	///
 	struct Line: public std::iterator<std::forward_iterator_tag,Line>{
-		Line(vector<char>::iterator _begin, vector<char>::iterator _end);
+		Line(char * _begin, char * _end);
 		const string & operator*() const;
 		const string * operator->() const;
 		const string & asString() const;
@@ -171,13 +221,13 @@ public:
 
 	private:
 		string line;
-		vector<char>::iterator _current, _begin, _end;
+		char * _current, * _begin, * _end;
 	};
 
 	/// A line of text in the buffer.
 	///
 	struct RLine: public std::iterator<std::forward_iterator_tag,Line>{
-		RLine(vector<char>::reverse_iterator _begin, vector<char>::reverse_iterator _end);
+		RLine(std::reverse_iterator<char*> _begin, std::reverse_iterator<char*> _end);
 		const string & operator*() const;
 		const string * operator->() const;
 		const string & asString() const;
@@ -196,13 +246,15 @@ public:
 
 	private:
 		string line;
-		vector<char>::reverse_iterator _current, _rbegin, _rend;
+		std::reverse_iterator<char*> _current, _rbegin, _rend;
 	};
 
 	/// A series of text lines in the buffer.
 	///
 	struct Lines{
-		Lines(vector<char>::iterator begin, vector<char>::iterator end);
+		Lines(char * begin, char * end);
+		OF_DEPRECATED_MSG("ofBuffer iterators are char pointers now, use ofBuffer::iterator",
+			Lines(vector<char>::iterator begin, vector<char>::iterator end));
 		
 		/// Get the first line in the buffer.
 		Line begin();
@@ -214,14 +266,53 @@ public:
 		RLine rend();
 
 	private:
-		vector<char>::iterator _begin, _end;
+		char * _begin, * _end;
+	};
+
+
+	/// A line of text in the buffer as a view of the buffer's contents.
+	///
+	struct LineView: public std::iterator<std::forward_iterator_tag,ofStringView>{
+		LineView(const char * _begin, const char * _end);
+		const ofStringView & operator*() const;
+		const ofStringView * operator->() const;
+
+		/// Increment to the next line.
+		LineView& operator++();
+
+		/// Increment to a number of lines.
+		LineView operator++(int);
+
+		bool operator!=(LineView const& rhs) const;
+		bool operator==(LineView const& rhs) const;
+
+		/// Is this line empty? (aka an empty string "")
+		bool empty() const;
+
+	private:
+		ofStringView line;
+		const char * _current, * _begin, * _end;
 	};
 
+	/// A series of text lines in the buffer as views.
+	///
+	struct LineViews{
+		LineViews(const char * begin, const char * end);
+
+		/// Get the first line in the buffer.
+		LineView begin() const;
+
+		/// Get the last line in the buffer.
+		LineView end() const;
+
+	private:
+		const char * _begin, * _end;
+	};
 
 	/// A series of text lines in the buffer.
 	///
 	struct RLines{
-		RLines(vector<char>::reverse_iterator rbegin, vector<char>::reverse_iterator rend);
+		RLines(std::reverse_iterator<char*> rbegin, std::reverse_iterator<char*> rend);
 
 		/// Get the first line in the buffer.
 		RLine begin();
@@ -230,7 +321,7 @@ public:
 		RLine end();
 
 	private:
-		vector<char>::reverse_iterator _rbegin, _rend;
+		std::reverse_iterator<char*> _rbegin, _rend;
 	};
 
 	/// Access the contents of the buffer as a series of text lines.
@@ -250,21 +341,48 @@ public:
 	/// \returns buffer text lines
 	RLines getReverseLines();
 
+	/// Access the contents of the buffer as a series of text lines without
+	/// copying them.
+	///
+	/// Works like getLines() but each line is a view of the buffer's
+	/// contents instead of a new string, which makes it much faster to parse
+	/// big files. The views are invalidated by any call that changes the size
+	/// of the buffer.
+	///
+	/// \returns buffer text lines as views
+	LineViews getLineViews() const;
+
 private:
+	struct Mapping;
+	void unmap(bool keepData);
+
 	vector<char> 	buffer;
+	std::unique_ptr<Mapping> mapping;
 	Line			currentLine;
 };
 
 //--------------------------------------------------
 /// Read the contents of a file at path into a buffer.
 ///
-/// Opens as a text file by default.
+/// Opens as a text file by default. Files in a mounted asset pack are read
+/// from the pack, see ofMountAssetPack().
 ///
 /// \param path file to open
 /// \param binary set to false if you are reading a text file & want lines
 /// split at endline characters automatically
 ofBuffer ofBufferFromFile(const std::filesystem::path & path, bool binary=true);
 
+//--------------------------------------------------
+/// Read the contents of a file at path into a buffer or map it.
+///
+/// The file is always opened in binary mode. Files in a mounted asset pack
+/// are read from the pack.
+///
+/// \param path file to open
+/// \param mode whether to read the file into memory or map it, if mapping
+/// fails the file is read instead
+ofBuffer ofBufferFromFile(const std::filesystem::path & path, ofBufferLoadMode mode);
+
 //--------------------------------------------------
 /// Write the contents of a buffer to a file at path.
 ///
@@ -803,6 +921,97 @@ private:
 	bool binary;
 };
 
+/// \class ofDirectoryListing
+///
+/// The files and directories found by ofDirectory::scan().
+///
+/// The type, size and modification time of every entry are read once while
+/// scanning and kept in compact fixed size records, with all the paths
+/// stored one after another in a single string. Listings of hundreds of
+/// thousands of files can be sorted and queried without accessing the
+/// filesystem again or allocating per entry.
+///
+/// Paths are relative to the scanned directory and always use / as
+/// separator, ie. "photos/2018/001.jpg".
+///
+class ofDirectoryListing{
+public:
+	enum Type: uint8_t{
+		File,
+		Directory,
+		Other, ///< devices, sockets, pipes or broken links
+	};
+
+	/// \returns the number of entries.
+	std::size_t size() const;
+
+	/// \returns true if there's no entries.
+	bool empty() const;
+
+	/// \returns the directory that was scanned.
+	const std::filesystem::path & getRoot() const;
+
+	/// \returns the path of entry i relative to the scanned directory.
+	ofStringView getRelativePath(std::size_t i) const;
+
+	/// \returns the full path of entry i, the root followed by its
+	/// relative path.
+	std::filesystem::path getPath(std::size_t i) const;
+
+	/// \returns the file or directory name of entry i, ie. "001.jpg".
+	ofStringView getName(std::size_t i) const;
+
+	/// \returns the extension of entry i without the dot, ie. "jpg", or an
+	/// empty view if it doesn't have one.
+	ofStringView getExtension(std::size_t i) const;
+
+	Type getType(std::size_t i) const;
+	bool isFile(std::size_t i) const;
+	bool isDirectory(std::size_t i) const;
+
+	/// \returns true if entry i is a symbolic link, its type, size and time
+	/// are the ones of the file it points to. Links to directories aren't
+	/// followed when scanning recursively.
+	bool isLink(std::size_t i) const;
+
+	/// \returns the size in bytes of entry i, 0 for directories.
+	uint64_t getSize(std::size_t i) const;
+
+	/// \returns the last modification time of entry i.
+	std::time_t getModified(std::size_t i) const;
+
+	/// Open an ofFile instance for entry i.
+	ofFile getFile(std::size_t i, ofFile::Mode mode=ofFile::Reference, bool binary=true) const;
+
+	/// Sort by relative path comparing numbers in names by their value, so
+	/// "frame2.png" goes before "frame10.png".
+	void sort();
+
+	/// Sort by modification time, oldest first.
+	void sortByDate();
+
+	/// Sort by size, smallest first.
+	void sortBySize();
+
+private:
+	friend class ofDirectory;
+	struct Entry{
+		uint64_t size;
+		int64_t modified;
+		std::size_t path;
+		uint32_t pathLength;
+		uint32_t nameOffset;
+		Type type;
+		bool link;
+	};
+
+	ofStringView getRelativePath(const Entry & entry) const;
+
+	std::filesystem::path root;
+	std::string paths;
+	vector<Entry> entries;
+};
+
 /// \class ofDirectory
 ///
 /// Path to a directory. Can be used to query file and directory
@@ -1078,6 +1287,21 @@ public:
 	/// nothing to sort.
 	void sortByDate();
 
+	/// Scan the contents of the directory, and optionally of all its
+	/// subdirectories, reading the type, size and modification time of
+	/// every entry along the way.
+	///
+	/// Subdirectories are read in parallel using the shared thread pool.
+	/// Hidden entries and allowed extensions are filtered while scanning as
+	/// in listDir(), hidden directories aren't scanned.
+	///
+	/// Unlike listDir() this doesn't modify the list of files of this
+	/// instance.
+	///
+	/// \param recursive set to false to only scan this directory
+	/// \returns the entries found, in no particular order
+	ofDirectoryListing scan(bool recursive = true) const;
+
 	/// Get a sorted ofDirectory instance using the current path.
 	///
 	/// \returns sorted ofDirectory instance
@@ -0,0 +1,593 @@
+#include "ofFileWatcher.h"
+#include "ofLog.h"
+#include "ofThreadPool.h"
+#include "ofUtils.h"
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifndef TARGET_NO_THREADS
+#include <thread>
+#include <condition_variable>
+#endif
+
+#ifdef TARGET_LINUX
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+typedef std::chrono::steady_clock Clock;
+
+namespace{
+#ifdef TARGET_LINUX
+	const uint32_t inotifyMask = IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_ONLYDIR;
+#endif
+
+	// the path of a file inside a watched directory, built the same way
+	// when polling and when notified so both can be compared
+	std::string joinPath(const std::string & directory, ofStringView relative){
+		std::string path = directory;
+		path += '/';
+		path.append(relative.data(), relative.size());
+#ifdef TARGET_WIN32
+		std::replace(path.begin(), path.end(), '/', '\\');
+#endif
+		return path;
+	}
+
+	std::string toWatchedPath(const std::filesystem::path & path){
+		auto resolved = ofToDataPath(path.string());
+		while(resolved.size() > 1 && (resolved.back() == '/' || resolved.back() == '\\')){
+			resolved.pop_back();
+		}
+		return resolved;
+	}
+
+	bool isRegularFile(const std::string & path){
+		try{
+			return std::filesystem::is_regular_file(path);
+		}catch(...){
+			return false;
+		}
+	}
+
+	bool isHidden(ofStringView name){
+		return !name.empty() && name[0] == '.';
+	}
+}
+
+struct ofFileWatcher::Impl{
+	struct Registration{
+		std::string path;
+		bool directory;
+		bool recursive;
+		bool polled;
+	};
+
+	struct FileState{
+		uint64_t size;
+		int64_t modified;
+		bool operator!=(const FileState & other) const{
+			return size != other.size || modified != other.modified;
+		}
+	};
+	typedef std::unordered_map<std::string, FileState> Snapshot;
+
+	Impl()
+	:version(0)
+	,running(false)
+	,usePolling(false)
+	,pollingInterval(500)
+	,coalesceTime(100)
+	,lastPoll(Clock::now()){
+#ifdef TARGET_LINUX
+		inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if(inotifyFd == -1 || wakeFd == -1){
+			ofLogWarning("ofFileWatcher") << "couldn't initialize inotify, files will be polled";
+			closeInotify();
+		}
+#endif
+	}
+
+	~Impl(){
+		stop();
+#ifdef TARGET_LINUX
+		closeInotify();
+#endif
+	}
+
+	// reads the current state of the files of a registration
+	void collect(const Registration & registration, Snapshot & state){
+		if(registration.directory){
+			ofDirectory dir(registration.path);
+			auto listing = dir.scan(registration.recursive);
+			for(std::size_t i = 0; i < listing.size(); i++){
+				if(listing.isFile(i)){
+					state[joinPath(registration.path, listing.getRelativePath(i))] = FileState{listing.getSize(i), int64_t(listing.getModified(i))};
+				}
+			}
+		}else{
+			try{
+				if(std::filesystem::is_regular_file(registration.path)){
+					state[registration.path] = FileState{uint64_t(std::filesystem::file_size(registration.path)), int64_t(std::filesystem::last_write_time(registration.path))};
+				}
+			}catch(...){}
+		}
+	}
+
+	void add(Registration registration){
+		Snapshot state;
+		collect(registration, state);
+		for(auto & file: state){
+			known.insert(file.first);
+		}
+#ifdef TARGET_LINUX
+		if(!registration.polled && !addNotifications(registration)){
+			registration.polled = true;
+		}
+#else
+		registration.polled = true;
+#endif
+		{
+			ofCoreLock lock(mutex);
+			registrations.push_back(registration);
+			if(registration.polled){
+				snapshot.insert(state.begin(), state.end());
+			}
+			version++;
+		}
+		start();
+		wake();
+	}
+
+	// forgets everything that was read from the registrations and reads it
+	// again, after removing some. Changes not notified yet are dropped,
+	// they were found against the files known before
+	void reset(){
+		vector<Registration> current;
+		{
+			ofCoreLock lock(mutex);
+			current = registrations;
+			registrations.clear();
+			snapshot.clear();
+			pending.clear();
+			version++;
+		}
+		known.clear();
+#ifdef TARGET_LINUX
+		removeNotifications();
+#endif
+		for(auto & registration: current){
+			registration.polled = usePolling;
+			add(registration);
+		}
+	}
+
+	void remove(const std::string & path){
+		{
+			ofCoreLock lock(mutex);
+			ofRemove(registrations, [&](const Registration & registration){
+				return registration.path == path;
+			});
+		}
+		reset();
+	}
+
+	void clear(){
+		{
+			ofCoreLock lock(mutex);
+			registrations.clear();
+		}
+		reset();
+	}
+
+	bool isPolling(){
+		ofCoreLock lock(mutex);
+		return std::any_of(registrations.begin(), registrations.end(), [](const Registration & registration){
+			return registration.polled;
+		});
+	}
+
+	// has to be called with the mutex locked
+	void changed(const std::string & path, Clock::time_point now){
+		pending[path] = now;
+	}
+
+	// reads the polled registrations and compares them with the last time
+	void poll(){
+		vector<Registration> polled;
+		uint64_t collectedVersion;
+		{
+			ofCoreLock lock(mutex);
+			for(auto & registration: registrations){
+				if(registration.polled){
+					polled.push_back(registration);
+				}
+			}
+			collectedVersion = version;
+		}
+		if(polled.empty()){
+			return;
+		}
+		Snapshot state;
+		for(auto & registration: polled){
+			collect(registration, state);
+		}
+		auto now = Clock::now();
+		ofCoreLock lock(mutex);
+		if(collectedVersion != version){
+			// watched paths changed while reading, compare next time
+			return;
+		}
+		for(auto & file: state){
+			auto previous = snapshot.find(file.first);
+			if(previous == snapshot.end() || previous->second != file.second){
+				changed(file.first, now);
+			}
+		}
+		for(auto & file: snapshot){
+			if(state.find(file.first) == state.end()){
+				changed(file.first, now);
+			}
+		}
+		snapshot = std::move(state);
+	}
+
+	// called from the main thread, returns the files that stopped changing
+	vector<std::string> takeReady(){
+		vector<std::string> ready;
+		auto now = Clock::now();
+		auto wait = std::chrono::milliseconds(coalesceTime.load());
+		ofCoreLock lock(mutex);
+		if(pending.empty()){
+			return ready;
+		}
+		for(auto it = pending.begin(); it != pending.end();){
+			if(now - it->second >= wait){
+				ready.push_back(it->first);
+				it = pending.erase(it);
+			}else{
+				++it;
+			}
+		}
+		return ready;
+	}
+
+#ifdef TARGET_LINUX
+	struct DirectoryWatch{
+		std::string path;
+		bool allFiles = false;
+		bool recursive = false;
+		std::unordered_set<std::string> names;
+	};
+
+	bool addDirectoryWatch(const std::string & path, bool allFiles, bool recursive, const std::string & name){
+		if(inotifyFd == -1){
+			return false;
+		}
+		int wd = inotify_add_watch(inotifyFd, path.c_str(), inotifyMask);
+		if(wd == -1){
+			if(errno == ENOSPC){
+				ofLogWarning("ofFileWatcher") << "out of inotify watches, polling \"" << path << "\". "
+					<< "The limit can be raised with sysctl fs.inotify.max_user_watches";
+			}
+			return false;
+		}
+		ofCoreLock lock(mutex);
+		// the same directory always gets the same watch
+		auto & watch = watches[wd];
+		watch.path = path;
+		watch.allFiles |= allFiles;
+		watch.recursive |= recursive;
+		if(!name.empty()){
+			watch.names.insert(name);
+		}
+		return true;
+	}
+
+	// watches a directory and, if recursive, all its subdirectories
+	bool addDirectoryWatches(const std::string & path, bool recursive){
+		if(!addDirectoryWatch(path, true, recursive, "")){
+			return false;
+		}
+		if(recursive){
+			auto listing = ofDirectory(path).scan(true);
+			for(std::size_t i = 0; i < listing.size(); i++){
+				if(listing.isDirectory(i) && !listing.isLink(i)){
+					if(!addDirectoryWatch(joinPath(path, listing.getRelativePath(i)), true, true, "")){
+						return false;
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	bool addNotifications(const Registration & registration){
+		if(registration.directory){
+			return addDirectoryWatches(registration.path, registration.recursive);
+		}else{
+			std::filesystem::path path(registration.path);
+			auto parent = path.parent_path().string();
+			return addDirectoryWatch(parent.empty() ? "." : parent, false, false, path.filename().string());
+		}
+	}
+
+	void removeNotifications(){
+		ofCoreLock lock(mutex);
+		for(auto & watch: watches){
+			inotify_rm_watch(inotifyFd, watch.first);
+		}
+		watches.clear();
+	}
+
+	void readNotifications(){
+		alignas(inotify_event) char buffer[64 * 1024];
+		vector<std::string> newDirectories;
+		while(true){
+			auto length = read(inotifyFd, buffer, sizeof(buffer));
+			if(length <= 0){
+				break;
+			}
+			auto now = Clock::now();
+			ofCoreLock lock(mutex);
+			for(char * ptr = buffer; ptr < buffer + length;){
+				auto event = reinterpret_cast<inotify_event*>(ptr);
+				ptr += sizeof(inotify_event) + event->len;
+				if(event->mask & IN_Q_OVERFLOW){
+					ofLogWarning("ofFileWatcher") << "too many changes at once, some have been lost";
+					continue;
+				}
+				auto watch = watches.find(event->wd);
+				if(watch == watches.end()){
+					continue;
+				}
+				if(event->mask & IN_IGNORED){
+					watches.erase(watch);
+					continue;
+				}
+				if(event->len == 0){
+					continue;
+				}
+				ofStringView name(event->name);
+				if(event->mask & IN_ISDIR){
+					if(watch->second.recursive && (event->mask & (IN_CREATE | IN_MOVED_TO)) && !isHidden(name)){
+						newDirectories.push_back(joinPath(watch->second.path, name));
+					}
+					continue;
+				}
+				if((watch->second.allFiles && !isHidden(name)) || watch->second.names.count(name.toString())){
+					changed(joinPath(watch->second.path, name), now);
+				}
+			}
+		}
+
+		// files might have been created in new directories before they were
+		// watched, report whatever is in them already
+		for(auto & directory: newDirectories){
+			addDirectoryWatches(directory, true);
+			Snapshot state;
+			collect(Registration{directory, true, true, false}, state);
+			auto now = Clock::now();
+			ofCoreLock lock(mutex);
+			for(auto & file: state){
+				changed(file.first, now);
+			}
+		}
+	}
+
+	void closeInotify(){
+		if(inotifyFd != -1){
+			close(inotifyFd);
+			inotifyFd = -1;
+		}
+		if(wakeFd != -1){
+			close(wakeFd);
+			wakeFd = -1;
+		}
+	}
+
+	int inotifyFd;
+	int wakeFd;
+	std::unordered_map<int, DirectoryWatch> watches;
+#endif
+
+#ifdef TARGET_NO_THREADS
+	void start(){}
+	void stop(){}
+	void wake(){}
+#else
+	void start(){
+		ofCoreLock lock(mutex);
+		if(running){
+			return;
+		}
+		running = true;
+		thread = std::thread(&Impl::threadedFunction, this);
+	}
+
+	void stop(){
+		{
+			ofCoreLock lock(mutex);
+			if(!running){
+				return;
+			}
+			running = false;
+		}
+		wake();
+		thread.join();
+	}
+
+	void wake(){
+		{
+			ofCoreLock lock(mutex);
+			wakeRequested = true;
+		}
+		condition.notify_all();
+#ifdef TARGET_LINUX
+		if(wakeFd != -1){
+			uint64_t one = 1;
+			auto written = write(wakeFd, &one, sizeof(one));
+			(void)written;
+		}
+#endif
+	}
+
+	void threadedFunction(){
+		while(true){
+			bool polling;
+			{
+				ofCoreLock lock(mutex);
+				if(!running){
+					return;
+				}
+				polling = std::any_of(registrations.begin(), registrations.end(), [](const Registration & registration){
+					return registration.polled;
+				});
+			}
+			auto interval = std::chrono::milliseconds(pollingInterval.load());
+			auto untilPoll = std::chrono::duration_cast<std::chrono::milliseconds>(lastPoll + interval - Clock::now());
+			if(polling && untilPoll.count() <= 0){
+				poll();
+				lastPoll = Clock::now();
+				continue;
+			}
+#ifdef TARGET_LINUX
+			if(inotifyFd != -1){
+				pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+				int ready = ::poll(fds, 2, polling ? int(untilPoll.count()) : -1);
+				if(ready > 0 && (fds[1].revents & POLLIN)){
+					uint64_t value;
+					auto readBytes = read(wakeFd, &value, sizeof(value));
+					(void)readBytes;
+				}
+				if(ready > 0 && (fds[0].revents & POLLIN)){
+					readNotifications();
+				}
+				continue;
+			}
+#endif
+			ofCoreLock lock(mutex);
+			auto timeout = polling ? untilPoll : std::chrono::milliseconds(1000 * 60 * 60);
+			condition.wait_for(lock, timeout, [this]{
+				return wakeRequested || !running;
+			});
+			wakeRequested = false;
+		}
+	}
+
+	std::condition_variable condition;
+	std::thread thread;
+	bool wakeRequested = false;
+#endif
+	ofCoreMutex mutex;
+
+	vector<Registration> registrations;
+	Snapshot snapshot;
+	std::unordered_map<std::string, Clock::time_point> pending;
+	uint64_t version;
+	bool running;
+
+	// only used from the main thread
+	std::unordered_set<std::string> known;
+	bool usePolling;
+
+	std::atomic<uint64_t> pollingInterval;
+	std::atomic<uint64_t> coalesceTime;
+	Clock::time_point lastPoll;
+};
+
+//--------------------------------------------------
+ofFileWatcher::ofFileWatcher()
+:impl(new Impl){
+	ofAddListener(ofEvents().update, this, &ofFileWatcher::update);
+}
+
+//--------------------------------------------------
+ofFileWatcher::~ofFileWatcher(){
+	ofRemoveListener(ofEvents().update, this, &ofFileWatcher::update);
+}
+
+//--------------------------------------------------
+void ofFileWatcher::watch(const std::filesystem::path & path, bool recursive){
+	Impl::Registration registration;
+	registration.path = toWatchedPath(path);
+	try{
+		registration.directory = std::filesystem::is_directory(registration.path);
+	}catch(...){
+		registration.directory = false;
+	}
+	registration.recursive = recursive && registration.directory;
+	registration.polled = impl->usePolling;
+	impl->add(registration);
+}
+
+//--------------------------------------------------
+void ofFileWatcher::unwatch(const std::filesystem::path & path){
+	impl->remove(toWatchedPath(path));
+}
+
+//--------------------------------------------------
+void ofFileWatcher::clear(){
+	impl->clear();
+}
+
+//--------------------------------------------------
+void ofFileWatcher::setUsePolling(bool usePolling){
+	if(impl->usePolling != usePolling){
+		impl->usePolling = usePolling;
+		impl->reset();
+	}
+}
+
+//--------------------------------------------------
+bool ofFileWatcher::isPolling() const{
+	return impl->isPolling();
+}
+
+//--------------------------------------------------
+void ofFileWatcher::setPollingInterval(uint64_t milliseconds){
+	impl->pollingInterval = milliseconds;
+	impl->wake();
+}
+
+//--------------------------------------------------
+void ofFileWatcher::setCoalesceTime(uint64_t milliseconds){
+	impl->coalesceTime = milliseconds;
+}
+
+//--------------------------------------------------
+void ofFileWatcher::update(ofEventArgs &){
+#ifdef TARGET_NO_THREADS
+	if(Clock::now() - impl->lastPoll >= std::chrono::milliseconds(impl->pollingInterval.load())){
+		impl->poll();
+		impl->lastPoll = Clock::now();
+	}
+#endif
+	auto ready = impl->takeReady();
+	std::sort(ready.begin(), ready.end());
+	for(auto & path: ready){
+		bool exists = isRegularFile(path);
+		bool wasKnown = impl->known.count(path) > 0;
+		ofFileWatcherEventArgs args;
+		args.path = path;
+		if(exists && wasKnown){
+			args.type = ofFileWatcherEventArgs::Modified;
+		}else if(exists){
+			args.type = ofFileWatcherEventArgs::Created;
+			impl->known.insert(path);
+		}else if(wasKnown){
+			args.type = ofFileWatcherEventArgs::Removed;
+			impl->known.erase(path);
+		}else{
+			// created and removed before notifying
+			continue;
+		}
+		ofNotifyEvent(fileChanged, args, this);
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofEvents.h"
+#include "ofFileUtils.h"
+
+/// \brief Arguments of ofFileWatcher::fileChanged.
+class ofFileWatcherEventArgs: public ofEventArgs{
+public:
+	enum Type{
+		Created,
+		Modified,
+		Removed,
+	};
+
+	ofFileWatcherEventArgs()
+	:type(Modified){}
+
+	ofFileWatcherEventArgs(const std::filesystem::path & path, Type type)
+	:path(path)
+	,type(type){}
+
+	/// Path of the file that changed, the watched path after ofToDataPath()
+	/// or, for files in a watched directory, the directory path followed by
+	/// the file's path inside it.
+	std::filesystem::path path;
+	Type type;
+};
+
+/// \class ofFileWatcher
+///
+/// Notifies when files change on disk, to reload shaders, images or
+/// settings while the application runs:
+///
+/// ~~~~{.cpp}
+/// watcher.watch("shaders", true);
+/// ofAddListener(watcher.fileChanged, this, &ofApp::fileChanged);
+///
+/// void ofApp::fileChanged(ofFileWatcherEventArgs & args){
+///     if(args.type != ofFileWatcherEventArgs::Removed){
+///         shader.load(args.path);
+///     }
+/// }
+/// ~~~~
+///
+/// On Linux changes are reported by the kernel through inotify, with one
+/// watch per directory, so watching tens of thousands of files costs
+/// nothing until something changes. Elsewhere, or if the system runs out
+/// of inotify watches, files are polled from a background thread. In both
+/// cases the main thread only checks for pending changes once per frame.
+/// Polling compares sizes and modification times, which some filesystems
+/// only store with a resolution of seconds.
+///
+/// Bursts of changes to the same file, like an editor writing it in
+/// several steps, are coalesced into one notification sent once the file
+/// hasn't changed for setCoalesceTime() milliseconds. Notifications are
+/// always sent from the main thread during ofEvents().update.
+///
+/// Hidden files, starting with a dot, are ignored in watched directories
+/// unless watched explicitly.
+class ofFileWatcher{
+public:
+	ofFileWatcher();
+	~ofFileWatcher();
+
+	/// \brief Watch a file or the files in a directory.
+	///
+	/// Files don't need to exist to be watched, their creation is
+	/// notified. Paths are relative to the data folder.
+	///
+	/// \param path File or directory to watch.
+	/// \param recursive Also watch the files in subdirectories of a
+	/// directory, including the ones created later.
+	void watch(const std::filesystem::path & path, bool recursive = false);
+
+	/// \brief Stop watching a path passed to watch().
+	///
+	/// Changes that haven't been notified yet are dropped, also the ones
+	/// to other paths, and the paths still watched are read again.
+	void unwatch(const std::filesystem::path & path);
+
+	/// \brief Stop watching everything.
+	void clear();
+
+	/// \brief Poll files even where the system can notify changes.
+	/// Mostly useful to test the fallback. Changing it drops the changes
+	/// that haven't been notified yet, like unwatch().
+	void setUsePolling(bool usePolling);
+
+	/// \returns true if any of the watched paths is polled.
+	bool isPolling() const;
+
+	/// \brief How often polled files are checked, 500ms by default.
+	void setPollingInterval(uint64_t milliseconds);
+
+	/// \brief How long a file has to stay unchanged before notifying
+	/// its changes, 100ms by default.
+	void setCoalesceTime(uint64_t milliseconds);
+
+	/// Notified from the main thread with the file that changed.
+	ofEvent<ofFileWatcherEventArgs> fileChanged;
+
+private:
+	ofFileWatcher(const ofFileWatcher &) = delete;
+	ofFileWatcher & operator=(const ofFileWatcher &) = delete;
+	void update(ofEventArgs & args);
+
+	struct Impl;
+	std::unique_ptr<Impl> impl;
+};
@@ -0,0 +1,610 @@
+#include "ofMath.h"
+#include "ofPixels.h"
+#include "ofSimdInternal.h"
+#include "ofThreadPool.h"
+
+// the batch noise functions have to give exactly the same results as the
+// scalar ones, so the compiler can't fuse multiplies and adds into fma
+// instructions differently in each of them. clang follows the standard
+// pragma, the makefiles and the xcode projects compile this file with
+// -ffp-contract=off and the visual studio project with /fp:strict
+#if defined(__clang__)
+	#pragma STDC FP_CONTRACT OFF
+#endif
+
+#include "ofNoise.h"
+
+//--------------------------------------------------
+float ofNoise(float x){
+	return _slang_library_noise1(x)*0.5f + 0.5f;
+}
+
+//--------------------------------------------------
+float ofNoise(float x, float y){
+	return _slang_library_noise2(x,y)*0.5f + 0.5f;
+}
+
+//--------------------------------------------------
+float ofNoise(const glm::vec2& p){
+	return ofNoise( p.x, p.y );
+}
+
+//--------------------------------------------------
+float ofNoise(float x, float y, float z){
+	return _slang_library_noise3(x,y,z)*0.5f + 0.5f;
+}
+
+//--------------------------------------------------
+float ofNoise(const glm::vec3& p){
+	return ofNoise( p.x, p.y, p.z );
+}
+
+//--------------------------------------------------
+float ofNoise(float x, float y, float z, float w){
+	return _slang_library_noise4(x,y,z,w)*0.5f + 0.5f;
+}
+
+//--------------------------------------------------
+float ofNoise(const glm::vec4& p){
+	return ofNoise( p.x, p.y, p.z, p.w );
+}
+
+//--------------------------------------------------
+float ofSignedNoise(float x){
+	return _slang_library_noise1(x);
+}
+
+//--------------------------------------------------
+float ofSignedNoise(float x, float y){
+	return _slang_library_noise2(x,y);
+}
+
+//--------------------------------------------------
+float ofSignedNoise(const glm::vec2& p){
+	return ofSignedNoise( p.x, p.y );
+}
+
+//--------------------------------------------------
+float ofSignedNoise(float x, float y, float z){
+	return _slang_library_noise3(x,y,z);
+}
+
+//--------------------------------------------------
+float ofSignedNoise(const glm::vec3& p){
+	return ofSignedNoise( p.x, p.y, p.z );
+}
+
+//--------------------------------------------------
+float ofSignedNoise(float x, float y, float z, float w){
+	return _slang_library_noise4(x,y,z,w);
+}
+
+//--------------------------------------------------
+float ofSignedNoise(const glm::vec4& p){
+	return ofSignedNoise( p.x, p.y, p.z, p.w );
+}
+
+namespace{
+	// points evaluated by each task of the shared thread pool
+	const size_t noiseGrainSize = 1024;
+
+	// coordinates of 4 points, [dimension][lane]
+	typedef float NoiseLanes[4][4];
+
+	struct NoiseSettings{
+		int dimensions;
+		int octaves; // 0 for plain noise, >0 for fractal noise
+		float lacunarity;
+		float gain;
+		bool normalized; // 0..1 instead of -1..1
+	};
+
+	float signedNoise(int dimensions, const float * p){
+		switch(dimensions){
+		case 1: return _slang_library_noise1(p[0]);
+		case 2: return _slang_library_noise2(p[0], p[1]);
+		case 3: return _slang_library_noise3(p[0], p[1], p[2]);
+		default: return _slang_library_noise4(p[0], p[1], p[2], p[3]);
+		}
+	}
+
+#if OF_SSE2
+	// the kernels below follow _slang_library_noiseN operation by operation
+	// so every lane gets exactly the same result as the scalar version
+
+	inline __m128 noiseSelect(__m128 mask, __m128 a, __m128 b){
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+
+	// FASTFLOOR: truncate and subtract 1 from anything that is not > 0
+	inline __m128i noiseFloor(__m128 v){
+		__m128i positive = _mm_castps_si128(_mm_cmpgt_ps(v, _mm_setzero_ps()));
+		return _mm_add_epi32(_mm_cvttps_epi32(v), _mm_andnot_si128(positive, _mm_set1_epi32(-1)));
+	}
+
+	// sign bit set in the lanes where bit of h is set
+	inline __m128 noiseSign(__m128i h, int bit, int shift){
+		return _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(bit)), shift));
+	}
+
+	inline __m128i noiseLoad(const int * values){
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+	}
+
+	inline void noiseStore(int * values, __m128i v){
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(values), v);
+	}
+
+	inline __m128 noiseGrad1(__m128i hash, __m128 x){
+		__m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+		__m128 grad = _mm_add_ps(_mm_set1_ps(1.0f), _mm_cvtepi32_ps(_mm_and_si128(h, _mm_set1_epi32(7))));
+		return _mm_mul_ps(_mm_xor_ps(grad, noiseSign(h, 8, 28)), x);
+	}
+
+	inline __m128 noiseGrad2(__m128i hash, __m128 x, __m128 y){
+		__m128i h = _mm_and_si128(hash, _mm_set1_epi32(7));
+		__m128 lt4 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+		__m128 u = noiseSelect(lt4, x, y);
+		__m128 v = _mm_mul_ps(_mm_set1_ps(2.0f), noiseSelect(lt4, y, x));
+		return _mm_add_ps(_mm_xor_ps(u, noiseSign(h, 1, 31)), _mm_xor_ps(v, noiseSign(h, 2, 30)));
+	}
+
+	inline __m128 noiseGrad3(__m128i hash, __m128 x, __m128 y, __m128 z){
+		__m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+		__m128 lt8 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(8)));
+		__m128 lt4 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+		__m128 is12or14 = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(h, _mm_set1_epi32(13)), _mm_set1_epi32(12)));
+		__m128 u = noiseSelect(lt8, x, y);
+		__m128 v = noiseSelect(lt4, y, noiseSelect(is12or14, x, z));
+		return _mm_add_ps(_mm_xor_ps(u, noiseSign(h, 1, 31)), _mm_xor_ps(v, noiseSign(h, 2, 30)));
+	}
+
+	// t*t*t*t*grad, or 0 in the lanes where t < 0
+	inline __m128 noiseCorner(__m128 t, __m128 grad){
+		__m128 outside = _mm_cmplt_ps(t, _mm_setzero_ps());
+		t = _mm_mul_ps(t, t);
+		return _mm_andnot_ps(outside, _mm_mul_ps(_mm_mul_ps(t, t), grad));
+	}
+
+	void signedNoise1Lanes(const NoiseLanes & p, float * out){
+		__m128 x = _mm_loadu_ps(p[0]);
+		__m128i i0 = noiseFloor(x);
+		__m128 x0 = _mm_sub_ps(x, _mm_cvtepi32_ps(i0));
+		__m128 x1 = _mm_sub_ps(x0, _mm_set1_ps(1.0f));
+		__m128 t0 = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(x0, x0));
+		__m128 t1 = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(x1, x1));
+
+		int i[4], h0[4], h1[4];
+		noiseStore(i, i0);
+		for(int l = 0; l < 4; l++){
+			h0[l] = perm[i[l] & 0xff];
+			h1[l] = perm[(i[l] + 1) & 0xff];
+		}
+
+		t0 = _mm_mul_ps(t0, t0);
+		__m128 n0 = _mm_mul_ps(_mm_mul_ps(t0, t0), noiseGrad1(noiseLoad(h0), x0));
+		t1 = _mm_mul_ps(t1, t1);
+		__m128 n1 = _mm_mul_ps(_mm_mul_ps(t1, t1), noiseGrad1(noiseLoad(h1), x1));
+		_mm_storeu_ps(out, _mm_mul_ps(_mm_set1_ps(0.25f), _mm_add_ps(n0, n1)));
+	}
+
+	void signedNoise2Lanes(const NoiseLanes & p, float * out){
+		__m128 x = _mm_loadu_ps(p[0]);
+		__m128 y = _mm_loadu_ps(p[1]);
+		__m128 s = _mm_mul_ps(_mm_add_ps(x, y), _mm_set1_ps(F2));
+		__m128i i = noiseFloor(_mm_add_ps(x, s));
+		__m128i j = noiseFloor(_mm_add_ps(y, s));
+		__m128 t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(i, j)), _mm_set1_ps(G2));
+		__m128 x0 = _mm_sub_ps(x, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+		__m128 y0 = _mm_sub_ps(y, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+
+		__m128 lower = _mm_cmpgt_ps(x0, y0);
+		__m128 one = _mm_set1_ps(1.0f);
+		__m128 i1 = _mm_and_ps(lower, one);
+		__m128 j1 = _mm_andnot_ps(lower, one);
+		__m128 x1 = _mm_add_ps(_mm_sub_ps(x0, i1), _mm_set1_ps(G2));
+		__m128 y1 = _mm_add_ps(_mm_sub_ps(y0, j1), _mm_set1_ps(G2));
+		__m128 x2 = _mm_add_ps(_mm_sub_ps(x0, one), _mm_set1_ps(2.0f * G2));
+		__m128 y2 = _mm_add_ps(_mm_sub_ps(y0, one), _mm_set1_ps(2.0f * G2));
+
+		// the permutation lookups stay scalar, there's no gather in SSE
+		int ii[4], jj[4], lowerLanes[4], h0[4], h1[4], h2[4];
+		noiseStore(ii, i);
+		noiseStore(jj, j);
+		noiseStore(lowerLanes, _mm_castps_si128(lower));
+		for(int l = 0; l < 4; l++){
+			int a = ii[l] % 256;
+			int b = jj[l] % 256;
+			int li1 = lowerLanes[l] ? 1 : 0;
+			h0[l] = perm[a + perm[b]];
+			h1[l] = perm[a + li1 + perm[b + 1 - li1]];
+			h2[l] = perm[a + 1 + perm[b + 1]];
+		}
+
+		__m128 half = _mm_set1_ps(0.5f);
+		__m128 t0 = _mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x0, x0)), _mm_mul_ps(y0, y0));
+		__m128 t1 = _mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x1, x1)), _mm_mul_ps(y1, y1));
+		__m128 t2 = _mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x2, x2)), _mm_mul_ps(y2, y2));
+		__m128 n0 = noiseCorner(t0, noiseGrad2(noiseLoad(h0), x0, y0));
+		__m128 n1 = noiseCorner(t1, noiseGrad2(noiseLoad(h1), x1, y1));
+		__m128 n2 = noiseCorner(t2, noiseGrad2(noiseLoad(h2), x2, y2));
+		_mm_storeu_ps(out, _mm_mul_ps(_mm_set1_ps(40.0f), _mm_add_ps(_mm_add_ps(n0, n1), n2)));
+	}
+
+	void signedNoise3Lanes(const NoiseLanes & p, float * out){
+		__m128 x = _mm_loadu_ps(p[0]);
+		__m128 y = _mm_loadu_ps(p[1]);
+		__m128 z = _mm_loadu_ps(p[2]);
+		__m128 s = _mm_mul_ps(_mm_add_ps(_mm_add_ps(x, y), z), _mm_set1_ps(F3));
+		__m128i i = noiseFloor(_mm_add_ps(x, s));
+		__m128i j = noiseFloor(_mm_add_ps(y, s));
+		__m128i k = noiseFloor(_mm_add_ps(z, s));
+		__m128 t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(_mm_add_epi32(i, j), k)), _mm_set1_ps(G3));
+		__m128 x0 = _mm_sub_ps(x, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+		__m128 y0 = _mm_sub_ps(y, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+		__m128 z0 = _mm_sub_ps(z, _mm_sub_ps(_mm_cvtepi32_ps(k), t));
+
+		// the branches choosing the simplex corners as masks
+		__m128 xy = _mm_cmpge_ps(x0, y0);
+		__m128 yz = _mm_cmpge_ps(y0, z0);
+		__m128 xz = _mm_cmpge_ps(x0, z0);
+		__m128 i1 = _mm_and_ps(xy, _mm_or_ps(yz, xz));
+		__m128 j1 = _mm_andnot_ps(xy, yz);
+		__m128 k1 = _mm_andnot_ps(yz, _mm_andnot_ps(_mm_and_ps(xy, xz), _mm_castsi128_ps(_mm_set1_epi32(-1))));
+		__m128 i2 = _mm_or_ps(xy, _mm_and_ps(yz, xz));
+		__m128 j2 = _mm_or_ps(_mm_andnot_ps(xy, _mm_castsi128_ps(_mm_set1_epi32(-1))), yz);
+		__m128 k2 = _mm_andnot_ps(_mm_and_ps(yz, _mm_or_ps(xy, xz)), _mm_castsi128_ps(_mm_set1_epi32(-1)));
+
+		__m128 one = _mm_set1_ps(1.0f);
+		__m128 g1 = _mm_set1_ps(G3);
+		__m128 g2 = _mm_set1_ps(2.0f * G3);
+		__m128 g3 = _mm_set1_ps(3.0f * G3);
+		__m128 x1 = _mm_add_ps(_mm_sub_ps(x0, _mm_and_ps(i1, one)), g1);
+		__m128 y1 = _mm_add_ps(_mm_sub_ps(y0, _mm_and_ps(j1, one)), g1);
+		__m128 z1 = _mm_add_ps(_mm_sub_ps(z0, _mm_and_ps(k1, one)), g1);
+		__m128 x2 = _mm_add_ps(_mm_sub_ps(x0, _mm_and_ps(i2, one)), g2);
+		__m128 y2 = _mm_add_ps(_mm_sub_ps(y0, _mm_and_ps(j2, one)), g2);
+		__m128 z2 = _mm_add_ps(_mm_sub_ps(z0, _mm_and_ps(k2, one)), g2);
+		__m128 x3 = _mm_add_ps(_mm_sub_ps(x0, one), g3);
+		__m128 y3 = _mm_add_ps(_mm_sub_ps(y0, one), g3);
+		__m128 z3 = _mm_add_ps(_mm_sub_ps(z0, one), g3);
+
+		int ii[4], jj[4], kk[4], o1[4][3], o2[4][3], h0[4], h1[4], h2[4], h3[4];
+		int li1[4], lj1[4], lk1[4], li2[4], lj2[4], lk2[4];
+		noiseStore(ii, i);
+		noiseStore(jj, j);
+		noiseStore(kk, k);
+		noiseStore(li1, _mm_castps_si128(i1));
+		noiseStore(lj1, _mm_castps_si128(j1));
+		noiseStore(lk1, _mm_castps_si128(k1));
+		noiseStore(li2, _mm_castps_si128(i2));
+		noiseStore(lj2, _mm_castps_si128(j2));
+		noiseStore(lk2, _mm_castps_si128(k2));
+		for(int l = 0; l < 4; l++){
+			int a = ii[l] % 256;
+			int b = jj[l] % 256;
+			int c = kk[l] % 256;
+			o1[l][0] = li1[l] & 1; o1[l][1] = lj1[l] & 1; o1[l][2] = lk1[l] & 1;
+			o2[l][0] = li2[l] & 1; o2[l][1] = lj2[l] & 1; o2[l][2] = lk2[l] & 1;
+			h0[l] = perm[a + perm[b + perm[c]]];
+			h1[l] = perm[a + o1[l][0] + perm[b + o1[l][1] + perm[c + o1[l][2]]]];
+			h2[l] = perm[a + o2[l][0] + perm[b + o2[l][1] + perm[c + o2[l][2]]]];
+			h3[l] = perm[a + 1 + perm[b + 1 + perm[c + 1]]];
+		}
+
+		__m128 r = _mm_set1_ps(0.6f);
+		__m128 t0 = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(r, _mm_mul_ps(x0, x0)), _mm_mul_ps(y0, y0)), _mm_mul_ps(z0, z0));
+		__m128 t1 = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(r, _mm_mul_ps(x1, x1)), _mm_mul_ps(y1, y1)), _mm_mul_ps(z1, z1));
+		__m128 t2 = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(r, _mm_mul_ps(x2, x2)), _mm_mul_ps(y2, y2)), _mm_mul_ps(z2, z2));
+		__m128 t3 = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(r, _mm_mul_ps(x3, x3)), _mm_mul_ps(y3, y3)), _mm_mul_ps(z3, z3));
+		__m128 n0 = noiseCorner(t0, noiseGrad3(noiseLoad(h0), x0, y0, z0));
+		__m128 n1 = noiseCorner(t1, noiseGrad3(noiseLoad(h1), x1, y1, z1));
+		__m128 n2 = noiseCorner(t2, noiseGrad3(noiseLoad(h2), x2, y2, z2));
+		__m128 n3 = noiseCorner(t3, noiseGrad3(noiseLoad(h3), x3, y3, z3));
+		_mm_storeu_ps(out, _mm_mul_ps(_mm_set1_ps(32.0f), _mm_add_ps(_mm_add_ps(_mm_add_ps(n0, n1), n2), n3)));
+	}
+#endif
+
+	void signedNoiseLanes(int dimensions, const NoiseLanes & p, float * out){
+#if OF_SSE2
+		switch(dimensions){
+		case 1: signedNoise1Lanes(p, out); return;
+		case 2: signedNoise2Lanes(p, out); return;
+		case 3: signedNoise3Lanes(p, out); return;
+		default: break;
+		}
+#endif
+		// 4D walks the simplex through a lookup table per point, it's
+		// evaluated point by point and only gains from the threading
+		for(int l = 0; l < 4; l++){
+			float q[4] = { p[0][l], p[1][l], p[2][l], p[3][l] };
+			out[l] = signedNoise(dimensions, q);
+		}
+	}
+
+	float evaluateNoise(const NoiseSettings & settings, const float * p){
+		float n;
+		if(settings.octaves == 0){
+			n = signedNoise(settings.dimensions, p);
+		}else{
+			float sum = 0, total = 0, amplitude = 1, frequency = 1;
+			for(int o = 0; o < settings.octaves; o++){
+				float q[4];
+				for(int d = 0; d < settings.dimensions; d++){
+					q[d] = p[d] * frequency;
+				}
+				sum += amplitude * signedNoise(settings.dimensions, q);
+				total += amplitude;
+				amplitude *= settings.gain;
+				frequency *= settings.lacunarity;
+			}
+			n = sum / total;
+		}
+		return settings.normalized ? n*0.5f + 0.5f : n;
+	}
+
+	// same as evaluateNoise for 4 points at once
+	void evaluateNoiseLanes(const NoiseSettings & settings, const NoiseLanes & p, float * out){
+		if(settings.octaves == 0){
+			signedNoiseLanes(settings.dimensions, p, out);
+		}else{
+			float sum[4] = {0, 0, 0, 0};
+			float total = 0, amplitude = 1, frequency = 1;
+			for(int o = 0; o < settings.octaves; o++){
+				NoiseLanes q;
+				float n[4];
+				for(int d = 0; d < settings.dimensions; d++){
+					for(int l = 0; l < 4; l++){
+						q[d][l] = p[d][l] * frequency;
+					}
+				}
+				signedNoiseLanes(settings.dimensions, q, n);
+				for(int l = 0; l < 4; l++){
+					sum[l] += amplitude * n[l];
+				}
+				total += amplitude;
+				amplitude *= settings.gain;
+				frequency *= settings.lacunarity;
+			}
+			for(int l = 0; l < 4; l++){
+				out[l] = sum[l] / total;
+			}
+		}
+		if(settings.normalized){
+			for(int l = 0; l < 4; l++){
+				out[l] = out[l]*0.5f + 0.5f;
+			}
+		}
+	}
+
+	// evaluates count points, getPoint(index, coordinates) fills the
+	// coordinates of each one. every value is written stride times, once
+	// per channel when filling pixels.
+	template<typename GetPoint>
+	void noiseBatch(const NoiseSettings & settings, GetPoint getPoint, float * out, size_t count, size_t stride){
+		auto store = [&](size_t index, float value){
+			for(size_t c = 0; c < stride; c++){
+				out[index * stride + c] = value;
+			}
+		};
+		ofParallelFor(0, count, [&](size_t begin, size_t end){
+			size_t index = begin;
+			for(; index + 4 <= end; index += 4){
+				NoiseLanes lanes;
+				float values[4];
+				for(int l = 0; l < 4; l++){
+					float p[4] = {0, 0, 0, 0};
+					getPoint(index + l, p);
+					for(int d = 0; d < 4; d++){
+						lanes[d][l] = p[d];
+					}
+				}
+				evaluateNoiseLanes(settings, lanes, values);
+				for(int l = 0; l < 4; l++){
+					store(index + l, values[l]);
+				}
+			}
+			for(; index < end; index++){
+				float p[4] = {0, 0, 0, 0};
+				getPoint(index, p);
+				store(index, evaluateNoise(settings, p));
+			}
+		}, noiseGrainSize);
+	}
+
+	template<typename Point>
+	void noisePoints(const NoiseSettings & settings, const Point * points, float * out, size_t count){
+		noiseBatch(settings, [&](size_t index, float * p){
+			for(int d = 0; d < settings.dimensions; d++){
+				p[d] = points[index][d];
+			}
+		}, out, count, 1);
+	}
+
+	void noisePoints(const NoiseSettings & settings, const float * x, float * out, size_t count){
+		noiseBatch(settings, [&](size_t index, float * p){
+			p[0] = x[index];
+		}, out, count, 1);
+	}
+
+	template<typename Point>
+	void noiseGrid(const NoiseSettings & settings, ofFloatPixels & pixels, const Point & origin, const glm::vec2 & step){
+		if(!pixels.isAllocated()){
+			return;
+		}
+		size_t width = pixels.getWidth();
+		noiseBatch(settings, [&](size_t index, float * p){
+			for(int d = 0; d < settings.dimensions; d++){
+				p[d] = origin[d];
+			}
+			p[0] = origin.x + (index % width) * step.x;
+			p[1] = origin.y + (index / width) * step.y;
+		}, pixels.getData(), width * pixels.getHeight(), pixels.getNumChannels());
+	}
+
+	NoiseSettings noiseSettings(int dimensions, bool normalized){
+		NoiseSettings settings = { dimensions, 0, 2.f, 0.5f, normalized };
+		return settings;
+	}
+
+	NoiseSettings fractalNoiseSettings(int dimensions, bool normalized, int octaves, float lacunarity, float gain){
+		NoiseSettings settings = { dimensions, std::max(octaves, 1), lacunarity, gain, normalized };
+		return settings;
+	}
+}
+
+//--------------------------------------------------
+void ofNoise(const float * x, float * out, size_t count){
+	noisePoints(noiseSettings(1, true), x, out, count);
+}
+
+//--------------------------------------------------
+void ofNoise(const glm::vec2 * points, float * out, size_t count){
+	noisePoints(noiseSettings(2, true), points, out, count);
+}
+
+//--------------------------------------------------
+void ofNoise(const glm::vec3 * points, float * out, size_t count){
+	noisePoints(noiseSettings(3, true), points, out, count);
+}
+
+//--------------------------------------------------
+void ofNoise(const glm::vec4 * points, float * out, size_t count){
+	noisePoints(noiseSettings(4, true), points, out, count);
+}
+
+//--------------------------------------------------
+void ofSignedNoise(const float * x, float * out, size_t count){
+	noisePoints(noiseSettings(1, false), x, out, count);
+}
+
+//--------------------------------------------------
+void ofSignedNoise(const glm::vec2 * points, float * out, size_t count){
+	noisePoints(noiseSettings(2, false), points, out, count);
+}
+
+//--------------------------------------------------
+void ofSignedNoise(const glm::vec3 * points, float * out, size_t count){
+	noisePoints(noiseSettings(3, false), points, out, count);
+}
+
+//--------------------------------------------------
+void ofSignedNoise(const glm::vec4 * points, float * out, size_t count){
+	noisePoints(noiseSettings(4, false), points, out, count);
+}
+
+//--------------------------------------------------
+void ofNoise(ofFloatPixels & pixels, const glm::vec2 & origin, const glm::vec2 & step){
+	noiseGrid(noiseSettings(2, true), pixels, origin, step);
+}
+
+//--------------------------------------------------
+void ofNoise(ofFloatPixels & pixels, const glm::vec3 & origin, const glm::vec2 & step){
+	noiseGrid(noiseSettings(3, true), pixels, origin, step);
+}
+
+//--------------------------------------------------
+void ofNoise(ofFloatPixels & pixels, const glm::vec4 & origin, const glm::vec2 & step){
+	noiseGrid(noiseSettings(4, true), pixels, origin, step);
+}
+
+//--------------------------------------------------
+float ofFractalNoise(float x, int octaves, float lacunarity, float gain){
+	return evaluateNoise(fractalNoiseSettings(1, true, octaves, lacunarity, gain), &x);
+}
+
+//--------------------------------------------------
+float ofFractalNoise(const glm::vec2 & p, int octaves, float lacunarity, float gain){
+	float q[4] = { p.x, p.y };
+	return evaluateNoise(fractalNoiseSettings(2, true, octaves, lacunarity, gain), q);
+}
+
+//--------------------------------------------------
+float ofFractalNoise(const glm::vec3 & p, int octaves, float lacunarity, float gain){
+	float q[4] = { p.x, p.y, p.z };
+	return evaluateNoise(fractalNoiseSettings(3, true, octaves, lacunarity, gain), q);
+}
+
+//--------------------------------------------------
+float ofFractalNoise(const glm::vec4 & p, int octaves, float lacunarity, float gain){
+	float q[4] = { p.x, p.y, p.z, p.w };
+	return evaluateNoise(fractalNoiseSettings(4, true, octaves, lacunarity, gain), q);
+}
+
+//--------------------------------------------------
+float ofSignedFractalNoise(float x, int octaves, float lacunarity, float gain){
+	return evaluateNoise(fractalNoiseSettings(1, false, octaves, lacunarity, gain), &x);
+}
+
+//--------------------------------------------------
+float ofSignedFractalNoise(const glm::vec2 & p, int octaves, float lacunarity, float gain){
+	float q[4] = { p.x, p.y };
+	return evaluateNoise(fractalNoiseSettings(2, false, octaves, lacunarity, gain), q);
+}
+
+//--------------------------------------------------
+float ofSignedFractalNoise(const glm::vec3 & p, int octaves, float lacunarity, float gain){
+	float q[4] = { p.x, p.y, p.z };
+	return evaluateNoise(fractalNoiseSettings(3, false, octaves, lacunarity, gain), q);
+}
+
+//--------------------------------------------------
+float ofSignedFractalNoise(const glm::vec4 & p, int octaves, float lacunarity, float gain){
+	float q[4] = { p.x, p.y, p.z, p.w };
+	return evaluateNoise(fractalNoiseSettings(4, false, octaves, lacunarity, gain), q);
+}
+
+//--------------------------------------------------
+void ofFractalNoise(const float * x, float * out, size_t count, int octaves, float lacunarity, float gain){
+	noisePoints(fractalNoiseSettings(1, true, octaves, lacunarity, gain), x, out, count);
+}
+
+//--------------------------------------------------
+void ofFractalNoise(const glm::vec2 * points, float * out, size_t count, int octaves, float lacunarity, float gain){
+	noisePoints(fractalNoiseSettings(2, true, octaves, lacunarity, gain), points, out, count);
+}
+
+//--------------------------------------------------
+void ofFractalNoise(const glm::vec3 * points, float * out, size_t count, int octaves, float lacunarity, float gain){
+	noisePoints(fractalNoiseSettings(3, true, octaves, lacunarity, gain), points, out, count);
+}
+
+//--------------------------------------------------
+void ofFractalNoise(const glm::vec4 * points, float * out, size_t count, int octaves, float lacunarity, float gain){
+	noisePoints(fractalNoiseSettings(4, true, octaves, lacunarity, gain), points, out, count);
+}
+
+//--------------------------------------------------
+void ofSignedFractalNoise(const float * x, float * out, size_t count, int octaves, float lacunarity, float gain){
+	noisePoints(fractalNoiseSettings(1, false, octaves, lacunarity, gain), x, out, count);
+}
+
+//--------------------------------------------------
+void ofSignedFractalNoise(const glm::vec2 * points, float * out, size_t count, int octaves, float lacunarity, float gain){
+	noisePoints(fractalNoiseSettings(2, false, octaves, lacunarity, gain), points, out, count);
+}
+
+//--------------------------------------------------
+void ofSignedFractalNoise(const glm::vec3 * points, float * out, size_t count, int octaves, float lacunarity, float gain){
+	noisePoints(fractalNoiseSettings(3, false, octaves, lacunarity, gain), points, out, count);
+}
+
+//--------------------------------------------------
+void ofSignedFractalNoise(const glm::vec4 * points, float * out, size_t count, int octaves, float lacunarity, float gain){
+	noisePoints(fractalNoiseSettings(4, false, octaves, lacunarity, gain), points, out, count);
+}
+
+//--------------------------------------------------
+void ofFractalNoise(ofFloatPixels & pixels, const glm::vec2 & origin, const glm::vec2 & step, int octaves, float lacunarity, float gain){
+	noiseGrid(fractalNoiseSettings(2, true, octaves, lacunarity, gain), pixels, origin, step);
+}
+
+//--------------------------------------------------
+void ofFractalNoise(ofFloatPixels & pixels, const glm::vec3 & origin, const glm::vec2 & step, int octaves, float lacunarity, float gain){
+	noiseGrid(fractalNoiseSettings(3, true, octaves, lacunarity, gain), pixels, origin, step);
+}
+
+//--------------------------------------------------
+void ofFractalNoise(ofFloatPixels & pixels, const glm::vec4 & origin, const glm::vec2 & step, int octaves, float lacunarity, float gain){
+	noiseGrid(fractalNoiseSettings(4, true, octaves, lacunarity, gain), pixels, origin, step);
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+/// \cond INTERNAL
+// detection of the simd instructions the core implementations can use,
+// not part of the api
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define OF_SSE2 1
+#else
+	#define OF_SSE2 0
+#endif
+/// \endcond
@@ -0,0 +1,257 @@
+#pragma once
+
+#include "ofConstants.h"
+
+/// \brief A non owning reference to a range of characters.
+///
+/// ofStringView points to characters owned by something else, a string or
+/// an ofBuffer, without copying them. It's meant for parsing big amounts
+/// of text where creating a std::string per line or token would take most
+/// of the time, see ofBuffer::getLineViews() and ofSplitStringView().
+///
+/// The characters have to outlive the view and aren't null terminated,
+/// use toString() to get a copy that can be kept or passed to functions
+/// expecting a c string.
+class ofStringView{
+public:
+	typedef const char * iterator;
+	typedef const char * const_iterator;
+	static const size_t npos = size_t(-1);
+
+	ofStringView()
+	:ptr(nullptr)
+	,len(0){}
+
+	ofStringView(const char * data, size_t size)
+	:ptr(data)
+	,len(size){}
+
+	ofStringView(const char * str)
+	:ptr(str)
+	,len(str ? strlen(str) : 0){}
+
+	ofStringView(const std::string & str)
+	:ptr(str.data())
+	,len(str.size()){}
+
+	const char * data() const{ return ptr; }
+	size_t size() const{ return len; }
+	size_t length() const{ return len; }
+	bool empty() const{ return len == 0; }
+
+	const char * begin() const{ return ptr; }
+	const char * end() const{ return ptr + len; }
+
+	char operator[](size_t pos) const{ return ptr[pos]; }
+	char front() const{ return ptr[0]; }
+	char back() const{ return ptr[len - 1]; }
+
+	/// \returns The view of count characters starting at pos, or until the
+	/// end if there's less than that.
+	ofStringView substr(size_t pos, size_t count = npos) const{
+		pos = std::min(pos, len);
+		return ofStringView(ptr + pos, std::min(count, len - pos));
+	}
+
+	/// \returns The position of the first c at or after pos, or npos.
+	size_t find(char c, size_t pos = 0) const{
+		if(pos >= len){
+			return npos;
+		}
+		auto found = static_cast<const char*>(memchr(ptr + pos, c, len - pos));
+		return found ? found - ptr : npos;
+	}
+
+	/// \returns The position of the first occurence of str at or after pos,
+	/// or npos.
+	size_t find(ofStringView str, size_t pos = 0) const{
+		if(pos > len){
+			return npos;
+		}
+		auto found = std::search(ptr + pos, end(), str.begin(), str.end());
+		return found == end() && !str.empty() ? npos : found - ptr;
+	}
+
+	bool startsWith(ofStringView prefix) const{
+		return len >= prefix.len && std::equal(prefix.begin(), prefix.end(), ptr);
+	}
+
+	bool endsWith(ofStringView suffix) const{
+		return len >= suffix.len && std::equal(suffix.begin(), suffix.end(), end() - suffix.len);
+	}
+
+	void removePrefix(size_t n){
+		ptr += n;
+		len -= n;
+	}
+
+	void removeSuffix(size_t n){
+		len -= n;
+	}
+
+	/// \returns The view without the whitespace at the start and end.
+	ofStringView trim() const{
+		auto first = ptr;
+		auto last = end();
+		while(first != last && isSpace(*first)){
+			++first;
+		}
+		while(last != first && isSpace(*(last - 1))){
+			--last;
+		}
+		return ofStringView(first, last - first);
+	}
+
+	std::string toString() const{
+		return std::string(ptr, len);
+	}
+
+	explicit operator std::string() const{
+		return toString();
+	}
+
+	friend bool operator==(ofStringView a, ofStringView b){
+		return a.len == b.len && (a.len == 0 || memcmp(a.ptr, b.ptr, a.len) == 0);
+	}
+
+	friend bool operator!=(ofStringView a, ofStringView b){
+		return !(a == b);
+	}
+
+	friend bool operator<(ofStringView a, ofStringView b){
+		return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+	}
+
+	friend std::ostream & operator<<(std::ostream & os, ofStringView view){
+		return os.write(view.ptr, view.len);
+	}
+
+private:
+	static bool isSpace(char c){
+		return c == ' ' || (c >= '\t' && c <= '\r');
+	}
+
+	const char * ptr;
+	size_t len;
+};
+
+
+/// \brief The tokens of a string split by a delimiter, returned by
+/// ofSplitStringView().
+///
+/// Tokens are found while iterating so no memory is allocated.
+class ofStringViewTokens{
+public:
+	ofStringViewTokens(ofStringView source, const std::string & delimiter, bool ignoreEmpty, bool trim)
+	:source(source)
+	,delimiter(delimiter)
+	,ignoreEmpty(ignoreEmpty)
+	,trim(trim){}
+
+	class iterator: public std::iterator<std::forward_iterator_tag, ofStringView>{
+	public:
+		iterator()
+		:tokens(nullptr)
+		,next(nullptr)
+		,last(true)
+		,finished(true){}
+
+		iterator(const ofStringViewTokens * tokens)
+		:tokens(tokens)
+		,next(tokens->source.begin())
+		,last(false)
+		,finished(false){
+			++(*this);
+		}
+
+		const ofStringView & operator*() const{ return token; }
+		const ofStringView * operator->() const{ return &token; }
+
+		iterator & operator++(){
+			auto & source = tokens->source;
+			auto & delimiter = tokens->delimiter;
+			while(true){
+				// next can't tell when there's nothing left since a null view
+				// has a null begin, but still has one empty token
+				if(last){
+					finished = true;
+					return *this;
+				}
+				if(delimiter.empty()){
+					token = source;
+					last = true;
+					return *this;
+				}
+				auto end = std::search(next, source.end(), delimiter.begin(), delimiter.end());
+				token = ofStringView(next, end - next);
+				if(tokens->trim){
+					token = token.trim();
+				}
+				if(end == source.end()){
+					last = true;
+				}else{
+					next = end + delimiter.size();
+				}
+				if(!tokens->ignoreEmpty || !token.empty()){
+					return *this;
+				}
+			}
+		}
+
+		iterator operator++(int){
+			iterator tmp(*this);
+			++(*this);
+			return tmp;
+		}
+
+		bool operator==(const iterator & other) const{
+			return finished == other.finished && (finished || (next == other.next && last == other.last && token.data() == other.token.data()));
+		}
+
+		bool operator!=(const iterator & other) const{
+			return !(*this == other);
+		}
+
+	private:
+		const ofStringViewTokens * tokens;
+		const char * next;
+		bool last;
+		bool finished;
+		ofStringView token;
+	};
+
+	iterator begin() const{ return iterator(this); }
+	iterator end() const{ return iterator(); }
+
+private:
+	ofStringView source;
+	std::string delimiter;
+	bool ignoreEmpty, trim;
+};
+
+/// \brief Split a string without copying it.
+///
+/// Works like ofSplitString() but returns views of the tokens in source,
+/// found one by one while iterating, instead of a vector of strings:
+///
+/// ~~~~{.cpp}
+/// for(auto line: buffer.getLineViews()){
+///     float x = 0, y = 0;
+///     size_t column = 0;
+///     for(auto token: ofSplitStringView(line, ",")){
+///         if(column == 0) x = ofToFloat(token);
+///         if(column == 1) y = ofToFloat(token);
+///         column++;
+///     }
+/// }
+/// ~~~~
+///
+/// Trimming only removes ascii whitespace.
+///
+/// \param source The string to split, it has to outlive the returned tokens.
+/// \param delimiter The string to split at.
+/// \param ignoreEmpty Skip empty tokens.
+/// \param trim Remove the whitespace at the start and end of each token.
+inline ofStringViewTokens ofSplitStringView(ofStringView source, const std::string & delimiter, bool ignoreEmpty = false, bool trim = false){
+	return ofStringViewTokens(source, delimiter, ignoreEmpty, trim);
+}
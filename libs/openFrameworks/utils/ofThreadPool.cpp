@@ -0,0 +1,161 @@
+#include "ofThreadPool.h"
+
+#ifndef TARGET_NO_THREADS
+#include <exception>
+
+//--------------------------------------------------
+ofThreadPool::ofThreadPool(size_t numThreads)
+:running(true){
+	for(size_t i = 0; i < numThreads; i++){
+		threads.emplace_back(&ofThreadPool::threadedFunction, this);
+	}
+}
+
+//--------------------------------------------------
+ofThreadPool::~ofThreadPool(){
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		running = false;
+	}
+	condition.notify_all();
+	for(auto & thread: threads){
+		thread.join();
+	}
+}
+
+//--------------------------------------------------
+void ofThreadPool::push(std::function<void()> task){
+	if(threads.empty()){
+		task();
+		return;
+	}
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		tasks.push_back(std::move(task));
+	}
+	condition.notify_one();
+}
+
+//--------------------------------------------------
+void ofThreadPool::parallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)> & function, size_t grainSize){
+	if(end <= begin){
+		return;
+	}
+	grainSize = std::max<size_t>(grainSize, 1);
+	size_t count = end - begin;
+	size_t numChunks = std::min(threads.size() + 1, (count + grainSize - 1) / grainSize);
+	if(numChunks <= 1 || isWorkerThread()){
+		function(begin, end);
+		return;
+	}
+
+	// the state is shared with the tasks so it outlives the last notification
+	struct Sync{
+		std::mutex mutex;
+		std::condition_variable condition;
+		size_t pending;
+		std::exception_ptr exception;
+	};
+	auto sync = std::make_shared<Sync>();
+	sync->pending = numChunks - 1;
+
+	auto chunkBegin = [&](size_t chunk){
+		return begin + count * chunk / numChunks;
+	};
+
+	for(size_t chunk = 1; chunk < numChunks; chunk++){
+		size_t b = chunkBegin(chunk);
+		size_t e = chunkBegin(chunk + 1);
+		push([sync, b, e, &function]{
+			std::exception_ptr exception;
+			try{
+				function(b, e);
+			}catch(...){
+				exception = std::current_exception();
+			}
+			std::unique_lock<std::mutex> lock(sync->mutex);
+			if(exception && !sync->exception){
+				sync->exception = exception;
+			}
+			if(--sync->pending == 0){
+				sync->condition.notify_one();
+			}
+		});
+	}
+
+	std::exception_ptr exception;
+	try{
+		function(begin, chunkBegin(1));
+	}catch(...){
+		exception = std::current_exception();
+	}
+
+	std::unique_lock<std::mutex> lock(sync->mutex);
+	while(sync->pending > 0){
+		sync->condition.wait(lock);
+	}
+	if(!exception){
+		exception = sync->exception;
+	}
+	if(exception){
+		std::rethrow_exception(exception);
+	}
+}
+
+//--------------------------------------------------
+size_t ofThreadPool::getNumThreads() const{
+	return threads.size();
+}
+
+//--------------------------------------------------
+bool ofThreadPool::isWorkerThread() const{
+	auto id = std::this_thread::get_id();
+	for(auto & thread: threads){
+		if(thread.get_id() == id){
+			return true;
+		}
+	}
+	return false;
+}
+
+//--------------------------------------------------
+void ofThreadPool::threadedFunction(){
+	while(true){
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			while(running && tasks.empty()){
+				condition.wait(lock);
+			}
+			if(!running && tasks.empty()){
+				return;
+			}
+			task = std::move(tasks.front());
+			tasks.pop_front();
+		}
+		task();
+	}
+}
+
+//--------------------------------------------------
+ofThreadPool & ofGetThreadPool(){
+	// never destroyed so the workers aren't joined during static destruction
+	static ofThreadPool * pool = new ofThreadPool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+	return *pool;
+}
+
+//--------------------------------------------------
+void ofParallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)> & function, size_t grainSize){
+	ofGetThreadPool().parallelFor(begin, end, function, grainSize);
+}
+
+#else
+
+//--------------------------------------------------
+void ofParallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)> & function, size_t grainSize){
+	if(end > begin){
+		function(begin, end);
+	}
+}
+
+#endif
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "ofConstants.h"
+#include <functional>
+#include <mutex>
+
+/// \cond INTERNAL
+// mutex for core classes that only need to lock when there are threads,
+// with TARGET_NO_THREADS locking it does nothing
+#ifdef TARGET_NO_THREADS
+struct ofCoreMutex{
+	void lock(){}
+	bool try_lock(){ return true; }
+	void unlock(){}
+};
+#else
+typedef std::mutex ofCoreMutex;
+#endif
+typedef std::unique_lock<ofCoreMutex> ofCoreLock;
+/// \endcond
+
+#ifndef TARGET_NO_THREADS
+#include <thread>
+#include <condition_variable>
+#include <deque>
+
+
+/// \brief A fixed set of worker threads that run queued tasks.
+///
+/// ofThreadPool is meant for short, CPU bound jobs like processing
+/// pixels, skinning meshes or generating noise, where creating a thread per
+/// job would cost more than the job itself. Tasks are run in the order they
+/// were pushed.
+///
+/// Most of the time there's no need to create a pool, ofParallelFor uses a
+/// pool shared by the whole application:
+///
+/// ~~~~{.cpp}
+/// ofParallelFor(0, pixels.getHeight(), [&](size_t begin, size_t end){
+///     for(size_t y = begin; y < end; y++){
+///         // process row y
+///     }
+/// });
+/// ~~~~
+class ofThreadPool{
+public:
+	/// \brief Create a pool with the specified number of worker threads.
+	/// \param numThreads Number of workers, 0 creates a pool that runs
+	/// every task in the calling thread.
+	ofThreadPool(size_t numThreads);
+	~ofThreadPool();
+
+	/// \brief Queue a task to be run by one of the workers.
+	/// If the pool has no workers the task is run immediately.
+	void push(std::function<void()> task);
+
+	/// \brief Split [begin, end) in ranges and run them in parallel.
+	///
+	/// The calling thread takes part in the work and the call returns once
+	/// every range has been processed. If called from one of the pool's
+	/// workers the whole range is run in the calling thread to avoid
+	/// deadlocks. Exceptions thrown by \p function are rethrown in the
+	/// calling thread.
+	///
+	/// \param begin First index of the range.
+	/// \param end One past the last index of the range.
+	/// \param function Called with the subrange [begin, end) to process.
+	/// \param grainSize Minimum number of indices per subrange.
+	void parallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)> & function, size_t grainSize = 1);
+
+	/// \returns The number of worker threads in this pool.
+	size_t getNumThreads() const;
+
+	/// \returns true if the calling thread is one of this pool's workers.
+	bool isWorkerThread() const;
+
+private:
+	ofThreadPool(const ofThreadPool&) = delete;
+	ofThreadPool & operator=(const ofThreadPool&) = delete;
+	void threadedFunction();
+
+	std::vector<std::thread> threads;
+	std::deque<std::function<void()>> tasks;
+	mutable std::mutex mutex;
+	std::condition_variable condition;
+	bool running;
+};
+
+/// \brief Get the pool shared by the application.
+///
+/// The pool is created the first time it's requested with one worker less
+/// than the number of hardware threads, since the thread calling
+/// parallelFor takes part in the work.
+ofThreadPool & ofGetThreadPool();
+#endif
+
+/// \brief Run \p function over [begin, end) split across the shared thread pool.
+///
+/// \p function receives the subrange to process and has to be safe to call
+/// concurrently for different subranges. On platforms without threads the
+/// whole range is processed in the calling thread.
+///
+/// \param begin First index of the range.
+/// \param end One past the last index of the range.
+/// \param function Called with the subrange [begin, end) to process.
+/// \param grainSize Minimum number of indices per subrange, ranges smaller
+/// than this are never split.
+void ofParallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)> & function, size_t grainSize = 1);
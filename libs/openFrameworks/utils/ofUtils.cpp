@@ -6,6 +6,7 @@
 #include <chrono>
 #include <numeric>
 #include <locale>
+#include <limits>
 #include "uriparser/Uri.h"
 
 #ifdef TARGET_WIN32	 // For ofLaunchBrowser.
@@ -515,6 +516,97 @@ int64_t ofToInt64(const string& intString) {
 	return ofTo<int64_t>(intString);
 }
 
+//----------------------------------------
+namespace{
+	bool isSpace(char c){
+		return c == ' ' || (c >= '\t' && c <= '\r');
+	}
+
+	// parses like a stream: skips leading whitespace, stops at the first
+	// character that isn't a digit and saturates on overflow
+	template<typename T>
+	T parseInteger(ofStringView str){
+		auto it = str.begin();
+		auto end = str.end();
+		while(it != end && isSpace(*it)){
+			++it;
+		}
+		bool negative = false;
+		if(it != end && (*it == '-' || *it == '+')){
+			negative = *it == '-';
+			++it;
+		}
+		const uint64_t limit = negative ? uint64_t(std::numeric_limits<T>::max()) + 1 : uint64_t(std::numeric_limits<T>::max());
+		uint64_t value = 0;
+		bool overflow = false;
+		for(; it != end && *it >= '0' && *it <= '9'; ++it){
+			uint64_t digit = *it - '0';
+			if(value > (limit - digit) / 10){
+				overflow = true;
+			}else{
+				value = value * 10 + digit;
+			}
+		}
+		if(overflow){
+			return negative ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+		}
+		return negative ? T(-int64_t(value - 1) - 1) : T(value);
+	}
+
+	// strtod needs a null terminated string, copy short numbers to the stack
+	template<typename T, typename F>
+	T parseFloat(ofStringView str, F strtoT){
+		char local[64];
+		if(str.size() < sizeof(local)){
+			memcpy(local, str.data(), str.size());
+			local[str.size()] = 0;
+			return strtoT(local, nullptr);
+		}else{
+			return strtoT(str.toString().c_str(), nullptr);
+		}
+	}
+}
+
+//----------------------------------------
+int ofToInt(ofStringView intString) {
+	return parseInteger<int>(intString);
+}
+
+//----------------------------------------
+int ofToInt(const char * intString) {
+	return ofToInt(string(intString));
+}
+
+//----------------------------------------
+int64_t ofToInt64(ofStringView intString) {
+	return parseInteger<int64_t>(intString);
+}
+
+//----------------------------------------
+int64_t ofToInt64(const char * intString) {
+	return ofToInt64(string(intString));
+}
+
+//----------------------------------------
+float ofToFloat(ofStringView floatString) {
+	return parseFloat<float>(floatString, [](const char * str, char ** end){ return strtof(str, end); });
+}
+
+//----------------------------------------
+float ofToFloat(const char * floatString) {
+	return ofToFloat(string(floatString));
+}
+
+//----------------------------------------
+double ofToDouble(ofStringView doubleString) {
+	return parseFloat<double>(doubleString, [](const char * str, char ** end){ return strtod(str, end); });
+}
+
+//----------------------------------------
+double ofToDouble(const char * doubleString) {
+	return ofToDouble(string(doubleString));
+}
+
 //----------------------------------------
 bool ofToBool(const string& boolString) {
 	auto lower = ofToLower(boolString);
@@ -5,6 +5,8 @@
 #include <bitset> // For ofToBinary.
 
 #include "ofLog.h"
+#include "ofMath.h"
+#include "ofStringView.h"
 
 
 /// \section Elapsed Time
@@ -194,10 +196,14 @@ void ofSetDataPathRoot(const string& root);
 /// \brief Randomly reorder the values in a vector.
 /// \tparam T the type contained by the vector.
 /// \param values The vector of values to modify.
-/// \sa http://www.cplusplus.com/reference/algorithm/random_shuffle/
+///
+/// The order is drawn from the calling thread's ofGetRandomEngine(), so it's
+/// repeatable after ofSeedRandom(val).
+///
+/// \sa http://en.cppreference.com/w/cpp/algorithm/random_shuffle
 template<class T>
 void ofRandomize(vector<T>& values) {
-	random_shuffle(values.begin(), values.end());
+	std::shuffle(values.begin(), values.end(), ofGetRandomEngine());
 }
 
 /// \brief Conditionally remove values from a vector.
@@ -599,6 +605,40 @@ float ofToFloat(const string& floatString);
 /// \returns the double represented by the string or 0 on failure.
 double ofToDouble(const string& doubleString);
 
+/// \brief Convert the characters in a view to an integer without copying
+/// them.
+///
+/// Parses like ofToInt(const string&) but doesn't allocate a string and a
+/// stream for every conversion, for parsing big amounts of text split with
+/// ofSplitStringView() or ofBuffer::getLineViews().
+///
+/// The const char * overloads of these functions only exist so calls with
+/// literals aren't ambiguous and parse like the string versions.
+///
+/// \param intString The characters representing the integer.
+/// \returns the integer represented by the characters or 0 on failure.
+int ofToInt(ofStringView intString);
+int ofToInt(const char * intString);
+
+/// \brief Convert the characters in a view to a int64_t without copying them.
+/// \sa ofToInt(ofStringView)
+int64_t ofToInt64(ofStringView intString);
+int64_t ofToInt64(const char * intString);
+
+/// \brief Convert the characters in a view to a float without copying them.
+///
+/// Uses strtof, so unlike ofToFloat(const string&) it also accepts
+/// hexadecimal floats, "inf" and "nan".
+///
+/// \sa ofToInt(ofStringView)
+float ofToFloat(ofStringView floatString);
+float ofToFloat(const char * floatString);
+
+/// \brief Convert the characters in a view to a double without copying them.
+/// \sa ofToFloat(ofStringView)
+double ofToDouble(ofStringView doubleString);
+double ofToDouble(const char * doubleString);
+
 /// \brief Convert a string to a boolean.
 ///
 /// Converts a std::string representation of a boolean (e.g., `"TRUE"`) to an
@@ -1,6 +1,7 @@
 #include "ofGstUtils.h"
 #ifndef TARGET_ANDROID
 #include "ofUtils.h"
+#include "ofPixelsPool.h"
 #include <gst/app/gstappsink.h>
 #include <gst/video/video.h>
 
@@ -801,6 +802,13 @@ ofGstVideoUtils::ofGstVideoUtils(){
 	glContext = NULL;
 #endif
 	copyPixels = false;
+
+	// the frames are swapped between these every frame, with a pool the
+	// ones that are copied reuse the same memory instead of reallocating it
+	auto pool = std::make_shared<ofPixelsPool>();
+	pixels.setPool(pool);
+	backPixels.setPool(pool);
+	eventPixels.setPool(pool);
 }
 
 ofGstVideoUtils::~ofGstVideoUtils(){
@@ -813,6 +821,7 @@ void ofGstVideoUtils::close(){
 	pixels.clear();
 	backPixels.clear();
 	eventPixels.clear();
+	pixels.getPool()->trim();
 	bIsFrameNew					= false;
 	bHavePixelsChanged			= false;
 	bBackPixelsChanged			= false;
@@ -0,0 +1,689 @@
+#include "ofImageSequencePlayer.h"
+#include "ofImage.h"
+#include "ofFileUtils.h"
+#include "ofThreadPool.h"
+#include "ofUtils.h"
+#include "ofLog.h"
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+#ifndef TARGET_NO_THREADS
+#include <thread>
+#endif
+
+struct ofImageSequencePlayer::Impl{
+	struct Slot{
+		enum State{
+			Empty,
+			Queued,
+			Decoding,
+			Ready,
+			Failed,
+		};
+		int frame = -1;
+		State state = Empty;
+		// position of the frame in the decoding order, lower is sooner
+		size_t priority = std::numeric_limits<size_t>::max();
+		ofPixels pixels;
+	};
+
+	ofCoreMutex mutex;
+
+	Impl(){
+#ifdef TARGET_NO_THREADS
+		numThreads = 0;
+#else
+		numThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+#endif
+	}
+
+	// settings
+	float fps = 30;
+	size_t ahead = 8;
+	size_t behind = 2;
+	size_t numThreads;
+	bool dropFrames = true;
+	ofPixelFormat pixelFormat = OF_PIXELS_NATIVE;
+	ofLoopType loopState = OF_LOOP_NORMAL;
+	float speed = 1;
+
+	// playback, only used from the main thread
+	double position = 0;
+	int direction = 1; // flips at the ends when looping as a palindrome
+	bool playing = false;
+	bool paused = false;
+	bool done = false;
+	bool frameNew = false;
+	bool firstFramePending = false;
+	uint64_t lastUpdate = 0;
+	int displayed = -1; // slot on screen, never reused while displayed
+	ofPixels empty;
+
+	// read by the workers, doesn't change until they are stopped
+	vector<std::filesystem::path> paths;
+
+	// guarded by the mutex, the pixels of a slot being decoded are only
+	// accessed by the worker decoding it
+	vector<Slot> slots;
+	ofImageSequencePlayerStats stats;
+	uint64_t decodeMicros = 0;
+
+#ifndef TARGET_NO_THREADS
+	// declared last so it's stopped before anything the tasks access
+	std::unique_ptr<ofThreadPool> pool;
+#endif
+
+	size_t getNumFrames() const{
+		return paths.size();
+	}
+
+	// index of the frame at a position, before wrapping it around
+	long long index(double p) const{
+		if(loopState == OF_LOOP_PALINDROME){
+			return (long long)std::floor(p + 0.5);
+		}else{
+			return (long long)std::floor(p);
+		}
+	}
+
+	int getFrameAt(double p) const{
+		return std::max(std::min(index(p), (long long)getNumFrames() - 1), 0ll);
+	}
+
+	// the frame a frame index ends up at after wrapping around the ends,
+	// false if it's out of the sequence
+	bool wrap(long long & frame) const{
+		long long n = getNumFrames();
+		switch(loopState){
+		case OF_LOOP_NORMAL:
+			frame = ((frame % n) + n) % n;
+			return true;
+		case OF_LOOP_PALINDROME:
+			if(n == 1){
+				frame = 0;
+			}else{
+				long long period = 2 * (n - 1);
+				frame = ((frame % period) + period) % period;
+				if(frame > n - 1){
+					frame = period - frame;
+				}
+			}
+			return true;
+		case OF_LOOP_NONE:
+		default:
+			return frame >= 0 && frame < n;
+		}
+	}
+
+	// moves the play head, returns how many frames it went past
+	size_t advance(double seconds){
+		double n = getNumFrames();
+		double old = position;
+		position += seconds * fps * speed * direction;
+		size_t steps = std::abs(index(position) - index(old));
+		switch(loopState){
+		case OF_LOOP_NORMAL:
+			position = std::fmod(position, n);
+			if(position < 0){
+				position += n;
+			}
+			break;
+		case OF_LOOP_PALINDROME:{
+			double last = n - 1;
+			if(last == 0){
+				position = 0;
+				break;
+			}
+			while(position < 0 || position > last){
+				position = position < 0 ? -position : 2 * last - position;
+				direction = -direction;
+			}
+			break;
+		}
+		case OF_LOOP_NONE:
+		default:
+			if(position < 0 || position >= n){
+				position = std::max(std::min(position, n - 1), 0.);
+				done = true;
+			}
+			steps = std::abs(index(position) - index(old));
+			break;
+		}
+		return steps;
+	}
+
+	// queues the frames around the play head to be decoded, head first, then
+	// the ones ahead in the direction it's playing, then the ones behind.
+	// has to be called with the mutex locked, returns the number of tasks
+	// to start
+	size_t schedule(int head){
+		vector<int> wanted;
+		auto want = [&](long long frame){
+			if(wrap(frame) && std::find(wanted.begin(), wanted.end(), frame) == wanted.end()){
+				wanted.push_back(frame);
+			}
+		};
+#ifdef TARGET_NO_THREADS
+		want(head);
+#else
+		// when frames can be dropped, the frames the play head will have
+		// gone past by the time they are decoded go last, so if decoding
+		// can't keep up the frames decoded are the ones that can still be
+		// displayed, instead of always finishing the one that was just missed
+		size_t lead = 0;
+		if(dropFrames && playing && !paused && stats.framesDecoded > 0){
+			double decodeSeconds = decodeMicros / 1000000. / stats.framesDecoded;
+			lead = std::min<size_t>(std::ceil(decodeSeconds * fps * std::abs(speed)), ahead);
+		}
+		int step = (speed < 0 ? -1 : 1) * direction;
+		for(size_t i = lead; i <= ahead; i++){
+			want(head + (long long)i * step);
+		}
+		for(size_t i = 0; i < lead; i++){
+			want(head + (long long)i * step);
+		}
+		for(size_t i = 1; i <= behind; i++){
+			want(head - (long long)i * step);
+		}
+#endif
+
+		for(auto & slot: slots){
+			auto it = std::find(wanted.begin(), wanted.end(), slot.frame);
+			slot.priority = it == wanted.end() ? std::numeric_limits<size_t>::max() : it - wanted.begin();
+		}
+
+		// frames that aren't wanted anymore are replaced, the ones queued
+		// but not decoded yet first, then the decoded ones, so going back
+		// to a frame that was just displayed doesn't need decoding it again
+		auto findSlot = [&](){
+			for(auto state: {Slot::Empty, Slot::Queued, Slot::Ready, Slot::Failed}){
+				for(size_t i = 0; i < slots.size(); i++){
+					auto & slot = slots[i];
+					if(slot.state == state && (int)i != displayed
+					   && (state == Slot::Empty || slot.priority == std::numeric_limits<size_t>::max())){
+						return (int)i;
+					}
+				}
+			}
+			return -1;
+		};
+
+		size_t jobs = 0;
+		for(size_t i = 0; i < wanted.size(); i++){
+			bool found = std::any_of(slots.begin(), slots.end(), [&](const Slot & slot){
+				return slot.frame == wanted[i] && slot.state != Slot::Empty;
+			});
+			if(found){
+				continue;
+			}
+			int index = findSlot();
+			if(index < 0){
+				break;
+			}
+			auto & slot = slots[index];
+			if(slot.state != Slot::Queued){
+				// a queued slot already has a task that will decode it
+				jobs++;
+			}
+			slot.frame = wanted[i];
+			slot.state = Slot::Queued;
+			slot.priority = i;
+		}
+		return jobs;
+	}
+
+	void start(size_t jobs){
+		for(size_t i = 0; i < jobs; i++){
+#ifdef TARGET_NO_THREADS
+			decodeNext();
+#else
+			pool->push([this]{
+				decodeNext();
+			});
+#endif
+		}
+	}
+
+	// decodes the queued frame that is needed the soonest, each task
+	// decodes the most urgent frame when it runs, not the one that was
+	// queued when it was started
+	void decodeNext(){
+		ofCoreLock lock(mutex);
+		Slot * next = nullptr;
+		for(auto & slot: slots){
+			if(slot.state == Slot::Queued && (!next || slot.priority < next->priority)){
+				next = &slot;
+			}
+		}
+		if(!next){
+			return;
+		}
+		auto & slot = *next;
+		slot.state = Slot::Decoding;
+		auto & path = paths[slot.frame];
+		auto format = pixelFormat;
+		lock.unlock();
+
+		auto startTime = ofGetElapsedTimeMicros();
+		bool loaded = ofLoadImage(slot.pixels, path);
+		if(loaded){
+			switch(format){
+			case OF_PIXELS_GRAY:
+				slot.pixels.setImageType(OF_IMAGE_GRAYSCALE);
+				break;
+			case OF_PIXELS_RGB:
+				slot.pixels.setImageType(OF_IMAGE_COLOR);
+				break;
+			case OF_PIXELS_RGBA:
+				slot.pixels.setImageType(OF_IMAGE_COLOR_ALPHA);
+				break;
+			default:
+				break;
+			}
+		}else{
+			ofLogError("ofImageSequencePlayer") << "couldn't load frame " << path;
+		}
+		auto elapsed = ofGetElapsedTimeMicros() - startTime;
+
+		lock.lock();
+		slot.state = loaded ? Slot::Ready : Slot::Failed;
+		if(loaded){
+			stats.framesDecoded++;
+			decodeMicros += elapsed;
+		}else{
+			stats.decodeFailures++;
+		}
+	}
+
+	int findReady(int frame){
+		for(size_t i = 0; i < slots.size(); i++){
+			if(slots[i].frame == frame && slots[i].state == Slot::Ready){
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	bool isFailed(int frame){
+		return std::any_of(slots.begin(), slots.end(), [&](const Slot & slot){
+			return slot.frame == frame && slot.state == Slot::Failed;
+		});
+	}
+
+	int getDisplayedFrame() const{
+		return displayed < 0 ? -1 : slots[displayed].frame;
+	}
+
+	void update(){
+		frameNew = firstFramePending;
+		firstFramePending = false;
+		if(paths.empty()){
+			return;
+		}
+
+		auto now = ofGetElapsedTimeMicros();
+		double oldPosition = position;
+		int oldDirection = direction;
+		int oldHead = getFrameAt(position);
+		size_t steps = 0;
+		if(playing && !paused && !done){
+			steps = advance((now - lastUpdate) / 1000000.);
+		}
+		lastUpdate = now;
+		int head = getFrameAt(position);
+
+		size_t jobs;
+		{
+			ofCoreLock lock(mutex);
+			jobs = schedule(head);
+		}
+		start(jobs);
+
+		ofCoreLock lock(mutex);
+		int ready = findReady(head);
+		if(ready < 0 && !dropFrames && head != getDisplayedFrame() && !isFailed(head) && steps > 0){
+			// wait for the frame instead of moving past it
+			position = oldPosition;
+			direction = oldDirection;
+			done = false;
+			return;
+		}
+		if(steps > 0){
+			// the frames in between were never under the play head and the
+			// previous one only counts if it was displayed
+			stats.framesDropped += steps - 1;
+			if(oldHead != getDisplayedFrame()){
+				stats.framesDropped++;
+			}
+		}
+		if(ready >= 0 && ready != displayed){
+			displayed = ready;
+			frameNew = true;
+			stats.framesShown++;
+		}
+	}
+
+	void seek(int frame){
+		if(paths.empty()){
+			return;
+		}
+		long long wrapped = frame;
+		if(!wrap(wrapped)){
+			wrapped = std::max(std::min(wrapped, (long long)getNumFrames() - 1), 0ll);
+		}
+		position = wrapped;
+		done = false;
+		size_t jobs;
+		{
+			ofCoreLock lock(mutex);
+			jobs = schedule(wrapped);
+		}
+		start(jobs);
+	}
+
+	void close(){
+		{
+			ofCoreLock lock(mutex);
+			// the tasks still queued find nothing to do
+			for(auto & slot: slots){
+				if(slot.state == Slot::Queued){
+					slot.state = Slot::Empty;
+				}
+			}
+		}
+#ifndef TARGET_NO_THREADS
+		pool.reset();
+#endif
+		slots.clear();
+		paths.clear();
+		stats = ofImageSequencePlayerStats();
+		decodeMicros = 0;
+		displayed = -1;
+		position = 0;
+		direction = 1;
+		playing = false;
+		paused = false;
+		done = false;
+		frameNew = false;
+		firstFramePending = false;
+	}
+};
+
+//--------------------------------------------------
+ofImageSequencePlayer::ofImageSequencePlayer()
+:impl(new Impl){}
+
+//--------------------------------------------------
+ofImageSequencePlayer::~ofImageSequencePlayer(){
+	impl->close();
+}
+
+//--------------------------------------------------
+bool ofImageSequencePlayer::load(string path){
+	close();
+
+	ofDirectory dir(path);
+	for(auto extension: {"bmp", "exr", "gif", "hdr", "jpeg", "jpg", "ofpix", "png", "psd", "qoi", "tga", "tif", "tiff"}){
+		dir.allowExt(extension);
+	}
+	auto listing = dir.scan(false);
+	listing.sort();
+	for(size_t i = 0; i < listing.size(); i++){
+		if(listing.isFile(i)){
+			impl->paths.push_back(listing.getPath(i));
+		}
+	}
+	if(impl->paths.empty()){
+		ofLogError("ofImageSequencePlayer") << "couldn't load \"" << path << "\", no images found";
+		return false;
+	}
+
+	// the first frame is decoded right away so the size is known after
+	// loading
+	impl->slots.resize(std::max<size_t>(std::min(impl->ahead + impl->behind + 2, impl->paths.size()), 1));
+	impl->slots[0].frame = 0;
+	impl->slots[0].state = Impl::Slot::Queued;
+	impl->decodeNext();
+	if(impl->slots[0].state != Impl::Slot::Ready){
+		close();
+		return false;
+	}
+	impl->displayed = 0;
+	impl->stats.framesShown = 1;
+	impl->firstFramePending = true;
+	impl->lastUpdate = ofGetElapsedTimeMicros();
+
+#ifndef TARGET_NO_THREADS
+	impl->pool.reset(new ofThreadPool(std::max<size_t>(impl->numThreads, 1)));
+#endif
+	impl->seek(0);
+	return true;
+}
+
+//--------------------------------------------------
+void ofImageSequencePlayer::close(){
+	impl->close();
+}
+
+//--------------------------------------------------
+void ofImageSequencePlayer::setFrameRate(float fps){
+	impl->fps = std::max(fps, 0.f);
+}
+
+//--------------------------------------------------
+float ofImageSequencePlayer::getFrameRate() const{
+	return impl->fps;
+}
+
+//--------------------------------------------------
+void ofImageSequencePlayer::setNumPrefetchFrames(size_t ahead, size_t behind){
+	impl->ahead = ahead;
+	impl->behind = behind;
+}
+
+//--------------------------------------------------
+void ofImageSequencePlayer::setNumThreads(size_t numThreads){
+	impl->numThreads = numThreads;
+}
+
+//--------------------------------------------------
+void ofImageSequencePlayer::setDropFrames(bool drop){
+	impl->dropFrames = drop;
+}
+
+//--------------------------------------------------
+bool ofImageSequencePlayer::isDropFrames() const{
+	return impl->dropFrames;
+}
+
+//--------------------------------------------------
+ofImageSequencePlayerStats ofImageSequencePlayer::getStats() const{
+	ofCoreLock lock(impl->mutex);
+	auto stats = impl->stats;
+	stats.framesReady = std::count_if(impl->slots.begin(), impl->slots.end(), [](const Impl::Slot & slot){
+		return slot.state == Impl::Slot::Ready;
+	});
+	if(stats.framesDecoded > 0){
+		stats.averageDecodeMillis = impl->decodeMicros / 1000.f / stats.framesDecoded;
+	}
+	return stats;
+}
+
+//--------------------------------------------------
+bool ofImageSequencePlayer::setPixelFormat(ofPixelFormat pixelFormat){
+	switch(pixelFormat){
+	case OF_PIXELS_NATIVE:
+	case OF_PIXELS_GRAY:
+	case OF_PIXELS_RGB:
+	case OF_PIXELS_RGBA:{
+		ofCoreLock lock(impl->mutex);
+		impl->pixelFormat = pixelFormat;
+		return true;
+	}
+	default:
+		ofLogError("ofImageSequencePlayer") << "setPixelFormat(): only native, gray, rgb and rgba pixels are supported";
+		return false;
+	}
+}
+
+//--------------------------------------------------
+ofPixelFormat ofImageSequencePlayer::getPixelFormat() const{
+	if(impl->pixelFormat == OF_PIXELS_NATIVE && isLoaded()){
+		return getPixels().getPixelFormat();
+	}
+	return impl->pixelFormat;
+}
+
+//--------------------------------------------------
+void ofImageSequencePlayer::update(){
+	impl->update();
+}
+
+//--------------------------------------------------
+bool ofImageSequencePlayer::isFrameNew() const{
+	return impl->frameNew;
+}
+
+//--------------------------------------------------
+ofPixels & ofImageSequencePlayer::getPixels(){
+	return impl->displayed < 0 ? impl->empty : impl->slots[impl->displayed].pixels;
+}
+
+//--------------------------------------------------
+const ofPixels & ofImageSequencePlayer::getPixels() const{
+	return impl->displayed < 0 ? impl->empty : impl->slots[impl->displayed].pixels;
+}
+
+//--------------------------------------------------
+float ofImageSequencePlayer::getWidth() const{
+	return getPixels().getWidth();
+}
+
+//--------------------------------------------------
+float ofImageSequencePlayer::getHeight() const{
+	return getPixels().getHeight();
+}
+
+//--------------------------------------------------
+void ofImageSequencePlayer::play(){
+	if(impl->done){
+		impl->seek(impl->speed < 0 ? getTotalNumFrames() - 1 : 0);
+	}
+	impl->playing = true;
+	impl->paused = false;
+	impl->lastUpdate = ofGetElapsedTimeMicros();
+}
+
+//--------------------------------------------------
+void ofImageSequencePlayer::stop(){
+	impl->playing = false;
+	impl->paused = false;
+}
+
+//--------------------------------------------------
+void ofImageSequencePlayer::setPaused(bool paused){
+	if(impl->paused && !paused){
+		impl->lastUpdate = ofGetElapsedTimeMicros();
+	}
+	impl->paused = paused;
+}
+
+//--------------------------------------------------
+bool ofImageSequencePlayer::isPaused() const{
+	return impl->paused;
+}
+
+//--------------------------------------------------
+bool ofImageSequencePlayer::isLoaded() const{
+	return impl->displayed >= 0;
+}
+
+//--------------------------------------------------
+bool ofImageSequencePlayer::isPlaying() const{
+	return impl->playing;
+}
+
+//--------------------------------------------------
+float ofImageSequencePlayer::getPosition() const{
+	if(impl->paths.empty()){
+		return 0;
+	}
+	return impl->position / impl->getNumFrames();
+}
+
+//--------------------------------------------------
+void ofImageSequencePlayer::setPosition(float pct){
+	impl->seek(pct * getTotalNumFrames());
+}
+
+//--------------------------------------------------
+float ofImageSequencePlayer::getDuration() const{
+	if(impl->fps == 0){
+		return 0;
+	}
+	return impl->getNumFrames() / impl->fps;
+}
+
+//--------------------------------------------------
+bool ofImageSequencePlayer::getIsMovieDone() const{
+	return impl->done;
+}
+
+//--------------------------------------------------
+void ofImageSequencePlayer::setSpeed(float speed){
+	impl->speed = speed;
+}
+
+//--------------------------------------------------
+float ofImageSequencePlayer::getSpeed() const{
+	return impl->speed;
+}
+
+//--------------------------------------------------
+void ofImageSequencePlayer::setLoopState(ofLoopType state){
+	impl->loopState = state;
+	impl->direction = 1;
+}
+
+//--------------------------------------------------
+ofLoopType ofImageSequencePlayer::getLoopState() const{
+	return impl->loopState;
+}
+
+//--------------------------------------------------
+void ofImageSequencePlayer::setFrame(int frame){
+	impl->seek(frame);
+}
+
+//--------------------------------------------------
+int ofImageSequencePlayer::getCurrentFrame() const{
+	return impl->getDisplayedFrame();
+}
+
+//--------------------------------------------------
+int ofImageSequencePlayer::getTotalNumFrames() const{
+	return impl->getNumFrames();
+}
+
+//--------------------------------------------------
+void ofImageSequencePlayer::firstFrame(){
+	impl->seek(0);
+}
+
+//--------------------------------------------------
+void ofImageSequencePlayer::nextFrame(){
+	// relative to the play head, the frame displayed might not have caught
+	// up with it yet
+	impl->seek(impl->getFrameAt(impl->position) + 1);
+}
+
+//--------------------------------------------------
+void ofImageSequencePlayer::previousFrame(){
+	impl->seek(impl->getFrameAt(impl->position) - 1);
+}
+
+//--------------------------------------------------
+const std::filesystem::path & ofImageSequencePlayer::getFramePath(size_t frame) const{
+	return impl->paths[frame];
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofBaseTypes.h"
+#include "ofPixels.h"
+#include <memory>
+
+class ofThreadPool;
+
+/// \brief What an ofImageSequencePlayer has done since it was loaded.
+struct ofImageSequencePlayerStats{
+	/// Frames that were displayed.
+	uint64_t framesShown = 0;
+	/// Frames the play head went past that weren't decoded in time, or
+	/// couldn't be decoded, and were never displayed.
+	uint64_t framesDropped = 0;
+	/// Frames decoded by the worker threads, including the ones that were
+	/// decoded again after being evicted from the pool.
+	uint64_t framesDecoded = 0;
+	/// Files that couldn't be decoded.
+	uint64_t decodeFailures = 0;
+	/// Frames in the pool ready to be displayed.
+	size_t framesReady = 0;
+	/// Average time it took to decode a frame.
+	float averageDecodeMillis = 0;
+};
+
+/// \class ofImageSequencePlayer
+///
+/// Plays a folder of images, one image per frame in the order of their
+/// names, as if it was a movie.
+///
+/// The folder is listed once when loading it. Frames are decoded on worker
+/// threads into a fixed pool of pixels holding the frames ahead of the play
+/// head, in the direction it's playing, and a few behind it, so update()
+/// never waits for a file to be loaded. If a frame isn't ready by the time
+/// it should be displayed the last one stays on screen and the frame is
+/// dropped, or, with setDropFrames(false), the play head waits for it.
+///
+/// It can be used on its own, uploading getPixels() to a texture when
+/// isFrameNew(), or through ofVideoPlayer:
+///
+/// ~~~~{.cpp}
+/// void ofApp::setup(){
+///     auto sequence = std::make_shared<ofImageSequencePlayer>();
+///     sequence->setFrameRate(24);
+///     player.setPlayer(sequence);
+///     player.load("frames");
+///     player.play();
+/// }
+/// ~~~~
+class ofImageSequencePlayer: public ofBaseVideoPlayer{
+public:
+	ofImageSequencePlayer();
+	~ofImageSequencePlayer();
+
+	/// \brief List the images in a folder and decode the first one.
+	///
+	/// Files with extensions other than the image formats supported by
+	/// ofLoadImage are ignored.
+	///
+	/// \param path Folder with the images, relative to the data folder.
+	/// \returns false if the folder has no images or the first one
+	/// couldn't be loaded.
+	bool load(string path);
+	void close();
+
+	/// \brief Set the frames per second the sequence is played at, 30 by
+	/// default.
+	void setFrameRate(float fps);
+	float getFrameRate() const;
+
+	/// \brief Set how many frames are decoded ahead of the play head, in
+	/// the direction it's playing, and behind it.
+	///
+	/// The pool holds as many frames as both plus two, the one displayed
+	/// and one more to decode while it's displayed. Takes effect on the
+	/// next call to load().
+	void setNumPrefetchFrames(size_t ahead, size_t behind);
+
+	/// \brief Set the number of threads decoding frames. Takes effect on
+	/// the next call to load().
+	void setNumThreads(size_t numThreads);
+
+	/// \brief Set what happens when a frame isn't ready when it should be
+	/// displayed.
+	///
+	/// \param drop If true, the default, the play head keeps moving and
+	/// the last frame stays on screen until the one under the play head is
+	/// ready. If false the play head waits for the frame so no frame is
+	/// skipped but playback slows down.
+	void setDropFrames(bool drop);
+	bool isDropFrames() const;
+
+	ofImageSequencePlayerStats getStats() const;
+
+	/// \brief Set the format of the pixels of the frames, has to be called
+	/// before load().
+	///
+	/// OF_PIXELS_NATIVE, the default, keeps the format of each image,
+	/// OF_PIXELS_GRAY, OF_PIXELS_RGB and OF_PIXELS_RGBA convert to that
+	/// format while decoding.
+	bool setPixelFormat(ofPixelFormat pixelFormat);
+	ofPixelFormat getPixelFormat() const;
+
+	/// \brief Advance the play head and display the frame under it if it's
+	/// ready, then queue the frames around it to be decoded.
+	void update();
+	bool isFrameNew() const;
+
+	/// \returns the pixels of the frame displayed, they stay valid and
+	/// unchanged until the next call to update().
+	ofPixels & getPixels();
+	const ofPixels & getPixels() const;
+
+	float getWidth() const;
+	float getHeight() const;
+
+	void play();
+	void stop();
+	void setPaused(bool paused);
+	bool isPaused() const;
+	bool isLoaded() const;
+	bool isPlaying() const;
+
+	float getPosition() const;
+	void setPosition(float pct);
+	float getDuration() const;
+	bool getIsMovieDone() const;
+
+	/// \brief Set the speed of playback, negative speeds play backwards.
+	void setSpeed(float speed);
+	float getSpeed() const;
+
+	void setLoopState(ofLoopType state);
+	ofLoopType getLoopState() const;
+
+	/// \brief Move the play head to a frame.
+	///
+	/// The frame is displayed by the first call to update() after it's
+	/// decoded, until then the last frame stays on screen.
+	void setFrame(int frame);
+
+	/// \returns the frame displayed.
+	int getCurrentFrame() const;
+	int getTotalNumFrames() const;
+
+	void firstFrame();
+	void nextFrame();
+	void previousFrame();
+
+	/// \returns the path of the file of a frame.
+	const std::filesystem::path & getFramePath(size_t frame) const;
+
+private:
+	ofImageSequencePlayer(const ofImageSequencePlayer &) = delete;
+	ofImageSequencePlayer & operator=(const ofImageSequencePlayer &) = delete;
+
+	struct Impl;
+	std::unique_ptr<Impl> impl;
+};
@@ -249,6 +249,10 @@ $(OF_CORE_OBJ_OUTPUT_PATH)%.o: $(OF_ROOT)/%.m $(OF_CORE_OBJ_OUTPUT_PATH).compile
 	@mkdir -p $(@D)
 	$(CC) $(OPTIMIZATION_CFLAGS) $(CFLAGS) $(CXXFLAGS) -MMD -MP -MF $(OF_CORE_OBJ_OUTPUT_PATH)$*.d -MT$(OF_CORE_OBJ_OUTPUT_PATH)$*.o -o $@ -c $<
 
+# the batch noise functions have to give the same results as the scalar ones,
+# so don't let the compiler fuse multiplies and adds differently in each
+$(OF_CORE_OBJ_OUTPUT_PATH)libs/openFrameworks/utils/ofNoise.o: CXXFLAGS += -ffp-contract=off
+
 # this target does the linking of the library
 # $(TARGET) : $(OF_CORE_OBJ_FILES) means that each of the items in the
 # $(OF_CORE_OBJ_FILES) must be processed first
@@ -0,0 +1,185 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofxThreadedImageLoader.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// each image is filled with its own number so it can be recognized
+	int imageNumber(ofImage & image){
+		return image.isAllocated() ? image.getColor(0, 0).r : -1;
+	}
+
+	// images are decoded in other threads so on a busy machine it can
+	// take a while
+	template<typename Done>
+	bool waitUntil(Done done){
+		auto deadline = ofGetElapsedTimeMillis() + 10000;
+		while(!done() && ofGetElapsedTimeMillis() < deadline){
+			ofSleepMillis(1);
+		}
+		return done();
+	}
+
+	// the tests run from setup so the uploads, done on update, have to be
+	// triggered by hand
+	bool uploadAll(ofxThreadedImageLoader & loader){
+		auto deadline = ofGetElapsedTimeMillis() + 10000;
+		while(loader.getNumLoading() > 0 && ofGetElapsedTimeMillis() < deadline){
+			ofEvents().notifyUpdate();
+			ofSleepMillis(1);
+		}
+		return loader.getNumLoading() == 0;
+	}
+
+	// without textures the images can be uploaded without a window
+	vector<ofImage> images(size_t numImages){
+		vector<ofImage> images(numImages);
+		for(auto & image: images){
+			image.setUseTexture(false);
+		}
+		return images;
+	}
+
+	string path(int i){
+		return "image" + ofToString(i) + ".png";
+	}
+
+	void run(){
+		const int numImages = 6;
+		const int width = 16, height = 16;
+		const uint64_t imageBytes = width * height * 3;
+		for(int i = 0; i < numImages; i++){
+			ofPixels pixels;
+			pixels.allocate(width, height, OF_PIXELS_RGB);
+			pixels.setColor(ofColor(i, 0, 0));
+			ofSaveImage(pixels, path(i));
+		}
+
+		{
+			ofxThreadedImageLoader loader;
+			auto loaded = images(2);
+			auto id = loader.loadFromDisk(loaded[0], path(3));
+			auto missing = loader.loadFromDisk(loaded[1], "missing.png");
+			test(loader.isLoading(id), "loading until uploaded");
+			test_eq(loader.getNumLoading(), 2, "num loading");
+			test(uploadAll(loader), "load");
+			test(!loader.isLoading(id), "not loading once uploaded");
+			test_eq(imageNumber(loaded[0]), 3, "loaded image");
+			test(!loader.isLoading(missing), "failed loads finish");
+			test(!loaded[1].isAllocated(), "failed loads leave the image as it was");
+		}
+
+		{
+			// with a single thread and room for a single decoded image, the
+			// images are decoded and uploaded one by one, in the order of
+			// their priorities
+			ofxThreadedImageLoader loader;
+			loader.setNumThreads(1);
+			loader.setMaxDecodedBytes(1);
+			loader.setUpdateBudget(0);
+			auto loaded = images(numImages);
+
+			// the first image blocks the thread until it's uploaded so the
+			// rest are queued before any of them is decoded
+			loader.loadFromDisk(loaded[0], path(0));
+			test(waitUntil([&]{ return loader.getNumDecoded() == 1; }), "first image decoded");
+			loader.loadFromDisk(loaded[1], path(1), 0);
+			loader.loadFromDisk(loaded[2], path(2), 5);
+			loader.loadFromDisk(loaded[3], path(3), 1);
+			auto raised = loader.loadFromDisk(loaded[4], path(4), 0);
+			auto cancelled = loader.loadFromDisk(loaded[5], path(5), 3);
+			loader.setPriority(raised, 2);
+			loader.cancel(cancelled);
+			test(!loader.isLoading(cancelled), "cancelled requests aren't loading");
+			test_eq(loader.getNumLoading(), numImages - 1, "num loading after cancel");
+
+			vector<int> order;
+			while(loader.getNumLoading() > 0 && waitUntil([&]{ return loader.getNumDecoded() > 0; })){
+				ofEvents().notifyUpdate();
+				for(int i = 0; i < numImages; i++){
+					if(loaded[i].isAllocated() && std::find(order.begin(), order.end(), i) == order.end()){
+						order.push_back(i);
+					}
+				}
+			}
+			test_eq(ofToString(order), ofToString(vector<int>{0, 2, 4, 3, 1}), "loaded by priority");
+			test(!loaded[5].isAllocated(), "cancelled images are left as they were");
+		}
+
+		{
+			// images being decoded count against the budget so with room
+			// for two images, three threads never have more than two
+			// decoded
+			ofxThreadedImageLoader loader;
+			loader.setNumThreads(3);
+			loader.setMaxDecodedBytes(2 * imageBytes);
+			loader.setUpdateBudget(0);
+			auto loaded = images(numImages);
+			for(int i = 0; i < numImages; i++){
+				loader.loadFromDisk(loaded[i], path(i));
+			}
+			bool reachedBudget = true;
+			bool withinBudget = true;
+			while(loader.getNumLoading() > 0){
+				auto expected = std::min<size_t>(loader.getNumLoading(), 2);
+				if(!waitUntil([&]{ return loader.getNumDecoded() >= expected; })){
+					reachedBudget = false;
+					break;
+				}
+				// leaves time to the other threads to go over the budget
+				ofSleepMillis(5);
+				withinBudget &= loader.getNumDecoded() <= 2;
+				ofEvents().notifyUpdate();
+			}
+			test(reachedBudget, "decodes as many images as fit in the budget");
+			test(withinBudget, "doesn't decode more images than fit in the budget");
+			bool allLoaded = true;
+			for(int i = 0; i < numImages; i++){
+				allLoaded &= imageNumber(loaded[i]) == i;
+			}
+			test(allLoaded, "loads every image within the budget");
+		}
+
+		{
+			// a 0ms update budget still uploads one image per update
+			ofxThreadedImageLoader loader;
+			loader.setUpdateBudget(0);
+			auto loaded = images(4);
+			vector<int> ids;
+			for(int i = 0; i < 4; i++){
+				ids.push_back(loader.loadFromDisk(loaded[i], path(i)));
+			}
+			test(waitUntil([&]{ return loader.getNumDecoded() == 4; }), "all decoded");
+			loader.cancel(ids[1]);
+			test_eq(loader.getNumDecoded(), 3, "cancelling drops decoded images");
+			ofEvents().notifyUpdate();
+			test_eq(loader.getNumLoading(), 2, "one upload per update with no budget");
+			loader.setUpdateBudget(1000);
+			ofEvents().notifyUpdate();
+			test_eq(loader.getNumLoading(), 0, "uploads everything decoded within the budget");
+			test(!loaded[1].isAllocated(), "cancelled decoded images are left as they were");
+
+			loader.setMaxDecodedBytes(1);
+			for(int i = 0; i < 4; i++){
+				loader.loadFromDisk(loaded[i], path(numImages - 1));
+			}
+			loader.cancelAll();
+			test_eq(loader.getNumLoading(), 0, "cancel all");
+			ofSleepMillis(20);
+			ofEvents().notifyUpdate();
+			test_eq(imageNumber(loaded[0]), 0, "cancel all leaves the images as they were");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+    ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	// this kicks off the running of my app
+	// can be OF_WINDOW or OF_FULLSCREEN
+	// pass in width and height too:
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,107 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		ofAssetCache cache;
+		cache.setDirectory("testcache");
+		cache.clear();
+		test_eq(cache.getSize(), uint64_t(0), "empty cache");
+
+		auto key = ofAssetCache::makeKey(ofBuffer("source", 6), "parameters");
+		test_eq(key.size(), size_t(32), "key size");
+		test(key == ofAssetCache::makeKey(ofBuffer("source", 6), "parameters"), "same key for the same source");
+		test(key != ofAssetCache::makeKey(ofBuffer("source", 6), "other parameters"), "parameters change the key");
+		test(key != ofAssetCache::makeKey(ofBuffer("sourcE", 6), "parameters"), "contents change the key");
+
+		ofPixels pixels;
+		pixels.allocate(5, 3, OF_PIXELS_RGBA);
+		for(size_t i = 0; i < pixels.size(); i++){
+			pixels[i] = i;
+		}
+		ofPixels loaded;
+		test(!cache.load(key, loaded), "missing entry");
+		test(cache.store(key, pixels), "store pixels");
+		test(cache.load(key, loaded), "load pixels");
+		test_eq(loaded.getWidth(), size_t(5), "width");
+		test_eq(loaded.getHeight(), size_t(3), "height");
+		test_eq(loaded.getPixelFormat(), OF_PIXELS_RGBA, "pixel format");
+		test(std::equal(pixels.begin(), pixels.end(), loaded.begin()), "pixels");
+		ofFloatPixels floatPixels;
+		test(!cache.load(key, floatPixels), "pixels of another type");
+		auto sizeWithEntry = cache.getSize();
+		test(cache.store(key, pixels) && cache.getSize() == sizeWithEntry, "replacing an entry keeps the size");
+
+		ofMesh mesh;
+		mesh.setMode(OF_PRIMITIVE_LINES);
+		mesh.addVertex({1, 2, 3});
+		mesh.addVertex({4, 5, 6});
+		mesh.addColor(ofFloatColor::red);
+		mesh.addIndex(1);
+		mesh.addIndex(0);
+		auto meshKey = ofAssetCache::makeKey(ofBuffer("mesh", 4), "");
+		ofMesh loadedMesh;
+		test(cache.store(meshKey, mesh), "store mesh");
+		test(cache.load(meshKey, loadedMesh), "load mesh");
+		test_eq(loadedMesh.getMode(), OF_PRIMITIVE_LINES, "mesh mode");
+		test(loadedMesh.getVertices() == mesh.getVertices(), "mesh vertices");
+		test(loadedMesh.getColors() == mesh.getColors(), "mesh colors");
+		test(loadedMesh.getIndices() == mesh.getIndices(), "mesh indices");
+		test_eq(loadedMesh.getNumNormals(), size_t(0), "mesh normals");
+		test(!cache.load(key, loadedMesh), "pixels aren't a mesh");
+
+		// entries used least recently are evicted first
+		cache.setMaxSize(1000);
+		vector<string> keys;
+		for(int i = 0; i < 20; i++){
+			auto name = ofToString(i);
+			keys.push_back(ofAssetCache::makeKey(ofBuffer(name.c_str(), name.size()), ""));
+			cache.store(keys.back(), pixels);
+			// the time of the last use has a resolution of seconds
+			std::filesystem::last_write_time(ofToDataPath("testcache/" + keys.back()), std::time(nullptr) - 100 + i);
+		}
+		test(cache.getSize() <= 1000, "size is limited");
+		test(!cache.load(keys.front(), loaded), "old entries are evicted");
+		test(cache.load(keys.back(), loaded), "recent entries are kept");
+		cache.clear();
+		test_eq(cache.getSize(), uint64_t(0), "clear");
+
+		// images opt in through the load settings
+		ofPixels image;
+		image.allocate(8, 8, OF_PIXELS_RGB);
+		image.setColor(ofColor::green);
+		ofSaveImage(image, "cached.png");
+		ofGetAssetCache().setDirectory("testcache");
+		ofImageLoadSettings settings;
+		settings.useCache = true;
+		test(ofLoadImage(loaded, "cached.png", settings), "load image");
+		test(ofGetAssetCache().getSize() > 0, "decoded image is cached");
+		auto imageKey = ofAssetCache::makeKey(ofBufferFromFile("cached.png"), "ofPixels 1 0000");
+		ofPixels cached;
+		test(ofGetAssetCache().load(imageKey, cached) && cached.getColor(3, 3) == ofColor::green, "cached pixels");
+		// an entry that's different from the file proves it's read from
+		// the cache
+		cached.setColor(ofColor::blue);
+		ofGetAssetCache().store(imageKey, cached);
+		test(ofLoadImage(loaded, "cached.png", settings) && loaded.getColor(3, 3) == ofColor::blue, "image is loaded from the cache");
+		test(ofLoadImage(loaded, "cached.png") && loaded.getColor(3, 3) == ofColor::green, "the cache is opt in");
+		// tga files have no signature, FreeImage finds them by the extension
+		ofSaveImage(image, "cached.tga");
+		test(ofLoadImage(loaded, "cached.tga", settings) && loaded.getColor(3, 3) == ofColor::green, "formats known by the extension load with the cache");
+		ofFile::removeFile("cached.tga");
+
+		ofGetAssetCache().clear();
+		ofDirectory::removeDirectory("testcache", true);
+		ofFile::removeFile("cached.png");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,120 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+// a glyph filled with a value that identifies it so its pixels can be
+// checked after being moved around the atlas
+ofPixels makeGlyph(int width, int height, uint32_t id){
+	ofPixels pixels;
+	pixels.allocate(width, height, OF_PIXELS_GRAY_ALPHA);
+	pixels.set(0, 255);
+	pixels.set(1, id % 251 + 1);
+	return pixels;
+}
+
+bool hasGlyph(const ofGlyphAtlas & atlas, const ofGlyphAtlas::Region & region, uint32_t id){
+	auto & pixels = atlas.getPixels();
+	for(int y = region.y; y < region.y + region.height; y++){
+		for(int x = region.x; x < region.x + region.width; x++){
+			if(pixels.getData()[pixels.getPixelIndex(x, y) + 1] != id % 251 + 1){
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+class ofApp: public ofxUnitTestsApp{
+public:
+	void run(){
+		ofSeedRandom(0);
+		ofSkylinePacker packer(256, 256);
+		vector<ofRectangle> packed;
+		int x, y;
+		for(int i = 0; i < 2000; i++){
+			int w = ofRandom(4, 24);
+			int h = ofRandom(8, 24);
+			if(packer.pack(w, h, x, y)){
+				packed.emplace_back(x, y, w, h);
+			}
+		}
+		bool inside = std::all_of(packed.begin(), packed.end(), [](const ofRectangle & r){
+			return r.x >= 0 && r.y >= 0 && r.getRight() <= 256 && r.getBottom() <= 256;
+		});
+		test(inside, "packed rectangles are inside the area");
+		bool overlap = false;
+		for(size_t i = 0; i < packed.size() && !overlap; i++){
+			for(size_t j = i + 1; j < packed.size() && !overlap; j++){
+				auto intersection = packed[i].getIntersection(packed[j]);
+				overlap = intersection.width > 0 && intersection.height > 0;
+			}
+		}
+		test(!overlap, "packed rectangles don't overlap");
+		test_gt(packer.getOccupancy(), 0.75f, "packer fills most of the area");
+		test(!packer.pack(257, 1, x, y), "rectangles wider than the area don't fit");
+
+		ofGlyphAtlas atlas;
+		atlas.allocate(128, 128);
+		auto empty = atlas.add(' ', ofPixels());
+		test(empty && empty->width == 0 && atlas.contains(' '), "glyphs without pixels are stored with an empty region");
+		test(atlas.add('W', makeGlyph(200, 10, 'W')) == nullptr, "glyphs bigger than the atlas aren't added");
+		test(atlas.isTooLarge('W') && !atlas.isTooLarge(' '), "glyphs bigger than the atlas are remembered");
+		test(atlas.isDirty(), "allocating marks the atlas dirty");
+		atlas.clearDirty();
+
+		// fill the atlas several times over, the last glyphs added must
+		// always be there with their pixels
+		uint32_t next = 0;
+		for(; next < 400; next++){
+			auto region = atlas.add(next, makeGlyph(10 + next % 7, 14, next));
+			if(!region){
+				break;
+			}
+		}
+		test_eq(next, 400u, "adding glyphs evicts old ones when the atlas is full");
+		test_gt(atlas.getNumEvicted(), 0u, "some glyphs were evicted");
+		bool contents = true;
+		for(uint32_t i = 390; i < 400; i++){
+			auto region = atlas.get(i);
+			contents &= region && hasGlyph(atlas, *region, i);
+		}
+		test(contents, "recently used glyphs keep their pixels after evicting");
+		test(atlas.isDirty(), "adding glyphs marks the atlas dirty");
+
+		// glyphs used in the current batch are never evicted
+		atlas.beginBatch();
+		vector<uint32_t> batch = {390, 391, 392};
+		for(auto glyph: batch){
+			atlas.get(glyph);
+		}
+		for(uint32_t i = 1000; i < 1300; i++){
+			atlas.beginBatch();
+			for(auto glyph: batch){
+				atlas.get(glyph);
+			}
+			atlas.add(i, makeGlyph(12, 14, i));
+		}
+		bool kept = true;
+		for(auto glyph: batch){
+			auto region = atlas.get(glyph);
+			kept &= region && hasGlyph(atlas, *region, glyph);
+		}
+		test(kept, "glyphs used in the current batch aren't evicted");
+
+		atlas.beginBatch();
+		size_t added = 0;
+		for(uint32_t i = 2000; i < 2200; i++){
+			added += atlas.add(i, makeGlyph(12, 14, i)) != nullptr;
+		}
+		test(added > 0 && added < 200, "a batch that doesn't fit fails instead of evicting itself");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
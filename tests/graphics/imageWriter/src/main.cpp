@@ -0,0 +1,88 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	ofPixels frame(size_t i){
+		ofPixels pixels;
+		pixels.allocate(64, 48, OF_PIXELS_RGBA);
+		for(size_t y = 0; y < pixels.getHeight(); y++){
+			for(size_t x = 0; x < pixels.getWidth(); x++){
+				pixels.setColor(x, y, ofColor(x * 4, y * 5, i * 10, 255 - x));
+			}
+		}
+		return pixels;
+	}
+
+	void run(){
+		// qoi is lossless
+		ofPixels pixels = frame(3);
+		ofBuffer buffer;
+		ofSaveImage(pixels, buffer, OF_IMAGE_FORMAT_QOI);
+		ofPixels loaded;
+		test(ofLoadImage(loaded, buffer), "load qoi");
+		test_eq(loaded.getPixelFormat(), OF_PIXELS_RGBA, "qoi pixel format");
+		test(std::equal(pixels.begin(), pixels.end(), loaded.begin()), "qoi is lossless");
+		ofPixels bgr;
+		bgr.allocate(2, 1, OF_PIXELS_BGR);
+		bgr.setColor(0, 0, ofColor::red);
+		bgr.setColor(1, 0, ofColor::blue);
+		ofSaveImage(bgr, "bgr.qoi");
+		test(ofLoadImage(loaded, "bgr.qoi") && loaded.getColor(0, 0) == ofColor::red && loaded.getColor(1, 0) == ofColor::blue, "qoi file");
+		ofFile::removeFile("bgr.qoi");
+
+		ofImageWriter writer;
+		ofImageWriterSettings settings;
+		settings.numThreads = 3;
+		settings.maxQueuedImages = 4;
+		writer.setup(settings);
+		for(size_t i = 0; i < 20; i++){
+			test(writer.write(frame(i), "frames/" + ofToString(i) + (i % 2 ? ".qoi" : ".png")), "write " + ofToString(i));
+			test(writer.getStats().queued <= 4, "the queue is bounded");
+		}
+		test(!writer.write(frame(0), "frames/unknown.format"), "unknown format");
+		writer.waitForAll();
+		auto stats = writer.getStats();
+		test_eq(stats.written, uint64_t(20), "written");
+		test_eq(stats.queued, size_t(0), "nothing queued after waiting");
+		test_eq(stats.failed, uint64_t(1), "failed");
+		bool allEqual = true;
+		for(size_t i = 0; i < 20; i++){
+			auto expected = frame(i);
+			allEqual &= ofLoadImage(loaded, "frames/" + ofToString(i) + (i % 2 ? ".qoi" : ".png"))
+				&& std::equal(expected.begin(), expected.end(), loaded.begin());
+		}
+		test(allEqual, "written images");
+
+		// while paused nothing leaves the queue, so every frame after the
+		// first one is dropped no matter how fast the thread compresses
+		settings.dropWhenFull = true;
+		settings.maxQueuedImages = 1;
+		settings.numThreads = 1;
+		writer.setup(settings);
+		writer.pause();
+		size_t accepted = 0;
+		for(size_t i = 0; i < 20; i++){
+			accepted += writer.write(frame(i), "frames/dropped" + ofToString(i) + ".png");
+		}
+		test(writer.isFull(), "a paused writer doesn't empty its queue");
+		writer.resume();
+		writer.waitForAll();
+		stats = writer.getStats();
+		test_eq(accepted, size_t(1), "frames are dropped when full");
+		test_eq(stats.dropped, uint64_t(19), "dropped frames are counted");
+		test_eq(stats.written, uint64_t(21), "frames queued while paused are written after resuming");
+		test(ofFile::doesFileExist("frames/dropped0.png"), "the first frame is written");
+
+		ofDirectory::removeDirectory("frames", true);
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -309,6 +309,88 @@ class ofApp: public ofxUnitTestsApp{
                 test_eq((uint64_t)&pixels.getLine(0).getPixel(10)[0], (uint64_t)pixels.getData()+(10*bpp/8),"getLine(0).getPixel(10)[0]==pixels.getData()+(10*bpp/8)");
 			}
 		}
+
+		// area resize averages the pixels each destination pixel covers
+		ofPixels checker;
+		checker.allocate(4, 4, OF_PIXELS_RGB);
+		for(size_t y = 0; y < 4; y++){
+			for(size_t x = 0; x < 4; x++){
+				checker.setColor(x, y, (x + y) % 2 ? ofColor::white : ofColor::black);
+			}
+		}
+		ofPixels halved = checker;
+		test(halved.resize(2, 2, OF_INTERPOLATE_AREA), "area resize");
+		test_eq(halved.getWidth(), size_t(2), "area resize width");
+		test_eq(halved.getColor(1, 1), ofColor(128), "area resize averages");
+		ofFloatPixels gradient;
+		gradient.allocate(3, 1, OF_PIXELS_GRAY);
+		gradient[0] = 0; gradient[1] = 0.3; gradient[2] = 0.6;
+		test(gradient.resize(2, 1, OF_INTERPOLATE_AREA), "area resize float");
+		test(std::abs(gradient[0] - 0.1f) < 0.0001f, "area resize covers part of a pixel");
+		test(std::abs(gradient[1] - 0.5f) < 0.0001f, "area resize covers part of a pixel");
+
+		// images can be scaled down while they are loaded
+		ofPixels photo;
+		photo.allocate(800, 600, OF_PIXELS_RGB);
+		photo.setColor(ofColor::red);
+		ofSaveImage(photo, "photo.jpg");
+		ofSaveImage(photo, "photo.png");
+		ofImageLoadSettings settings;
+		settings.maxWidth = 100;
+		settings.maxHeight = 100;
+		for(auto file: {"photo.jpg", "photo.png"}){
+			ofPixels thumbnail;
+			test(ofLoadImage(thumbnail, file, settings), string("load scaled ") + file);
+			test_eq(thumbnail.getWidth(), size_t(100), string("scaled width ") + file);
+			test_eq(thumbnail.getHeight(), size_t(75), string("scaled height ") + file);
+			test(thumbnail.getColor(50, 40).r > 240 && thumbnail.getColor(50, 40).g < 15, string("scaled color ") + file);
+			thumbnail.clear();
+			test(ofLoadImage(thumbnail, ofBufferFromFile(file), settings) && thumbnail.getWidth() == 100 && thumbnail.getHeight() == 75, string("load scaled from buffer ") + file);
+		}
+		ofPixels full;
+		settings.maxWidth = 0;
+		settings.maxHeight = 1000;
+		test(ofLoadImage(full, "photo.jpg", settings) && full.getWidth() == 800, "smaller images aren't scaled");
+
+		// gifs are saved with a palette that's looked up while loading
+		ofSaveImage(photo, "photo.gif");
+		test(ofLoadImage(full, "photo.gif") && full.getPixelFormat() == OF_PIXELS_RGB, "load palette");
+		test(full.getColor(10, 20).r > 240 && full.getColor(10, 20).b < 15, "palette colors");
+		ofFile::removeFile("photo.jpg");
+		ofFile::removeFile("photo.png");
+		ofFile::removeFile("photo.gif");
+
+		// ofpix files are used mapped without copying them
+		ofFloatPixels lut;
+		lut.allocate(33, 33 * 33, OF_PIXELS_RGBA);
+		for(size_t i = 0; i < lut.size(); i++){
+			lut[i] = i * 0.001f;
+		}
+		ofSaveImage(lut, "lut.ofpix");
+		ofFloatPixels mapped;
+		test(ofLoadImage(mapped, "lut.ofpix"), "load ofpix");
+		test_eq(mapped.getPixelFormat(), OF_PIXELS_RGBA, "ofpix pixel format");
+		test(std::equal(lut.begin(), lut.end(), mapped.begin()), "ofpix is lossless");
+		test_eq(size_t(mapped.getData()) % 64, size_t(0), "ofpix data is aligned");
+		mapped[0] = 1;
+		ofFloatPixels reloaded;
+		settings = ofImageLoadSettings();
+		settings.keepMapped = false;
+		test(ofLoadImage(reloaded, "lut.ofpix", settings) && reloaded[0] == 0, "modifying mapped pixels doesn't change the file");
+		ofFloatPixels moved = std::move(mapped);
+		test_eq(moved[0], 1.f, "the mapping moves with the pixels");
+#ifndef TARGET_WIN32
+		// windows doesn't allow replacing a mapped file
+		ofSaveImage(moved, "lut.ofpix");
+		test(ofLoadImage(reloaded, "lut.ofpix") && reloaded[0] == 1 && reloaded[1] == lut[1], "save over a mapped file");
+#endif
+		ofBuffer buffer;
+		ofSaveImage(photo, buffer, OF_IMAGE_FORMAT_OFPIX);
+		test(ofLoadImage(full, buffer) && full.getWidth() == 800 && full.getColor(1, 1) == ofColor::red, "load ofpix from a buffer");
+		test(ofLoadImage(reloaded, buffer) && reloaded.getColor(1, 1) == ofFloatColor::red, "convert ofpix type");
+		moved.clear();
+		reloaded.clear();
+		ofFile::removeFile("lut.ofpix");
 	}
 };
 
@@ -0,0 +1,148 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// the blend formulas computed per pixel in double precision, rounded
+	// after every operation like the integer kernels do
+	template<typename T>
+	struct Reference{
+		static double limit(){
+			return ofColor_<T>::limit();
+		}
+		static double clamp(double v){
+			v = std::min(std::max(v, 0.0), limit());
+			return std::numeric_limits<T>::is_integer ? std::floor(v + 0.5) : v;
+		}
+		static double mul(double x, double y){
+			return std::numeric_limits<T>::is_integer ? clamp(x * y / limit()) : x * y;
+		}
+		static double value(double s, double d, double ia, ofBlendMode mode){
+			switch(mode){
+			case OF_BLENDMODE_ADD: return clamp(s + d);
+			case OF_BLENDMODE_SUBTRACT: return clamp(d - s);
+			case OF_BLENDMODE_MULTIPLY: return clamp(mul(s, d) + mul(d, ia));
+			case OF_BLENDMODE_SCREEN: return clamp(s + mul(d, limit() - s));
+			default: return clamp(s + mul(d, ia));
+			}
+		}
+		static void blend(const ofPixels_<T> & src, ofPixels_<T> & dst, int x, int y, ofBlendMode mode, bool premultiplied){
+			size_t channels = src.getNumChannels();
+			bool hasAlpha = channels == 2 || channels == 4;
+			for(int sy = 0; sy < int(src.getHeight()); sy++){
+				for(int sx = 0; sx < int(src.getWidth()); sx++){
+					int dx = x + sx, dy = y + sy;
+					if(dx < 0 || dy < 0 || dx >= int(dst.getWidth()) || dy >= int(dst.getHeight())) continue;
+					const T * s = &src[(sy * src.getWidth() + sx) * channels];
+					T * d = &dst[(dy * dst.getWidth() + dx) * channels];
+					if(mode == OF_BLENDMODE_DISABLED){
+						std::copy(s, s + channels, d);
+						continue;
+					}
+					double a = hasAlpha ? s[channels - 1] : limit();
+					double ia = limit() - a;
+					size_t colors = hasAlpha ? channels - 1 : channels;
+					for(size_t c = 0; c < colors; c++){
+						double sc = premultiplied || !hasAlpha ? s[c] : mul(s[c], a);
+						d[c] = T(value(sc, d[c], hasAlpha ? ia : 0, mode));
+					}
+					if(hasAlpha){
+						d[channels - 1] = T(clamp(a + mul(d[channels - 1], ia)));
+					}
+				}
+			}
+		}
+	};
+
+	template<typename T>
+	void randomPixels(ofPixels_<T> & pixels, size_t w, size_t h, ofPixelFormat format){
+		pixels.allocate(w, h, format);
+		for(auto & v: pixels){
+			v = T(ofRandom(0, ofColor_<T>::limit()));
+		}
+	}
+
+	template<typename T>
+	bool blendsLikeReference(const std::string & type){
+		const ofPixelFormat formats[] = {OF_PIXELS_GRAY, OF_PIXELS_GRAY_ALPHA, OF_PIXELS_RGB, OF_PIXELS_RGBA};
+		const ofBlendMode modes[] = {OF_BLENDMODE_DISABLED, OF_BLENDMODE_ALPHA, OF_BLENDMODE_ADD, OF_BLENDMODE_SUBTRACT, OF_BLENDMODE_MULTIPLY, OF_BLENDMODE_SCREEN};
+		double tolerance = std::numeric_limits<T>::is_integer ? 0 : 1e-5;
+		bool allEqual = true;
+		for(auto format: formats){
+			for(auto mode: modes){
+				for(int premultiplied = 0; premultiplied < 2; premultiplied++){
+					// odd sizes and positions partially outside the
+					// destination exercise the clipping and the scalar
+					// tails of the vectorized loops
+					ofPixels_<T> src, dst, expected;
+					randomPixels(src, 37, 29, format);
+					randomPixels(dst, 300, 250, format);
+					int x = int(ofRandom(-40, 310));
+					int y = int(ofRandom(-30, 260));
+					expected = dst;
+					Reference<T>::blend(src, expected, x, y, mode, premultiplied);
+					bool blended = src.blendInto(dst, x, y, mode, premultiplied);
+					bool equal = blended;
+					for(size_t i = 0; i < dst.size() && equal; i++){
+						equal = std::abs(double(dst[i]) - double(expected[i])) <= tolerance;
+					}
+					test(equal, type + " format " + ofToString(int(format)) + " mode " + ofToString(int(mode)) + (premultiplied ? " premultiplied" : ""));
+					allEqual &= equal;
+				}
+			}
+		}
+		// large enough to be split across threads
+		ofPixels_<T> src, dst, expected;
+		randomPixels(src, 1024, 512, OF_PIXELS_RGBA);
+		randomPixels(dst, 1000, 600, OF_PIXELS_RGBA);
+		expected = dst;
+		Reference<T>::blend(src, expected, -10, 50, OF_BLENDMODE_ALPHA, false);
+		src.blendInto(dst, -10, 50, OF_BLENDMODE_ALPHA);
+		bool equal = true;
+		for(size_t i = 0; i < dst.size() && equal; i++){
+			equal = std::abs(double(dst[i]) - double(expected[i])) <= tolerance;
+		}
+		test(equal, type + " large blend");
+		return allEqual && equal;
+	}
+
+	void run(){
+		blendsLikeReference<unsigned char>("8 bit");
+		blendsLikeReference<unsigned short>("16 bit");
+		blendsLikeReference<float>("float");
+
+		ofPixels sprite, canvas;
+		sprite.allocate(4, 4, OF_PIXELS_RGBA);
+		sprite.setColor(ofColor(255, 0, 0, 128));
+		canvas.allocate(8, 8, OF_PIXELS_RGBA);
+		canvas.setColor(ofColor(0, 0, 255, 255));
+		test(sprite.blendInto(canvas, 6, -2, OF_BLENDMODE_ALPHA), "blend clipped");
+		test_eq(canvas.getColor(6, 1), ofColor(128, 0, 127, 255), "straight alpha over");
+		test_eq(canvas.getColor(5, 1), ofColor(0, 0, 255, 255), "outside of the source");
+		test_eq(canvas.getColor(6, 2), ofColor(0, 0, 255, 255), "below the source");
+		test(sprite.blendInto(canvas, 100, 100, OF_BLENDMODE_ALPHA), "blend outside the destination");
+		ofPixels rgb;
+		rgb.allocate(4, 4, OF_PIXELS_RGB);
+		test(!sprite.blendInto(rgb, 0, 0, OF_BLENDMODE_ALPHA), "different formats");
+		ofPixels bgra;
+		bgra.allocate(4, 4, OF_PIXELS_BGRA);
+		test(!sprite.blendInto(bgra, 0, 0, OF_BLENDMODE_ALPHA), "same channels in a different order");
+		test(!sprite.blendInto(sprite, 0, 0, OF_BLENDMODE_ALPHA), "into itself");
+
+		ofPixels premultiplied;
+		premultiplied.allocate(2, 2, OF_PIXELS_RGBA);
+		premultiplied.setColor(ofColor(100, 0, 0, 128));
+		canvas.setColor(ofColor(0, 0, 200, 255));
+		test(premultiplied.blendInto(canvas, 0, 0), "blend premultiplied");
+		test_eq(canvas.getColor(0, 0), ofColor(100, 0, 100, 255), "premultiplied over");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,198 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+template<typename PixelType>
+void randomPixels(ofPixels_<PixelType> & pixels, size_t width, size_t height, ofPixelFormat format){
+	pixels.allocate(width, height, format);
+	for(auto & value: pixels){
+		value = PixelType(ofRandom(ofColor_<PixelType>::limit()));
+	}
+}
+
+// the value of a channel with the coordinates clamped to the image
+template<typename PixelType>
+double valueAt(const ofPixels_<PixelType> & pixels, int x, int y, size_t channel){
+	x = ofClamp(x, 0, pixels.getWidth() - 1);
+	y = ofClamp(y, 0, pixels.getHeight() - 1);
+	return pixels[(y * pixels.getWidth() + x) * pixels.getNumChannels() + channel];
+}
+
+template<typename PixelType>
+std::vector<double> referenceConvolve(const ofPixels_<PixelType> & src, const std::vector<float> & kernelX, const std::vector<float> & kernelY){
+	int width = src.getWidth();
+	int height = src.getHeight();
+	size_t channels = src.getNumChannels();
+	int radiusX = kernelX.size() / 2;
+	int radiusY = kernelY.size() / 2;
+	std::vector<double> result(src.size());
+	for(int y = 0; y < height; y++){
+		for(int x = 0; x < width; x++){
+			for(size_t c = 0; c < channels; c++){
+				double sum = 0;
+				for(int j = 0; j < int(kernelY.size()); j++){
+					for(int i = 0; i < int(kernelX.size()); i++){
+						sum += kernelY[j] * kernelX[i] * valueAt(src, x + i - radiusX, y + j - radiusY, c);
+					}
+				}
+				// float pixels aren't clamped
+				if(std::is_integral<PixelType>::value){
+					sum = ofClamp(sum, 0, ofColor_<PixelType>::limit());
+				}
+				result[(y * width + x) * channels + c] = sum;
+			}
+		}
+	}
+	return result;
+}
+
+template<typename PixelType>
+double maxDifference(const ofPixels_<PixelType> & pixels, const std::vector<double> & reference){
+	double difference = 0;
+	for(size_t i = 0; i < pixels.size(); i++){
+		difference = std::max(difference, std::abs(pixels[i] - reference[i]));
+	}
+	return difference;
+}
+
+template<typename PixelType>
+bool samePixels(const ofPixels_<PixelType> & a, const ofPixels_<PixelType> & b){
+	return a.getWidth() == b.getWidth() && a.getHeight() == b.getHeight() && a.getPixelFormat() == b.getPixelFormat()
+		&& std::equal(a.begin(), a.end(), b.begin());
+}
+
+class ofApp: public ofxUnitTestsApp{
+	template<typename PixelType>
+	void testFilters(const std::string & type, double tolerance){
+		ofPixels_<PixelType> src, dst;
+		randomPixels(src, 83, 47, OF_PIXELS_RGBA);
+
+		bool boxMatches = true;
+		for(size_t radius: {1, 4, 60}){
+			ofBoxBlur(src, dst, radius);
+			std::vector<float> kernel(2 * radius + 1, 1.f / (2 * radius + 1));
+			boxMatches &= maxDifference(dst, referenceConvolve(src, kernel, kernel)) <= tolerance;
+		}
+		test(boxMatches, type + " box blur matches averaging every pixel");
+
+		std::vector<float> kernelX = {0.25f, -1.f, 2.f};
+		std::vector<float> kernelY = {1.f, 2.f, 1.f, 0.5f, -0.5f};
+		test(ofConvolve(src, dst, kernelX, kernelY), type + " convolve");
+		test(maxDifference(dst, referenceConvolve(src, kernelX, kernelY)) <= tolerance, type + " convolve matches the reference");
+		test(ofConvolve(src, dst, {}, {}) && samePixels(src, dst), type + " empty kernels keep the pixels");
+		ofLogNotice() << "an error about an even kernel is expected";
+		test(!ofConvolve(src, dst, {0.5f, 0.5f}, {}), type + " even kernels fail");
+
+		ofPixels_<PixelType> eroded, dilated;
+		ofErode(src, eroded, 2);
+		ofDilate(src, dilated, 2);
+		bool minMaxMatch = true;
+		for(int y = 0; y < int(src.getHeight()); y++){
+			for(int x = 0; x < int(src.getWidth()); x++){
+				for(size_t c = 0; c < src.getNumChannels(); c++){
+					double minimum = std::numeric_limits<double>::max();
+					double maximum = std::numeric_limits<double>::lowest();
+					for(int j = -2; j <= 2; j++){
+						for(int i = -2; i <= 2; i++){
+							minimum = std::min(minimum, valueAt(src, x + i, y + j, c));
+							maximum = std::max(maximum, valueAt(src, x + i, y + j, c));
+						}
+					}
+					minMaxMatch &= valueAt(eroded, x, y, c) == minimum && valueAt(dilated, x, y, c) == maximum;
+				}
+			}
+		}
+		test(minMaxMatch, type + " erode and dilate are the minimum and maximum around each pixel");
+
+		ofPixels_<PixelType> filtered;
+		ofGaussianBlur(src, filtered, 3.5);
+		dst = src;
+		ofGaussianBlur(dst, dst, 3.5);
+		test(samePixels(dst, filtered), type + " gaussian blur in place");
+		ofSobel(src, filtered);
+		dst = src;
+		ofSobel(dst, dst);
+		test(samePixels(dst, filtered), type + " sobel in place");
+		ofErode(src, filtered, 3);
+		dst = src;
+		ofErode(dst, dst, 3);
+		test(samePixels(dst, filtered), type + " erode in place");
+
+		ofPixels_<PixelType> flat;
+		flat.allocate(64, 32, OF_PIXELS_RGB);
+		flat.setColor(ofColor_<PixelType>(ofColor_<PixelType>::limit() / 2));
+		ofGaussianBlur(flat, dst, 10);
+		test(maxDifference(dst, std::vector<double>(flat.begin(), flat.end())) <= tolerance, type + " blurring a flat image keeps it");
+		ofSharpen(flat, dst, 2);
+		test(maxDifference(dst, std::vector<double>(flat.begin(), flat.end())) <= tolerance, type + " sharpening a flat image keeps it");
+		ofSobel(flat, dst);
+		test(maxDifference(dst, std::vector<double>(flat.size(), 0)) <= tolerance, type + " sobel of a flat image is 0");
+
+		ofLut3D lut;
+		lut.setupIdentity(17);
+		randomPixels(src, 31, 17, OF_PIXELS_BGR);
+		ofApplyLut(src, dst, lut);
+		test(maxDifference(dst, std::vector<double>(src.begin(), src.end())) <= tolerance, type + " identity lut keeps the colors");
+	}
+
+	void run(){
+		testFilters<unsigned char>("ofPixels", 1);
+		testFilters<unsigned short>("ofShortPixels", 1);
+		testFilters<float>("ofFloatPixels", 1e-4);
+
+		ofPixels edge;
+		edge.allocate(8, 8, OF_PIXELS_GRAY);
+		for(size_t y = 0; y < 8; y++){
+			for(size_t x = 0; x < 8; x++){
+				edge[y * 8 + x] = x < 4 ? 0 : 100;
+			}
+		}
+		ofSobel(edge, edge);
+		test(edge[2] == 0 && edge[3] == 255 && edge[4] == 255 && edge[5] == 0, "sobel finds a vertical edge");
+
+		// a table that inverts the colors
+		std::vector<ofFloatColor> colors;
+		for(int b = 0; b < 2; b++){
+			for(int g = 0; g < 2; g++){
+				for(int r = 0; r < 2; r++){
+					colors.emplace_back(1 - r, 1 - g, 1 - b);
+				}
+			}
+		}
+		ofLut3D lut;
+		test(lut.setup(2, colors), "lut setup");
+		auto inverted = lut.getColor(ofFloatColor(0.2, 0.4, 0.6, 0.5));
+		test(std::abs(inverted.r - 0.8) < 1e-5 && std::abs(inverted.g - 0.6) < 1e-5 && std::abs(inverted.b - 0.4) < 1e-5 && inverted.a == 0.5f, "lut color");
+		ofPixels pixels;
+		pixels.allocate(4, 4, OF_PIXELS_BGRA);
+		pixels.setColor(ofColor(30, 20, 10, 77));
+		ofApplyLut(pixels, pixels, lut);
+		test(pixels.getColor(0, 0) == ofColor(225, 235, 245, 77), "lut in place keeps alpha");
+
+		ofBuffer cube;
+		cube.set("# comment\nTITLE \"invert\"\nLUT_3D_SIZE 2\n\n1 1 1\n0 1 1\n1 0 1\n0 0 1\n1 1 0\n0 1 0\n1 0 0\n0 0 0\n");
+		ofBufferToFile("invert.cube", cube);
+		test(lut.load("invert.cube") && lut.getSize() == 2, "load a .cube file");
+		test(lut.getColor(ofFloatColor(0.2, 0.4, 0.6, 0.5)) == inverted, "loaded lut color");
+		ofFile::removeFile("invert.cube");
+		ofLogNotice() << "an error about a missing file is expected";
+		test(!lut.load("missing.cube") && !lut.isLoaded(), "missing .cube file");
+		// 4194304^3 overflows to 0 entries in 64 bits
+		cube.set("LUT_3D_SIZE 4194304\n");
+		ofBufferToFile("huge.cube", cube);
+		ofLogNotice() << "an error about the size of the table is expected";
+		test(!lut.load("huge.cube") && !lut.isLoaded(), "tables bigger than 256^3 aren't loaded");
+		ofFile::removeFile("huge.cube");
+		ofLogNotice() << "an error about the size of the table is expected";
+		test(!lut.setup(4194304, {}), "tables bigger than 256^3 can't be set up");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
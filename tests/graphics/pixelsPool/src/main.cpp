@@ -0,0 +1,88 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		test_eq(ofPixelsPool::getSizeClass(1), size_t(64), "smallest size class");
+		test_eq(ofPixelsPool::getSizeClass(3840 * 2160 * 4), size_t(32 * 1024 * 1024), "4k size class");
+		bool classesFit = true;
+		for(size_t bytes = 1; bytes < 100000; bytes++){
+			auto sizeClass = ofPixelsPool::getSizeClass(bytes);
+			classesFit &= sizeClass >= bytes && (bytes <= 64 || sizeClass * 4 <= bytes * 5 + 64);
+		}
+		test(classesFit, "size classes waste at most a quarter");
+
+		auto pool = std::make_shared<ofPixelsPool>();
+		ofPixels pixels;
+		pixels.setPool(pool);
+		pixels.allocate(640, 480, OF_PIXELS_RGBA);
+		auto data = pixels.getData();
+		pixels.clear();
+		pixels.allocate(600, 500, OF_PIXELS_RGBA);
+		test(pixels.getData() == data, "a similar size reuses the buffer");
+		auto stats = pool->getStats();
+		test_eq(stats.misses, uint64_t(1), "misses");
+		test_eq(stats.hits, uint64_t(1), "hits");
+		test_eq(stats.buffersInUse, size_t(1), "buffers in use");
+
+		pixels.setColor(ofColor::red);
+		pixels.resize(320, 240);
+		pixels.rotate90(1);
+		pixels.crop(0, 0, 100, 100);
+		pixels.setImageType(OF_IMAGE_COLOR_ALPHA);
+		test(pixels.getWidth() == 100 && pixels.getColor(10, 10) == ofColor::red, "operations on pooled pixels");
+		test_eq(pool->getStats().buffersInUse, size_t(1), "operations give back the old buffer");
+
+		ofPixels copy(pixels);
+		test(copy.getPool() == pool, "copies use the pool");
+		ofPixels assigned;
+		assigned = pixels;
+		test(!assigned.getPool(), "assigning keeps the pool");
+		ofPixels moved(std::move(copy));
+		test(moved.getPool() == pool && moved.getColor(10, 10) == ofColor::red, "moves use the pool");
+		assigned = std::move(moved);
+		test_eq(pool->getStats().buffersInUse, size_t(2), "moved buffers stay in use");
+		assigned.clear();
+		pixels.clear();
+		stats = pool->getStats();
+		test_eq(stats.buffersInUse, size_t(0), "all buffers released");
+		test(stats.highWaterBytes >= 640 * 480 * 4 && stats.buffersCached > 0, "high water and cached buffers");
+
+		pool->setMaxCachedBytes(1024 * 1024);
+		{
+			ofPixels a, b;
+			a.setPool(pool);
+			b.setPool(pool);
+			a.allocate(512, 512, OF_PIXELS_RGBA);
+			b.allocate(256, 256, OF_PIXELS_RGBA);
+		}
+		stats = pool->getStats();
+		test(stats.bytesCached <= 1024 * 1024 && stats.evicted > 0, "the pool is bounded");
+		pool->trim();
+		test_eq(pool->getStats().bytesCached, size_t(0), "trim");
+
+		// buffers can outlive the pool, the pixels stop using it so only
+		// their buffer references it once the test drops it
+		auto shortLived = std::make_shared<ofPixelsPool>();
+		std::weak_ptr<ofPixelsPool> destroyed = shortLived;
+		ofPixels outliving;
+		outliving.setPool(shortLived);
+		outliving.allocate(64, 64, OF_PIXELS_RGBA);
+		outliving.setPool(nullptr);
+		shortLived.reset();
+		test(destroyed.expired(), "the pool is destroyed before its buffers");
+		outliving.setColor(ofColor::blue);
+		test(outliving.getColor(0, 0) == ofColor::blue, "pixels outlive the pool");
+		outliving.clear();
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,130 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+template<typename PixelType>
+void randomPixels(ofPixels_<PixelType> & pixels, size_t width, size_t height, ofPixelFormat format){
+	pixels.allocate(width, height, format);
+	for(auto & value: pixels){
+		value = PixelType(ofRandom(ofColor_<PixelType>::limit()));
+	}
+}
+
+class ofApp: public ofxUnitTestsApp{
+	template<typename PixelType>
+	void testStats(const std::string & type){
+		double limit = ofColor_<PixelType>::limit();
+		ofPixels_<PixelType> pixels;
+		randomPixels(pixels, 123, 45, OF_PIXELS_RGB);
+		size_t width = pixels.getWidth();
+		size_t channels = pixels.getNumChannels();
+
+		// a region that goes out of the pixels, to test clipping
+		size_t x0 = 100, y0 = 10;
+		auto stats = ofGetPixelsStats(pixels, x0, y0, 50, 20);
+		test_eq(stats.size(), channels, type + " stats of every channel");
+		bool statsMatch = true;
+		bool histogramsMatch = true;
+		auto histogram = ofGetHistogram(pixels, 10, 0, limit, x0, y0, 50, 20);
+		for(size_t c = 0; c < channels; c++){
+			double sum = 0, squaredSum = 0;
+			double minimum = limit, maximum = 0;
+			std::vector<uint64_t> counts(10, 0);
+			for(size_t y = y0; y < y0 + 20; y++){
+				for(size_t x = x0; x < width; x++){
+					double value = pixels[(y * width + x) * channels + c];
+					sum += value;
+					squaredSum += value * value;
+					minimum = std::min(minimum, value);
+					maximum = std::max(maximum, value);
+					counts[histogram.getBin(value)]++;
+				}
+			}
+			double count = (width - x0) * 20;
+			double mean = sum / count;
+			double stddev = std::sqrt(squaredSum / count - mean * mean);
+			statsMatch &= stats[c].count == count && stats[c].min == minimum && stats[c].max == maximum
+				&& std::abs(stats[c].mean - mean) < limit * 1e-6 && std::abs(stats[c].stddev - stddev) < limit * 1e-6;
+			for(size_t bin = 0; bin < 10; bin++){
+				histogramsMatch &= histogram.getCount(c, bin) == counts[bin];
+			}
+		}
+		test(statsMatch, type + " stats match adding every value");
+		test(histogramsMatch, type + " histogram matches counting every value");
+
+		ofIntegralImage integral;
+		test(integral.setup(pixels, true), type + " integral image");
+		bool sumsMatch = true;
+		for(int i = 0; i < 100; i++){
+			int x = ofRandom(-10, width);
+			int y = ofRandom(-10, pixels.getHeight());
+			int w = ofRandom(0, 60);
+			int h = ofRandom(0, 30);
+			size_t c = ofRandom(channels);
+			double sum = 0, squaredSum = 0, count = 0;
+			for(int j = std::max(y, 0); j < std::min<int>(y + h, pixels.getHeight()); j++){
+				for(int i = std::max(x, 0); i < std::min<int>(x + w, width); i++){
+					double value = pixels[(j * width + i) * channels + c];
+					sum += value;
+					squaredSum += value * value;
+					count++;
+				}
+			}
+			sumsMatch &= std::abs(integral.getSum(x, y, w, h, c) - sum) <= std::max(sum, 1.0) * 1e-9;
+			if(count > 0){
+				double mean = sum / count;
+				sumsMatch &= std::abs(integral.getMean(x, y, w, h, c) - mean) <= limit * 1e-9;
+				sumsMatch &= std::abs(integral.getVariance(x, y, w, h, c) - (squaredSum / count - mean * mean)) <= limit * limit * 1e-9;
+			}
+		}
+		test(sumsMatch, type + " rectangle sums match adding every value");
+	}
+
+	void run(){
+		testStats<unsigned char>("ofPixels");
+		testStats<unsigned short>("ofShortPixels");
+		testStats<float>("ofFloatPixels");
+
+		ofPixels ramp;
+		ramp.allocate(10, 10, OF_PIXELS_GRAY);
+		for(size_t i = 0; i < ramp.size(); i++){
+			ramp[i] = i;
+		}
+		auto histogram = ofGetHistogram(ramp);
+		test_eq(histogram.getTotal(0), uint64_t(100), "histogram total");
+		test_eq(histogram.getPercentile(0, 0), 0.f, "0th percentile");
+		test_eq(histogram.getPercentile(0, 50), 49.f, "median");
+		test_eq(histogram.getPercentile(0, 95), 94.f, "95th percentile");
+		test_eq(histogram.getPercentile(0, 100), 99.f, "100th percentile");
+		histogram = ofGetHistogram(ramp, 4);
+		test(histogram.getCount(0, 0) == 64 && histogram.getCount(0, 1) == 36, "bins of 64 values");
+		test_eq(histogram.getBinValue(1), 64.f, "bin value");
+
+		ofFloatPixels outOfRange;
+		outOfRange.allocate(3, 1, OF_PIXELS_GRAY);
+		outOfRange[0] = -1;
+		outOfRange[1] = 2;
+		outOfRange[2] = 0.6;
+		histogram = ofGetHistogram(outOfRange, 4);
+		test(histogram.getCount(0, 0) == 1 && histogram.getCount(0, 2) == 1 && histogram.getCount(0, 3) == 1, "values out of the range go to the first and last bins");
+
+		ofPixels flat;
+		flat.allocate(16, 16, OF_PIXELS_RGBA);
+		flat.setColor(ofColor(10, 20, 30, 40));
+		auto stats = ofGetPixelsStats(flat);
+		test(stats[2].mean == 30 && stats[2].stddev == 0 && stats[3].min == 40 && stats[3].max == 40, "stats of a flat image");
+		ofIntegralImage integral;
+		integral.setup(flat);
+		test_eq(integral.getSum(0, 0, 16, 16, 1), 20. * 256, "sum of the whole image");
+		test_eq(integral.getSum(-100, -100, 50, 50), 0., "sum outside of the image");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,84 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+
+bool sameMesh(const ofMesh & a, const ofMesh & b, glm::vec2 translation = {0, 0}){
+	if(a.getNumVertices() != b.getNumVertices() || a.getTexCoords() != b.getTexCoords()){
+		return false;
+	}
+	for(size_t i = 0; i < a.getNumVertices(); i++){
+		if(a.getVertex(i) + glm::vec3(translation, 0) != b.getVertex(i)){
+			return false;
+		}
+	}
+	return true;
+}
+
+class ofApp: public ofxUnitTestsApp{
+public:
+	void run(){
+		ofTrueTypeFont font;
+		if(!test(font.load(OF_TTF_SANS, 14), "load a font")){
+			return;
+		}
+
+		// the cached meshes are laid out at the fractional part of the
+		// position, rounded to quarter pixels, and translated by whole
+		// pixels, they have to end up exactly where laying out the string
+		// at the rounded position puts them
+		std::string text = "Quick brown fox,\njumps over the lazy dog";
+		std::vector<glm::vec2> positions = {{10, 20}, {10.25f, 20.5f}, {-3.75f, -7.4f}, {0.6f, 33.9f}, {101.5f, 0.125f}};
+		bool getStringMeshMatches = true;
+		bool cachedMeshMatches = true;
+		bool wholePixels = true;
+		for(auto vflip: {true, false}){
+			for(auto position: positions){
+				auto rounded = glm::round(position * 4.f) / 4.f;
+				font.setStringMeshCacheSize(0);
+				ofMesh uncached = font.getStringMesh(text, rounded.x, rounded.y, vflip);
+				font.setStringMeshCacheSize(256);
+				// the second time comes from the cache
+				for(int i = 0; i < 2; i++){
+					getStringMeshMatches &= sameMesh(font.getStringMesh(text, position.x, position.y, vflip), uncached);
+					glm::vec2 translation;
+					auto & cached = font.getCachedStringMesh(text, position.x, position.y, vflip, translation);
+					cachedMeshMatches &= sameMesh(cached, uncached, translation);
+					wholePixels &= translation == glm::floor(translation);
+				}
+			}
+		}
+		test(getStringMeshMatches, "cached getStringMesh matches laying out the string");
+		test(cachedMeshMatches, "cached mesh plus its translation matches laying out the string");
+		test(wholePixels, "cached meshes are translated by whole pixels");
+
+		glm::vec2 translation;
+		auto first = &font.getCachedStringMesh(text, 10.01f, 20, true, translation);
+		auto second = &font.getCachedStringMesh(text, 10.05f, 20.1f, true, translation);
+		test(first == second, "positions in the same quarter pixel share a cached mesh");
+
+		bool snapped = true;
+		for(auto & vertex: font.getStringMesh(text, 12.7f, 30.3f).getVertices()){
+			snapped &= vertex.x == floor(vertex.x) && vertex.y == floor(vertex.y);
+		}
+		test(snapped, "glyphs are snapped to whole pixels");
+
+		ofTextLayout layout(font, "fox");
+		auto smallWidth = layout.getBoundingBox().width;
+		auto generation = font.getGeneration();
+		if(!test(font.load(OF_TTF_SANS, 28), "reload the font")){
+			return;
+		}
+		test(font.getGeneration() != generation, "reloading a font changes its generation");
+		test_gt(layout.getBoundingBox().width, smallWidth, "a text layout is updated when its font is reloaded");
+	}
+};
+
+//========================================================================
+int main( ){
+	// fonts need a GL context for their texture
+	ofGLFWWindowSettings settings;
+	settings.visible = false;
+	auto window = ofCreateWindow(settings);
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
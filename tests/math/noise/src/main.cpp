@@ -0,0 +1,107 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+// the batch functions have to return exactly the same values as the scalar
+// ones so compare the bits, not an approximation
+bool same(float a, float b){
+	return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+class ofApp: public ofxUnitTestsApp{
+public:
+	void run(){
+		// an odd count so the last points don't fill a whole simd register,
+		// over a range that includes negative coordinates and integers
+		const size_t count = 10007;
+		vector<float> xs(count);
+		vector<glm::vec2> points2(count);
+		vector<glm::vec3> points3(count);
+		vector<glm::vec4> points4(count);
+		ofSeedRandom(0);
+		for(size_t i = 0; i < count; i++){
+			xs[i] = ofRandom(-300, 300);
+			points2[i] = glm::vec2(ofRandom(-300, 300), ofRandom(-300, 300));
+			points3[i] = glm::vec3(ofRandom(-300, 300), ofRandom(-300, 300), ofRandom(-300, 300));
+			points4[i] = glm::vec4(ofRandom(-300, 300), ofRandom(-300, 300), ofRandom(-300, 300), ofRandom(-300, 300));
+		}
+		for(size_t i = 0; i < 100; i++){
+			float x = float(int(i % 10) - 5);
+			float y = float(int(i / 10) - 5);
+			xs[i] = x;
+			points2[i] = glm::vec2(x, y);
+			points3[i] = glm::vec3(x, y, 0);
+			points4[i] = glm::vec4(x, y, 0, -1);
+		}
+
+		vector<float> out(count);
+		auto all = [&](std::function<float(size_t)> scalar){
+			for(size_t i = 0; i < count; i++){
+				if(!same(out[i], scalar(i))){
+					ofLogError() << "point " << i << ": " << out[i] << " != " << scalar(i);
+					return false;
+				}
+			}
+			return true;
+		};
+
+		ofNoise(xs.data(), out.data(), count);
+		test(all([&](size_t i){ return ofNoise(xs[i]); }), "1D batch noise equals ofNoise");
+		ofNoise(points2.data(), out.data(), count);
+		test(all([&](size_t i){ return ofNoise(points2[i]); }), "2D batch noise equals ofNoise");
+		ofNoise(points3.data(), out.data(), count);
+		test(all([&](size_t i){ return ofNoise(points3[i]); }), "3D batch noise equals ofNoise");
+		ofNoise(points4.data(), out.data(), count);
+		test(all([&](size_t i){ return ofNoise(points4[i]); }), "4D batch noise equals ofNoise");
+
+		ofSignedNoise(xs.data(), out.data(), count);
+		test(all([&](size_t i){ return ofSignedNoise(xs[i]); }), "1D batch noise equals ofSignedNoise");
+		ofSignedNoise(points2.data(), out.data(), count);
+		test(all([&](size_t i){ return ofSignedNoise(points2[i]); }), "2D batch noise equals ofSignedNoise");
+		ofSignedNoise(points3.data(), out.data(), count);
+		test(all([&](size_t i){ return ofSignedNoise(points3[i]); }), "3D batch noise equals ofSignedNoise");
+		ofSignedNoise(points4.data(), out.data(), count);
+		test(all([&](size_t i){ return ofSignedNoise(points4[i]); }), "4D batch noise equals ofSignedNoise");
+
+		ofFractalNoise(points2.data(), out.data(), count, 5);
+		test(all([&](size_t i){ return ofFractalNoise(points2[i], 5); }), "2D batch fractal noise equals ofFractalNoise");
+		ofSignedFractalNoise(points3.data(), out.data(), count, 4, 1.9f, 0.6f);
+		test(all([&](size_t i){ return ofSignedFractalNoise(points3[i], 4, 1.9f, 0.6f); }), "3D batch fractal noise equals ofSignedFractalNoise");
+		test(same(ofSignedFractalNoise(points2[200], 1), ofSignedNoise(points2[200])), "a single octave of fractal noise equals ofSignedNoise");
+
+		float amplitude = 0;
+		for(size_t i = 0; i < count; i++){
+			amplitude = std::max(amplitude, std::abs(ofSignedFractalNoise(points3[i], 6)));
+		}
+		test(amplitude <= 1, "fractal noise stays in the range of a single octave");
+
+		ofFloatPixels pixels;
+		pixels.allocate(101, 67, OF_PIXELS_RGB);
+		glm::vec3 origin(-3.5f, 2.f, 0.7f);
+		// steps that are powers of 2 so x * step is exact whether or not
+		// this file is compiled with fused multiply-adds
+		glm::vec2 step(1.f / 64.f, 1.f / 32.f);
+		ofNoise(pixels, origin, step);
+		bool gridEqual = true;
+		for(size_t y = 0; y < pixels.getHeight() && gridEqual; y++){
+			for(size_t x = 0; x < pixels.getWidth() && gridEqual; x++){
+				float expected = ofNoise(origin.x + x * step.x, origin.y + y * step.y, origin.z);
+				auto color = pixels.getColor(x, y);
+				gridEqual = same(color.r, expected) && same(color.g, expected) && same(color.b, expected);
+			}
+		}
+		test(gridEqual, "noise grid equals ofNoise at each pixel");
+
+		ofFractalNoise(pixels, glm::vec2(origin), step, 3);
+		test(same(pixels.getColor(50, 30).r, ofFractalNoise(glm::vec2(origin.x + 50 * step.x, origin.y + 30 * step.y), 3)), "fractal noise grid equals ofFractalNoise");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
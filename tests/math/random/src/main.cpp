@@ -0,0 +1,74 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+#include <numeric>
+
+class ofApp: public ofxUnitTestsApp{
+public:
+	void run(){
+		const size_t count = 100000;
+
+		ofSeedRandom(1234);
+		vector<float> first(count);
+		for(auto & value: first){
+			value = ofRandom(-10, 10);
+		}
+		ofSeedRandom(1234);
+		vector<float> second(count);
+		ofRandom(second.data(), count, -10, 10);
+		test(first == second, "ofSeedRandom repeats the sequence and bulk fills match single calls");
+
+		auto minmax = std::minmax_element(first.begin(), first.end());
+		test(*minmax.first >= -10 && *minmax.second < 10, "ofRandom stays in [min, max)");
+		test_eq(ofRandom(5, 5), 5, "ofRandom with an empty range returns min");
+
+		vector<float> uniform(count);
+		ofRandomuf(uniform.data(), count);
+		double mean = std::accumulate(uniform.begin(), uniform.end(), 0.0) / count;
+		test_lt(std::abs(mean - 0.5), 0.01, "ofRandomuf mean is close to 0.5");
+
+		vector<glm::vec3> points(count);
+		ofRandom(points.data(), count, glm::vec3(-1, 0, 10), glm::vec3(1, 2, 11));
+		bool inside = std::all_of(points.begin(), points.end(), [](const glm::vec3 & p){
+			return p.x >= -1 && p.x < 1 && p.y >= 0 && p.y < 2 && p.z >= 10 && p.z < 11;
+		});
+		test(inside, "random points stay inside the box");
+
+		ofSeedRandom(99);
+		vector<int> shuffled1(50);
+		std::iota(shuffled1.begin(), shuffled1.end(), 0);
+		ofRandomize(shuffled1);
+		ofSeedRandom(99);
+		vector<int> shuffled2(50);
+		std::iota(shuffled2.begin(), shuffled2.end(), 0);
+		ofRandomize(shuffled2);
+		test(shuffled1 == shuffled2, "ofRandomize is repeatable after ofSeedRandom");
+
+		// other threads get their own stream of the same seed
+		ofSeedRandom(7);
+		float mainValue = ofRandomuf();
+		float threadValue = 0;
+		std::thread thread([&]{
+			threadValue = ofRandomuf();
+		});
+		thread.join();
+		test(mainValue != threadValue, "threads draw from different streams");
+
+		ofRandomEngine engine1(ofGetRandomSeed(), 3);
+		ofRandomEngine engine2(7, 3);
+		ofRandomEngine engine3(7, 4);
+		auto value1 = engine1();
+		test_eq(ofGetRandomSeed(), uint64_t(7), "ofGetRandomSeed returns the last seed");
+		test(value1 == engine2(), "engines with the same seed and stream are equal");
+		test(value1 != engine3(), "engines with different streams differ");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
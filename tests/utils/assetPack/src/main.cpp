@@ -0,0 +1,113 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		ofDirectory::removeDirectory("packed", true);
+		ofDirectory::createDirectory("packed/sub", true, true);
+		std::string text;
+		for(int i = 0; i < 1000; i++){
+			text += "line " + ofToString(i % 10) + "\n";
+		}
+		std::string noise;
+		for(int i = 0; i < 10000; i++){
+			noise += char(ofRandom(256));
+		}
+		ofBufferToFile("packed/text.txt", ofBuffer(text.c_str(), text.size()));
+		ofBufferToFile("packed/sub/noise.bin", ofBuffer(noise.c_str(), noise.size()));
+		ofBufferToFile("packed/empty", ofBuffer());
+		ofBufferToFile("packed/.hidden", ofBuffer("x", 1));
+
+		ofPixels pixels;
+		pixels.allocate(4, 2, OF_PIXELS_RGB);
+		pixels.setColor(ofColor::red);
+		pixels.setColor(3, 1, ofColor::blue);
+		ofSaveImage(pixels, "packed/sub/image.png");
+
+		ofMesh mesh;
+		mesh.addVertex({0, 0, 0});
+		mesh.addVertex({1, 0, 0});
+		mesh.addVertex({0, 1, 0});
+		mesh.save("packed/mesh.ply");
+
+		test(ofAssetPack::create("packed", "packed.pack"), "create");
+		test(ofAssetPack::create("packed", "packed/raw.pack", ofAssetPackCompression::None), "create without compression");
+
+		ofAssetPack pack;
+		test(pack.open("packed.pack"), "open");
+		test_eq(pack.size(), size_t(5), "hidden files aren't packed");
+		test_eq(pack.getName(0).toString(), "empty", "names are sorted");
+		test_eq(pack.getName(3).toString(), "sub/noise.bin", "names are relative paths");
+		test(pack.getCompression(4) == ofAssetPackCompression::LZ4, "text is compressed");
+		test(pack.getCompression(3) == ofAssetPackCompression::None, "noise isn't compressed");
+		ofBuffer buffer;
+		test(pack.read("text.txt", buffer), "read compressed");
+		test_eq(buffer.getText(), text, "compressed contents");
+		test(pack.read("sub/noise.bin", buffer), "read");
+		test_eq(buffer.getText(), noise, "contents");
+		test(pack.read("empty", buffer) && buffer.size() == 0, "read empty");
+		test(!pack.read("missing", buffer), "missing file");
+
+		ofAssetPack raw;
+		test(raw.open("packed/raw.pack"), "open without compression");
+		test_eq(raw.size(), size_t(5), "the pack isn't packed");
+		test(raw.getCompression(4) == ofAssetPackCompression::None, "uncompressed");
+		test(raw.read("text.txt", buffer) && buffer.getText() == text, "uncompressed contents");
+
+		ofBufferToFile("invalid.pack", ofBuffer(text.c_str(), text.size()));
+		ofAssetPack invalid;
+		test(!invalid.open("invalid.pack"), "invalid pack");
+		test(!ofMountAssetPack("invalid.pack"), "mount invalid pack");
+
+		// the loose files are removed so they can only come from the pack
+		ofDirectory::removeDirectory("packed", true);
+		test(!ofIsInMountedAssetPack("text.txt"), "not mounted");
+		test(ofMountAssetPack("packed.pack"), "mount");
+		test(ofIsInMountedAssetPack("text.txt"), "mounted file");
+		test(ofIsInMountedAssetPack("sub/../sub/./noise.bin"), "mounted file relative path");
+		test(ofIsInMountedAssetPack(ofToDataPath("text.txt", true)), "mounted file absolute path");
+		test(!ofIsInMountedAssetPack("sub"), "directories aren't files");
+		test_eq(ofBufferFromFile("text.txt").getText(), text, "ofBufferFromFile");
+		test_eq(ofBufferFromFile("sub/noise.bin", ofBufferLoadMode::Mapped).getText(), noise, "ofBufferFromFile mapped");
+
+		ofPixels loaded;
+		test(ofLoadImage(loaded, "sub/image.png"), "ofLoadImage");
+		test_eq(loaded.getWidth(), size_t(4), "image width");
+		test(loaded.getColor(3, 1) == ofColor::blue, "image pixels");
+
+		ofMesh loadedMesh;
+		loadedMesh.load("mesh.ply");
+		test_eq(loadedMesh.getNumVertices(), size_t(3), "ofMesh::load");
+
+		std::string asyncText;
+		ofReadFileAsync("text.txt", [&](ofBuffer & contents, const ofFileLoadResult & result){
+			asyncText = contents.getText();
+		});
+		auto end = ofGetElapsedTimeMillis() + 2000;
+		while(ofGetNumFileRequests() > 0 && ofGetElapsedTimeMillis() < end){
+			ofEvents().notifyUpdate();
+			ofSleepMillis(5);
+		}
+		test_eq(asyncText, text, "ofReadFileAsync");
+
+		test(ofMountAssetPack("packed.pack", "assets"), "mount in a folder");
+		test(ofIsInMountedAssetPack("assets/text.txt"), "file in mount point");
+		test(!ofIsInMountedAssetPack("text.txt"), "mounting again moves the pack");
+		ofUnmountAssetPack("packed.pack");
+		test(!ofIsInMountedAssetPack("assets/text.txt"), "unmount");
+		test_eq(ofBufferFromFile("text.txt").size(), size_t(0), "unmounted files are read from disk");
+
+		ofFile::removeFile("packed.pack");
+		ofFile::removeFile("invalid.pack");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,114 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// the tests run from setup so updates have to be triggered by hand to
+	// get the callbacks called
+	void waitForRequests(){
+		auto start = ofGetElapsedTimeMillis();
+		while(ofGetNumFileRequests() > 0 && ofGetElapsedTimeMillis() - start < 10000){
+			ofEvents().notifyUpdate();
+			ofSleepMillis(1);
+		}
+	}
+
+	void run(){
+		ofBuffer text;
+		text.set("async file contents");
+		ofBufferToFile("async_test.txt", text);
+
+		ofBuffer read;
+		ofFileLoadResult result;
+		auto mainThread = std::this_thread::get_id();
+		bool calledFromMain = false;
+		auto id = ofReadFileAsync("async_test.txt", [&](ofBuffer & buffer, const ofFileLoadResult & r){
+			read = std::move(buffer);
+			result = r;
+			calledFromMain = std::this_thread::get_id() == mainThread;
+		});
+		test_eq(read.size(), 0, "callbacks aren't called before an update");
+		waitForRequests();
+		test(result.loaded, "read loaded");
+		test_eq(result.id, id, "result id");
+		test_eq(read.getText(), text.getText(), "read contents");
+		test(calledFromMain, "callbacks are called from the main thread");
+
+		ofFileLoadResult missing;
+		missing.loaded = true;
+		ofReadFileAsync("async_test_missing.txt", [&](ofBuffer &, const ofFileLoadResult & r){
+			missing = r;
+		});
+		waitForRequests();
+		test(!missing.loaded && !missing.error.empty(), "missing files fail with an error");
+
+		// keep the only loader thread busy while queueing requests with
+		// different priorities
+		ofSetNumFileLoaderThreads(1);
+		std::atomic<bool> release(false);
+		std::vector<int> order;
+		ofLoadFileAsync("", [&](const std::filesystem::path &){
+			while(!release){
+				ofSleepMillis(1);
+			}
+			return true;
+		}, [&](const ofFileLoadResult &){
+			order.push_back(0);
+		});
+		ofSleepMillis(50);
+		std::vector<int> ids(5);
+		for(int i = 1; i < 5; i++){
+			ids[i] = ofLoadFileAsync("", [](const std::filesystem::path &){
+				return true;
+			}, [&order, i](const ofFileLoadResult &){
+				order.push_back(i);
+			}, i == 2 ? 5 : 0);
+		}
+		ofSetFileRequestPriority(ids[4], 10);
+		ofCancelFileRequest(ids[3]);
+		release = true;
+		waitForRequests();
+		test((order == std::vector<int>{0, 4, 2, 1}), "requests are loaded by priority and cancelled ones are skipped");
+		ofSetNumFileLoaderThreads(2);
+
+		ofPixels pixels;
+		pixels.allocate(64, 32, OF_PIXELS_RGB);
+		for(size_t i = 0; i < pixels.size(); i++){
+			pixels[i] = i % 256;
+		}
+		ofSaveImage(pixels, "async_test.png");
+		ofPixels loadedPixels;
+		ofLoadImageAsync("async_test.png", [&](ofPixels & pix, const ofFileLoadResult & r){
+			if(r.loaded){
+				loadedPixels = std::move(pix);
+			}
+		});
+		waitForRequests();
+		test(loadedPixels.getWidth() == 64 && loadedPixels.getHeight() == 32, "image dimensions");
+		test(loadedPixels.size() == pixels.size() && std::equal(pixels.begin(), pixels.end(), loadedPixels.begin()), "image pixels");
+
+		ofMesh mesh = ofMesh::box(10, 10, 10);
+		mesh.save("async_test.ply");
+		ofMesh loadedMesh;
+		ofLoadMeshAsync("async_test.ply", [&](ofMesh & m, const ofFileLoadResult & r){
+			if(r.loaded){
+				loadedMesh = std::move(m);
+			}
+		});
+		waitForRequests();
+		test_eq(loadedMesh.getNumVertices(), mesh.getNumVertices(), "mesh vertices");
+
+		ofFile::removeFile("async_test.txt");
+		ofFile::removeFile("async_test.png");
+		ofFile::removeFile("async_test.ply");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -211,6 +211,55 @@ class ofApp: public ofxUnitTestsApp{
 			test(allLinesEqual, "all lines are correct");
 			test_eq(numLines,lines.size(),"lines iterator correct numLines");
 		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "file read and mapped";
+			std::string text;
+			for(int i=0;i<10000;i++){
+				text += "line " + ofToString(i) + "\r\n";
+			}
+			ofBuffer src;
+			src.set(text);
+			ofBufferToFile("buffer_test.txt", src);
+
+			ofBuffer read = ofBufferFromFile("buffer_test.txt");
+			test(!read.isMapped(), "regular load isn't mapped");
+			test_eq(read.getText(), text, "regular load reads the whole file");
+
+			ofBuffer mapped = ofBufferFromFile("buffer_test.txt", ofBufferLoadMode::Mapped);
+			test(mapped.isMapped(), "mapped load is mapped");
+			test_eq(mapped.size(), text.size(), "mapped size");
+			test_eq(mapped.getText(), text, "mapped contents");
+			auto numLines = 0;
+			auto allLinesEqual = true;
+			for(auto line: mapped.getLines()){
+				allLinesEqual &= line == "line " + ofToString(numLines);
+				++numLines;
+			}
+			test(allLinesEqual, "mapped lines are correct");
+			test_eq(numLines, 10000, "mapped lines iterator correct numLines");
+
+			numLines = 0;
+			allLinesEqual = true;
+			for(auto line: mapped.getLineViews()){
+				allLinesEqual &= line == "line " + ofToString(numLines);
+				++numLines;
+			}
+			test(allLinesEqual, "line views are correct");
+			test_eq(numLines, 10000, "line views iterator correct numLines");
+
+			mapped.getData()[0] = 'X';
+			test_eq(ofBufferFromFile("buffer_test.txt", ofBufferLoadMode::Mapped).getData()[0], 'l', "writing to a mapped buffer doesn't change the file");
+			ofBuffer copy = mapped;
+			test(!copy.isMapped() && copy.getData()[0] == 'X', "copies of mapped buffers own their data");
+			mapped.append("end");
+			test(!mapped.isMapped() && mapped.size() == text.size() + 3, "appending to a mapped buffer copies it");
+
+			ofBuffer missing = ofBufferFromFile("buffer_test_missing.txt", ofBufferLoadMode::Mapped);
+			test_eq(missing.size(), 0, "missing file");
+			ofFile::removeFile("buffer_test.txt");
+		}
 	}
 };
 
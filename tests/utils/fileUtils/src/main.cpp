@@ -147,6 +147,32 @@ class ofApp: public ofxUnitTestsApp{
 		test(ofDirectory("d4").remove(true),"ofDirectory::remove recursive");
 		test(!ofDirectory("d4").exists(),"!ofDirectory::exists after remove");
 
+		ofFile("d2/f10.jpg").create();
+		ofFile("d2/d3/f9.JPG").create();
+		ofBufferToFile("d2/d3/f8.txt", ofBuffer("12345", 5));
+		auto listing = ofDirectory("d2").scan();
+		test_eq(listing.size(), 6, "ofDirectory::scan recursive");
+		listing.sort();
+		std::vector<std::string> paths;
+		for(std::size_t i = 0; i < listing.size(); i++){
+			paths.push_back(listing.getRelativePath(i).toString());
+		}
+		test((paths == std::vector<std::string>{"d3", "d3/f2", "d3/f8.txt", "d3/f9.JPG", "f1", "f10.jpg"}), "ofDirectoryListing::sort");
+		test(listing.isDirectory(0) && listing.isFile(1), "ofDirectoryListing types");
+		test_eq(listing.getSize(2), uint64_t(5), "ofDirectoryListing::getSize");
+		test_eq(listing.getName(2), "f8.txt", "ofDirectoryListing::getName");
+		test_eq(listing.getExtension(3), "JPG", "ofDirectoryListing::getExtension");
+		test(listing.getFile(2).isFile(), "ofDirectoryListing::getFile");
+		test_eq(ofDirectory("d2").scan(false).size(), 3, "ofDirectory::scan not recursive");
+		ofDirectory jpgs("d2");
+		jpgs.allowExt("jpg");
+		listing = jpgs.scan();
+		listing.sort();
+		test(listing.size() == 2 && listing.getName(0) == "f9.JPG" && listing.getName(1) == "f10.jpg", "ofDirectory::scan with allowed extensions");
+		ofFile::removeFile("d2/f10.jpg");
+		ofFile::removeFile("d2/d3/f9.JPG");
+		ofFile::removeFile("d2/d3/f8.txt");
+
 
 
 		//========================================================================
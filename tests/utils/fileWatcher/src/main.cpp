@@ -0,0 +1,105 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// the tests run from setup so updates have to be triggered by hand to
+	// get the notifications
+	void updateFor(uint64_t milliseconds){
+		auto end = ofGetElapsedTimeMillis() + milliseconds;
+		while(ofGetElapsedTimeMillis() < end){
+			ofEvents().notifyUpdate();
+			ofSleepMillis(5);
+		}
+	}
+
+	void fileChanged(ofFileWatcherEventArgs & args){
+		changes.emplace_back(ofFilePath::getFileName(args.path.string()), args.type);
+	}
+
+	void testWatcher(bool polling){
+		auto name = polling ? std::string(" polling") : std::string("");
+		ofDirectory::removeDirectory("watched", true);
+		ofDirectory::createDirectory("watched/sub", true, true);
+		ofBufferToFile("watched/existing.txt", ofBuffer("x", 1));
+		ofBufferToFile("single.txt", ofBuffer("x", 1));
+
+		ofFileWatcher watcher;
+		watcher.setUsePolling(polling);
+		watcher.setPollingInterval(50);
+		watcher.setCoalesceTime(100);
+		ofAddListener(watcher.fileChanged, this, &ofApp::fileChanged);
+		watcher.watch("watched", true);
+		watcher.watch("single.txt");
+		watcher.watch("missing.txt");
+		if(ofGetTargetPlatform() == OF_TARGET_LINUX || ofGetTargetPlatform() == OF_TARGET_LINUX64){
+			test_eq(watcher.isPolling(), polling, "isPolling" + name);
+		}
+		changes.clear();
+		updateFor(200);
+		test(changes.empty(), "no changes without modifications" + name);
+
+		ofBufferToFile("watched/new.txt", ofBuffer("new", 3));
+		for(int i = 0; i < 10; i++){
+			std::string contents(i + 2, 'y');
+			ofBufferToFile("watched/existing.txt", ofBuffer(contents.c_str(), contents.size()));
+		}
+		ofBufferToFile("watched/sub/deep.txt", ofBuffer("x", 1));
+		ofBufferToFile("watched/.hidden", ofBuffer("x", 1));
+		ofBufferToFile("single.txt", ofBuffer("xx", 2));
+		ofBufferToFile("unwatched.txt", ofBuffer("x", 1));
+		updateFor(600);
+		ofSort(changes);
+		test((changes == Changes{
+			{"deep.txt", ofFileWatcherEventArgs::Created},
+			{"existing.txt", ofFileWatcherEventArgs::Modified},
+			{"new.txt", ofFileWatcherEventArgs::Created},
+			{"single.txt", ofFileWatcherEventArgs::Modified},
+		}), "created and modified files are notified once" + name);
+
+		changes.clear();
+		ofFile::removeFile("watched/new.txt");
+		ofBufferToFile("missing.txt", ofBuffer("x", 1));
+		updateFor(600);
+		ofSort(changes);
+		test((changes == Changes{
+			{"missing.txt", ofFileWatcherEventArgs::Created},
+			{"new.txt", ofFileWatcherEventArgs::Removed},
+		}), "removed and new watched files are notified" + name);
+
+		// the change is found but still waiting for the coalesce time when
+		// the path is unwatched
+		changes.clear();
+		watcher.setCoalesceTime(10000);
+		ofBufferToFile("watched/existing.txt", ofBuffer("zzz", 3));
+		updateFor(300);
+		watcher.unwatch("watched");
+		watcher.setCoalesceTime(0);
+		ofBufferToFile("watched/existing.txt", ofBuffer("zzzzzzzz", 8));
+		updateFor(300);
+		test(changes.empty(), "unwatched paths aren't notified" + name);
+
+		ofRemoveListener(watcher.fileChanged, this, &ofApp::fileChanged);
+		ofDirectory::removeDirectory("watched", true);
+		ofFile::removeFile("single.txt");
+		ofFile::removeFile("missing.txt");
+		ofFile::removeFile("unwatched.txt");
+	}
+
+	void run(){
+		testWatcher(false);
+		testWatcher(true);
+	}
+
+	typedef std::vector<std::pair<std::string, ofFileWatcherEventArgs::Type>> Changes;
+	Changes changes;
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
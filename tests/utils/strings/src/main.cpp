@@ -47,6 +47,35 @@ class ofApp: public ofxUnitTestsApp{
 		test_eq(split2[4],"split","split trim2 4");
 		test_eq(split2[5],"test","split trim2 5");
 
+		auto splitViewsEqual = [](const std::string & source, const std::string & delimiter, bool ignoreEmpty, bool trim){
+			std::vector<std::string> views;
+			for(auto token: ofSplitStringView(source, delimiter, ignoreEmpty, trim)){
+				views.push_back(token.toString());
+			}
+			return views == ofSplitString(source, delimiter, ignoreEmpty, trim);
+		};
+		test(splitViewsEqual("hi this is a split test", " ", false, false), "split view");
+		test(splitViewsEqual(" hi this is a split test ", " ", false, false), "split view no trim");
+		test(splitViewsEqual(" hi      this is a split test ", " ", true, true), "split view trim");
+		test(splitViewsEqual("a::b::::c::", "::", false, false), "split view multichar delimiter");
+		test(splitViewsEqual("", ",", false, false), "split view empty string");
+		test(splitViewsEqual("a,b", "", false, false), "split view empty delimiter");
+		auto countTokens = [](ofStringView source){
+			auto tokens = ofSplitStringView(source, ",");
+			return std::distance(tokens.begin(), tokens.end());
+		};
+		test_eq(countTokens(ofStringView()), countTokens(ofStringView("")), "split view null and empty views have the same tokens");
+
+		test_eq(ofToInt(ofStringView(" -42abc")), -42, "int from view");
+		test_eq(ofToInt(ofStringView("2147483648")), 2147483647, "int from view saturates");
+		test_eq(ofToInt64(ofStringView("-9223372036854775807")), -9223372036854775807ll, "int64 from view");
+		test_eq(ofToFloat(ofStringView("3.25e2")), 325.f, "float from view");
+		test_eq(ofToDouble(ofStringView("0.1")), ofToDouble(std::string("0.1")), "double from view");
+		std::string numbers = "1.5,2.5";
+		test_eq(ofToFloat(ofStringView(numbers).substr(0, 3)), 1.5f, "float from a view that isn't null terminated");
+		test_eq(ofToInt("12"), 12, "int from c string");
+		test_eq(ofToFloat("0x10"), ofToFloat(std::string("0x10")), "float from c string parses like a string");
+
 		test_eq(ofJoinString({"hi","this","is","a","join","test"}," "),"hi this is a join test","join string");
 		test_eq(ofJoinString({"hi"}," "),"hi","join string 1 element");
 		test_eq(ofJoinString({}," "),"","join string 0 elements");
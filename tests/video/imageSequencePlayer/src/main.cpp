@@ -0,0 +1,108 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// each frame is filled with its own number so it can be recognized
+	int frameNumber(const ofPixels & pixels){
+		return pixels.getColor(0, 0).r;
+	}
+
+	// updates the player until done returns true, frames are decoded in
+	// other threads so on a busy machine it can take much longer than the
+	// frame rate says. onUpdate is called after every update
+	template<typename Done, typename OnUpdate>
+	bool updateUntil(ofImageSequencePlayer & player, Done done, OnUpdate onUpdate){
+		auto deadline = ofGetElapsedTimeMillis() + 20000;
+		while(!done() && ofGetElapsedTimeMillis() < deadline){
+			ofSleepMillis(2);
+			player.update();
+			onUpdate();
+		}
+		return done();
+	}
+
+	// updates the player until it displays a frame
+	bool waitForFrame(ofImageSequencePlayer & player, int frame){
+		updateUntil(player, [&]{ return player.getCurrentFrame() == frame; }, []{});
+		return player.getCurrentFrame() == frame && frameNumber(player.getPixels()) == frame;
+	}
+
+	void run(){
+		const int numFrames = 40;
+		// saved backwards and without padding, the player sorts them by
+		// their number
+		for(int i = numFrames - 1; i >= 0; i--){
+			ofPixels pixels;
+			pixels.allocate(32, 24, OF_PIXELS_RGB);
+			pixels.setColor(ofColor(i, 255 - i, 0));
+			ofSaveImage(pixels, "sequence/frame" + ofToString(i) + ".qoi");
+		}
+		string notes = "not an image";
+		ofBufferToFile("sequence/notes.txt", ofBuffer(notes.c_str(), notes.size()));
+
+		ofImageSequencePlayer player;
+		player.setNumThreads(2);
+		player.setNumPrefetchFrames(4, 1);
+		test(player.load("sequence"), "load");
+		test_eq(player.getTotalNumFrames(), numFrames, "only images are frames");
+		test_eq(player.getWidth(), 32.f, "width");
+		test_eq(player.getCurrentFrame(), 0, "first frame displayed after loading");
+		test_eq(frameNumber(player.getPixels()), 0, "frames sorted by name");
+		player.update();
+		test(player.isFrameNew(), "first frame is new");
+
+		player.setFrame(20);
+		test(waitForFrame(player, 20), "seek");
+		player.nextFrame();
+		test(waitForFrame(player, 21), "next frame");
+		player.previousFrame();
+		player.previousFrame();
+		test(waitForFrame(player, 19), "previous frame");
+
+		// playing backwards and not dropping frames shows every frame in
+		// reverse order
+		player.setDropFrames(false);
+		player.setFrameRate(100);
+		player.setSpeed(-1);
+		player.setLoopState(OF_LOOP_NONE);
+		player.play();
+		vector<int> shown;
+		bool done = updateUntil(player, [&]{ return player.getIsMovieDone(); }, [&]{
+			if(player.isFrameNew()){
+				shown.push_back(frameNumber(player.getPixels()));
+			}
+		});
+		test(done, "done playing");
+		test(waitForFrame(player, 0), "stops at the first frame");
+		bool inOrder = !shown.empty() && shown.front() == 18;
+		for(size_t i = 1; i < shown.size(); i++){
+			inOrder &= shown[i] == shown[i - 1] - 1;
+		}
+		test(inOrder, "frames shown in reverse order");
+		auto stats = player.getStats();
+		test_eq(stats.framesDropped, uint64_t(0), "no frames dropped");
+		test_eq(stats.decodeFailures, uint64_t(0), "no failures");
+		test(stats.framesDecoded >= 19, "frames decoded");
+
+		player.setPixelFormat(OF_PIXELS_RGBA);
+		test(player.load("sequence"), "load again");
+		test_eq(player.getPixelFormat(), OF_PIXELS_RGBA, "pixel format converted");
+		test(!player.setPixelFormat(OF_PIXELS_YUY2), "unsupported pixel format");
+
+		player.close();
+		test(!player.isLoaded(), "closed");
+		test(!player.load("missing"), "missing folder");
+
+		ofDirectory::removeDirectory("sequence", true);
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}